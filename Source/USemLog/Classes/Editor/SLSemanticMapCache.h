@@ -0,0 +1,101 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SLOwlSemanticMap.h"
+
+/**
+* Cached owl nodes of an individual (or class definition) with the hash of the data they were created from
+*/
+struct FSLSemanticMapCacheEntry
+{
+	// Content hash of the gathered data
+	uint64 Hash = 0;
+
+	// Created nodes (individual, pose, bones etc.)
+	TArray<FSLOwlNode> Nodes;
+};
+
+/**
+* Position of the entry nodes in the written document
+*/
+struct FSLSemanticMapCacheRange
+{
+	// Individual id or class name
+	FString Key;
+
+	// Content hash of the gathered data
+	uint64 Hash = 0;
+
+	// First node index in the document array
+	int32 Start = 0;
+
+	// Number of nodes
+	int32 Num = 0;
+};
+
+/**
+ * Sidecar cache of the semantic map (<Filename>_Cache.bin), stores the document id and the nodes of every individual
+ * and class definition together with a hash of their data (id, class, pose, physics, tags, constraints),
+ * the incremental writer reuses the nodes of the unchanged entries and only creates the changed or new ones
+ */
+class USEMLOG_API FSLSemanticMapCache
+{
+public:
+	// Ctor
+	FSLSemanticMapCache();
+
+	// Read the cache from file
+	bool LoadFromFile(const FString& FilePath);
+
+	// Write the ranges of the document to file
+	bool SaveToFile(const FString& FilePath, FSLOwlSemanticMap& Doc) const;
+
+	// Move out the cached nodes of the individual if its hash did not change (each entry can be taken once)
+	bool TakeIndividualNodes(const FString& Id, uint64 Hash, TArray<FSLOwlNode>& OutNodes);
+
+	// Move out the cached nodes of the class definition if its hash did not change (each entry can be taken once)
+	bool TakeClassNodes(const FString& Class, uint64 Hash, TArray<FSLOwlNode>& OutNodes);
+
+	// Remember where the nodes of the individual were written
+	void AddIndividualRange(const FString& Id, uint64 Hash, int32 Start, int32 Num);
+
+	// Remember where the nodes of the class definition were written
+	void AddClassRange(const FString& Class, uint64 Hash, int32 Start, int32 Num);
+
+	// Default cache file path of the semantic map
+	static FString GetFilePath(const FString& InDirectory, const FString& InFilename);
+
+public:
+	// Template of the cached document (the cache is not used if the template changes)
+	ESLOwlSemanticMapTemplate TemplateType;
+
+	// Id of the cached document (kept to have the same describedInMap values)
+	FString DocId;
+
+private:
+	// Move out the cached nodes if the hash did not change
+	static bool TakeNodes(TMap<FString, FSLSemanticMapCacheEntry>& Entries, const FString& Key, uint64 Hash,
+		TArray<FSLOwlNode>& OutNodes);
+
+	// Write the entries of the ranges
+	static void WriteRanges(FArchive& Ar, const TArray<FSLSemanticMapCacheRange>& Ranges, TArray<FSLOwlNode>& Nodes);
+
+	// Read the entries
+	static bool ReadEntries(FArchive& Ar, TMap<FString, FSLSemanticMapCacheEntry>& OutEntries);
+
+private:
+	// Loaded individual entries
+	TMap<FString, FSLSemanticMapCacheEntry> IndividualEntries;
+
+	// Loaded class definition entries
+	TMap<FString, FSLSemanticMapCacheEntry> ClassEntries;
+
+	// Individual ranges of the written document
+	TArray<FSLSemanticMapCacheRange> IndividualRanges;
+
+	// Class definition ranges of the written document
+	TArray<FSLSemanticMapCacheRange> ClassRanges;
+};
@@ -5,9 +5,120 @@
 
 #include "CoreMinimal.h"
 #include "SLOwlSemanticMap.h"
+#include "SLOwlTripleWriter.h"
 
 /**
- * Class for exporting the semantic map in an OWL format
+* Game thread copy of the physics constraint data
+*/
+struct FSLSemanticMapConstraintData
+{
+	// Constrained parent and child ids
+	FString ParentId;
+	FString ChildId;
+
+	// Linear and angular constraint individual ids
+	FString LinId;
+	FString AngId;
+
+	// Linear limits
+	uint8 LinXMotion = 0;
+	uint8 LinYMotion = 0;
+	uint8 LinZMotion = 0;
+	float LinLimit = 0.f;
+	bool bLinSoftConstraint = false;
+	float LinStiffness = 0.f;
+	float LinDamping = 0.f;
+
+	// Angular limits (radians)
+	uint8 AngSwing1Motion = 0;
+	uint8 AngSwing2Motion = 0;
+	uint8 AngTwistMotion = 0;
+	float AngSwing1Limit = 0.f;
+	float AngSwing2Limit = 0.f;
+	float AngTwistLimit = 0.f;
+	bool bAngSoftSwingConstraint = false;
+	float AngSwingStiffness = 0.f;
+	float AngSwingDamping = 0.f;
+	bool bAngSoftTwistConstraint = false;
+	float AngTwistStiffness = 0.f;
+	float AngTwistDamping = 0.f;
+};
+
+/**
+* Game thread copy of the data needed to create the individuals of an object or constraint
+*/
+struct FSLSemanticMapIndividualData
+{
+	// Semantic id
+	FString Id;
+
+	// Semantic class (empty for constraints)
+	FString Class;
+
+	// True if the data describes a physics constraint
+	bool bIsConstraint = false;
+
+	// Attachment parent id
+	FString ParentId;
+
+	// Direct children ids
+	TArray<FString> ChildIds;
+
+	// Mobility (static, stationary, kinematic, dynamic)
+	FString Mobility;
+
+	// Physics properties (gravity, overlap events, mass)
+	bool bHasPhysics = false;
+	float Mass = 0.f;
+	bool bGenerateOverlapEvents = false;
+	bool bGravity = false;
+
+	// Visual mask color
+	FString ColorHex;
+
+	// Actors and scene components have a pose and tags data
+	bool bHasPose = false;
+	FString PoseId;
+	FVector Location = FVector::ZeroVector;
+	FQuat Quat = FQuat::Identity;
+	TArray<FName> Tags;
+
+	// Path to the static mesh model
+	FString PathToCadModel;
+
+	// Skeletal bones, their ids and the index of their parent bone
+	TArray<FString> BoneNames;
+	TArray<FString> BoneIds;
+	TArray<int32> BoneParentIdxs;
+
+	// Constraint data
+	FSLSemanticMapConstraintData Constraint;
+};
+
+/**
+* Game thread copy of the data needed to create a class definition
+*/
+struct FSLSemanticMapClassData
+{
+	// Class name
+	FString Class;
+
+	// Upper class
+	FString SubClassOf;
+
+	// Bounding box size (zero if not available)
+	FVector BBSize = FVector::ZeroVector;
+
+	// Skeletal actors get the person upper class, capabilities and bone class definitions
+	bool bIsSkeletalActor = false;
+
+	// Skeletal bone names
+	TArray<FString> BoneNames;
+};
+
+/**
+ * Class for exporting the semantic map in an OWL format,
+ * the actor data is gathered on the game thread, the individuals are created in parallel and merged in the actor order
  */
 struct USEMLOG_API FSLSemanticMapWriter
 {
@@ -15,12 +126,14 @@ public:
 	// Default constructor
 	FSLSemanticMapWriter();
 
-	// Write semantic map to file
+	// Write semantic map to file, in incremental mode only the individuals changed since the last write are re-created
 	bool WriteToFile(UWorld* World,
 		ESLOwlSemanticMapTemplate TemplateType = ESLOwlSemanticMapTemplate::NONE,
 		const FString& InDirectory = TEXT("SemLog"),
 		const FString& InFilename = TEXT("SemanticMap"),
-		bool bOverwrite = false);
+		bool bOverwrite = false,
+		ESLOwlDocFormat Format = ESLOwlDocFormat::RdfXml,
+		bool bIncremental = false);
 
 private:
 	// Create semantic map template
@@ -29,28 +142,34 @@ private:
 		const FString& DocId = "");
 
 	// Add individuals to the semantic map
-	void AddAllIndividuals(TSharedPtr<FSLOwlSemanticMap> InSemMap, UWorld* World);
-
-	// Add object individual to the semantic map
-	void AddObjectIndividual(TSharedPtr<FSLOwlSemanticMap> InSemMap,
-		UObject* Object,
-		const FString& InId,
-		const FString& InClass);
-
-	// Add class definition individual
-	void AddClassDefinition(TSharedPtr<FSLOwlSemanticMap> InSemMap,
-		UObject* Object,
-		const FString& InClass,
-		const FString& InSubClassOf = TEXT(""));
-
-	// Add constraint individual
-	void AddConstraintIndividual(TSharedPtr<FSLOwlSemanticMap> InSemMap,
-		class UPhysicsConstraintComponent* ConstraintComp,
-		const FString& InId,
-		const TArray<FName>& InTags);
-
-	// Add individual physics properties
-	TArray<FSLOwlNode> GetIndividualPhysicsProperties(UObject* Object);
+	void AddAllIndividuals(TSharedPtr<FSLOwlSemanticMap> InSemMap, UWorld* World, class FSLSemanticMapCache& Cache);
+
+	// Copy the object individual data (game thread)
+	void GatherObjectData(UObject* Object, const FString& InId, const FString& InClass, FSLSemanticMapIndividualData& OutData);
+
+	// Copy the constraint individual data, false if the constrained actors are not annotated (game thread)
+	bool GatherConstraintData(class UPhysicsConstraintComponent* ConstraintComp, const FString& InId,
+		const TArray<FName>& InTags, FSLSemanticMapIndividualData& OutData);
+
+	// Generate the unique pose, bone and constraint ids of the individual
+	static void GenerateIds(FSLSemanticMapIndividualData& InOutData);
+
+	// Copy the class definition data (game thread)
+	void GatherClassData(UObject* Object, const FString& InClass, const FString& InSubClassOf, FSLSemanticMapClassData& OutData);
+
+	// Create the object individual and its pose and bone individuals (thread safe)
+	static void CreateObjectIndividuals(const FSLSemanticMapIndividualData& InData,
+		const FString& MapPrefix, const FString& DocId, TArray<FSLOwlNode>& OutNodes);
+
+	// Create the constraint individual and its pose and limits individuals (thread safe)
+	static void CreateConstraintIndividuals(const FSLSemanticMapIndividualData& InData,
+		const FString& MapPrefix, const FString& DocId, TArray<FSLOwlNode>& OutNodes);
+
+	// Create the class definition and its bone class definitions (thread safe)
+	static void CreateClassDefinitions(const FSLSemanticMapClassData& InData, TArray<FSLOwlNode>& OutNodes);
+
+	// Add bounding box size properties
+	static void AddSizeProperties(FSLOwlNode& ClassDefinition, const FVector& BBSize);
 	
 	// Get object semantically annotated parent id (empty string if none)
 	FString GetParentId(UObject* Object);
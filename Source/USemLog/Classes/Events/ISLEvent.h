@@ -48,4 +48,10 @@ public:
 		
 	// To string
 	virtual FString ToString() const = 0;
+
+	// Get the event type name (e.g. Contact, Grasp)
+	virtual FString TypeName() const = 0;
+
+	// Get the ids of the participating entities
+	virtual void GetParticipantIds(TArray<FString>& OutIds) const = 0;
 };
\ No newline at end of file
@@ -0,0 +1,164 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Forward declaration
+class ISLEvent;
+
+/**
+* Indexed event interval
+*/
+struct FSLEventIndexEntry
+{
+	// Unique id of the event
+	FString Id;
+
+	// Index of the event type name
+	int32 TypeIdx;
+
+	// Start time of the event
+	float Start;
+
+	// End time of the event
+	float End;
+
+	// Indexes of the participating entity ids
+	TArray<int32> ParticipantIdxs;
+
+	// Default ctor
+	FSLEventIndexEntry() : TypeIdx(INDEX_NONE), Start(0.f), End(0.f) {};
+};
+
+/**
+ * Start time sorted entry indexes with a max end time tree on top (bottom up, over a power of two number of leaves),
+ * an insert shifts the entries starting later by one leaf and updates their ancestors only (O(log n + shifted entries))
+ */
+struct FSLEventIntervalTree
+{
+	// Entry indexes sorted by start (equal starts keep the insertion order)
+	TArray<int32> SortedIdxs;
+
+	// Max end time of the entries of each node (node 1 is the root, the leaves start at Capacity)
+	TArray<float> MaxEnd;
+
+	// Number of leaves
+	int32 Capacity = 0;
+
+	// Number of entries in the tree
+	int32 Num() const { return SortedIdxs.Num(); }
+
+	// Insert the entry at its start position
+	void Insert(int32 EntryIdx, const TArray<FSLEventIndexEntry>& Entries);
+
+	// Re-build the tree from the sorted indexes (bulk loading)
+	void Build(const TArray<FSLEventIndexEntry>& Entries);
+
+	// Collect the entries with start <= End and end >= Start
+	void Query(float Start, float End, const TArray<FSLEventIndexEntry>& Entries, TArray<int32>& OutEntryIdxs) const;
+
+	// Remove all entries
+	void Empty();
+
+private:
+	// Re-compute the leaves of the [First, Last) sorted positions and their ancestors
+	void UpdateLeaves(int32 First, int32 Last, const TArray<FSLEventIndexEntry>& Entries);
+
+	// Collect the entries of the node covering the [Low, High) sorted positions
+	void QueryNode(int32 NodeIdx, int32 Low, int32 High, float Start, float End,
+		const TArray<FSLEventIndexEntry>& Entries, TArray<int32>& OutEntryIdxs) const;
+};
+
+/**
+ * Interval index over the finished events, keyed by [Start, End] with secondary keys by type and participant;
+ * the entries keep their insertion order (stable indexes), every key has its own interval tree updated on add
+ * (O(log n + k) stabbing and overlap queries on the smallest matching tree, nothing is re-built);
+ * saved next to the episode (<EpisodeId>_EI.bin) to be loaded by the offline tools without parsing the owl file
+ */
+class USEMLOG_API FSLEventIndex
+{
+public:
+	// Ctor
+	FSLEventIndex();
+
+	// Add the finished event
+	void Add(const ISLEvent& Event);
+
+	// Add the event interval
+	void Add(const FString& Id, const FString& TypeName, float Start, float End, const TArray<FString>& ParticipantIds);
+
+	// Remove all entries
+	void Empty();
+
+	// Number of indexed events
+	int32 Num() const { return Entries.Num(); }
+
+	// Get the entry (the index stays valid, the returned reference only until the next add)
+	const FSLEventIndexEntry& GetEntry(int32 EntryIdx) const { return Entries[EntryIdx]; }
+
+	// Get the type name of the entry
+	const FString& GetTypeName(const FSLEventIndexEntry& Entry) const { return TypeNames[Entry.TypeIdx]; }
+
+	// Get the participant ids of the entry
+	void GetParticipantIds(const FSLEventIndexEntry& Entry, TArray<FString>& OutIds) const;
+
+	// Get the number of entries of each event type
+	void GetTypeCounts(TMap<FString, int32>& OutCounts) const;
+
+	// Get the entries active at the given time, optionally filtered by type and participant (empty means any)
+	void GetActiveAt(float Time, TArray<int32>& OutEntryIdxs,
+		const FString& TypeName = FString(), const FString& ParticipantId = FString()) const;
+
+	// Get the entries overlapping the time interval, optionally filtered by type and participant (empty means any)
+	void GetOverlapping(float Start, float End, TArray<int32>& OutEntryIdxs,
+		const FString& TypeName = FString(), const FString& ParticipantId = FString()) const;
+
+	// Get the entries of the given type overlapping the given entry (e.g. the grasps during a contact)
+	void GetOverlappingEntry(int32 EntryIdx, const FString& TypeName, TArray<int32>& OutEntryIdxs) const;
+
+	// Write the index to file
+	bool SaveToFile(const FString& FilePath);
+
+	// Read the index from file
+	bool LoadFromFile(const FString& FilePath);
+
+	// Default file path of the episode index (SemLog/<TaskId>/<EpisodeId>_EI.bin)
+	static FString GetEpisodeFilePath(const FString& TaskId, const FString& EpisodeId);
+
+private:
+	// Add the entry to the tree of all entries and to the trees of its keys
+	void InsertEntry(int32 EntryIdx);
+
+	// Check if the entry has the type and the participant (INDEX_NONE means any)
+	bool Matches(const FSLEventIndexEntry& Entry, int32 TypeIdx, int32 ParticipantIdx) const;
+
+	// Get or add the name to the table
+	static int32 GetOrAddName(const FString& Name, TArray<FString>& Names, TMap<FString, int32>& NameToIdx);
+
+private:
+	// Event intervals (in insertion order, their indexes are the entry indexes)
+	TArray<FSLEventIndexEntry> Entries;
+
+	// Tree of all the entries
+	FSLEventIntervalTree EntriesTree;
+
+	// Type names table
+	TArray<FString> TypeNames;
+
+	// Type name to its index
+	TMap<FString, int32> TypeNameToIdx;
+
+	// Participant ids table
+	TArray<FString> ParticipantIds;
+
+	// Participant id to its index
+	TMap<FString, int32> ParticipantIdToIdx;
+
+	// Tree of the entries of each type
+	TArray<FSLEventIntervalTree> TypeTrees;
+
+	// Tree of the entries of each participant
+	TArray<FSLEventIntervalTree> ParticipantTrees;
+};
@@ -0,0 +1,54 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Singleton creating the events of the episode, every event is a single allocation holding the object and its
+ * reference count (MakeShared), and the event ids are made of a random episode prefix and a counter
+ * instead of a new base64 encoded guid for every event; the events are created on the game thread
+ */
+class USEMLOG_API FSLEventPool
+{
+private:
+	// Constructor
+	FSLEventPool();
+
+public:
+	// Destructor
+	~FSLEventPool() = default;
+
+	// Get singleton
+	static FSLEventPool* GetInstance();
+
+	// Delete instance
+	static void DeleteInstance();
+
+	// Start a new episode (new id prefix, counter reset)
+	void Init();
+
+	// Create a new event with a new id as its first argument (one allocation for the event and its reference count)
+	template<typename EventType, typename... ArgTypes>
+	TSharedPtr<EventType> NewEvent(ArgTypes&&... Args)
+	{
+		return MakeShared<EventType>(NewId(), Forward<ArgTypes>(Args)...);
+	}
+
+	// Unique id of the episode events (prefix + counter)
+	FString NewId();
+
+	// Number of ids given out in the current episode
+	uint64 GetNumIds() const { return IdCounter; }
+
+private:
+	// Instance of the singleton
+	static TSharedPtr<FSLEventPool> StaticInstance;
+
+	// Random base64url prefix of the episode ids
+	TArray<TCHAR> IdPrefix;
+
+	// Counter of the episode ids
+	uint64 IdCounter;
+};
@@ -58,5 +58,11 @@ public:
 
 	// Get data as string
 	virtual FString ToString() const override;
+
+	// Get the event type name
+	virtual FString TypeName() const override;
+
+	// Get the ids of the participating entities
+	virtual void GetParticipantIds(TArray<FString>& OutIds) const override;
 	/* End IEvent interface */
 };
\ No newline at end of file
@@ -0,0 +1,35 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Forward declaration
+class ISLEvent;
+
+/**
+ * Writes the events as a columnar timeline file (<EpisodeId>_TL.bin) and an offline viewer page (<EpisodeId>_TL.html);
+ * the events are grouped by context and sorted by start time, each context has per time bucket record offsets
+ * and busy times, the viewer reads only the records of the visible time window (File.slice) and draws the
+ * bucket busy times at coarse zoom, no external scripts are used
+ *
+ * File layout (little endian):
+ *	header: magic, version, start, end, bucket duration, num buckets, num contexts, num events, records offset, strings offset
+ *	contexts: name (len + utf8), max event duration, first record, num records, bucket first records [num buckets + 1], bucket busy times [num buckets]
+ *	records: start, end (float32)
+ *	strings: offsets [num events + 1], utf8 "<id>\t<tooltip>" blob
+ */
+struct USEMLOG_API FSLTimelineWriter
+{
+	// Write the timeline data and the viewer page of the events
+	static bool WriteTimelines(const TArray<TSharedPtr<ISLEvent>>& InEvents,
+		const FString& InLogDir,
+		const FString& InEpId);
+
+	// Write the timeline data file
+	static bool WriteData(const TArray<TSharedPtr<ISLEvent>>& InEvents, const FString& FilePath);
+
+	// Write the viewer page, it loads the given data file name
+	static bool WriteViewer(const FString& FilePath, const FString& DataFileName);
+};
@@ -6,6 +6,7 @@
 #include "CoreMinimal.h"
 #include "SLMetaScannerStructs.h"
 #include "SLMetaScannerToolkit.h"
+#include "Utils/SLImagePipeline.h"
 #include "SLMetaScanner.generated.h"
 
 // Forward declarations
@@ -111,8 +112,11 @@ private:
 	// Clean exit, all the Finish() methods will be triggered
 	void QuitEditor();
 
-	// Save the compressed screenshot image locally
-	void SaveImageLocally(const TArray<uint8>& CompressedBitmap);
+	// Path of the current image if it should be saved locally (empty otherwise)
+	FString GetLocalImagePath() const;
+
+	// Add the scan pose data to the parent once its images are compressed
+	void AddScanPoseEntry();
 
 	// Print progress
 	void PrintProgress() const;
@@ -147,6 +151,12 @@ private:
 	// Contains the data of the current scan in a given camera pose
 	FSLScanPoseData ScanPoseData;
 
+	// Compresses (and saves) the images and adds the scan entries in order
+	FSLImagePipeline ImagePipeline;
+
+	// Image index in the scan pose data to its compression job
+	TArray<TPair<int32, TSharedRef<FSLImageJob, ESPMode::ThreadSafe>>> ScanPoseImages;
+
 	// Pointer to the parent, used for updating the metadata mongo document;
 	USLMetadataLogger* MetadataLoggerParent;
 	
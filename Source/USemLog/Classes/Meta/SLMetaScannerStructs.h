@@ -43,6 +43,12 @@ struct FSLMetaScannerParams
 	// Save the scanned images locally
 	bool bIncludeScansLocally;
 
+	// Number of image compression workers (0 - compress on the game thread)
+	int32 NumImageWorkers = 2;
+
+	// Max memory of the raw images waiting for compression
+	int32 MaxInFlightImagesMB = 512;
+
 	// Default constructor
 	FSLMetaScannerParams() {};
 
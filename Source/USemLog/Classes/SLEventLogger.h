@@ -5,7 +5,9 @@
 
 #include "USemLog.h"
 #include "SLOwlExperiment.h"
+#include "SLOwlTripleWriter.h"
 #include "Events/ISLEventHandler.h"
+#include "Events/SLEventIndex.h"
 #include "SLEventLogger.generated.h"
 
 // Forward declaration
@@ -22,6 +24,9 @@ struct FSLEventWriterParams
 	// Episode unique id
 	FString EpisodeId;
 
+	// Output format of the events document
+	ESLOwlDocFormat DocFormat;
+
 	//// Task description
 	//FString TaskDescription;
 
@@ -34,7 +39,8 @@ struct FSLEventWriterParams
 	// Constructor
 	FSLEventWriterParams(
 		const FString& InTaskId,
-		const FString& InEpisodeId
+		const FString& InEpisodeId,
+		ESLOwlDocFormat InDocFormat = ESLOwlDocFormat::RdfXml
 		/*,
 		const FString& InTaskDescription,
 		const FString& InServerIp = "",
@@ -42,7 +48,8 @@ struct FSLEventWriterParams
 		*/
 		) :
 		TaskId(InTaskId),
-		EpisodeId(InEpisodeId)
+		EpisodeId(InEpisodeId),
+		DocFormat(InDocFormat)
 		/*,
 		TaskDescription(InTaskDescription),
 		ServerIp(InServerIp),
@@ -74,7 +81,8 @@ public:
 		bool bInLogGraspEvents,
 		bool bInPickAndPlaceEvents,
 		bool bInLogSlicingEvents,
-		bool bInWriteTimelines);
+		bool bInWriteTimelines,
+		bool bInUseContactBroadphase = false);
 	
 
 	// Start logger
@@ -116,12 +124,18 @@ private:
 	// Type of owl template to write the events to
 	ESLOwlExperimentTemplate OwlDocTemplate;
 
+	// Output format of the events document
+	ESLOwlDocFormat DocFormat;
+
 	// Save events to timelines
 	bool bWriteTimelines;
 
 	// Array of finished events
 	TArray<TSharedPtr<ISLEvent>> FinishedEvents;
 
+	// Interval index of the finished events (written next to the episode)
+	FSLEventIndex EventIndex;
+
 	// Owl document of the finished events
 	TSharedPtr<FSLOwlExperiment> ExperimentDoc;
 
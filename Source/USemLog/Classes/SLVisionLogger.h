@@ -9,10 +9,15 @@
 #include "Animation/SkeletalMeshActor.h"
 
 #include "Vision/SLVisionStructs.h"
+#include "Vision/SLVisionEpisode.h"
 #include "Vision/SLVisionPoseableMeshActor.h"
 #include "Vision/SLVisionDBHandler.h"
 #include "Vision/SLVisionMaskImageHandler.h"
 #include "Vision/SLVisionOverlapCalc.h"
+#include "Vision/SLVisionSoftwareOcclusion.h"
+#include "Vision/SLVisionOverlapCache.h"
+#include "Vision/SLVisionChangeDetector.h"
+#include "Utils/SLImagePipeline.h"
 
 #include "SLVisionLogger.generated.h"
 
@@ -21,6 +26,25 @@ class UGameViewportClient;
 class ASLVisionCamera;
 class USLSkeletalDataComponent;
 
+/**
+* Image of the frame being compressed, copied into the frame data before it is written
+*/
+struct FSLVisionPendingImage
+{
+	// Index of the view in the frame
+	int32 ViewIdx;
+
+	// Index of the image in the view
+	int32 ImageIdx;
+
+	// Compression job
+	TSharedRef<FSLImageJob, ESPMode::ThreadSafe> Job;
+
+	// Init ctor
+	FSLVisionPendingImage(int32 InViewIdx, int32 InImageIdx, const TSharedRef<FSLImageJob, ESPMode::ThreadSafe>& InJob) :
+		ViewIdx(InViewIdx), ImageIdx(InImageIdx), Job(InJob) {};
+};
+
 /**
  * Replays episodes from different perspectives and view modes,
  * while updating the data with vision related annotations
@@ -62,6 +86,9 @@ public:
 	// Get paused state
 	bool IsPaused() const { return bIsPaused; };
 
+	// Get the image compression pipeline
+	FSLImagePipeline& GetImagePipeline() { return ImagePipeline; };
+
 	// Get access to the static mesh clone from the id
 	AStaticMeshActor* GetStaticMeshMaskCloneFromId(const FString& Id);
 
@@ -86,6 +113,9 @@ protected:
 
 	// Goto next episode frame, return false if there are no other left
 	bool SetupNextEpisodeFrame();
+
+	// Reference the previous data of the current view if nothing in it changed, return true if reused
+	bool ReuseUnchangedView();
 	
 	// Goto the first virtual camera view
 	bool GotoFirstCameraView();
@@ -129,9 +159,12 @@ private:
 
 	// Clean exit, all the Finish() methods will be triggered
 	void QuitEditor();
+
+	// A shard which can not run marks itself as failed (if connected) and exits, otherwise the shards commandlet would wait on it
+	void QuitFailedShard(bool bIsConnected);
 	
-	// Save the compressed screenshot image locally
-	void SaveImageLocally(const TArray<uint8>& CompressedBitmap);
+	// Path of the current image if it should be saved locally (empty otherwise)
+	FString GetLocalImagePath() const;
 	
 	// Output progress to terminal
 	void PrintProgress() const;
@@ -159,10 +192,37 @@ private:
 	// Gathers semantics from the images
 	FSLVisionMaskImageHandler MaskImgHandler;
 
+	// Compresses (and saves) the images and writes the frames in order
+	FSLImagePipeline ImagePipeline;
+
+	// Images of the current frame waiting for compression
+	TArray<FSLVisionPendingImage> CurrFrameImages;
+
+	// Store the mask images with the palette and run-length encoding instead of png
+	bool bEncodeMasks;
+
+	// Timestamp range shard of the episode (INDEX_NONE for the whole episode)
+	int32 ShardIdx;
+
+	// Number of shards the episode is split into
+	int32 NumShards;
+
+	// Set when the last frame of the episode (or shard) was processed
+	bool bIsEpisodeDone;
+
 	// Calculates entities overlap percentages in images
 	UPROPERTY() // Avoid GC
 	USLVisionOverlapCalc* OverlapCalc;
 
+	// Estimates the entities overlap percentages without rendering
+	FSLVisionSoftwareOcclusion SoftwareOcclusion;
+
+	// Reuses the overlaps of the unchanged entities between the frames of a view
+	FSLVisionOverlapCache OverlapCache;
+
+	// Detects the views which are not affected by the frame changes
+	FSLVisionChangeDetector ChangeDetector;
+
 	// Current frame timestamp
 	float CurrTimestamp;
 
@@ -0,0 +1,97 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Vision/SLVisionStructs.h"
+
+// Forward declarations
+class UCameraComponent;
+
+/**
+* Last rendered state of a view
+*/
+struct FSLVisionRenderedView
+{
+	// False until the view is rendered the first time
+	bool bIsValid = false;
+
+	// Timestamp of the frame the view was rendered in
+	float Timestamp = -1.f;
+
+	// Camera pose of the rendered view
+	FTransform CameraPose;
+
+	// Entity data of the rendered view (without the images)
+	FSLVisionViewData Data;
+};
+
+/**
+* Detects the views which are not affected by the pose changes of an episode frame;
+* a view is unchanged if its camera did not move and no moved actor (before or after the move)
+* is inside its frustum, the unchanged views reuse the data and the images of their last rendering
+*/
+class FSLVisionChangeDetector
+{
+public:
+	// Ctor
+	FSLVisionChangeDetector();
+
+	// Set the number of views and the image resolution
+	void Init(int32 NumViews, FIntPoint InResolution);
+
+	// Get init state
+	bool IsInit() const { return bIsInit; };
+
+	// Cache the bounds of the actors the frame is going to move (call before applying the frame)
+	void BeginFrame(const FSLVisionFrame& Frame);
+
+	// Add the bounds of the moved actors after the frame was applied
+	void EndFrame();
+
+	// Check if nothing in the frustum of the camera changed since the last rendering of the view
+	bool IsViewUnchanged(int32 ViewIdx, const UCameraComponent* Camera) const;
+
+	// Get the last rendered state of the view
+	const FSLVisionRenderedView& GetRenderedView(int32 ViewIdx) const { return Views[ViewIdx]; };
+
+	// Store the rendered view
+	void SetRenderedView(int32 ViewIdx, const FSLVisionViewData& ViewData, float Timestamp, const UCameraComponent* Camera);
+
+	// Count the reused view
+	void AddReusedView() { NumReused++; };
+
+	// Log the number of rendered and reused views
+	void LogSummary() const;
+
+private:
+	// Check if any part of the box can be seen from the pose
+	bool IsInFrustum(const FBox& Box, const FTransform& ViewPose, float Focal) const;
+
+public:
+	// Camera poses within this tolerance are considered unchanged
+	static constexpr float CameraPoseTolerance = 1.e-3f;
+
+private:
+	// Set when initialized
+	bool bIsInit;
+
+	// Image resolution
+	FIntPoint Resolution;
+
+	// Last rendered state of every view
+	TArray<FSLVisionRenderedView> Views;
+
+	// Actors moved by the current frame
+	TArray<AActor*> MovedActors;
+
+	// Bounds of the moved actors before and after the move
+	TArray<FBox> MovedBounds;
+
+	// Number of rendered views
+	int64 NumRendered;
+
+	// Number of reused views
+	int64 NumReused;
+};
@@ -5,7 +5,13 @@
 
 #include "CoreMinimal.h"
 #include "Vision/SLVisionStructs.h"
+#include "Vision/SLVisionEpisode.h"
 #include "Animation/SkeletalMeshActor.h"
+#include "HAL/ThreadSafeBool.h"
+
+// Forward declarations
+class FRunnable;
+class FRunnableThread;
 
 #if SL_WITH_LIBMONGO_C
 class ASLVisionPoseableMeshActor;
@@ -20,6 +26,67 @@ THIRD_PARTY_INCLUDES_START
 THIRD_PARTY_INCLUDES_END
 #endif //SL_WITH_LIBMONGO_C
 
+#if SL_WITH_LIBMONGO_C
+/**
+* Image stored in gridfs, referenced by the views reusing it
+*/
+struct FSLVisionDBImageRef
+{
+	// Image type
+	FString Type;
+
+	// Encoding of the data
+	FString Format;
+
+	// Gridfs file id
+	bson_oid_t FileId;
+};
+#endif //SL_WITH_LIBMONGO_C
+
+/**
+* Maps the utf8 keys read from the database to slots, without creating intermediate strings
+*/
+class FSLVisionDBKeyTable
+{
+public:
+	// Add a key, returns its slot (the existing slot if the key was already added)
+	int32 Add(const FString& Key);
+
+	// Get the slot of the utf8 key (INDEX_NONE if not found)
+	int32 Find(const char* Key, uint32 Length) const;
+
+	// Get the number of keys
+	int32 Num() const { return Keys.Num(); };
+
+	// Remove all the keys
+	void Reset() { Keys.Reset(); NextSlots.Reset(); HashToSlot.Reset(); };
+
+private:
+	// Utf8 keys by slot
+	TArray<TArray<ANSICHAR>> Keys;
+
+	// Next slot with the same hash
+	TArray<int32> NextSlots;
+
+	// First slot of every hash
+	TMap<uint32, int32> HashToSlot;
+};
+
+/**
+* Actor of an entity id from the episode data
+*/
+struct FSLVisionDBEntitySlot
+{
+	// Static mesh entity
+	AStaticMeshActor* StaticMeshActor = nullptr;
+
+	// Virtual camera
+	ASLVisionCamera* VisionCamera = nullptr;
+
+	// Poseable clone of the skeletal entity
+	ASLVisionPoseableMeshActor* PoseableMeshActor = nullptr;
+};
+
 /**
  * Helper class for reading and writing vision related data to mongodb
  */
@@ -29,9 +96,12 @@ public:
 	// Ctor
 	FSLVisionDBHandler();
 
-	// Connect to the database
+	// Dtor
+	~FSLVisionDBHandler();
+
+	// Connect to the database (a shard writes to its own staging vision collection)
 	bool Connect(const FString& DBName, const FString& CollName, const FString& ServerIp,
-		uint16 ServerPort, bool bRemovePrevEntries);
+		uint16 ServerPort, bool bRemovePrevEntries, int32 InShardIdx = INDEX_NONE);
 
 	// Disconnect and clean db connection
 	void Disconnect() const;
@@ -39,14 +109,37 @@ public:
 	// Create indexes on the inserted data
 	void CreateIndexes() const;
 
-	// Get episode data from the database (UpdateRate = 0 means all the data)
-	bool GetEpisodeData(float UpdateRate, const TMap<ASkeletalMeshActor*,
+	// Start streaming the episode data (or the timestamp range of the shard) into the episode buffer (UpdateRate = 0 means all the data)
+	bool StartEpisodeStream(float UpdateRate, const TMap<ASkeletalMeshActor*,
 		ASLVisionPoseableMeshActor*>& InSkelToPoseableMap,
-		FSLVisionEpisode& OutEpisode);
+		FSLVisionEpisode& OutEpisode, int32 NumShards = 1);
+
+	// Stop the episode stream and wait for the loader thread
+	void StopEpisodeStream();
+
+	// Check if the loader read all the frames of the episode (or shard) without errors
+	bool IsEpisodeStreamComplete() const { return bIsEpisodeStreamComplete; };
 
 	// Write current frame
 	void WriteFrame(const FSLVisionFrameData& Frame) const;
 
+	// Store the state of the shard (running, finished, failed, merged) in the shards collection
+	void WriteShardState(int32 InShardIdx, int32 NumShards, const FString& State,
+		int32 NumFrames = 0, float FirstTs = -1.f, float LastTs = -1.f) const;
+
+	// Copy the finished shards into the connected (canonical) vision collection in timestamp order, drop their staging collections
+	bool MergeShards(int32 NumShards) const;
+
+	// Read the state of every shard of the episode (empty if the shard never started)
+	static bool GetShardStates(const FString& DBName, const FString& CollName, const FString& ServerIp,
+		uint16 ServerPort, int32 NumShards, TArray<FString>& OutStates);
+
+	// Get the name of the vision collection, or the staging collection of the shard
+	static FString GetVisCollName(const FString& CollName, int32 ShardIdx = INDEX_NONE);
+
+	// Get the name of the collection with the shard states
+	static FString GetShardsCollName(const FString& CollName) { return CollName + TEXT(".vis.shards"); };
+
 private:
 	// Remove any previously added vision data from the database
 	void DropPreviousEntriesFromWorldColl_Legacy(const FString& DBName, const FString& CollName) const;
@@ -54,16 +147,26 @@ private:
 	// Remove any previously added vision data from the database
 	void DropPreviousEntries(const FString& DBName, const FString& CollName) const;
 
-#if SL_WITH_LIBMONGO_C
-	// Helper function to get the entities data out of the bson iterator, returns false if there are no entities
-	bool GetEntitiesData(bson_iter_t* doc,
-		TMap<AStaticMeshActor*, FTransform>& OutEntityPoses,
-		TMap<ASLVisionCamera*, FTransform>& OutVirtualCameraPoses) const;
+	// Map the entity ids and bone names of the episode data to their actors and names (call before loading)
+	void CreateEntitySlots(const TMap<ASkeletalMeshActor*, ASLVisionPoseableMeshActor*>& InSkelToPoseableMap);
+
+	// Read the episode frames (of the shard) into the episode buffer (runs on the loader thread with its own client)
+	bool LoadEpisodeFrames(float UpdateRate, int32 NumShards, FSLVisionEpisode& OutEpisode) const;
 
-	// Helper function to get the entities data out of the bson iterator, returns false if there are no entities
-	bool GetSkeletalEntitiesData(bson_iter_t* doc,
-		const TMap<ASkeletalMeshActor*, ASLVisionPoseableMeshActor*>& InSkelToPoseableMap,
-		TMap<ASLVisionPoseableMeshActor*, TMap<FName, FTransform>>& OutSkeletalPoses) const;
+#if SL_WITH_LIBMONGO_C
+	// Helper function to get the entities data out of the entities array iterator (single pass), returns false if there are no entities;
+	// the poses already in the frame (index by entity slot in InOutSlotToPoseIdx) are overwritten, every entity has one entry
+	bool GetEntitiesData(const bson_iter_t* entities_iter,
+		TArray<TPair<AStaticMeshActor*, FTransform>>& OutEntityPoses,
+		TArray<TPair<ASLVisionCamera*, FTransform>>& OutVirtualCameraPoses,
+		TArray<int32>& InOutSlotToPoseIdx) const;
+
+	// Helper function to get the skeletal entities data out of the skeletal entities array iterator (single pass), returns false if there are no entities;
+	// the bones of the skeletal entities already in the frame are overwritten (or added to their entry)
+	bool GetSkeletalEntitiesData(const bson_iter_t* skel_entities_iter,
+		TArray<TPair<ASLVisionPoseableMeshActor*, int32>>& OutSkeletalPoses,
+		TArray<TPair<FName, FTransform>>& OutBonePoses,
+		TArray<int32>& InOutSlotToPoseIdx) const;
 
 	// Save image to gridfs, get the file oid and return true if succeeded
 	bool AddToGridFs(const TArray<uint8>& InData, bson_oid_t* out_oid) const;
@@ -79,6 +182,39 @@ private:
 #endif //SL_WITH_LIBMONGO_C
 
 private:
+	// Episode loader
+	FRunnable* EpisodeLoader;
+
+	// Thread running the episode loader
+	FRunnableThread* EpisodeLoaderThread;
+
+	// Episode filled by the loader
+	FSLVisionEpisode* StreamedEpisode;
+
+	// Set by the loader if all the frames were read
+	FThreadSafeBool bIsEpisodeStreamComplete;
+
+	// Database name
+	FString DBName;
+
+	// Episode collection name
+	FString CollName;
+
+	// Timestamp range shard of the episode (INDEX_NONE for the whole episode)
+	int32 ShardIdx;
+
+	// Slots of the entity ids
+	FSLVisionDBKeyTable EntityIds;
+
+	// Entity actors by slot
+	TArray<FSLVisionDBEntitySlot> EntitySlots;
+
+	// Slots of the bone names
+	FSLVisionDBKeyTable BoneNameKeys;
+
+	// Bone names by slot
+	TArray<FName> BoneNames;
+
 #if SL_WITH_LIBMONGO_C
 	// Server uri
 	mongoc_uri_t* uri;
@@ -97,5 +233,8 @@ private:
 
 	// Store image binaries
 	mongoc_gridfs_t* gridfs;
+
+	// Last written images of every view (by view id), referenced by the unchanged views
+	mutable TMap<FString, TArray<FSLVisionDBImageRef>> PrevViewImages;
 #endif //SL_WITH_LIBMONGO_C	
 };
@@ -0,0 +1,111 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Vision/SLVisionStructs.h"
+
+/**
+* The episode frames, streamed through a bounded buffer; a loader thread pushes the frames
+* and blocks while the buffer holds more than the prefetch window, the vision logger
+* pops them in order and waits only if the loader is behind
+*/
+class FSLVisionEpisode
+{
+public:
+	// Default ctor
+	FSLVisionEpisode();
+
+	// Dtor
+	~FSLVisionEpisode();
+
+	// Set the buffer limits (episode seconds ahead of the active frame, and max number of buffered frames)
+	void Init(float InPrefetchSeconds = 5.f, int32 InMaxBufferedFrames = 512);
+
+	// Add a new frame (loader side), blocks while the buffer is full, returns false if the episode was stopped
+	bool PushFrame(FSLVisionFrame&& Frame);
+
+	// No more frames will be added (loader side)
+	void SetLoadingFinished();
+
+	// Unblock the loader and the renderer, no more frames will be returned
+	void Stop();
+
+	// Get the active frame in the episode
+	int32 GetCurrIndex() const { return FrameIdx; };
+
+	// Get the number of loaded frames (the total once the loading is finished)
+	int32 GetFramesNum() const;
+
+	// Get the active frame (nullptr if none is active)
+	const FSLVisionFrame* GetCurrFrame() const { return FrameIdx != INDEX_NONE ? &CurrFrame : nullptr; };
+
+	// Get the frame following the active one, waits for the loader (nullptr if none is left, valid until the next setup)
+	const FSLVisionFrame* GetNextFrame();
+
+	// Move actors to the first frame
+	bool SetupFirstFrame(float& OutTimestamp,
+		bool bIncludeMasks,
+		TMap<AStaticMeshActor*, AStaticMeshActor*>& MaskClones,
+		TMap<ASLVisionPoseableMeshActor*, ASLVisionPoseableMeshActor*>& SkelMaskClones);
+
+	// Move actors to the next frame transformations, return false if no more frames are available
+	bool SetupNextFrame(float& OutTimestamp,
+		bool bIncludeMasks,
+		TMap<AStaticMeshActor*, AStaticMeshActor*>& MaskClones,
+		TMap<ASLVisionPoseableMeshActor*, ASLVisionPoseableMeshActor*>& SkelMaskClones);
+
+	// Get first timestamp
+	float GetFirstTimestamp() const;
+
+	// Get the timestamp of the last loaded frame (the last one once the loading is finished)
+	float GetLastTimestamp() const;
+
+private:
+	// Wait until the frame after the active one is buffered, false if there are no more frames
+	bool WaitForNextFrame();
+
+	// Check if the loader has to wait (call with the lock)
+	bool IsBufferFull() const;
+
+private:
+	// Episode seconds buffered ahead of the active frame
+	float PrefetchSeconds;
+
+	// Max number of buffered frames
+	int32 MaxBufferedFrames;
+
+	// Guards the buffer and the loading state
+	mutable FCriticalSection Lock;
+
+	// Signaled when a frame is added or the loading finished
+	FEvent* FrameAddedEvent;
+
+	// Signaled when a frame is removed or the episode is stopped
+	FEvent* FrameRemovedEvent;
+
+	// Frames loaded and not yet active, in order
+	TArray<FSLVisionFrame> Buffer;
+
+	// Active frame
+	FSLVisionFrame CurrFrame;
+
+	// Current frame index
+	int32 FrameIdx;
+
+	// Number of loaded frames
+	int32 NumLoadedFrames;
+
+	// Timestamp of the first loaded frame
+	float FirstTimestamp;
+
+	// Timestamp of the last loaded frame
+	float LastTimestamp;
+
+	// Set by the loader when there are no more frames
+	bool bIsLoadingFinished;
+
+	// Set when the episode is stopped
+	bool bIsStopped;
+};
@@ -0,0 +1,47 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+* Run of equal pixels in a mask image row
+*/
+struct FSLVisionMaskRun
+{
+	// Number of pixels
+	int32 Len;
+
+	// Color index (see FSLVisionMaskImageHandler, 0 - black, dense color index + 1, or unknown)
+	uint32 Code;
+
+	// Color of the unknown codes
+	FColor Color;
+};
+
+/**
+ * Lossless mask image encoding, a palette of the colors in the image and the row-wise runs of palette indices,
+ * optionally zlib compressed on top; mask images are made of a few hundred flat colored regions
+ * so this is faster to produce and smaller than png
+ *
+ * Layout (little endian):
+ *	header: magic, version, width, height, flags, num palette colors
+ *	palette: RGBA colors
+ *	payload (zlib: raw size + compressed bytes): runs as varint length + varint palette index, runs do not cross rows
+ */
+struct USEMLOG_API FSLVisionMaskCodec
+{
+	// Format name of the encoded images
+	static const FString FormatName;
+
+	// Code of the unknown colors in the runs
+	static const uint32 UnknownCode;
+
+	// Encode the runs (in raster order), the palette holds the colors of the codes (e.g. the original mask colors)
+	static void Encode(int32 Width, int32 Height, const TArray<FSLVisionMaskRun>& Runs, const TArray<FColor>& CodeColors,
+		bool bCompress, TArray<uint8>& OutData);
+
+	// Decode the image, returns false if the data is not a valid encoded mask
+	static bool Decode(const TArray<uint8>& InData, int32& OutWidth, int32& OutHeight, TArray<FColor>& OutBitmap);
+};
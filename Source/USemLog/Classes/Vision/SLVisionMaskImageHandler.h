@@ -6,6 +6,7 @@
 #include "CoreMinimal.h"
 #include "Engine/StaticMeshActor.h"
 #include "SLVisionStructs.h"
+#include "SLVisionMaskCodec.h"
 
 /**
 * Image pixel color related data, convenient mapping of mask colors to their semantic data
@@ -80,7 +81,27 @@ struct FSLVisionImageColorInfo
 };
 
 /**
- * 
+* Pixel statistics of a mask color in a part of the image (rows of a worker)
+*/
+struct FSLVisionMaskPixelStats
+{
+	// Number of pixels
+	int64 Num = 0;
+
+	// Bounding box without the first pixel (the first pixel of a color only inits its data)
+	FIntPoint MinBB;
+	FIntPoint MaxBB;
+
+	// Raster index of the first pixel
+	int32 FirstPixel = MAX_int32;
+
+	// Position of the first pixel
+	FIntPoint FirstPixelPos;
+};
+
+/**
+ * Restores the mask images and gets the entities data from them, the rendered colors are mapped
+ * to dense indices through a 24 bit lookup table, the image rows are processed in parallel
  */
 class FSLVisionMaskImageHandler
 {
@@ -88,25 +109,25 @@ public:
 	// Ctor
 	FSLVisionMaskImageHandler();
 
-	// Load the color to entities mapping
-	bool Init();
+	// Load the color to entities mapping, rendered colors within the tolerance (sum of the channel differences) are restored to the closest mask
+	bool Init(uint8 InColorTolerance = 0);
 
 	// Clear init flag and mappings
 	void Reset();
 
-	// Restore image (the screenshot image pixel colors are a bit offseted from the supposed mask value) and get the entities from mask image
-	void GetDataAndRestoreImage(TArray<FColor>& MaskBitmap, int32 ImgWidth, int32 ImgHeight, FSLVisionViewData& OutViewData) const;
+	// Restore image (the screenshot image pixel colors are a bit offseted from the supposed mask value) and get the entities from mask image,
+	// if OutEncodedMask is set the restored image is also encoded with FSLVisionMaskCodec in the same pass
+	void GetDataAndRestoreImage(TArray<FColor>& MaskBitmap, int32 ImgWidth, int32 ImgHeight, FSLVisionViewData& OutViewData,
+		TArray<uint8>* OutEncodedMask = nullptr) const;
 
 private:
 	/* Helper functions */
-	// Restore the color of the pixel to its original mask value (offseted by screenshot rendering artifacts), returns true if restoration happened
-	bool RestoreColorValueFromArray(FColor& PixelColor, const TArray<FColor>& InOriginalMaskColors, uint8 Tolerance = 13) const;
+	// Count the pixels of the rows and restore their colors, runs of equal pixels are processed at once
+	void ProcessRows(FColor* Pixels, int32 ImgWidth, int32 FirstRow, int32 LastRow,
+		TArray<FSLVisionMaskPixelStats>& OutStats, TSet<FColor>& OutUnknownColors, TArray<FSLVisionMaskRun>* OutRuns) const;
 
-	// Check if the two colors are equal with a tolerance
-	FORCEINLINE static bool AlmostEqual(const FColor& C1, const FColor& C2, uint8 Tolerance = 0)
-	{
-		return FMath::Abs(C1.R - C2.R) + FMath::Abs(C1.G - C2.G) + FMath::Abs(C1.B - C2.B) <= Tolerance;
-	}
+	// Map every color within the tolerance of a rendered mask color to its dense index
+	void BuildColorLookupTable(uint8 Tolerance);
 
 private:
 	// Init flag
@@ -117,4 +138,16 @@ private:
 
 	// Rendered color to skeletal entity data
 	TMap<FColor, FSLVisionMaskSkelInfo> RenderedColorToSkelInfo;
+
+	// Rendered 24 bit RGB value to the dense index + 1 of the closest mask color within the tolerance (0 if unknown)
+	TArray<uint16> RenderedColorToIdx;
+
+	// Rendered colors of the dense indices
+	TArray<FColor> DenseRenderedColors;
+
+	// Original mask colors of the dense indices
+	TArray<FColor> DenseOrigMaskColors;
+
+	// Colors of the run codes (black + the original mask colors of the dense indices)
+	TArray<FColor> RunCodeColors;
 };
@@ -0,0 +1,98 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Vision/SLVisionStructs.h"
+
+// Forward declarations
+class USLVisionLogger;
+class UCameraComponent;
+
+/**
+* Overlaps of the last processed frame of a view
+*/
+struct FSLVisionOverlapViewCache
+{
+	// False until the first frame of the view is stored
+	bool bIsValid = false;
+
+	// Camera pose of the stored frame
+	FTransform CameraPose;
+
+	// Entities of the stored frame by id
+	TMap<FString, FSLVisionViewEntityData> Entities;
+
+	// Skeletal entities of the stored frame by id
+	TMap<FString, FSLVisionViewSkelData> SkelEntities;
+
+	// Screen footprints of the mask clones visible in the stored frame
+	TMap<AActor*, FBox2D> ScreenBounds;
+
+	// Mask clones moved since the stored frame
+	TSet<AActor*> MovedActors;
+};
+
+/**
+* Reuses the overlap (occlusion) values of the entities between the frames of a view;
+* if the camera did not move, only the entities that moved, or whose screen footprint
+* intersects the previous or current footprint of a moved entity, are recalculated
+*/
+class FSLVisionOverlapCache
+{
+public:
+	// Ctor
+	FSLVisionOverlapCache();
+
+	// Set the parent (access to the mask clones), the number of views and the image resolution
+	void Init(USLVisionLogger* InParent, int32 NumViews, FIntPoint InResolution);
+
+	// Get init state
+	bool IsInit() const { return bIsInit; };
+
+	// Mark the mask clones moved by the new episode frame as dirty in every view
+	void AddMovedActors(const TArray<AActor*>& MovedActors);
+
+	// Copy the cached overlaps to the unchanged entities of the view, return the number of entities left to calculate
+	int32 ReuseOverlaps(int32 ViewIdx, const UCameraComponent* Camera, FSLVisionViewData& ViewData);
+
+	// Store the overlaps of the view (call after ReuseOverlaps once the overlaps are calculated)
+	void Update(int32 ViewIdx, const FSLVisionViewData& ViewData);
+
+	// Log the number of reused and calculated overlaps
+	void LogSummary() const;
+
+private:
+	// Project the bounds of the mask clone to the screen, false if not possible
+	bool GetScreenBounds(AActor* MaskClone, const FTransform& ViewPose, float Focal, FBox2D& OutBounds) const;
+
+public:
+	// Camera poses within this tolerance are considered unchanged
+	static constexpr float CameraPoseTolerance = 1.e-3f;
+
+private:
+	// Set when initialized
+	bool bIsInit;
+
+	// Gives access to the mask clones
+	USLVisionLogger* Parent;
+
+	// Image resolution
+	FIntPoint Resolution;
+
+	// Cached overlaps of every view
+	TArray<FSLVisionOverlapViewCache> Views;
+
+	// Camera pose of the view being calculated
+	FTransform CurrCameraPose;
+
+	// Screen footprints of the view being calculated
+	TMap<AActor*, FBox2D> CurrScreenBounds;
+
+	// Number of entities with reused overlaps
+	int64 NumReused;
+
+	// Number of entities with calculated overlaps
+	int64 NumCalculated;
+};
@@ -34,8 +34,8 @@ public:
 	// Give control to the overlap calc to pause and start its parent (vision logger)
 	void Init(USLVisionLogger* InParent, FIntPoint InResolution, const FString& InSaveLocallyPath = FString());
 
-	// Calculate overlaps for the given scene
-	void Start(struct FSLVisionViewData* CurrViewData, float Timestamp, int32 FrameIdx);
+	// Calculate overlaps for the given scene, false if there is nothing to calculate (the parent is not paused)
+	bool Start(struct FSLVisionViewData* CurrViewData, float Timestamp, int32 FrameIdx);
 
 	// Reset all flags and temporaries, called when the scene overlaps are calculated, this un-pauses the parent as well
 	void Finish();
@@ -26,7 +26,7 @@ public:
 	bool IsInit() const { return bIsInit; };
 
 	// Apply bone transformations
-	void SetBoneTransforms(const TMap<FName, FTransform>& BoneTransfroms);
+	void SetBoneTransforms(const TArrayView<const TPair<FName, FTransform>>& BoneTransfroms);
 
 	// Set a custom material on the skeletal mesh at the given index
 	bool SetCustomMaterial(int32 ElementIndex, UMaterialInterface* Material);
@@ -0,0 +1,178 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Vision/SLVisionStructs.h"
+
+// Forward declarations
+class USLVisionLogger;
+class UStaticMesh;
+class UCameraComponent;
+class USkeletalBodySetup;
+struct FKAggregateGeom;
+
+/**
+* Local space triangles of the simplified geometry (lowest LOD or collision) of a mesh or body
+*/
+struct FSLOcclusionMesh
+{
+	// Local space vertices
+	TArray<FVector> Vertices;
+
+	// Triangle vertex indices
+	TArray<int32> Indices;
+};
+
+/**
+* Item rasterized into the depth buffer (entity, or a body of a skeletal entity)
+*/
+struct FSLOcclusionItem
+{
+	// Index of the entity in the view (INDEX_NONE if part of a skeletal entity)
+	int32 EntityIdx = INDEX_NONE;
+
+	// Index of the skeletal entity in the view (INDEX_NONE if static)
+	int32 SkelIdx = INDEX_NONE;
+
+	// Index of the bone in the skeletal entity (INDEX_NONE if the body has no semantic bone)
+	int32 BoneIdx = INDEX_NONE;
+
+	// Projected triangles, three vertices each (x, y in pixels, z as inverse depth)
+	TArray<FVector> ScreenTris;
+
+	// Number of pixels covered by the item if nothing was in front of it
+	int64 NumPixels = 0;
+
+	// Number of pixels where the item is the closest one
+	int64 NumVisiblePixels = 0;
+
+	// True if the item covers the edges of the image
+	bool bIsClipped = false;
+};
+
+/**
+* Estimates the occlusion percentages of the entities in a view with a single software rasterization pass;
+* the simplified geometry of the mask clones is rasterized into a shared depth buffer while counting
+* the coverage of every item, no screenshots (or GPU) are required
+*/
+class FSLVisionSoftwareOcclusion
+{
+public:
+	// Ctor
+	FSLVisionSoftwareOcclusion();
+
+	// Set the parent (access to the mask clones) and the resolution of the depth buffer
+	void Init(USLVisionLogger* InParent, FIntPoint InResolution);
+
+	// Get init state
+	bool IsInit() const { return bIsInit; };
+
+	// Calculate the occlusion percentages and the clipped flags of the entities in the view
+	void Calculate(const UCameraComponent* Camera, FSLVisionViewData& ViewData);
+
+	// Calculate the occlusion percentages on a copy of the view entities, compared later against the screenshot values
+	void CalculateForValidation(const UCameraComponent* Camera, const FSLVisionViewData& ViewData);
+
+	// Compare the last validation estimates against the values calculated from the screenshots
+	void Validate(const FSLVisionViewData& ScreenshotViewData);
+
+	// Log the accumulated validation errors
+	void LogValidationSummary() const;
+
+private:
+	// Project the geometry of the view entities to the screen
+	void ProjectItems(const UCameraComponent* Camera, FSLVisionViewData& ViewData);
+
+	// Rasterize the items into the depth buffer, count the covered and visible pixels
+	void RasterizeItems(TArray<int64>& OutSkelNumPixels);
+
+	// Rasterize the items in the given rows, count the covered and visible pixels of the rows
+	void RasterizeRows(int32 FirstRow, int32 LastRow, TArray<int64>& OutNumPixels, TArray<int64>& OutNumVisiblePixels,
+		TArray<int64>& OutSkelNumPixels, TArray<bool>& OutIsClipped);
+
+	// Write the results back to the view entities
+	void WriteResults(FSLVisionViewData& ViewData, const TArray<int64>& SkelNumPixels) const;
+
+	// Project the mesh triangles, clipped against the near plane
+	void ProjectMesh(const FSLOcclusionMesh& Mesh, const FTransform& MeshToWorld, const FTransform& ViewPose, float Focal,
+		TArray<FVector>& OutScreenTris) const;
+
+	// Get the simplified geometry of the static mesh (cached)
+	const FSLOcclusionMesh* GetStaticMeshGeometry(UStaticMesh* StaticMesh);
+
+	// Get the collision geometry of the skeletal body (cached)
+	const FSLOcclusionMesh* GetBodyGeometry(USkeletalBodySetup* BodySetup);
+
+	// Triangulate the collision shapes
+	static void AddAggregateGeometry(const FKAggregateGeom& AggGeom, FSLOcclusionMesh& OutMesh);
+
+	// Triangulate the box
+	static void AddBox(const FBox& Box, const FTransform& Transform, FSLOcclusionMesh& OutMesh);
+
+	// Triangulate the capsule along the Z axis (a sphere if the length is zero)
+	static void AddCapsule(float Radius, float Length, const FTransform& Transform, FSLOcclusionMesh& OutMesh);
+
+	// Collect the errors of a single estimate
+	void AddValidationSample(const FString& Name, float Estimated, float Reference, bool bEstClipped, bool bRefClipped);
+
+public:
+	// Triangles closer than this (cm) are clipped (same as the default near clipping plane)
+	static constexpr float NearClipDistance = 10.f;
+
+	// Number of segments used for approximating spheres and capsules
+	static constexpr int32 NumCapsuleSegments = 8;
+
+	// Estimates differing more than this from the screenshot values are logged
+	static constexpr float ValidationLogThreshold = 0.1f;
+
+private:
+	// Set when initialized
+	bool bIsInit;
+
+	// Gives access to the mask clones
+	USLVisionLogger* Parent;
+
+	// Depth buffer resolution
+	FIntPoint Resolution;
+
+	// Items of the current view
+	TArray<FSLOcclusionItem> Items;
+
+	// Number of skeletal entities in the current view
+	int32 NumSkels;
+
+	// Inverse depth of the closest item of every pixel
+	TArray<float> DepthBuffer;
+
+	// Index of the closest item of every pixel (INDEX_NONE if empty)
+	TArray<int32> ItemBuffer;
+
+	// Last item that covered the pixel, used to count every pixel once per item
+	TArray<int32> ItemStamp;
+
+	// Last skeletal entity that covered the pixel, used to count every pixel once per skeleton
+	TArray<int32> SkelStamp;
+
+	// Cached simplified geometry of the static meshes
+	TMap<UStaticMesh*, FSLOcclusionMesh> StaticMeshGeometry;
+
+	// Cached collision geometry of the skeletal bodies
+	TMap<USkeletalBodySetup*, FSLOcclusionMesh> BodyGeometry;
+
+	// Estimates waiting to be compared against the screenshot values
+	FSLVisionViewData ValidationViewData;
+
+	// Number of compared values
+	int64 NumValidationSamples;
+
+	// Sum of the absolute occlusion percentage differences
+	double SumValidationError;
+
+	// Largest absolute occlusion percentage difference
+	float MaxValidationError;
+
+	// Number of samples where the clipped flags differ
+	int64 NumClippedMismatches;
+};
@@ -22,6 +22,17 @@ enum class ESLVisionViewMode : uint8
 	Normal					UMETA(DisplayName = "Normal"),
 };
 
+/**
+* Overlap (occlusion) calculation methods
+*/
+UENUM()
+enum class ESLVisionOverlapMethod : uint8
+{
+	Screenshots				UMETA(DisplayName = "Screenshots"),
+	Rasterizer				UMETA(DisplayName = "Rasterizer"),
+	Validate				UMETA(DisplayName = "Validate"),
+};
+
 
 /**
 * Vision logger parameters
@@ -43,6 +54,39 @@ struct FSLVisionLoggerParams
 	// Make screenshots for calculating overlaps smaller for faster logging
 	uint8 OverlapResolutionDivisor;
 
+	// Rendered mask colors within this tolerance are restored to the closest mask color
+	uint8 MaskColorTolerance;
+
+	// Number of image compression workers (0 - compress on the game thread)
+	int32 NumImageWorkers = 2;
+
+	// Max memory of the raw images waiting for compression
+	int32 MaxInFlightImagesMB = 512;
+
+	// Store the mask images with the palette and run-length encoding instead of png
+	bool bEncodeMasks = false;
+
+	// Per entity screenshots, software rasterization, or both with the rasterized values compared against the screenshots
+	ESLVisionOverlapMethod OverlapMethod = ESLVisionOverlapMethod::Screenshots;
+
+	// Reuse the overlaps of the entities whose screen footprint did not change since the previous frame
+	bool bReuseOverlaps = true;
+
+	// Views not affected by the frame changes reference their previous images and data instead of being rendered (opt-in)
+	bool bSkipUnchangedViews = false;
+
+	// Episode seconds loaded ahead of the rendered frame
+	float EpisodePrefetchSeconds = 5.f;
+
+	// Max number of episode frames loaded ahead of the rendered frame
+	int32 MaxBufferedFrames = 512;
+
+	// Timestamp range shard of the episode to replay (INDEX_NONE for the whole episode)
+	int32 ShardIdx = INDEX_NONE;
+
+	// Number of equal timestamp ranges the episode is split into
+	int32 NumShards = 1;
+
 	// Default ctor
 	FSLVisionLoggerParams() {};
 
@@ -52,37 +96,42 @@ struct FSLVisionLoggerParams
 		FIntPoint InResolution,
 		bool bInIncludeLocally,
 		bool InCalculateOverlaps,
-		uint8 InOverlapResolutionDivisor) :
+		uint8 InOverlapResolutionDivisor,
+		uint8 InMaskColorTolerance = 0) :
 		UpdateRate(InUpdateRate),
 		Resolution(InResolution),
 		bIncludeLocally(bInIncludeLocally),
 		bCalculateOverlaps(InCalculateOverlaps),
-		OverlapResolutionDivisor(InOverlapResolutionDivisor)
+		OverlapResolutionDivisor(InOverlapResolutionDivisor),
+		MaskColorTolerance(InMaskColorTolerance)
 	{};
 };
 
 /**
-* Episode frame data
+* Episode frame data, the pose changes since the previous frame stored in flat arrays
 */
 struct FSLVisionFrame
 {
 	// Frame timestamp
-	float Timestamp;
+	float Timestamp = -1.f;
 
 	// Entity poses
-	TMap<AStaticMeshActor*, FTransform> ActorPoses;
+	TArray<TPair<AStaticMeshActor*, FTransform>> ActorPoses;
 
 	// Virtual camera poses
-	TMap<ASLVisionCamera*, FTransform> VisionCameraPoses;
+	TArray<TPair<ASLVisionCamera*, FTransform>> VisionCameraPoses;
+
+	// Skeletal (poseable) meshes with the number of their consecutive entries in the bone poses
+	TArray<TPair<ASLVisionPoseableMeshActor*, int32>> SkeletalPoses;
 
-	// Skeletal (poseable) meshes bone transformation
-	TMap<ASLVisionPoseableMeshActor*, TMap<FName, FTransform>> SkeletalPoses;
+	// Bone transformations of all the skeletal meshes
+	TArray<TPair<FName, FTransform>> BonePoses;
 
 	// Apply transformations, return the frame timestamp
 	float ApplyTransformations(
 		bool bIncludeMasks,
 		TMap<AStaticMeshActor*, AStaticMeshActor*>& MaskClones,
-		TMap<ASLVisionPoseableMeshActor*, ASLVisionPoseableMeshActor*>& SkelMaskClones)
+		TMap<ASLVisionPoseableMeshActor*, ASLVisionPoseableMeshActor*>& SkelMaskClones) const
 	{
 		// Move the static meshes
 		for(const auto& Pair : ActorPoses)
@@ -98,14 +147,17 @@ struct FSLVisionFrame
 		}
 
 		// Move the skeletal(poseable) meshes
+		int32 FirstBoneIdx = 0;
 		for(const auto& Pair : SkeletalPoses)
 		{
-			Pair.Key->SetBoneTransforms(Pair.Value);
+			const TArrayView<const TPair<FName, FTransform>> Bones(BonePoses.GetData() + FirstBoneIdx, Pair.Value);
+			FirstBoneIdx += Pair.Value;
+			Pair.Key->SetBoneTransforms(Bones);
 			if(bIncludeMasks)
 			{
 				if(ASLVisionPoseableMeshActor** PMAClone = SkelMaskClones.Find(Pair.Key))
 				{
-					(*PMAClone)->SetBoneTransforms(Pair.Value);
+					(*PMAClone)->SetBoneTransforms(Bones);
 				}
 			}
 		}
@@ -118,71 +170,11 @@ struct FSLVisionFrame
 		return Timestamp;
 	}
 
-	// Clear time and poses
-	void Clear() { Timestamp = -1.f; ActorPoses.Empty(); SkeletalPoses.Empty(); VisionCameraPoses.Empty(); };
-};
-
-/**
-* The whole episode data
-*/
-class FSLVisionEpisode
-{
-public:
-	// Default ctor
-	FSLVisionEpisode() : FrameIdx(INDEX_NONE) {};
-
-	// Add a new frame
-	int32 AddFrame(const FSLVisionFrame& Frame) { return Frames.Emplace(Frame); };
-	
-	// Get the active frame in the episode
-	int32 GetCurrIndex() const { return FrameIdx; };
-
-	// Get the total number of frames
-	int32 GetFramesNum() const { return Frames.Num(); };
-
-	// Move actors to the first frame
-	bool SetupFirstFrame(float& OutTimestamp,
-		bool bIncludeMasks,
-		TMap<AStaticMeshActor*, AStaticMeshActor*>& MaskClones,
-		TMap<ASLVisionPoseableMeshActor*, ASLVisionPoseableMeshActor*>& SkelMaskClones)
-	{
-		FrameIdx = 0;
-		if(Frames.IsValidIndex(FrameIdx))
-		{
-			OutTimestamp = Frames[FrameIdx].ApplyTransformations(bIncludeMasks, MaskClones, SkelMaskClones);
-			return true;
-		}
-		return false;
-	}
-
-	// Move actors to the next frame transformations, return false if no more frames are available
-	bool SetupNextFrame(float& OutTimestamp,
-		bool bIncludeMasks,
-		TMap<AStaticMeshActor*, AStaticMeshActor*>& MaskClones,
-		TMap<ASLVisionPoseableMeshActor*, ASLVisionPoseableMeshActor*>& SkelMaskClones)
-	{
-		FrameIdx++;
-		if(Frames.IsValidIndex(FrameIdx))
-		{
-			OutTimestamp = Frames[FrameIdx].ApplyTransformations(bIncludeMasks, MaskClones, SkelMaskClones);
-			return true;
-		}
-		FrameIdx = INDEX_NONE;
-		return false;
-	}
+	// Check if the frame has any entity changes
+	bool HasEntityPoses() const { return ActorPoses.Num() > 0 || SkeletalPoses.Num() > 0; };
 
-	// Get first timestamp
-	FORCEINLINE float GetFirstTimestamp() const { return Frames.IsValidIndex(0) ? Frames[0].Timestamp : -1.f; };
-
-	// Get last timestamp
-	FORCEINLINE float GetLastTimestamp() const { return Frames.Num() > 0 ? Frames.Last().Timestamp : -1.f; };
-	
-private:
-	// All the frames from the episode
-	TArray<FSLVisionFrame> Frames;
-	
-	// Current frame index
-	int32 FrameIdx;
+	// Clear time and poses
+	void Clear() { Timestamp = -1.f; ActorPoses.Empty(); SkeletalPoses.Empty(); BonePoses.Empty(); VisionCameraPoses.Empty(); };
 };
 
 /**
@@ -339,6 +331,9 @@ struct FSLVisionImageData
 	// Image type
 	FString Type;
 
+	// Encoding of the data (png, or FSLVisionMaskCodec::FormatName)
+	FString Format = TEXT("png");
+
 	// Data
 	TArray<uint8> Data;
 };
@@ -366,6 +361,9 @@ struct FSLVisionViewData
 	// Array of image data pair, render type name to binary data
 	TArray<FSLVisionImageData> Images;
 
+	// Timestamp of the frame whose images are referenced instead (-1 if the view was rendered)
+	float RefTimestamp = -1.f;
+
 	// Set the initial values
 	void Init(const FString& InId, const FString& InClass)
 	{
@@ -379,6 +377,7 @@ struct FSLVisionViewData
 		Entities.Empty();
 		SkelEntities.Empty();
 		Images.Empty();
+		RefTimestamp = -1.f;
 	}
 };
 
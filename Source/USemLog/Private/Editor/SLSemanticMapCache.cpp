@@ -0,0 +1,175 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "Editor/SLSemanticMapCache.h"
+#include "Misc/Paths.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+
+// File identifier and version
+static const uint32 SLSemanticMapCacheMagic = 0x4d535f53; // S_SM
+static const int32 SLSemanticMapCacheVersion = 1;
+
+// Ctor
+FSLSemanticMapCache::FSLSemanticMapCache() : TemplateType(ESLOwlSemanticMapTemplate::NONE)
+{
+}
+
+// Read the cache from file
+bool FSLSemanticMapCache::LoadFromFile(const FString& FilePath)
+{
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *FilePath, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Data);
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Reader << Magic;
+	Reader << Version;
+	if (Magic != SLSemanticMapCacheMagic || Version != SLSemanticMapCacheVersion)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d %s is not a valid semantic map cache, ignoring it.."),
+			*FString(__func__), __LINE__, *FilePath);
+		return false;
+	}
+
+	uint8 Template = 0;
+	Reader << Template;
+	TemplateType = static_cast<ESLOwlSemanticMapTemplate>(Template);
+	Reader << DocId;
+
+	if (!ReadEntries(Reader, IndividualEntries) || !ReadEntries(Reader, ClassEntries) || Reader.IsError())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d %s is corrupted, ignoring it.."), *FString(__func__), __LINE__, *FilePath);
+		IndividualEntries.Empty();
+		ClassEntries.Empty();
+		return false;
+	}
+	return true;
+}
+
+// Write the ranges of the document to file
+bool FSLSemanticMapCache::SaveToFile(const FString& FilePath, FSLOwlSemanticMap& Doc) const
+{
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+
+	uint32 Magic = SLSemanticMapCacheMagic;
+	int32 Version = SLSemanticMapCacheVersion;
+	Writer << Magic;
+	Writer << Version;
+
+	uint8 Template = static_cast<uint8>(TemplateType);
+	Writer << Template;
+	FString Id = DocId;
+	Writer << Id;
+
+	WriteRanges(Writer, IndividualRanges, Doc.Individuals);
+	WriteRanges(Writer, ClassRanges, Doc.ClassDefinitions);
+
+	return FFileHelper::SaveArrayToFile(Data, *FilePath);
+}
+
+// Move out the cached nodes of the individual if its hash did not change (each entry can be taken once)
+bool FSLSemanticMapCache::TakeIndividualNodes(const FString& Id, uint64 Hash, TArray<FSLOwlNode>& OutNodes)
+{
+	return TakeNodes(IndividualEntries, Id, Hash, OutNodes);
+}
+
+// Move out the cached nodes of the class definition if its hash did not change (each entry can be taken once)
+bool FSLSemanticMapCache::TakeClassNodes(const FString& Class, uint64 Hash, TArray<FSLOwlNode>& OutNodes)
+{
+	return TakeNodes(ClassEntries, Class, Hash, OutNodes);
+}
+
+// Remember where the nodes of the individual were written
+void FSLSemanticMapCache::AddIndividualRange(const FString& Id, uint64 Hash, int32 Start, int32 Num)
+{
+	FSLSemanticMapCacheRange& Range = IndividualRanges.AddDefaulted_GetRef();
+	Range.Key = Id;
+	Range.Hash = Hash;
+	Range.Start = Start;
+	Range.Num = Num;
+}
+
+// Remember where the nodes of the class definition were written
+void FSLSemanticMapCache::AddClassRange(const FString& Class, uint64 Hash, int32 Start, int32 Num)
+{
+	FSLSemanticMapCacheRange& Range = ClassRanges.AddDefaulted_GetRef();
+	Range.Key = Class;
+	Range.Hash = Hash;
+	Range.Start = Start;
+	Range.Num = Num;
+}
+
+// Default cache file path of the semantic map
+FString FSLSemanticMapCache::GetFilePath(const FString& InDirectory, const FString& InFilename)
+{
+	FString FilePath = FPaths::ProjectDir() + "/SemLog/" + InDirectory + TEXT("/") + InFilename + TEXT("_Cache.bin");
+	FPaths::RemoveDuplicateSlashes(FilePath);
+	return FilePath;
+}
+
+// Move out the cached nodes if the hash did not change
+bool FSLSemanticMapCache::TakeNodes(TMap<FString, FSLSemanticMapCacheEntry>& Entries, const FString& Key, uint64 Hash,
+	TArray<FSLOwlNode>& OutNodes)
+{
+	FSLSemanticMapCacheEntry Entry;
+	if (Entries.RemoveAndCopyValue(Key, Entry) && Entry.Hash == Hash)
+	{
+		OutNodes = MoveTemp(Entry.Nodes);
+		return true;
+	}
+	return false;
+}
+
+// Write the entries of the ranges
+void FSLSemanticMapCache::WriteRanges(FArchive& Ar, const TArray<FSLSemanticMapCacheRange>& Ranges, TArray<FSLOwlNode>& Nodes)
+{
+	int32 NumRanges = Ranges.Num();
+	Ar << NumRanges;
+	for (const FSLSemanticMapCacheRange& Range : Ranges)
+	{
+		FString Key = Range.Key;
+		uint64 Hash = Range.Hash;
+		int32 Num = Range.Num;
+		Ar << Key;
+		Ar << Hash;
+		Ar << Num;
+		for (int32 Idx = Range.Start; Idx < Range.Start + Range.Num; ++Idx)
+		{
+			Ar << Nodes[Idx];
+		}
+	}
+}
+
+// Read the entries
+bool FSLSemanticMapCache::ReadEntries(FArchive& Ar, TMap<FString, FSLSemanticMapCacheEntry>& OutEntries)
+{
+	int32 NumEntries = 0;
+	Ar << NumEntries;
+	for (int32 EntryIdx = 0; EntryIdx < NumEntries && !Ar.IsError(); ++EntryIdx)
+	{
+		FString Key;
+		FSLSemanticMapCacheEntry Entry;
+		int32 Num = 0;
+		Ar << Key;
+		Ar << Entry.Hash;
+		Ar << Num;
+		if (Num < 0 || Num > Ar.TotalSize())
+		{
+			return false;
+		}
+		Entry.Nodes.SetNum(Num);
+		for (FSLOwlNode& Node : Entry.Nodes)
+		{
+			Ar << Node;
+		}
+		OutEntries.Add(Key, MoveTemp(Entry));
+	}
+	return !Ar.IsError();
+}
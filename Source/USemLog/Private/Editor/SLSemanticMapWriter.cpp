@@ -9,6 +9,10 @@
 #include "Animation/SkeletalMeshActor.h"
 #include "Misc/Paths.h"
 #include "Misc/FileHelper.h"
+#include "Async/ParallelFor.h"
+#include "SLArticulationGraph.h"
+#include "Editor/SLSemanticMapCache.h"
+#include "Hash/CityHash.h"
 
 // UOwl
 #include "SLOwlSemanticMapStatics.h"
@@ -22,6 +26,110 @@
 #include "Conversions.h"
 #endif // SL_WITH_ROS_CONVERSIONS
 
+namespace
+{
+	// Chained content hash of the gathered data
+	struct FSLContentHasher
+	{
+		// Current hash
+		uint64 Hash = 0;
+
+		// Add the bytes
+		void Add(const void* Data, int32 Num)
+		{
+			Hash = CityHash64WithSeed(static_cast<const char*>(Data), Num, Hash);
+		}
+
+		// Add the plain value
+		template<typename T>
+		void AddPod(const T& Value)
+		{
+			Add(&Value, sizeof(T));
+		}
+
+		// Add the string (with its length, "ab"+"c" differs from "a"+"bc")
+		void Add(const FString& Str)
+		{
+			AddPod(Str.Len());
+			Add(*Str, Str.Len() * sizeof(TCHAR));
+		}
+
+		// Add the strings
+		void Add(const TArray<FString>& Strs)
+		{
+			AddPod(Strs.Num());
+			for (const FString& Str : Strs)
+			{
+				Add(Str);
+			}
+		}
+	};
+
+	// Content hash of the individual (the generated pose, bone and constraint ids are not part of the content)
+	uint64 GetContentHash(const FSLSemanticMapIndividualData& Data)
+	{
+		FSLContentHasher Hasher;
+		Hasher.Add(Data.Id);
+		Hasher.Add(Data.Class);
+		Hasher.AddPod(Data.bIsConstraint);
+		Hasher.Add(Data.ParentId);
+		Hasher.Add(Data.ChildIds);
+		Hasher.Add(Data.Mobility);
+		Hasher.AddPod(Data.bHasPhysics);
+		Hasher.AddPod(Data.Mass);
+		Hasher.AddPod(Data.bGenerateOverlapEvents);
+		Hasher.AddPod(Data.bGravity);
+		Hasher.Add(Data.ColorHex);
+		Hasher.AddPod(Data.bHasPose);
+		Hasher.AddPod(Data.Location);
+		Hasher.AddPod(Data.Quat);
+		Hasher.AddPod(Data.Tags.Num());
+		for (const FName& Tag : Data.Tags)
+		{
+			Hasher.Add(Tag.ToString());
+		}
+		Hasher.Add(Data.PathToCadModel);
+		Hasher.Add(Data.BoneNames);
+		Hasher.Add(Data.BoneParentIdxs.GetData(), Data.BoneParentIdxs.Num() * sizeof(int32));
+
+		const FSLSemanticMapConstraintData& Constr = Data.Constraint;
+		Hasher.Add(Constr.ParentId);
+		Hasher.Add(Constr.ChildId);
+		Hasher.AddPod(Constr.LinXMotion);
+		Hasher.AddPod(Constr.LinYMotion);
+		Hasher.AddPod(Constr.LinZMotion);
+		Hasher.AddPod(Constr.LinLimit);
+		Hasher.AddPod(Constr.bLinSoftConstraint);
+		Hasher.AddPod(Constr.LinStiffness);
+		Hasher.AddPod(Constr.LinDamping);
+		Hasher.AddPod(Constr.AngSwing1Motion);
+		Hasher.AddPod(Constr.AngSwing2Motion);
+		Hasher.AddPod(Constr.AngTwistMotion);
+		Hasher.AddPod(Constr.AngSwing1Limit);
+		Hasher.AddPod(Constr.AngSwing2Limit);
+		Hasher.AddPod(Constr.AngTwistLimit);
+		Hasher.AddPod(Constr.bAngSoftSwingConstraint);
+		Hasher.AddPod(Constr.AngSwingStiffness);
+		Hasher.AddPod(Constr.AngSwingDamping);
+		Hasher.AddPod(Constr.bAngSoftTwistConstraint);
+		Hasher.AddPod(Constr.AngTwistStiffness);
+		Hasher.AddPod(Constr.AngTwistDamping);
+		return Hasher.Hash;
+	}
+
+	// Content hash of the class definition
+	uint64 GetContentHash(const FSLSemanticMapClassData& Data)
+	{
+		FSLContentHasher Hasher;
+		Hasher.Add(Data.Class);
+		Hasher.Add(Data.SubClassOf);
+		Hasher.AddPod(Data.BBSize);
+		Hasher.AddPod(Data.bIsSkeletalActor);
+		Hasher.Add(Data.BoneNames);
+		return Hasher.Hash;
+	}
+}
+
 // Default constructor
 FSLSemanticMapWriter::FSLSemanticMapWriter()
 {
@@ -33,27 +141,54 @@ bool FSLSemanticMapWriter::WriteToFile(UWorld* World,
 	ESLOwlSemanticMapTemplate TemplateType,
 	const FString& InDirectory,
 	const FString& InFilename,
-	bool bOverwrite)
+	bool bOverwrite,
+	ESLOwlDocFormat Format,
+	bool bIncremental)
 {
 	FString FullFilePath = FPaths::ProjectDir() + "/SemLog/" +
-		InDirectory + TEXT("/") + InFilename + TEXT(".owl");
+		InDirectory + TEXT("/") + InFilename + TEXT(".") + FSLOwlTripleWriter::GetFileExtension(Format);
 
-	// Check if map already exists
-	if (!bOverwrite && FPaths::FileExists(FullFilePath))
+	// Check if map already exists (the incremental update always replaces it)
+	if (!bOverwrite && !bIncremental && FPaths::FileExists(FullFilePath))
 	{
 		return false;
 	}
 
-	// Create the semantic map template
-	TSharedPtr<FSLOwlSemanticMap> SemMap = CreateSemanticMapDocTemplate(TemplateType);
+	// Build the attachment graph and the semantic ids once for all the individuals
+	// (re-built on every write, the tags or the attachments might have changed in the editor)
+	FSLArticulationGraph::GetInstance()->Rebuild(World);
+
+	// Load the nodes of the previous write, only usable with the same template (same prefix and class definitions)
+	const FString CacheFilePath = FSLSemanticMapCache::GetFilePath(InDirectory, InFilename);
+	FSLSemanticMapCache Cache;
+	if (bIncremental && (!Cache.LoadFromFile(CacheFilePath) || Cache.TemplateType != TemplateType))
+	{
+		UE_LOG(LogTemp, Log, TEXT("%s::%d No usable semantic map cache found (%s), writing the full map.."),
+			*FString(__func__), __LINE__, *CacheFilePath);
+		Cache = FSLSemanticMapCache();
+	}
+
+	// Create the semantic map template (keep the document id of the cached nodes)
+	TSharedPtr<FSLOwlSemanticMap> SemMap = CreateSemanticMapDocTemplate(TemplateType, Cache.DocId);
 
 	// Add individuals to map
-	AddAllIndividuals(SemMap, World);
+	AddAllIndividuals(SemMap, World, Cache);
 
-	// Write map to file
-	
+	// Write map to file (rdf/xml, n-triples or turtle)
 	FPaths::RemoveDuplicateSlashes(FullFilePath);
-	return FFileHelper::SaveStringToFile(SemMap->ToString(), *FullFilePath);
+	if (!FSLOwlTripleWriter::WriteToFile(*SemMap.Get(), FullFilePath, Format))
+	{
+		return false;
+	}
+
+	// Save the cache for the next incremental update (only for a written map)
+	if (bIncremental)
+	{
+		Cache.TemplateType = TemplateType;
+		Cache.DocId = SemMap->Id;
+		Cache.SaveToFile(CacheFilePath, *SemMap.Get());
+	}
+	return true;
 }
 
 // Create semantic map template
@@ -77,9 +212,25 @@ TSharedPtr<FSLOwlSemanticMap> FSLSemanticMapWriter::CreateSemanticMapDocTemplate
 }
 
 // Add individuals to the semantic map
-void FSLSemanticMapWriter::AddAllIndividuals(TSharedPtr<FSLOwlSemanticMap> InSemMap, UWorld* World)
+void FSLSemanticMapWriter::AddAllIndividuals(TSharedPtr<FSLOwlSemanticMap> InSemMap, UWorld* World, FSLSemanticMapCache& Cache)
 {
-	// Iterate objects with SemLog tag key
+	TArray<FSLSemanticMapIndividualData> IndividualsData;
+	TArray<FSLSemanticMapClassData> ClassesData;
+
+	// Classes defined by the template or by previous objects (only the first object of a class defines it)
+	TSet<FString> DefinedClasses;
+	for (const auto& ClassDef : InSemMap->ClassDefinitions)
+	{
+		for (const auto& ClassAttr : ClassDef.Attributes)
+		{
+			if (ClassAttr.Key.Prefix.Equals("rdf") && ClassAttr.Key.LocalName.Equals("about"))
+			{
+				DefinedClasses.Add(ClassAttr.Value.LocalValue);
+			}
+		}
+	}
+
+	// Gather phase (game thread), iterate objects with SemLog tag key and copy their data
 	for (const auto& ActorPairs : FSLTagIO::GetWorldKVPairs(World, "SemLog"))
 	{
 		// Get Id and Class of items
@@ -92,73 +243,145 @@ void FSLSemanticMapWriter::AddAllIndividuals(TSharedPtr<FSLOwlSemanticMap> InSem
 			// Check if class is also available
 			if (ClassPtr)
 			{
-				AddObjectIndividual(InSemMap, ActorPairs.Key, *IdPtr, *ClassPtr);
+				GatherObjectData(ActorPairs.Key, *IdPtr, *ClassPtr, IndividualsData.AddDefaulted_GetRef());
 			}
 			// No class is available, check for other types, e.g. constraints can be actors or components
 			else if (APhysicsConstraintActor* ConstrAct = Cast<APhysicsConstraintActor>(ActorPairs.Key))
 			{
-				AddConstraintIndividual(InSemMap, ConstrAct->GetConstraintComp(), *IdPtr, ConstrAct->Tags);
+				FSLSemanticMapIndividualData ConstrData;
+				if (GatherConstraintData(ConstrAct->GetConstraintComp(), *IdPtr, ConstrAct->Tags, ConstrData))
+				{
+					IndividualsData.Emplace(MoveTemp(ConstrData));
+				}
 			}
 		}
 
 		// Add class individuals (Id not mandatory)
-		if (ClassPtr)
+		if (ClassPtr && !DefinedClasses.Contains(*ClassPtr))
 		{
 			const FString* SubClassOfPtr = ActorPairs.Value.Find("SubClassOf");
 			const FString SubClassOf = SubClassOfPtr ? *SubClassOfPtr : "";
-			AddClassDefinition(InSemMap, ActorPairs.Key, *ClassPtr, SubClassOf);
+			FSLSemanticMapClassData& ClassData = ClassesData.AddDefaulted_GetRef();
+			GatherClassData(ActorPairs.Key, *ClassPtr, SubClassOf, ClassData);
+			DefinedClasses.Add(*ClassPtr);
+			if (ClassData.bIsSkeletalActor)
+			{
+				DefinedClasses.Append(ClassData.BoneNames);
+			}
 		}
 	}
-}
 
-// Add object individual to the semantic map
-void FSLSemanticMapWriter::AddObjectIndividual(TSharedPtr<FSLOwlSemanticMap> InSemMap,
-	UObject* Object, const FString& InId, const FString& InClass)
-{
-	// Get map data
+	// Reuse the cached nodes of the unchanged entries (the cache is empty if not in incremental mode)
+	TArray<uint64> IndividualHashes;
+	TArray<TArray<FSLOwlNode>> IndividualNodes;
+	TArray<bool> IndividualReused;
+	int32 NumReusedIndividuals = 0;
+	IndividualNodes.SetNum(IndividualsData.Num());
+	IndividualReused.SetNumZeroed(IndividualsData.Num());
+	for (int32 Idx = 0; Idx < IndividualsData.Num(); ++Idx)
+	{
+		IndividualHashes.Add(GetContentHash(IndividualsData[Idx]));
+		IndividualReused[Idx] = Cache.TakeIndividualNodes(IndividualsData[Idx].Id, IndividualHashes[Idx], IndividualNodes[Idx]);
+		if (IndividualReused[Idx])
+		{
+			NumReusedIndividuals++;
+		}
+		else
+		{
+			// Only the rebuilt entries need new pose, bone and constraint ids (in the gather order)
+			GenerateIds(IndividualsData[Idx]);
+		}
+	}
+
+	TArray<uint64> ClassHashes;
+	TArray<TArray<FSLOwlNode>> ClassNodes;
+	TArray<bool> ClassReused;
+	int32 NumReusedClasses = 0;
+	ClassNodes.SetNum(ClassesData.Num());
+	ClassReused.SetNumZeroed(ClassesData.Num());
+	for (int32 Idx = 0; Idx < ClassesData.Num(); ++Idx)
+	{
+		ClassHashes.Add(GetContentHash(ClassesData[Idx]));
+		ClassReused[Idx] = Cache.TakeClassNodes(ClassesData[Idx].Class, ClassHashes[Idx], ClassNodes[Idx]);
+		NumReusedClasses += ClassReused[Idx] ? 1 : 0;
+	}
+
+	// Build phase, create the owl nodes of the changed or new entries in parallel, each entry writes only to its own output slot
 	const FString MapPrefix = InSemMap->Prefix;
 	const FString DocId = InSemMap->Id;
+	ParallelFor(IndividualsData.Num() + ClassesData.Num(), [&](int32 Idx)
+	{
+		if (Idx < IndividualsData.Num())
+		{
+			if (IndividualReused[Idx])
+			{
+				return;
+			}
+			const FSLSemanticMapIndividualData& Data = IndividualsData[Idx];
+			if (Data.bIsConstraint)
+			{
+				CreateConstraintIndividuals(Data, MapPrefix, DocId, IndividualNodes[Idx]);
+			}
+			else
+			{
+				CreateObjectIndividuals(Data, MapPrefix, DocId, IndividualNodes[Idx]);
+			}
+		}
+		else
+		{
+			const int32 ClassIdx = Idx - IndividualsData.Num();
+			if (!ClassReused[ClassIdx])
+			{
+				CreateClassDefinitions(ClassesData[ClassIdx], ClassNodes[ClassIdx]);
+			}
+		}
+	});
 
-	// Create the object individual
-	FSLOwlNode ObjIndividual = FSLOwlSemanticMapStatics::CreateObjectIndividual(MapPrefix, InId, InClass);
-
-	// Add describedInMap property
-	ObjIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateDescribedInMapProperty(MapPrefix, DocId));
-	
-	// Add parent property
-	const FString ParentId = GetParentId(Object);
-	if (!ParentId.IsEmpty())
+	// Merge phase, append the nodes in the gather order (same document as the serial writer),
+	// the deleted entries are not gathered and drop out of the document and the cache
+	for (int32 Idx = 0; Idx < IndividualNodes.Num(); ++Idx)
 	{
-		ObjIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateParentProperty(MapPrefix, ParentId));
+		Cache.AddIndividualRange(IndividualsData[Idx].Id, IndividualHashes[Idx], InSemMap->Individuals.Num(), IndividualNodes[Idx].Num());
+		InSemMap->AddIndividuals(MoveTemp(IndividualNodes[Idx]));
 	}
-
-	// Add child properties
-	TArray<FString> ChildIds;
-	GetChildIds(Object, ChildIds);
-	for (const auto& ChildId : ChildIds)
+	for (int32 Idx = 0; Idx < ClassNodes.Num(); ++Idx)
 	{
-		ObjIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateChildProperty(MapPrefix, ChildId));
+		Cache.AddClassRange(ClassesData[Idx].Class, ClassHashes[Idx], InSemMap->ClassDefinitions.Num(), ClassNodes[Idx].Num());
+		InSemMap->ClassDefinitions.Append(MoveTemp(ClassNodes[Idx]));
 	}
 
-	// Add mobility property
-	const FString Mobility = GetMobility(Object);
-	if (!Mobility.IsEmpty())
+	UE_LOG(LogTemp, Log, TEXT("%s::%d Semantic map: reused %d/%d individuals and %d/%d class definitions from the cache.."),
+		*FString(__func__), __LINE__,
+		NumReusedIndividuals, IndividualsData.Num(), NumReusedClasses, ClassesData.Num());
+}
+
+// Copy the object individual data (game thread)
+void FSLSemanticMapWriter::GatherObjectData(UObject* Object, const FString& InId, const FString& InClass,
+	FSLSemanticMapIndividualData& OutData)
+{
+	OutData.Id = InId;
+	OutData.Class = InClass;
+	OutData.ParentId = GetParentId(Object);
+	GetChildIds(Object, OutData.ChildIds);
+	OutData.Mobility = GetMobility(Object);
+	OutData.ColorHex = FTags::GetValue(Object, "SemLog", "VisMask");
+
+	// Physics properties (gravity, overlap events, mass)
+	UStaticMeshComponent* PhysicsSMC = nullptr;
+	if (AStaticMeshActor* ObjAsSMA = Cast<AStaticMeshActor>(Object))
 	{
-		ObjIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateMobilityProperty(Mobility));
+		PhysicsSMC = ObjAsSMA->GetStaticMeshComponent();
 	}
-
-	// Add physics properties (gravity, overlap events, mass)
-	TArray<FSLOwlNode> PhysicsProperties = GetIndividualPhysicsProperties(Object);
-	if (PhysicsProperties.Num() > 0)
+	else
 	{
-		ObjIndividual.AddChildNodes(PhysicsProperties);
+		PhysicsSMC = Cast<UStaticMeshComponent>(Object);
 	}
-	
-	// Add color property
-	FString ColorHex = FTags::GetValue(Object, "SemLog", "VisMask");
-	if (!ColorHex.IsEmpty())
+	if (PhysicsSMC)
 	{
-		ObjIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateMaskColorProperty(ColorHex));
+		OutData.bHasPhysics = true;
+		OutData.Mass = PhysicsSMC->IsSimulatingPhysics() ? PhysicsSMC->GetMass() : PhysicsSMC->CalculateMass();
+		OutData.bGenerateOverlapEvents = PhysicsSMC->GetGenerateOverlapEvents();
+		OutData.bGravity = PhysicsSMC->IsGravityEnabled();
 	}
 
 	// Lambda to remove path before and including "Models/", after and including ".", and the "SM_" prefixes 
@@ -174,16 +397,18 @@ void FSLSemanticMapWriter::AddObjectIndividual(TSharedPtr<FSLOwlSemanticMap> InS
 		return Path;
 	};
 
-	// Add various properties
+	// Pose, model path, bones and tags
 	if (AActor* ObjAsAct = Cast<AActor>(Object))
 	{
-		// Generate unique id for the properties
-		const FString PoseId = FIds::NewGuidInBase64Url();
-
-		/* Add properties */
-		// Pose property
-		ObjIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreatePoseProperty(MapPrefix, PoseId));
-
+		OutData.bHasPose = true;
+		OutData.Tags = ObjAsAct->Tags;
+#if SL_WITH_ROS_CONVERSIONS
+		OutData.Location = FConversions::UToROS(ObjAsAct->GetActorLocation());
+		OutData.Quat = FConversions::UToROS(ObjAsAct->GetActorQuat());
+#else
+		OutData.Location = ObjAsAct->GetActorLocation();
+		OutData.Quat = ObjAsAct->GetActorQuat();
+#endif // SL_WITH_ROS_CONVERSIONS
 
 		// If static mesh, add pathToCadModel property
 		if (AStaticMeshActor* ActAsSMA = Cast<AStaticMeshActor>(ObjAsAct))
@@ -192,415 +417,377 @@ void FSLSemanticMapWriter::AddObjectIndividual(TSharedPtr<FSLOwlSemanticMap> InS
 			{
 				if (UStaticMesh* SM = SMC->GetStaticMesh())
 				{
-					ObjIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreatePathToCadModelProperty(GetPathToCadModelLambda(SM)));
+					OutData.PathToCadModel = GetPathToCadModelLambda(SM);
 				}
 			}
 		}
 
-		// If skeletalmesh, add bones as properties
-		// Cache created bone individuals (if any)
-		TArray<FSLOwlNode> BoneIndividuals;
+		// If skeletalmesh, add bones
 		if (ASkeletalMeshActor* ActAsSkMA = Cast<ASkeletalMeshActor>(ObjAsAct))
 		{
 			if (USkeletalMeshComponent* SkelComp = ActAsSkMA->GetSkeletalMeshComponent())
 			{
-				// Create and cache unique ids for every bone name
-				TMap<FName, FString> CachedBoneIds;
-
-				// Add bones to the skeletal individual, cache the ids to access them later on
 				TArray<FName> BoneNames;
 				SkelComp->GetBoneNames(BoneNames);
 				for (const auto& BoneName : BoneNames)
 				{
 					// TODO read bone ids from data structure
-					const FString BoneId = FIds::NewGuidInBase64Url();
-					ObjIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateSrdlSkeletalBoneProperty(MapPrefix, BoneId));
-					CachedBoneIds.Add(BoneName, BoneId);
-				}
-
-								
-				// Create bone individuals
-				for (auto& BoneName : BoneNames)
-				{
-					const FString BoneNameStr = BoneName.ToString();
-
-					FString BoneId = "IdNotFound";
-					if (FString* FoundId = CachedBoneIds.Find(BoneName))
-					{
-						BoneId = *FoundId;
-					}
-				
-					// Check for parent bone
-					FString BaseLinkId = "";
-					FName ParentBone = SkelComp->GetParentBone(BoneName);
-					if (!ParentBone.IsNone())
-					{
-						if (FString* FoundBaseId = CachedBoneIds.Find(ParentBone))
-						{
-							BaseLinkId = *FoundBaseId;
-						}
-					}
-					
-					// Check for child bone
-					FString EndLinkId = "";
-					// Check child link by iterating all bones and checking if their parent equals this
-					for (auto& ChildName : BoneNames)
-					{
-						FName CurrParent = SkelComp->GetParentBone(ChildName);
-						if (CurrParent.IsEqual(BoneName))
-						{
-							if (FString* FoundEndId = CachedBoneIds.Find(ChildName))
-							{
-								EndLinkId = *FoundEndId;
-							}
-							break;
-						}
-					}
-
-					// TODO read class from datastructure, otherwise use the bone name
-					const FString BoneClass = BoneNameStr;
-					BoneIndividuals.Add(FSLOwlSemanticMapStatics::CreateBoneIndividual(MapPrefix, BoneId, BoneClass, BaseLinkId, EndLinkId, BoneNameStr));
-
-					// Direct access to bone name
-					//ObjIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateSkeletalBoneProperty(BoneNameStr));
+					OutData.BoneNames.Add(BoneName.ToString());
+					OutData.BoneParentIdxs.Add(BoneNames.Find(SkelComp->GetParentBone(BoneName)));
 				}
 			}
 		}
-
-		// Add tags data property
-		ObjIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateTagsDataProperty(
-			ObjAsAct->Tags));
-
-		// Add skeletal individual
-		InSemMap->AddIndividual(ObjIndividual);
-
-		// Create pose individual
-#if SL_WITH_ROS_CONVERSIONS
-		const FVector ROSLoc = FConversions::UToROS(ObjAsAct->GetActorLocation());
-		const FQuat ROSQuat = FConversions::UToROS(ObjAsAct->GetActorQuat());
-		InSemMap->AddIndividual(FSLOwlSemanticMapStatics::CreatePoseIndividual(
-			MapPrefix, PoseId, ROSLoc, ROSQuat));
-#else
-		InSemMap->AddIndividual(FSLOwlSemanticMapStatics::CreatePoseIndividual(
-			MapPrefix, PoseId, ObjAsAct->GetActorLocation(), ObjAsAct->GetActorQuat()));
-#endif // SL_WITH_ROS_CONVERSIONS
-
-		// Create and add skeletal bones individuals (if any)
-		if (BoneIndividuals.Num())
-		{
-			InSemMap->AddIndividuals(BoneIndividuals);
-		}
 	}
 	else if (USceneComponent* ObjAsSceneComp = Cast<USceneComponent>(Object))
 	{
-		// Generate unique id for the properties
-		const FString PoseId = FIds::NewGuidInBase64Url();
-		const FString TagsId = FIds::NewGuidInBase64Url();
-
-		// Add properties
-		ObjIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreatePoseProperty(
-			MapPrefix, PoseId));
+		OutData.bHasPose = true;
+		OutData.Tags = ObjAsSceneComp->ComponentTags;
+#if SL_WITH_ROS_CONVERSIONS
+		OutData.Location = FConversions::UToROS(ObjAsSceneComp->GetComponentLocation());
+		OutData.Quat = FConversions::UToROS(ObjAsSceneComp->GetComponentQuat());
+#else
+		OutData.Location = ObjAsSceneComp->GetComponentLocation();
+		OutData.Quat = ObjAsSceneComp->GetComponentQuat();
+#endif // SL_WITH_ROS_CONVERSIONS
 
 		// If static mesh, add pathToCadModel property
 		if (UStaticMeshComponent* CompAsSMC = Cast<UStaticMeshComponent>(ObjAsSceneComp))
 		{
 			if (UStaticMesh* SM = CompAsSMC->GetStaticMesh())
 			{
-				ObjIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreatePathToCadModelProperty(GetPathToCadModelLambda(SM)));
+				OutData.PathToCadModel = GetPathToCadModelLambda(SM);
 			}
 		}
+	}
+}
 
-		// Add tags data property
-		ObjIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateTagsDataProperty(
-			ObjAsSceneComp->ComponentTags));
-		
-		// Add individuals 
-		InSemMap->AddIndividual(ObjIndividual);
+// Copy the constraint individual data, false if the constrained actors are not annotated (game thread)
+bool FSLSemanticMapWriter::GatherConstraintData(UPhysicsConstraintComponent* ConstraintComp, const FString& InId,
+	const TArray<FName>& InTags, FSLSemanticMapIndividualData& OutData)
+{
+	AActor* ParentAct = ConstraintComp->ConstraintActor1;
+	AActor* ChildAct = ConstraintComp->ConstraintActor2;
+	if (!ParentAct || !ChildAct)
+	{
+		return false;
+	}
+
+	FSLSemanticMapConstraintData& Constr = OutData.Constraint;
+	Constr.ParentId = FTags::GetValue(ParentAct, "SemLog", "Id");
+	Constr.ChildId = FTags::GetValue(ChildAct, "SemLog", "Id");
+	if (Constr.ParentId.IsEmpty() || Constr.ChildId.IsEmpty())
+	{
+		return false;
+	}
 
-		// Create pose individual
+	OutData.Id = InId;
+	OutData.bIsConstraint = true;
+	OutData.Tags = InTags;
+	OutData.bHasPose = true;
+
+#if SL_WITH_ROS_CONVERSIONS
+	OutData.Location = FConversions::UToROS(ConstraintComp->GetComponentLocation());
+	OutData.Quat = FConversions::UToROS(ConstraintComp->GetComponentQuat());
+#else
+	OutData.Location = ConstraintComp->GetComponentLocation();
+	OutData.Quat = ConstraintComp->GetComponentQuat();
+#endif // SL_WITH_ROS_CONVERSIONS
+
+	// Linear constraint
+	const FConstraintInstance& Instance = ConstraintComp->ConstraintInstance;
+	Constr.LinXMotion = Instance.GetLinearXMotion();
+	Constr.LinYMotion = Instance.GetLinearYMotion();
+	Constr.LinZMotion = Instance.GetLinearZMotion();
 #if SL_WITH_ROS_CONVERSIONS
-		const FVector ROSLoc = FConversions::UToROS(ObjAsSceneComp->GetComponentLocation());
-		const FQuat ROSQuat = FConversions::UToROS(ObjAsSceneComp->GetComponentQuat());
-		InSemMap->AddIndividual(FSLOwlSemanticMapStatics::CreatePoseIndividual(
-			MapPrefix, PoseId, ROSLoc, ROSQuat));
+	Constr.LinLimit = FConversions::CmToM(Instance.GetLinearLimit());
 #else
-		InSemMap->AddIndividual(FSLOwlSemanticMapStatics::CreatePoseIndividual(
-			MapPrefix, PoseId, ObjAsSceneComp->GetComponentLocation(), ObjAsSceneComp->GetComponentQuat()));
+	Constr.LinLimit = Instance.GetLinearLimit();
 #endif // SL_WITH_ROS_CONVERSIONS
+	Constr.bLinSoftConstraint = Instance.ProfileInstance.LinearLimit.bSoftConstraint;
+	Constr.LinStiffness = Instance.ProfileInstance.LinearLimit.Stiffness;
+	Constr.LinDamping = Instance.ProfileInstance.LinearLimit.Damping;
+
+	// Angular constraint
+	Constr.AngSwing1Motion = Instance.GetAngularSwing1Motion();
+	Constr.AngSwing2Motion = Instance.GetAngularSwing2Motion();
+	Constr.AngTwistMotion = Instance.GetAngularTwistMotion();
+	Constr.AngSwing1Limit = FMath::DegreesToRadians(Instance.GetAngularSwing1Limit());
+	Constr.AngSwing2Limit = FMath::DegreesToRadians(Instance.GetAngularSwing2Limit());
+	Constr.AngTwistLimit = FMath::DegreesToRadians(Instance.GetAngularTwistLimit());
+	Constr.bAngSoftSwingConstraint = Instance.ProfileInstance.ConeLimit.bSoftConstraint;
+	Constr.AngSwingStiffness = Instance.ProfileInstance.ConeLimit.Stiffness;
+	Constr.AngSwingDamping = Instance.ProfileInstance.ConeLimit.Damping;
+	Constr.bAngSoftTwistConstraint = Instance.ProfileInstance.TwistLimit.bSoftConstraint;
+	Constr.AngTwistStiffness = Instance.ProfileInstance.TwistLimit.Stiffness;
+	Constr.AngTwistDamping = Instance.ProfileInstance.TwistLimit.Damping;
+	return true;
+}
+
+// Generate the unique pose, bone and constraint ids of the individual
+void FSLSemanticMapWriter::GenerateIds(FSLSemanticMapIndividualData& InOutData)
+{
+	if (InOutData.bHasPose)
+	{
+		InOutData.PoseId = FIds::NewGuidInBase64Url();
 	}
-	else
+	InOutData.BoneIds.Empty(InOutData.BoneNames.Num());
+	for (int32 BoneIdx = 0; BoneIdx < InOutData.BoneNames.Num(); ++BoneIdx)
+	{
+		InOutData.BoneIds.Add(FIds::NewGuidInBase64Url());
+	}
+	if (InOutData.bIsConstraint)
 	{
-		// Obj has no pose info
-		InSemMap->AddIndividual(ObjIndividual);
+		InOutData.Constraint.LinId = FIds::NewGuidInBase64Url();
+		InOutData.Constraint.AngId = FIds::NewGuidInBase64Url();
 	}
 }
 
-// Add class individual
-void FSLSemanticMapWriter::AddClassDefinition(TSharedPtr<FSLOwlSemanticMap> InSemMap,
-	UObject* Object,
-	const FString& InClass,
-	const FString& InSubClassOf)
+// Copy the class definition data (game thread)
+void FSLSemanticMapWriter::GatherClassData(UObject* Object, const FString& InClass, const FString& InSubClassOf,
+	FSLSemanticMapClassData& OutData)
 {
-	// Return if class was already defined
-	for (const auto& ClassDef : InSemMap->ClassDefinitions)
+	OutData.Class = InClass;
+	OutData.SubClassOf = InSubClassOf;
+
+	// Bounds and bones if available
+	UPrimitiveComponent* BoundsComp = nullptr;
+	USkeletalMeshComponent* BonesComp = nullptr;
+	if (AStaticMeshActor* ObjAsSMAct = Cast<AStaticMeshActor>(Object))
 	{
-		for (const auto& ClassAttr : ClassDef.Attributes)
-		{
-			if (ClassAttr.Key.Prefix.Equals("rdf") &&
-				ClassAttr.Key.LocalName.Equals("about") &&
-				ClassAttr.Value.LocalValue.Equals(InClass))
-			{
-				return;
-			}
-		}
+		BoundsComp = ObjAsSMAct->GetStaticMeshComponent();
 	}
-
-	// Create class definition individual
-	FSLOwlNode ClassDefinition = FSLOwlSemanticMapStatics::CreateClassDefinition(InClass);
-	ClassDefinition.Comment = TEXT("Class ") + InClass;
-
-	// If object is skeletal, create class definitions for each bone
-	TArray<FSLOwlNode> BonesClassDefintions;
-
-	// Check if upper class is known
-	if (!InSubClassOf.IsEmpty())
+	else if (ASkeletalMeshActor* ObjAsSkelAct = Cast<ASkeletalMeshActor>(Object))
+	{
+		BonesComp = ObjAsSkelAct->GetSkeletalMeshComponent();
+		BoundsComp = BonesComp;
+		OutData.bIsSkeletalActor = BonesComp != nullptr;
+	}
+	else if (USkeletalMeshComponent* ObjAsSkelComp = Cast<USkeletalMeshComponent>(Object))
 	{
-		ClassDefinition.AddChildNode(FSLOwlSemanticMapStatics::CreateSubClassOfProperty(InSubClassOf));
+		BonesComp = ObjAsSkelComp;
+		BoundsComp = ObjAsSkelComp;
+	}
+	else
+	{
+		BoundsComp = Cast<UPrimitiveComponent>(Object);
 	}
 
-	// Add bounds if available
-	if (AStaticMeshActor* ObjAsSMAct = Cast<AStaticMeshActor>(Object))
+	if (BoundsComp)
 	{
-		if (UStaticMeshComponent* SMComp = ObjAsSMAct->GetStaticMeshComponent())
-		{
-			FVector BBSize;
 #if SL_WITH_ROS_CONVERSIONS
-			BBSize = FConversions::CmToM(SMComp->Bounds.GetBox().GetSize());
+		OutData.BBSize = FConversions::CmToM(BoundsComp->Bounds.GetBox().GetSize());
 #else
-			BBSize = SMComp->Bounds.GetBox().GetSize();
+		OutData.BBSize = BoundsComp->Bounds.GetBox().GetSize();
 #endif // SL_WITH_ROS_CONVERSIONS
-			if (!BBSize.IsZero())
-			{
-				ClassDefinition.AddChildNode(FSLOwlSemanticMapStatics::CreateDepthProperty(BBSize.X));
-				ClassDefinition.AddChildNode(FSLOwlSemanticMapStatics::CreateWidthProperty(BBSize.Y));
-				ClassDefinition.AddChildNode(FSLOwlSemanticMapStatics::CreateHeightProperty(BBSize.Z));
-			}
-		}
 	}
-	else if (ASkeletalMeshActor* ObjAsSkelAct = Cast<ASkeletalMeshActor>(Object))
+
+	if (BonesComp)
 	{
-		if (USkeletalMeshComponent* SkelComp = ObjAsSkelAct->GetSkeletalMeshComponent())
+		TArray<FName> BoneNames;
+		BonesComp->GetBoneNames(BoneNames);
+		for (const auto& BoneName : BoneNames)
 		{
-			// Set a generic upper class if none is given
-			if (InSubClassOf.IsEmpty())
-			{
-				ClassDefinition.AddChildNode(FSLOwlSemanticMapStatics::CreateSubClassOfProperty("Person"));
-			}
+			OutData.BoneNames.Add(BoneName.ToString());
+		}
+	}
+}
 
-			FVector BBSize;
-#if SL_WITH_ROS_CONVERSIONS
-			BBSize = FConversions::CmToM(SkelComp->Bounds.GetBox().GetSize());
-#else
-			BBSize = SkelComp->Bounds.GetBox().GetSize();
-#endif // SL_WITH_ROS_CONVERSIONS
-			if (!BBSize.IsZero())
-			{
-				ClassDefinition.AddChildNode(FSLOwlSemanticMapStatics::CreateDepthProperty(BBSize.X));
-				ClassDefinition.AddChildNode(FSLOwlSemanticMapStatics::CreateWidthProperty(BBSize.Y));
-				ClassDefinition.AddChildNode(FSLOwlSemanticMapStatics::CreateHeightProperty(BBSize.Z));
-			}
+// Create the object individual and its pose and bone individuals (thread safe)
+void FSLSemanticMapWriter::CreateObjectIndividuals(const FSLSemanticMapIndividualData& InData,
+	const FString& MapPrefix, const FString& DocId, TArray<FSLOwlNode>& OutNodes)
+{
+	// Create the object individual
+	FSLOwlNode ObjIndividual = FSLOwlSemanticMapStatics::CreateObjectIndividual(MapPrefix, InData.Id, InData.Class);
 
-			// Add srdl capabilities
-			TArray<FString> Capabilities = { "GraspingCapability", "move_arm", "move_base"};
-			ClassDefinition.AddChildNode(FSLOwlSemanticMapStatics::CreateHasCapabilityProperties(Capabilities));
+	// Add describedInMap property
+	ObjIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateDescribedInMapProperty(MapPrefix, DocId));
+	
+	// Add parent property
+	if (!InData.ParentId.IsEmpty())
+	{
+		ObjIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateParentProperty(MapPrefix, InData.ParentId));
+	}
 
-			TArray<FName> BoneNames;
-			SkelComp->GetBoneNames(BoneNames);
-			for (const auto& BoneName : BoneNames)
-			{
-				const FString BoneNameStr = BoneName.ToString();
-				ClassDefinition.AddChildNode(FSLOwlSemanticMapStatics::CreateSkeletalBoneProperty(BoneNameStr));
+	// Add child properties
+	for (const auto& ChildId : InData.ChildIds)
+	{
+		ObjIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateChildProperty(MapPrefix, ChildId));
+	}
 
-				// Create separate bone class definition
-				FSLOwlNode BoneClassDefinition = FSLOwlSemanticMapStatics::CreateClassDefinition(BoneNameStr);
-				BoneClassDefinition.Comment = TEXT("Bone Class ") + BoneNameStr;
+	// Add mobility property
+	if (!InData.Mobility.IsEmpty())
+	{
+		ObjIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateMobilityProperty(InData.Mobility));
+	}
 
-				// TODO read from actor skeletal component
-				const FString BoneSubClassOf = "SkeletalBone";
-				// Check if upper class is known
-				if (!BoneSubClassOf.IsEmpty())
-				{
-					BoneClassDefinition.AddChildNode(FSLOwlSemanticMapStatics::CreateSubClassOfProperty(BoneSubClassOf));
-				}
+	// Add physics properties (gravity, overlap events, mass)
+	if (InData.bHasPhysics)
+	{
+		ObjIndividual.AddChildNodes(FSLOwlSemanticMapStatics::CreatePhysicsProperties(
+			InData.Mass, InData.bGenerateOverlapEvents, InData.bGravity));
+	}
+	
+	// Add color property
+	if (!InData.ColorHex.IsEmpty())
+	{
+		ObjIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateMaskColorProperty(InData.ColorHex));
+	}
 
-				BonesClassDefintions.Add(BoneClassDefinition);
-			}
-		}
+	// Obj has no pose info
+	if (!InData.bHasPose)
+	{
+		OutNodes.Emplace(MoveTemp(ObjIndividual));
+		return;
 	}
-	else if (USkeletalMeshComponent* ObjAsSkelComp = Cast<USkeletalMeshComponent>(Object))
-	{		
-		FVector BBSize;
-#if SL_WITH_ROS_CONVERSIONS
-		BBSize = FConversions::CmToM(ObjAsSkelComp->Bounds.GetBox().GetSize());
-#else
-		BBSize = ObjAsSkelComp->Bounds.GetBox().GetSize();
-#endif // SL_WITH_ROS_CONVERSIONS
-		if (!BBSize.IsZero())
-		{
-			ClassDefinition.AddChildNode(FSLOwlSemanticMapStatics::CreateDepthProperty(BBSize.X));
-			ClassDefinition.AddChildNode(FSLOwlSemanticMapStatics::CreateWidthProperty(BBSize.Y));
-			ClassDefinition.AddChildNode(FSLOwlSemanticMapStatics::CreateHeightProperty(BBSize.Z));
-		}
 
-		TArray<FName> BoneNames;
-		ObjAsSkelComp->GetBoneNames(BoneNames);
-		for (const auto& BoneName : BoneNames)
-		{
-			ClassDefinition.AddChildNode(
-				FSLOwlSemanticMapStatics::CreateSkeletalBoneProperty(BoneName.ToString()));
-		}
+	// Pose property
+	ObjIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreatePoseProperty(MapPrefix, InData.PoseId));
+
+	// If static mesh, add pathToCadModel property
+	if (!InData.PathToCadModel.IsEmpty())
+	{
+		ObjIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreatePathToCadModelProperty(InData.PathToCadModel));
 	}
-	else if(UPrimitiveComponent* ObjAsPrimComp = Cast<UPrimitiveComponent>(Object))
+
+	// If skeletalmesh, add bones as properties
+	for (const auto& BoneId : InData.BoneIds)
 	{
-		FVector BBSize;
-#if SL_WITH_ROS_CONVERSIONS
-		BBSize = FConversions::CmToM(ObjAsPrimComp->Bounds.GetBox().GetSize());
-#else
-		BBSize = ObjAsPrimComp->Bounds.GetBox().GetSize();
-#endif // SL_WITH_ROS_CONVERSIONS
-		if (!BBSize.IsZero())
-		{
-			ClassDefinition.AddChildNode(FSLOwlSemanticMapStatics::CreateDepthProperty(BBSize.X));
-			ClassDefinition.AddChildNode(FSLOwlSemanticMapStatics::CreateWidthProperty(BBSize.Y));
-			ClassDefinition.AddChildNode(FSLOwlSemanticMapStatics::CreateHeightProperty(BBSize.Z));
-		}
+		ObjIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateSrdlSkeletalBoneProperty(MapPrefix, BoneId));
 	}
-	InSemMap->ClassDefinitions.Add(ClassDefinition);
 
-	if (BonesClassDefintions.Num())
+	// Add tags data property
+	ObjIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateTagsDataProperty(InData.Tags));
+
+	// Add the individual and its pose
+	OutNodes.Emplace(MoveTemp(ObjIndividual));
+	OutNodes.Emplace(FSLOwlSemanticMapStatics::CreatePoseIndividual(
+		MapPrefix, InData.PoseId, InData.Location, InData.Quat));
+
+	// Create skeletal bones individuals (if any)
+	for (int32 BoneIdx = 0; BoneIdx < InData.BoneNames.Num(); ++BoneIdx)
 	{
-		InSemMap->ClassDefinitions.Append(BonesClassDefintions);
+		// Check for parent bone
+		const int32 ParentIdx = InData.BoneParentIdxs[BoneIdx];
+		const FString BaseLinkId = InData.BoneIds.IsValidIndex(ParentIdx) ? InData.BoneIds[ParentIdx] : FString();
+
+		// Check child link by iterating all bones and checking if their parent equals this
+		const int32 ChildIdx = InData.BoneParentIdxs.Find(BoneIdx);
+		const FString EndLinkId = ChildIdx != INDEX_NONE ? InData.BoneIds[ChildIdx] : FString();
+
+		// TODO read class from datastructure, otherwise use the bone name
+		const FString& BoneNameStr = InData.BoneNames[BoneIdx];
+		OutNodes.Emplace(FSLOwlSemanticMapStatics::CreateBoneIndividual(
+			MapPrefix, InData.BoneIds[BoneIdx], BoneNameStr, BaseLinkId, EndLinkId, BoneNameStr));
 	}
 }
 
-// Add constraint individual
-void FSLSemanticMapWriter::AddConstraintIndividual(TSharedPtr<FSLOwlSemanticMap> InSemMap,
-	UPhysicsConstraintComponent* ConstraintComp,
-	const FString& InId,
-	const TArray<FName>& InTags)
+// Create the constraint individual and its pose and limits individuals (thread safe)
+void FSLSemanticMapWriter::CreateConstraintIndividuals(const FSLSemanticMapIndividualData& InData,
+	const FString& MapPrefix, const FString& DocId, TArray<FSLOwlNode>& OutNodes)
 {
-	const FString MapPrefix = InSemMap->Prefix;
-	const FString DocId = InSemMap->Id;
-
-	AActor* ParentAct = ConstraintComp->ConstraintActor1;
-	AActor* ChildAct = ConstraintComp->ConstraintActor2;
+	const FSLSemanticMapConstraintData& Constr = InData.Constraint;
 
-	if (ParentAct && ChildAct)
-	{
-		const FString ParentId = FTags::GetValue(ParentAct, "SemLog", "Id");
-		const FString ChildId = FTags::GetValue(ChildAct, "SemLog", "Id");
-		if (!ParentId.IsEmpty() && !ChildId.IsEmpty())
-		{
-			// Create the object individual
-			FSLOwlNode ConstrIndividual = FSLOwlSemanticMapStatics::CreateConstraintIndividual(
-				MapPrefix, InId, ParentId, ChildId);
-
-			// Add describedInMap property
-			ConstrIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateDescribedInMapProperty(
-				MapPrefix, DocId));
-
-			// Add tags data property
-			ConstrIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateTagsDataProperty(
-				InTags));
-
-			// Generate unique ids 
-			const FString PoseId = FIds::NewGuidInBase64Url();
-			const FString LinId = FIds::NewGuidInBase64Url();
-			const FString AngId = FIds::NewGuidInBase64Url();
-
-			// Add properties
-			ConstrIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreatePoseProperty(
-				MapPrefix, PoseId));
-			ConstrIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateLinearConstraintProperty(
-				MapPrefix, LinId));
-			ConstrIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateAngularConstraintProperty(
-				MapPrefix, AngId));
-			
-			// Add individuals to the map
-			InSemMap->AddIndividual(ConstrIndividual);
-
-			// Create pose individual
-#if SL_WITH_ROS_CONVERSIONS
-			const FVector ROSLoc = FConversions::UToROS(ConstraintComp->GetComponentLocation());
-			const FQuat ROSQuat = FConversions::UToROS(ConstraintComp->GetComponentQuat());
-			InSemMap->AddIndividual(FSLOwlSemanticMapStatics::CreatePoseIndividual(
-				MapPrefix, PoseId, ROSLoc, ROSQuat));
-#else
-			InSemMap->AddIndividual(FSLOwlSemanticMapStatics::CreatePoseIndividual(
-				MapPrefix, PoseId, ConstraintComp->GetComponentLocation(), ConstraintComp->GetComponentQuat()));
-#endif // SL_WITH_ROS_CONVERSIONS
+	// Create the object individual
+	FSLOwlNode ConstrIndividual = FSLOwlSemanticMapStatics::CreateConstraintIndividual(
+		MapPrefix, InData.Id, Constr.ParentId, Constr.ChildId);
 
-			// Create linear constraint individual
-			const uint8 LinXMotion = ConstraintComp->ConstraintInstance.GetLinearXMotion();
-			const uint8 LinYMotion = ConstraintComp->ConstraintInstance.GetLinearYMotion();
-			const uint8 LinZMotion = ConstraintComp->ConstraintInstance.GetLinearZMotion();
-			float LinLimit;
-#if SL_WITH_ROS_CONVERSIONS
-			LinLimit = FConversions::CmToM(ConstraintComp->ConstraintInstance.GetLinearLimit());
-#else
-			LinLimit =ConstraintComp->ConstraintInstance.GetLinearLimit();
-#endif // SL_WITH_ROS_CONVERSIONS
-			const bool bLinSoftConstraint = ConstraintComp->ConstraintInstance.ProfileInstance.LinearLimit.bSoftConstraint;
-			const float LinStiffness = ConstraintComp->ConstraintInstance.ProfileInstance.LinearLimit.Stiffness;
-			const float LinDamping = ConstraintComp->ConstraintInstance.ProfileInstance.LinearLimit.Damping;
-			
-			InSemMap->AddIndividual(FSLOwlSemanticMapStatics::CreateLinearConstraintProperties(
-				MapPrefix, LinId, LinXMotion, LinYMotion, LinZMotion, LinLimit, 
-				bLinSoftConstraint, LinStiffness, LinDamping));
-
-			// Create angular constraint individual
-			const uint8 AngSwing1Motion = ConstraintComp->ConstraintInstance.GetAngularSwing1Motion();
-			const uint8 AngSwing2Motion = ConstraintComp->ConstraintInstance.GetAngularSwing2Motion();
-			const uint8 AngTwistMotion = ConstraintComp->ConstraintInstance.GetAngularTwistMotion();
-			const float AngSwing1Limit = FMath::DegreesToRadians(ConstraintComp->ConstraintInstance.GetAngularSwing1Limit());
-			const float AngSwing2Limit = FMath::DegreesToRadians(ConstraintComp->ConstraintInstance.GetAngularSwing2Limit());
-			const float AngTwistLimit = FMath::DegreesToRadians(ConstraintComp->ConstraintInstance.GetAngularTwistLimit());
-			const bool bAngSoftSwingConstraint = ConstraintComp->ConstraintInstance.ProfileInstance.ConeLimit.bSoftConstraint;
-			const float AngSwingStiffness = ConstraintComp->ConstraintInstance.ProfileInstance.ConeLimit.Stiffness;
-			const float AngSwingDamping = ConstraintComp->ConstraintInstance.ProfileInstance.ConeLimit.Damping;
-			const bool bAngSoftTwistConstraint = ConstraintComp->ConstraintInstance.ProfileInstance.TwistLimit.bSoftConstraint;
-			const float AngTwistStiffness = ConstraintComp->ConstraintInstance.ProfileInstance.TwistLimit.Stiffness;
-			const float AngTwistDamping = ConstraintComp->ConstraintInstance.ProfileInstance.TwistLimit.Damping;
-
-			InSemMap->AddIndividual(FSLOwlSemanticMapStatics::CreateAngularConstraintProperties(
-				MapPrefix, AngId, AngSwing1Motion, AngSwing2Motion, AngTwistMotion,
-				AngSwing1Limit, AngSwing2Limit, AngTwistLimit, bAngSoftSwingConstraint,
-				AngSwingStiffness, AngSwingDamping, bAngSoftTwistConstraint,
-				AngTwistStiffness, AngTwistDamping));
-		}
-	}
+	// Add describedInMap property
+	ConstrIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateDescribedInMapProperty(
+		MapPrefix, DocId));
+
+	// Add tags data property
+	ConstrIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateTagsDataProperty(
+		InData.Tags));
+
+	// Add properties
+	ConstrIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreatePoseProperty(
+		MapPrefix, InData.PoseId));
+	ConstrIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateLinearConstraintProperty(
+		MapPrefix, Constr.LinId));
+	ConstrIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateAngularConstraintProperty(
+		MapPrefix, Constr.AngId));
+
+	// Add individuals to the map
+	OutNodes.Emplace(MoveTemp(ConstrIndividual));
+
+	// Create pose individual
+	OutNodes.Emplace(FSLOwlSemanticMapStatics::CreatePoseIndividual(
+		MapPrefix, InData.PoseId, InData.Location, InData.Quat));
+
+	// Create linear constraint individual
+	OutNodes.Emplace(FSLOwlSemanticMapStatics::CreateLinearConstraintProperties(
+		MapPrefix, Constr.LinId, Constr.LinXMotion, Constr.LinYMotion, Constr.LinZMotion, Constr.LinLimit,
+		Constr.bLinSoftConstraint, Constr.LinStiffness, Constr.LinDamping));
+
+	// Create angular constraint individual
+	OutNodes.Emplace(FSLOwlSemanticMapStatics::CreateAngularConstraintProperties(
+		MapPrefix, Constr.AngId, Constr.AngSwing1Motion, Constr.AngSwing2Motion, Constr.AngTwistMotion,
+		Constr.AngSwing1Limit, Constr.AngSwing2Limit, Constr.AngTwistLimit, Constr.bAngSoftSwingConstraint,
+		Constr.AngSwingStiffness, Constr.AngSwingDamping, Constr.bAngSoftTwistConstraint,
+		Constr.AngTwistStiffness, Constr.AngTwistDamping));
 }
 
-// Add individual physics properties
-TArray<FSLOwlNode> FSLSemanticMapWriter::GetIndividualPhysicsProperties(UObject* Object)
+// Create the class definition and its bone class definitions (thread safe)
+void FSLSemanticMapWriter::CreateClassDefinitions(const FSLSemanticMapClassData& InData, TArray<FSLOwlNode>& OutNodes)
 {
-	// Check object type
-	if (AStaticMeshActor* ObjAsSMA = Cast<AStaticMeshActor>(Object))
+	// Create class definition individual
+	FSLOwlNode ClassDefinition = FSLOwlSemanticMapStatics::CreateClassDefinition(InData.Class);
+	ClassDefinition.Comment = TEXT("Class ") + InData.Class;
+
+	// If object is skeletal, create class definitions for each bone
+	TArray<FSLOwlNode> BonesClassDefintions;
+
+	// Check if upper class is known
+	if (!InData.SubClassOf.IsEmpty())
+	{
+		ClassDefinition.AddChildNode(FSLOwlSemanticMapStatics::CreateSubClassOfProperty(InData.SubClassOf));
+	}
+	else if (InData.bIsSkeletalActor)
+	{
+		// Set a generic upper class if none is given
+		ClassDefinition.AddChildNode(FSLOwlSemanticMapStatics::CreateSubClassOfProperty("Person"));
+	}
+
+	// Add bounds if available
+	AddSizeProperties(ClassDefinition, InData.BBSize);
+
+	if (InData.bIsSkeletalActor)
 	{
-		if (UStaticMeshComponent* SMC = ObjAsSMA->GetStaticMeshComponent())
+		// Add srdl capabilities
+		TArray<FString> Capabilities = { "GraspingCapability", "move_arm", "move_base" };
+		ClassDefinition.AddChildNode(FSLOwlSemanticMapStatics::CreateHasCapabilityProperties(Capabilities));
+	}
+
+	for (const auto& BoneNameStr : InData.BoneNames)
+	{
+		ClassDefinition.AddChildNode(FSLOwlSemanticMapStatics::CreateSkeletalBoneProperty(BoneNameStr));
+
+		if (InData.bIsSkeletalActor)
 		{
-			float Mass = SMC->IsSimulatingPhysics() ? SMC->GetMass() : SMC->CalculateMass();
-			return FSLOwlSemanticMapStatics::CreatePhysicsProperties(
-				Mass, SMC->GetGenerateOverlapEvents(), SMC->IsGravityEnabled());
+			// Create separate bone class definition
+			FSLOwlNode BoneClassDefinition = FSLOwlSemanticMapStatics::CreateClassDefinition(BoneNameStr);
+			BoneClassDefinition.Comment = TEXT("Bone Class ") + BoneNameStr;
+
+			// TODO read from actor skeletal component
+			const FString BoneSubClassOf = "SkeletalBone";
+			BoneClassDefinition.AddChildNode(FSLOwlSemanticMapStatics::CreateSubClassOfProperty(BoneSubClassOf));
+			BonesClassDefintions.Emplace(MoveTemp(BoneClassDefinition));
 		}
 	}
-	else if (UStaticMeshComponent* ObjAsSMC = Cast<UStaticMeshComponent>(Object))
+
+	OutNodes.Emplace(MoveTemp(ClassDefinition));
+	OutNodes.Append(MoveTemp(BonesClassDefintions));
+}
+
+// Add bounding box size properties
+void FSLSemanticMapWriter::AddSizeProperties(FSLOwlNode& ClassDefinition, const FVector& BBSize)
+{
+	if (!BBSize.IsZero())
 	{
-		float Mass = ObjAsSMC->IsSimulatingPhysics() ? ObjAsSMC->GetMass() : ObjAsSMC->CalculateMass();
-		return FSLOwlSemanticMapStatics::CreatePhysicsProperties(
-			Mass, ObjAsSMC->GetGenerateOverlapEvents(), ObjAsSMC->IsGravityEnabled());
+		ClassDefinition.AddChildNode(FSLOwlSemanticMapStatics::CreateDepthProperty(BBSize.X));
+		ClassDefinition.AddChildNode(FSLOwlSemanticMapStatics::CreateWidthProperty(BBSize.Y));
+		ClassDefinition.AddChildNode(FSLOwlSemanticMapStatics::CreateHeightProperty(BBSize.Z));
 	}
-	return TArray<FSLOwlNode>();
 }
 
 // Get parent id (empty string if none)
@@ -618,10 +805,10 @@ FString FSLSemanticMapWriter::GetParentId(UObject* Object)
 			}
 		}
 
-		if (AActor* ParentAttAct = ObjAsAct->GetAttachParentActor())
+		if (AActor* ParentAttAct = FSLArticulationGraph::GetInstance()->GetAttachParent(ObjAsAct))
 		{
-			const FString Id = FTags::GetValue(ParentAttAct, "SemLog", "Id");
-			if (!Id.IsEmpty() && FTags::HasKey(ParentAttAct, "SemLog", "Class"))
+			const FString Id = FSLArticulationGraph::GetInstance()->GetSemanticId(ParentAttAct);
+			if (!Id.IsEmpty())
 			{
 				return Id;
 			}
@@ -687,12 +874,11 @@ void FSLSemanticMapWriter::GetChildIds(UObject* Object, TArray<FString>& OutChil
 	if (AActor* ObjAsActor = Cast<AActor>(Object))
 	{
 		// Iterate child actors (only direct children, no grandchildren etc.)
-		TArray<AActor*> AttachedActors;
-		ObjAsActor->GetAttachedActors(AttachedActors);
-		for (const auto& ChildAct : AttachedActors)
+		FSLArticulationGraph* Graph = FSLArticulationGraph::GetInstance();
+		for (const auto& ChildAct : Graph->GetAttachedActors(ObjAsActor))
 		{
-			const FString ChildId = FTags::GetValue(ChildAct, "SemLog", "Id");
-			if (!ChildId.IsEmpty() && FTags::HasKey(ChildAct, "SemLog", "Class"))
+			const FString ChildId = Graph->GetSemanticId(ChildAct);
+			if (!ChildId.IsEmpty())
 			{
 				OutChildIds.AddUnique(ChildId);
 			}
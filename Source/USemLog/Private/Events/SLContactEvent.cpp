@@ -42,14 +42,10 @@ void FSLContactEvent::AddToOwlDoc(FSLOwlDoc* OutDoc)
 	// we cannot use the safer dynamic_cast because RTTI is not enabled by default
 	// if (FOwlEvents* EventsDoc = dynamic_cast<FOwlEvents*>(OutDoc))
 	FSLOwlExperiment* EventsDoc = static_cast<FSLOwlExperiment*>(OutDoc);
-	EventsDoc->AddTimepointIndividual(
-		Start, FSLOwlExperimentStatics::CreateTimepointIndividual("log", Start));
-	EventsDoc->AddTimepointIndividual(
-		End, FSLOwlExperimentStatics::CreateTimepointIndividual("log", End));
-	EventsDoc->AddObjectIndividual(Item1.Obj,
-		FSLOwlExperimentStatics::CreateObjectIndividual("log", Item1.Id, Item1.Class));
-	EventsDoc->AddObjectIndividual(Item2.Obj,
-		FSLOwlExperimentStatics::CreateObjectIndividual("log", Item2.Id, Item2.Class));
+	EventsDoc->AddTimepointIndividual("log", Start);
+	EventsDoc->AddTimepointIndividual("log", End);
+	EventsDoc->AddObjectIndividual("log", Item1.Id, Item1.Class);
+	EventsDoc->AddObjectIndividual("log", Item2.Id, Item2.Class);
 	OutDoc->AddIndividual(ToOwlNode());
 }
 
@@ -72,4 +68,17 @@ FString FSLContactEvent::ToString() const
 	return FString::Printf(TEXT("Item1:[%s] Item2:[%s] PairId:%lld"),
 		*Item1.ToString(), *Item2.ToString(), PairId);
 }
+
+// Get the event type name
+FString FSLContactEvent::TypeName() const
+{
+	return TEXT("Contact");
+}
+
+// Get the ids of the participating entities
+void FSLContactEvent::GetParticipantIds(TArray<FString>& OutIds) const
+{
+	OutIds.Add(Item1.Id);
+	OutIds.Add(Item2.Id);
+}
 /* End ISLEvent interface */
\ No newline at end of file
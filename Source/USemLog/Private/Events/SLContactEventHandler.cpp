@@ -2,6 +2,7 @@
 // Author: Andrei Haidu (http://haidu.eu)
 
 #include "Events/SLContactEventHandler.h"
+#include "Events/SLEventPool.h"
 #include "SLContactShapeInterface.h"
 
 // UUtils
@@ -69,10 +70,10 @@ void FSLContactEventHandler::Finish(float EndTime, bool bForced)
 void FSLContactEventHandler::AddNewContactEvent(const FSLContactResult& InResult)
 {
 	// Start a semantic contact event
-	TSharedPtr<FSLContactEvent> ContactEvent = MakeShareable(new FSLContactEvent(
-		FIds::NewGuidInBase64Url(), InResult.Time,
+	TSharedPtr<FSLContactEvent> ContactEvent = FSLEventPool::GetInstance()->NewEvent<FSLContactEvent>(
+		InResult.Time,
 		FIds::PairEncodeCantor(InResult.Self.Obj->GetUniqueID(), InResult.Other.Obj->GetUniqueID()),
-		InResult.Self, InResult.Other));
+		InResult.Self, InResult.Other);
 	// Add event to the pending contacts array
 	StartedContactEvents.Emplace(ContactEvent);
 }
@@ -108,8 +109,8 @@ bool FSLContactEventHandler::FinishContactEvent(const FSLEntity& InOther, float
 void FSLContactEventHandler::AddNewSupportedByEvent(const FSLEntity& Supported, const FSLEntity& Supporting, float StartTime, const uint64 EventPairId)
 {
 	// Start a supported by event
-	TSharedPtr<FSLSupportedByEvent> Event = MakeShareable(new FSLSupportedByEvent(
-		FIds::NewGuidInBase64Url(), StartTime, EventPairId, Supported, Supporting));
+	TSharedPtr<FSLSupportedByEvent> Event = FSLEventPool::GetInstance()->NewEvent<FSLSupportedByEvent>(
+		StartTime, EventPairId, Supported, Supporting);
 	// Add event to the pending array
 	StartedSupportedByEvents.Emplace(Event);
 }
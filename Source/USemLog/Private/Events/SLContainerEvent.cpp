@@ -43,14 +43,10 @@ void FSLContainerEvent::AddToOwlDoc(FSLOwlDoc* OutDoc)
 	// we cannot use the safer dynamic_cast because RTTI is not enabled by default
 	// if (FOwlEvents* EventsDoc = dynamic_cast<FOwlEvents*>(OutDoc))
 	FSLOwlExperiment* EventsDoc = static_cast<FSLOwlExperiment*>(OutDoc);
-	EventsDoc->AddTimepointIndividual(
-		Start, FSLOwlExperimentStatics::CreateTimepointIndividual("log", Start));
-	EventsDoc->AddTimepointIndividual(
-		End, FSLOwlExperimentStatics::CreateTimepointIndividual("log", End));
-	EventsDoc->AddObjectIndividual(Manipulator.Obj,
-		FSLOwlExperimentStatics::CreateObjectIndividual("log", Manipulator.Id, Manipulator.Class));
-	EventsDoc->AddObjectIndividual(Item.Obj,
-		FSLOwlExperimentStatics::CreateObjectIndividual("log", Item.Id, Item.Class));
+	EventsDoc->AddTimepointIndividual("log", Start);
+	EventsDoc->AddTimepointIndividual("log", End);
+	EventsDoc->AddObjectIndividual("log", Manipulator.Id, Manipulator.Class);
+	EventsDoc->AddObjectIndividual("log", Item.Id, Item.Class);
 	OutDoc->AddIndividual(ToOwlNode());
 }
 
@@ -73,4 +69,17 @@ FString FSLContainerEvent::ToString() const
 	return FString::Printf(TEXT("Manipulator:[%s] Other:[%s] PairId:%lld"),
 		*Manipulator.ToString(), *Item.ToString(), PairId);
 }
+
+// Get the event type name
+FString FSLContainerEvent::TypeName() const
+{
+	return TEXT("ContainerManipulation");
+}
+
+// Get the ids of the participating entities
+void FSLContainerEvent::GetParticipantIds(TArray<FString>& OutIds) const
+{
+	OutIds.Add(Manipulator.Id);
+	OutIds.Add(Item.Id);
+}
 /* End ISLEvent interface */
\ No newline at end of file
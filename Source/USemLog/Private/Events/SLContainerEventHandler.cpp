@@ -2,6 +2,7 @@
 // Author: Andrei Haidu (http://haidu.eu)
 
 #include "Events/SLContainerEventHandler.h"
+#include "Events/SLEventPool.h"
 #include "SLEntitiesManager.h"
 #include "SLContainerListener.h"
 #include "Events/SLContainerEvent.h"
@@ -67,9 +68,9 @@ void FSLContainerEventHandler::OnContainerManipulation(const FSLEntity& Self, AA
 	// Check that the objects are semantically annotated
 	if(FSLEntity* OtherItem = FSLEntitiesManager::GetInstance()->GetEntityPtr(Other))
 	{
-		OnSemanticEvent.ExecuteIfBound(MakeShareable(new FSLContainerEvent(
-			FIds::NewGuidInBase64Url(), StartTime, EndTime,
+		OnSemanticEvent.ExecuteIfBound(FSLEventPool::GetInstance()->NewEvent<FSLContainerEvent>(
+			StartTime, EndTime,
 			FIds::PairEncodeCantor(Self.Obj->GetUniqueID(), Other->GetUniqueID()),
-			Self, *OtherItem, Type)));
+			Self, *OtherItem, Type));
 	}
 }
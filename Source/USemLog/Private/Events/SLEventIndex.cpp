@@ -0,0 +1,422 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "Events/SLEventIndex.h"
+#include "Events/ISLEvent.h"
+#include "Misc/Paths.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+
+// File identifier and version
+static const uint32 SLEventIndexMagic = 0x49455f53; // S_EI
+static const int32 SLEventIndexVersion = 1;
+
+// Insert the entry at its start position
+void FSLEventIntervalTree::Insert(int32 EntryIdx, const TArray<FSLEventIndexEntry>& Entries)
+{
+	// Upper bound of the start, the events mostly finish in start order so the position is close to the end
+	const float EntryStart = Entries[EntryIdx].Start;
+	int32 Low = 0;
+	int32 High = SortedIdxs.Num();
+	while (Low < High)
+	{
+		const int32 Mid = Low + (High - Low) / 2;
+		if (Entries[SortedIdxs[Mid]].Start <= EntryStart)
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+	SortedIdxs.Insert(EntryIdx, Low);
+
+	// The leaves are doubled when full, otherwise only the shifted entries are updated
+	if (SortedIdxs.Num() > Capacity)
+	{
+		Build(Entries);
+	}
+	else
+	{
+		UpdateLeaves(Low, SortedIdxs.Num(), Entries);
+	}
+}
+
+// Re-build the tree from the sorted indexes (bulk loading)
+void FSLEventIntervalTree::Build(const TArray<FSLEventIndexEntry>& Entries)
+{
+	Capacity = SortedIdxs.Num() > 0 ? FMath::RoundUpToPowerOfTwo(SortedIdxs.Num()) : 0;
+	MaxEnd.Init(-MAX_flt, 2 * Capacity);
+	for (int32 Pos = 0; Pos < SortedIdxs.Num(); ++Pos)
+	{
+		MaxEnd[Capacity + Pos] = Entries[SortedIdxs[Pos]].End;
+	}
+	for (int32 NodeIdx = Capacity - 1; NodeIdx >= 1; --NodeIdx)
+	{
+		MaxEnd[NodeIdx] = FMath::Max(MaxEnd[2 * NodeIdx], MaxEnd[2 * NodeIdx + 1]);
+	}
+}
+
+// Collect the entries with start <= End and end >= Start
+void FSLEventIntervalTree::Query(float Start, float End, const TArray<FSLEventIndexEntry>& Entries, TArray<int32>& OutEntryIdxs) const
+{
+	if (SortedIdxs.Num() > 0)
+	{
+		QueryNode(1, 0, Capacity, Start, End, Entries, OutEntryIdxs);
+	}
+}
+
+// Remove all entries
+void FSLEventIntervalTree::Empty()
+{
+	SortedIdxs.Empty();
+	MaxEnd.Empty();
+	Capacity = 0;
+}
+
+// Re-compute the leaves of the [First, Last) sorted positions and their ancestors
+void FSLEventIntervalTree::UpdateLeaves(int32 First, int32 Last, const TArray<FSLEventIndexEntry>& Entries)
+{
+	for (int32 Pos = First; Pos < Last; ++Pos)
+	{
+		MaxEnd[Capacity + Pos] = Entries[SortedIdxs[Pos]].End;
+	}
+
+	// Walk up the levels, only the nodes above the changed leaves
+	int32 LowNode = (Capacity + First) / 2;
+	int32 HighNode = (Capacity + Last - 1) / 2;
+	while (LowNode >= 1)
+	{
+		for (int32 NodeIdx = LowNode; NodeIdx <= HighNode; ++NodeIdx)
+		{
+			MaxEnd[NodeIdx] = FMath::Max(MaxEnd[2 * NodeIdx], MaxEnd[2 * NodeIdx + 1]);
+		}
+		LowNode /= 2;
+		HighNode /= 2;
+	}
+}
+
+// Collect the entries of the node covering the [Low, High) sorted positions
+void FSLEventIntervalTree::QueryNode(int32 NodeIdx, int32 Low, int32 High, float Start, float End,
+	const TArray<FSLEventIndexEntry>& Entries, TArray<int32>& OutEntryIdxs) const
+{
+	// Empty leaves, no entry of the node ends after the query start, or all of them start after the query end
+	if (Low >= SortedIdxs.Num() || MaxEnd[NodeIdx] < Start || Entries[SortedIdxs[Low]].Start > End)
+	{
+		return;
+	}
+
+	if (High - Low == 1)
+	{
+		OutEntryIdxs.Add(SortedIdxs[Low]);
+		return;
+	}
+
+	const int32 Mid = Low + (High - Low) / 2;
+	QueryNode(2 * NodeIdx, Low, Mid, Start, End, Entries, OutEntryIdxs);
+	QueryNode(2 * NodeIdx + 1, Mid, High, Start, End, Entries, OutEntryIdxs);
+}
+
+// Ctor
+FSLEventIndex::FSLEventIndex()
+{
+}
+
+// Add the finished event
+void FSLEventIndex::Add(const ISLEvent& Event)
+{
+	TArray<FString> Participants;
+	Event.GetParticipantIds(Participants);
+	Add(Event.Id, Event.TypeName(), Event.Start, Event.End, Participants);
+}
+
+// Add the event interval
+void FSLEventIndex::Add(const FString& Id, const FString& TypeName, float Start, float End, const TArray<FString>& InParticipantIds)
+{
+	FSLEventIndexEntry Entry;
+	Entry.Id = Id;
+	Entry.TypeIdx = GetOrAddName(TypeName, TypeNames, TypeNameToIdx);
+	Entry.Start = Start;
+	Entry.End = FMath::Max(Start, End);
+	for (const FString& ParticipantId : InParticipantIds)
+	{
+		Entry.ParticipantIdxs.AddUnique(GetOrAddName(ParticipantId, ParticipantIds, ParticipantIdToIdx));
+	}
+
+	InsertEntry(Entries.Emplace(MoveTemp(Entry)));
+}
+
+// Remove all entries
+void FSLEventIndex::Empty()
+{
+	Entries.Empty();
+	EntriesTree.Empty();
+	TypeNames.Empty();
+	TypeNameToIdx.Empty();
+	ParticipantIds.Empty();
+	ParticipantIdToIdx.Empty();
+	TypeTrees.Empty();
+	ParticipantTrees.Empty();
+}
+
+// Get the participant ids of the entry
+void FSLEventIndex::GetParticipantIds(const FSLEventIndexEntry& Entry, TArray<FString>& OutIds) const
+{
+	for (const int32 ParticipantIdx : Entry.ParticipantIdxs)
+	{
+		OutIds.Add(ParticipantIds[ParticipantIdx]);
+	}
+}
+
+// Get the number of entries of each event type
+void FSLEventIndex::GetTypeCounts(TMap<FString, int32>& OutCounts) const
+{
+	for (const FSLEventIndexEntry& Entry : Entries)
+	{
+		OutCounts.FindOrAdd(TypeNames[Entry.TypeIdx])++;
+	}
+}
+
+// Get the entries active at the given time, optionally filtered by type and participant (empty means any)
+void FSLEventIndex::GetActiveAt(float Time, TArray<int32>& OutEntryIdxs, const FString& TypeName, const FString& ParticipantId) const
+{
+	GetOverlapping(Time, Time, OutEntryIdxs, TypeName, ParticipantId);
+}
+
+// Get the entries overlapping the time interval, optionally filtered by type and participant (empty means any)
+void FSLEventIndex::GetOverlapping(float Start, float End, TArray<int32>& OutEntryIdxs, const FString& TypeName, const FString& ParticipantId) const
+{
+	int32 TypeIdx = INDEX_NONE;
+	if (!TypeName.IsEmpty())
+	{
+		const int32* TypeIdxPtr = TypeNameToIdx.Find(TypeName);
+		if (!TypeIdxPtr)
+		{
+			return;
+		}
+		TypeIdx = *TypeIdxPtr;
+	}
+
+	int32 ParticipantIdx = INDEX_NONE;
+	if (!ParticipantId.IsEmpty())
+	{
+		const int32* ParticipantIdxPtr = ParticipantIdToIdx.Find(ParticipantId);
+		if (!ParticipantIdxPtr)
+		{
+			return;
+		}
+		ParticipantIdx = *ParticipantIdxPtr;
+	}
+
+	// Query the smallest tree matching one of the keys, filter the results by the other key
+	const FSLEventIntervalTree* Tree = &EntriesTree;
+	if (TypeIdx != INDEX_NONE)
+	{
+		Tree = &TypeTrees[TypeIdx];
+	}
+	if (ParticipantIdx != INDEX_NONE && ParticipantTrees[ParticipantIdx].Num() < Tree->Num())
+	{
+		Tree = &ParticipantTrees[ParticipantIdx];
+	}
+
+	const int32 FirstNewIdx = OutEntryIdxs.Num();
+	Tree->Query(Start, End, Entries, OutEntryIdxs);
+	if (TypeIdx != INDEX_NONE && ParticipantIdx != INDEX_NONE)
+	{
+		for (int32 Idx = OutEntryIdxs.Num() - 1; Idx >= FirstNewIdx; --Idx)
+		{
+			if (!Matches(Entries[OutEntryIdxs[Idx]], TypeIdx, ParticipantIdx))
+			{
+				OutEntryIdxs.RemoveAt(Idx, 1, false);
+			}
+		}
+	}
+}
+
+// Get the entries of the given type overlapping the given entry (e.g. the grasps during a contact)
+void FSLEventIndex::GetOverlappingEntry(int32 EntryIdx, const FString& TypeName, TArray<int32>& OutEntryIdxs) const
+{
+	if (Entries.IsValidIndex(EntryIdx))
+	{
+		const float Start = Entries[EntryIdx].Start;
+		const float End = Entries[EntryIdx].End;
+		GetOverlapping(Start, End, OutEntryIdxs, TypeName);
+		OutEntryIdxs.Remove(EntryIdx);
+	}
+}
+
+// Write the index to file
+bool FSLEventIndex::SaveToFile(const FString& FilePath)
+{
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+
+	uint32 Magic = SLEventIndexMagic;
+	int32 Version = SLEventIndexVersion;
+	Writer << Magic;
+	Writer << Version;
+	Writer << TypeNames;
+	Writer << ParticipantIds;
+
+	int32 NumEntries = Entries.Num();
+	Writer << NumEntries;
+	for (FSLEventIndexEntry& Entry : Entries)
+	{
+		Writer << Entry.Id;
+		Writer << Entry.TypeIdx;
+		Writer << Entry.Start;
+		Writer << Entry.End;
+		Writer << Entry.ParticipantIdxs;
+	}
+
+	return FFileHelper::SaveArrayToFile(Data, *FilePath);
+}
+
+// Read the index from file
+bool FSLEventIndex::LoadFromFile(const FString& FilePath)
+{
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *FilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Could not read %s.."), *FString(__func__), __LINE__, *FilePath);
+		return false;
+	}
+
+	FMemoryReader Reader(Data);
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Reader << Magic;
+	Reader << Version;
+	if (Magic != SLEventIndexMagic || Version != SLEventIndexVersion)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d %s is not a valid event index file.."), *FString(__func__), __LINE__, *FilePath);
+		return false;
+	}
+
+	Empty();
+	Reader << TypeNames;
+	Reader << ParticipantIds;
+
+	int32 NumEntries = 0;
+	Reader << NumEntries;
+	Entries.SetNum(FMath::Max(NumEntries, 0));
+	for (FSLEventIndexEntry& Entry : Entries)
+	{
+		Reader << Entry.Id;
+		Reader << Entry.TypeIdx;
+		Reader << Entry.Start;
+		Reader << Entry.End;
+		Reader << Entry.ParticipantIdxs;
+
+		// Make sure the table indexes are valid
+		bool bValidParticipants = true;
+		for (const int32 ParticipantIdx : Entry.ParticipantIdxs)
+		{
+			bValidParticipants &= ParticipantIds.IsValidIndex(ParticipantIdx);
+		}
+		if (!TypeNames.IsValidIndex(Entry.TypeIdx) || !bValidParticipants)
+		{
+			Reader.SetError();
+			break;
+		}
+	}
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d %s is truncated.."), *FString(__func__), __LINE__, *FilePath);
+		Empty();
+		return false;
+	}
+
+	// Re-create the lookups
+	for (int32 Idx = 0; Idx < TypeNames.Num(); ++Idx)
+	{
+		TypeNameToIdx.Add(TypeNames[Idx], Idx);
+	}
+	for (int32 Idx = 0; Idx < ParticipantIds.Num(); ++Idx)
+	{
+		ParticipantIdToIdx.Add(ParticipantIds[Idx], Idx);
+	}
+
+	// Bulk load the trees, the entries are sorted once and appended in start order
+	TArray<int32> SortedIdxs;
+	SortedIdxs.SetNumUninitialized(Entries.Num());
+	for (int32 EntryIdx = 0; EntryIdx < Entries.Num(); ++EntryIdx)
+	{
+		SortedIdxs[EntryIdx] = EntryIdx;
+	}
+	SortedIdxs.StableSort([this](const int32 A, const int32 B) { return Entries[A].Start < Entries[B].Start; });
+
+	TypeTrees.SetNum(TypeNames.Num());
+	ParticipantTrees.SetNum(ParticipantIds.Num());
+	EntriesTree.SortedIdxs = SortedIdxs;
+	for (const int32 EntryIdx : SortedIdxs)
+	{
+		TypeTrees[Entries[EntryIdx].TypeIdx].SortedIdxs.Add(EntryIdx);
+		for (const int32 ParticipantIdx : Entries[EntryIdx].ParticipantIdxs)
+		{
+			ParticipantTrees[ParticipantIdx].SortedIdxs.Add(EntryIdx);
+		}
+	}
+	EntriesTree.Build(Entries);
+	for (FSLEventIntervalTree& Tree : TypeTrees)
+	{
+		Tree.Build(Entries);
+	}
+	for (FSLEventIntervalTree& Tree : ParticipantTrees)
+	{
+		Tree.Build(Entries);
+	}
+	return true;
+}
+
+// Default file path of the episode index (SemLog/<TaskId>/<EpisodeId>_EI.bin)
+FString FSLEventIndex::GetEpisodeFilePath(const FString& TaskId, const FString& EpisodeId)
+{
+	FString FilePath = FPaths::ProjectDir() + "/SemLog/" + TaskId + "/" + EpisodeId + TEXT("_EI.bin");
+	FPaths::RemoveDuplicateSlashes(FilePath);
+	return FilePath;
+}
+
+// Add the entry to the tree of all entries and to the trees of its keys
+void FSLEventIndex::InsertEntry(int32 EntryIdx)
+{
+	const FSLEventIndexEntry& Entry = Entries[EntryIdx];
+	EntriesTree.Insert(EntryIdx, Entries);
+
+	if (TypeTrees.Num() < TypeNames.Num())
+	{
+		TypeTrees.SetNum(TypeNames.Num());
+	}
+	TypeTrees[Entry.TypeIdx].Insert(EntryIdx, Entries);
+
+	if (ParticipantTrees.Num() < ParticipantIds.Num())
+	{
+		ParticipantTrees.SetNum(ParticipantIds.Num());
+	}
+	for (const int32 ParticipantIdx : Entry.ParticipantIdxs)
+	{
+		ParticipantTrees[ParticipantIdx].Insert(EntryIdx, Entries);
+	}
+}
+
+// Check if the entry has the type and the participant (INDEX_NONE means any)
+bool FSLEventIndex::Matches(const FSLEventIndexEntry& Entry, int32 TypeIdx, int32 ParticipantIdx) const
+{
+	return (TypeIdx == INDEX_NONE || Entry.TypeIdx == TypeIdx) &&
+		(ParticipantIdx == INDEX_NONE || Entry.ParticipantIdxs.Contains(ParticipantIdx));
+}
+
+// Get or add the name to the table
+int32 FSLEventIndex::GetOrAddName(const FString& Name, TArray<FString>& Names, TMap<FString, int32>& NameToIdx)
+{
+	if (const int32* IdxPtr = NameToIdx.Find(Name))
+	{
+		return *IdxPtr;
+	}
+	const int32 Idx = Names.Add(Name);
+	NameToIdx.Add(Name, Idx);
+	return Idx;
+}
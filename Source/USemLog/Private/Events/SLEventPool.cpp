@@ -0,0 +1,77 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "Events/SLEventPool.h"
+#include "Misc/Guid.h"
+
+// Base64url alphabet of the ids
+static const TCHAR SLEventIdChars[] = TEXT("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_");
+
+// Number of random prefix characters (6 bits each)
+static const int32 SLEventIdPrefixLen = 11;
+
+TSharedPtr<FSLEventPool> FSLEventPool::StaticInstance;
+
+// Constructor
+FSLEventPool::FSLEventPool() : IdCounter(0)
+{
+	Init();
+}
+
+// Get singleton
+FSLEventPool* FSLEventPool::GetInstance()
+{
+	if (!StaticInstance.IsValid())
+	{
+		StaticInstance = MakeShareable(new FSLEventPool());
+	}
+	return StaticInstance.Get();
+}
+
+// Delete instance
+void FSLEventPool::DeleteInstance()
+{
+	StaticInstance.Reset();
+}
+
+// Start a new episode (new id prefix, counter reset)
+void FSLEventPool::Init()
+{
+	// Random prefix from a guid (unique across episodes), the counter makes the ids unique within the episode
+	const FGuid Guid = FGuid::NewGuid();
+	const uint64 Bits[2] = { (uint64(Guid.A) << 32) | Guid.B, (uint64(Guid.C) << 32) | Guid.D };
+	IdPrefix.Reset(SLEventIdPrefixLen);
+	for (int32 Idx = 0; Idx < SLEventIdPrefixLen; ++Idx)
+	{
+		const int32 Bit = Idx * 6;
+		const uint64 Word = Bits[Bit / 64] >> (Bit % 64);
+		IdPrefix.Add(SLEventIdChars[Word & 0x3F]);
+	}
+	IdCounter = 0;
+}
+
+// Unique id of the episode events (prefix + counter)
+FString FSLEventPool::NewId()
+{
+	uint64 Counter = IdCounter++;
+
+	// Prefix and the base64url counter digits (most significant first)
+	TCHAR Digits[12];
+	int32 NumDigits = 0;
+	do
+	{
+		Digits[NumDigits++] = SLEventIdChars[Counter & 0x3F];
+		Counter >>= 6;
+	} while (Counter > 0);
+
+	FString Id;
+	TArray<TCHAR>& Chars = Id.GetCharArray();
+	Chars.Reserve(IdPrefix.Num() + NumDigits + 1);
+	Chars.Append(IdPrefix);
+	while (NumDigits > 0)
+	{
+		Chars.Add(Digits[--NumDigits]);
+	}
+	Chars.Add(TEXT('\0'));
+	return Id;
+}
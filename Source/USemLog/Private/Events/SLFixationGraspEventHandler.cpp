@@ -2,6 +2,7 @@
 // Author: Andrei Haidu (http://haidu.eu)
 
 #include "Events/SLFixationGraspEventHandler.h"
+#include "Events/SLEventPool.h"
 #include "SLEntitiesManager.h"
 #if SL_WITH_MC_GRASP
 #include "MCGraspFixation.h"
@@ -73,10 +74,10 @@ void FSLFixationGraspEventHandler::Finish(float EndTime, bool bForced)
 void FSLFixationGraspEventHandler::AddNewEvent(const FSLEntity& Self, const FSLEntity& Other, float StartTime)
 {
 	// Start a semantic grasp event
-	TSharedPtr<FSLGraspEvent> Event = MakeShareable(new FSLGraspEvent(
-		FIds::NewGuidInBase64Url(), StartTime, 
+	TSharedPtr<FSLGraspEvent> Event = FSLEventPool::GetInstance()->NewEvent<FSLGraspEvent>(
+		StartTime, 
 		FIds::PairEncodeCantor(Self.Obj->GetUniqueID(), Other.Obj->GetUniqueID()),
-		Self, Other));
+		Self, Other);
 	// Add event to the pending array
 	StartedEvents.Emplace(Event);
 }
@@ -2,6 +2,7 @@
 // Author: Andrei Haidu (http://haidu.eu)
 
 #include "Events/SLGraspEventHandler.h"
+#include "Events/SLEventPool.h"
 #include "SLEntitiesManager.h"
 #include "SLManipulatorListener.h"
 
@@ -72,10 +73,10 @@ void FSLGraspEventHandler::Finish(float EndTime, bool bForced)
 void FSLGraspEventHandler::AddNewEvent(const FSLEntity& Self, const FSLEntity& Other, float StartTime, const FString& InType)
 {
 	// Start a semantic grasp event
-	TSharedPtr<FSLGraspEvent> Event = MakeShareable(new FSLGraspEvent(
-		FIds::NewGuidInBase64Url(), StartTime,
+	TSharedPtr<FSLGraspEvent> Event = FSLEventPool::GetInstance()->NewEvent<FSLGraspEvent>(
+		StartTime,
 		FIds::PairEncodeCantor(Self.Obj->GetUniqueID(), Other.Obj->GetUniqueID()),
-		Self, Other, InType));
+		Self, Other, InType);
 	// Add event to the pending array
 	StartedEvents.Emplace(Event);
 }
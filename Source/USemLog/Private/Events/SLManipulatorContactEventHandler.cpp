@@ -2,6 +2,7 @@
 // Author: Andrei Haidu (http://haidu.eu)
 
 #include "Events/SLManipulatorContactEventHandler.h"
+#include "Events/SLEventPool.h"
 #include "SLManipulatorOverlapSphere.h"
 #include "SLManipulatorListener.h"
 
@@ -64,10 +65,10 @@ void FSLManipulatorContactEventHandler::Finish(float EndTime, bool bForced)
 void FSLManipulatorContactEventHandler::AddNewEvent(const FSLContactResult& InResult)
 {
 	// Start a semantic contact event
-	TSharedPtr<FSLContactEvent> ContactEvent = MakeShareable(new FSLContactEvent(
-		FIds::NewGuidInBase64Url(), InResult.Time,
+	TSharedPtr<FSLContactEvent> ContactEvent = FSLEventPool::GetInstance()->NewEvent<FSLContactEvent>(
+		InResult.Time,
 		FIds::PairEncodeCantor(InResult.Self.Obj->GetUniqueID(), InResult.Other.Obj->GetUniqueID()),
-		InResult.Self, InResult.Other));
+		InResult.Self, InResult.Other);
 	// Add event to the pending contacts array
 	StartedEvents.Emplace(ContactEvent);
 }
@@ -2,6 +2,7 @@
 // Author: Andrei Haidu (http://haidu.eu)
 
 #include "Events/SLPickAndPlaceEventsHandler.h"
+#include "Events/SLEventPool.h"
 #include "SLEntitiesManager.h"
 #include "SLPickAndPlaceListener.h"
 
@@ -79,10 +80,10 @@ void FSLPickAndPlaceEventsHandler::OnSLSlide(const FSLEntity& Self, AActor* Othe
 {
 	if(FSLEntity* OtherItem = FSLEntitiesManager::GetInstance()->GetEntityPtr(Other))
 	{
-		OnSemanticEvent.ExecuteIfBound(MakeShareable(new FSLSlideEvent(
-			FIds::NewGuidInBase64Url(), StartTime, EndTime,
+		OnSemanticEvent.ExecuteIfBound(FSLEventPool::GetInstance()->NewEvent<FSLSlideEvent>(
+			StartTime, EndTime,
 			FIds::PairEncodeCantor(Self.Obj->GetUniqueID(), Other->GetUniqueID()),
-			Self, *OtherItem)));
+			Self, *OtherItem));
 	}
 }
 
@@ -91,10 +92,10 @@ void FSLPickAndPlaceEventsHandler::OnSLPickUp(const FSLEntity& Self, AActor* Oth
 {
 	if(FSLEntity* OtherItem = FSLEntitiesManager::GetInstance()->GetEntityPtr(Other))
 	{
-		OnSemanticEvent.ExecuteIfBound(MakeShareable(new FSLPickUpEvent(
-			FIds::NewGuidInBase64Url(), StartTime, EndTime,
+		OnSemanticEvent.ExecuteIfBound(FSLEventPool::GetInstance()->NewEvent<FSLPickUpEvent>(
+			StartTime, EndTime,
 			FIds::PairEncodeCantor(Self.Obj->GetUniqueID(), Other->GetUniqueID()),
-			Self, *OtherItem)));
+			Self, *OtherItem));
 	}
 }
 
@@ -103,10 +104,10 @@ void FSLPickAndPlaceEventsHandler::OnSLTransport(const FSLEntity& Self, AActor*
 {
 	if(FSLEntity* OtherItem = FSLEntitiesManager::GetInstance()->GetEntityPtr(Other))
 	{
-		OnSemanticEvent.ExecuteIfBound(MakeShareable(new FSLTransportEvent(
-			FIds::NewGuidInBase64Url(), StartTime, EndTime,
+		OnSemanticEvent.ExecuteIfBound(FSLEventPool::GetInstance()->NewEvent<FSLTransportEvent>(
+			StartTime, EndTime,
 			FIds::PairEncodeCantor(Self.Obj->GetUniqueID(), Other->GetUniqueID()),
-			Self, *OtherItem)));
+			Self, *OtherItem));
 	}
 }
 
@@ -115,9 +116,9 @@ void FSLPickAndPlaceEventsHandler::OnSLPutDown(const FSLEntity& Self, AActor* Ot
 {
 	if(FSLEntity* OtherItem = FSLEntitiesManager::GetInstance()->GetEntityPtr(Other))
 	{
-		OnSemanticEvent.ExecuteIfBound(MakeShareable(new FSLPutDownEvent(
-			FIds::NewGuidInBase64Url(), StartTime, EndTime,
+		OnSemanticEvent.ExecuteIfBound(FSLEventPool::GetInstance()->NewEvent<FSLPutDownEvent>(
+			StartTime, EndTime,
 			FIds::PairEncodeCantor(Self.Obj->GetUniqueID(), Other->GetUniqueID()),
-			Self, *OtherItem)));
+			Self, *OtherItem));
 	}
 }
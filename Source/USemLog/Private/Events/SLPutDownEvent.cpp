@@ -40,14 +40,10 @@ void FSLPutDownEvent::AddToOwlDoc(FSLOwlDoc* OutDoc)
 	// we cannot use the safer dynamic_cast because RTTI is not enabled by default
 	// if (FOwlEvents* EventsDoc = dynamic_cast<FOwlEvents*>(OutDoc))
 	FSLOwlExperiment* EventsDoc = static_cast<FSLOwlExperiment*>(OutDoc);
-	EventsDoc->AddTimepointIndividual(
-		Start, FSLOwlExperimentStatics::CreateTimepointIndividual("log", Start));
-	EventsDoc->AddTimepointIndividual(
-		End, FSLOwlExperimentStatics::CreateTimepointIndividual("log", End));
-	EventsDoc->AddObjectIndividual(Item.Obj,
-		FSLOwlExperimentStatics::CreateObjectIndividual("log", Item.Id, Manipulator.Class));
-	EventsDoc->AddObjectIndividual(Manipulator.Obj,
-		FSLOwlExperimentStatics::CreateObjectIndividual("log", Manipulator.Id, Manipulator.Class));
+	EventsDoc->AddTimepointIndividual("log", Start);
+	EventsDoc->AddTimepointIndividual("log", End);
+	EventsDoc->AddObjectIndividual("log", Item.Id, Item.Class);
+	EventsDoc->AddObjectIndividual("log", Manipulator.Id, Manipulator.Class);
 	OutDoc->AddIndividual(ToOwlNode());
 }
 
@@ -70,4 +66,17 @@ FString FSLPutDownEvent::ToString() const
 	return FString::Printf(TEXT("Item:[%s] Manipulator:[%s] PairId:%lld"),
 		*Item.ToString(), *Manipulator.ToString(), PairId);
 }
+
+// Get the event type name
+FString FSLPutDownEvent::TypeName() const
+{
+	return TEXT("PutDown");
+}
+
+// Get the ids of the participating entities
+void FSLPutDownEvent::GetParticipantIds(TArray<FString>& OutIds) const
+{
+	OutIds.Add(Manipulator.Id);
+	OutIds.Add(Item.Id);
+}
 /* End ISLEvent interface */
\ No newline at end of file
@@ -2,6 +2,7 @@
 // Author: Andrei Haidu (http://haidu.eu)
 
 #include "Events/SLReachEventHandler.h"
+#include "Events/SLEventPool.h"
 #include "SLEntitiesManager.h"
 #include "SLReachListener.h"
 
@@ -74,16 +75,16 @@ void FSLReachEventHandler::OnSLPreAndReachEvent(const FSLEntity& Self, UObject*
 		const uint64 PairID =FIds::PairEncodeCantor(Self.Obj->GetUniqueID(), OtherItem->Obj->GetUniqueID());
 		if(ReachEndTime - ReachStartTime > ReachEventMin)
 		{
-			OnSemanticEvent.ExecuteIfBound(MakeShareable(new FSLReachEvent(
-				FIds::NewGuidInBase64Url(), ReachStartTime, ReachEndTime,
-				PairID,Self, *OtherItem)));
+			OnSemanticEvent.ExecuteIfBound(FSLEventPool::GetInstance()->NewEvent<FSLReachEvent>(
+				ReachStartTime, ReachEndTime,
+				PairID,Self, *OtherItem));
 		}
 
 		if(PreGraspEndTime - ReachEndTime > PreGraspPositioningEventMin)
 		{
-			OnSemanticEvent.ExecuteIfBound(MakeShareable(new FSLPreGraspPositioningEvent(
-				FIds::NewGuidInBase64Url(), ReachEndTime, PreGraspEndTime,
-				PairID,Self, *OtherItem)));
+			OnSemanticEvent.ExecuteIfBound(FSLEventPool::GetInstance()->NewEvent<FSLPreGraspPositioningEvent>(
+				ReachEndTime, PreGraspEndTime,
+				PairID,Self, *OtherItem));
 		}
 	}
 }
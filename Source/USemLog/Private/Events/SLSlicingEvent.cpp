@@ -50,20 +50,14 @@ void FSLSlicingEvent::AddToOwlDoc(FSLOwlDoc* OutDoc)
 	// we cannot use the safer dynamic_cast because RTTI is not enabled by default
 	// if (FOwlEvents* EventsDoc = dynamic_cast<FOwlEvents*>(OutDoc))
 	FSLOwlExperiment* EventsDoc = static_cast<FSLOwlExperiment*>(OutDoc);
-	EventsDoc->AddTimepointIndividual(
-		Start, FSLOwlExperimentStatics::CreateTimepointIndividual("log", Start));
-	EventsDoc->AddTimepointIndividual(
-		End, FSLOwlExperimentStatics::CreateTimepointIndividual("log", End));
-	EventsDoc->AddObjectIndividual(PerformedBy.Obj,
-		FSLOwlExperimentStatics::CreateObjectIndividual("log", PerformedBy.Id, PerformedBy.Class));
-	EventsDoc->AddObjectIndividual(DeviceUsed.Obj,
-		FSLOwlExperimentStatics::CreateObjectIndividual("log", DeviceUsed.Id, DeviceUsed.Class));
-	EventsDoc->AddObjectIndividual(ObjectActedOn.Obj,
-		FSLOwlExperimentStatics::CreateObjectIndividual("log", ObjectActedOn.Id, ObjectActedOn.Class));
+	EventsDoc->AddTimepointIndividual("log", Start);
+	EventsDoc->AddTimepointIndividual("log", End);
+	EventsDoc->AddObjectIndividual("log", PerformedBy.Id, PerformedBy.Class);
+	EventsDoc->AddObjectIndividual("log", DeviceUsed.Id, DeviceUsed.Class);
+	EventsDoc->AddObjectIndividual("log", ObjectActedOn.Id, ObjectActedOn.Class);
 	if (bTaskSuccessful)
 	{
-	EventsDoc->AddObjectIndividual(OutputsCreated.Obj,
-		FSLOwlExperimentStatics::CreateObjectIndividual("log", OutputsCreated.Id, OutputsCreated.Class));
+	EventsDoc->AddObjectIndividual("log", OutputsCreated.Id, OutputsCreated.Class);
 	}
 	OutDoc->AddIndividual(ToOwlNode());
 }
@@ -115,4 +109,31 @@ FString FSLSlicingEvent::ToString() const
 			*PerformedBy.ToString(), *DeviceUsed.ToString(), *ObjectActedOn.ToString(), PairId);
 	}
 }
+
+// Get the event type name
+FString FSLSlicingEvent::TypeName() const
+{
+	return TEXT("Slicing");
+}
+
+// Get the ids of the participating entities
+void FSLSlicingEvent::GetParticipantIds(TArray<FString>& OutIds) const
+{
+	if (!PerformedBy.Id.IsEmpty())
+	{
+		OutIds.Add(PerformedBy.Id);
+	}
+	if (!DeviceUsed.Id.IsEmpty())
+	{
+		OutIds.Add(DeviceUsed.Id);
+	}
+	if (!ObjectActedOn.Id.IsEmpty())
+	{
+		OutIds.Add(ObjectActedOn.Id);
+	}
+	if (!OutputsCreated.Id.IsEmpty())
+	{
+		OutIds.Add(OutputsCreated.Id);
+	}
+}
 /* End ISLEvent interface */
\ No newline at end of file
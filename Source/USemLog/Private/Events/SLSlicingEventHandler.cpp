@@ -2,6 +2,7 @@
 // Author: Andrei Haidu (http://haidu.eu)
 
 #include "Events/SLSlicingEventHandler.h"
+#include "Events/SLEventPool.h"
 #include "SLEntitiesManager.h"
 #include "Tags.h"
 #if SL_WITH_SLICING
@@ -77,10 +78,10 @@ void FSLSlicingEventHandler::Finish(float EndTime, bool bForced)
 void FSLSlicingEventHandler::AddNewEvent(const FSLEntity& PerformedBy, const FSLEntity& DeviceUsed, const FSLEntity& ObjectActedOn, float StartTime)
 {
 	// Start a semantic Slicing event
-	TSharedPtr<FSLSlicingEvent> Event = MakeShareable(new FSLSlicingEvent(
-		FIds::NewGuidInBase64Url(), StartTime, 
+	TSharedPtr<FSLSlicingEvent> Event = FSLEventPool::GetInstance()->NewEvent<FSLSlicingEvent>(
+		StartTime, 
 		FIds::PairEncodeCantor(PerformedBy.Obj->GetUniqueID(), ObjectActedOn.Obj->GetUniqueID()),
-		PerformedBy, DeviceUsed, ObjectActedOn));
+		PerformedBy, DeviceUsed, ObjectActedOn);
 	// Add event to the pending array
 	StartedEvents.Emplace(Event);
 }
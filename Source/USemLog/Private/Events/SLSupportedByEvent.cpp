@@ -40,14 +40,10 @@ void FSLSupportedByEvent::AddToOwlDoc(FSLOwlDoc* OutDoc)
 	// we cannot use the safer dynamic_cast because RTTI is not enabled by default
 	// if (FOwlEvents* EventsDoc = dynamic_cast<FOwlEvents*>(OutDoc))
 	FSLOwlExperiment* EventsDoc = static_cast<FSLOwlExperiment*>(OutDoc);
-	EventsDoc->AddTimepointIndividual(Start,
-		FSLOwlExperimentStatics::CreateTimepointIndividual("log", Start));
-	EventsDoc->AddTimepointIndividual(End,
-		FSLOwlExperimentStatics::CreateTimepointIndividual("log", End));
-	EventsDoc->AddObjectIndividual(SupportedItem.Obj,
-		 FSLOwlExperimentStatics::CreateObjectIndividual("log", SupportedItem.Id, SupportedItem.Class));
-	EventsDoc->AddObjectIndividual(SupportingItem.Obj,
-		FSLOwlExperimentStatics::CreateObjectIndividual("log", SupportingItem.Id, SupportingItem.Class));
+	EventsDoc->AddTimepointIndividual("log", Start);
+	EventsDoc->AddTimepointIndividual("log", End);
+	EventsDoc->AddObjectIndividual("log", SupportedItem.Id, SupportedItem.Class);
+	EventsDoc->AddObjectIndividual("log", SupportingItem.Id, SupportingItem.Class);
 	OutDoc->AddIndividual(ToOwlNode());
 }
 
@@ -70,4 +66,17 @@ FString FSLSupportedByEvent::ToString() const
 	return FString::Printf(TEXT("SupportedItem:[%s] SupportingItem:[%s] PairId:%lld"),
 		*SupportedItem.ToString(), *SupportingItem.ToString(), PairId);
 }
+
+// Get the event type name
+FString FSLSupportedByEvent::TypeName() const
+{
+	return TEXT("SupportedBy");
+}
+
+// Get the ids of the participating entities
+void FSLSupportedByEvent::GetParticipantIds(TArray<FString>& OutIds) const
+{
+	OutIds.Add(SupportedItem.Id);
+	OutIds.Add(SupportingItem.Id);
+}
 /* End ISLEvent interface */
\ No newline at end of file
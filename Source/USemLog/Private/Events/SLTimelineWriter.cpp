@@ -0,0 +1,432 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "Events/SLTimelineWriter.h"
+#include "Events/ISLEvent.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
+#include "Templates/UniquePtr.h"
+
+// File identifier and version
+static const uint32 SLTimelineMagic = 0x4c544c53; // SLTL
+static const uint32 SLTimelineVersion = 1;
+
+// Size of the file header (10 x 4 bytes)
+static const uint32 SLTimelineHeaderSize = 40;
+
+// Upper limit of the bucket table entries (num contexts x num buckets)
+static const int32 SLTimelineMaxBucketEntries = 1 << 20;
+
+// Viewer page, the data file name is written between the two parts
+static const char* SLTimelineViewerHead = R"SLTL(<!DOCTYPE html>
+<html>
+<head>
+<meta charset="utf-8">
+<title>SemLog timeline</title>
+<style>
+body { margin: 0; font: 12px sans-serif; background: #fafafa; overflow: hidden; }
+#bar { padding: 6px; border-bottom: 1px solid #ccc; background: #fff; }
+#hint { color: #888; }
+canvas { display: block; }
+#tip { position: fixed; display: none; background: #fff; border: 1px solid #888; padding: 4px 6px; pointer-events: none; white-space: nowrap; box-shadow: 1px 1px 3px #aaa; }
+</style>
+</head>
+<body>
+<div id="bar"><input type="file" id="file"> <span id="info"></span> <span id="hint">wheel: scroll rows, ctrl+wheel: zoom, drag: pan, double click: reset</span></div>
+<canvas id="cv"></canvas>
+<div id="tip"></div>
+<script>
+var DATA_FILE = ")SLTL";
+
+static const char* SLTimelineViewerTail = R"SLTL(";
+var LABEL_W = 240, ROW_H = 16, AXIS_H = 20;
+var cv = document.getElementById('cv'), g = cv.getContext('2d');
+var tip = document.getElementById('tip'), info = document.getElementById('info');
+var blob = null, tl = null, view = null, rowOff = 0, cache = {}, pending = {}, drag = null;
+
+// Read the header and the context index, the records are read later per visible window
+function load(b) {
+	blob = b; tl = null; cache = {}; pending = {};
+	b.slice(0, 40).arrayBuffer().then(function (h) {
+		var d = new DataView(h);
+		if (h.byteLength < 40 || d.getUint32(0, true) !== 0x4c544c53) { info.textContent = 'Not a timeline file'; return; }
+		return b.slice(0, d.getUint32(32, true)).arrayBuffer().then(parse);
+	});
+}
+
+function parse(buf) {
+	var d = new DataView(buf), dec = new TextDecoder();
+	var t = { start: d.getFloat32(8, true), end: d.getFloat32(12, true), dur: d.getFloat32(16, true),
+		nb: d.getUint32(20, true), nc: d.getUint32(24, true), ne: d.getUint32(28, true),
+		recOff: d.getUint32(32, true), strOff: d.getUint32(36, true), ctx: [] };
+	var p = 40;
+	for (var i = 0; i < t.nc; i++) {
+		var n = d.getUint32(p, true); p += 4;
+		var c = { name: dec.decode(new Uint8Array(buf, p, n)) }; p += n;
+		c.maxDur = d.getFloat32(p, true); c.first = d.getUint32(p + 4, true); c.num = d.getUint32(p + 8, true); p += 12;
+		c.bFirst = new Uint32Array(buf.slice(p, p + 4 * (t.nb + 1))); p += 4 * (t.nb + 1);
+		c.busy = new Float32Array(buf.slice(p, p + 4 * t.nb)); p += 4 * t.nb;
+		c.color = color(c.name.split(' - ')[0]);
+		t.ctx.push(c);
+	}
+	tl = t;
+	info.textContent = t.ne + ' events, ' + t.nc + ' rows, ' + (t.end - t.start).toFixed(3) + 's';
+	reset();
+}
+
+function color(type) {
+	var h = 0;
+	for (var i = 0; i < type.length; i++) { h = (h * 31 + type.charCodeAt(i)) % 360; }
+	return 'hsl(' + h + ',55%,55%)';
+}
+
+function reset() {
+	view = { t0: tl.start, t1: Math.max(tl.end, tl.start + 0.001) };
+	rowOff = 0;
+	draw();
+}
+
+function resize() {
+	cv.width = window.innerWidth;
+	cv.height = window.innerHeight - document.getElementById('bar').offsetHeight;
+	draw();
+}
+
+function toX(t) { return LABEL_W + (t - view.t0) / (view.t1 - view.t0) * (cv.width - LABEL_W); }
+function toT(x) { return view.t0 + (x - LABEL_W) / (cv.width - LABEL_W) * (view.t1 - view.t0); }
+function bucket(t) { return Math.max(0, Math.min(tl.nb - 1, Math.floor((t - tl.start) / tl.dur))); }
+
+// Record range of the context overlapping the visible window
+function range(c) {
+	return { from: c.bFirst[bucket(view.t0 - c.maxDur)], to: c.bFirst[bucket(view.t1) + 1] };
+}
+
+// Cached records of the visible window, missing ones are read from the file and drawn when available
+function records(ci) {
+	var c = tl.ctx[ci], r = range(c), e = cache[ci];
+	if (e && e.from <= r.from && e.to >= r.to) { return e; }
+	if (!pending[ci]) {
+		pending[ci] = true;
+		blob.slice(tl.recOff + (c.first + r.from) * 8, tl.recOff + (c.first + r.to) * 8).arrayBuffer().then(function (ab) {
+			delete pending[ci];
+			if (Object.keys(cache).length > 512) { cache = {}; }
+			cache[ci] = { from: r.from, to: r.to, r: new Float32Array(ab) };
+			draw();
+		});
+	}
+	return e;
+}
+
+function axis() {
+	var span = view.t1 - view.t0, step = Math.pow(10, Math.floor(Math.log10(span / 10)));
+	if (span / step > 50) { step *= 5; } else if (span / step > 20) { step *= 2; }
+	g.fillStyle = '#666'; g.strokeStyle = '#ddd';
+	for (var t = Math.ceil(view.t0 / step) * step; t <= view.t1; t += step) {
+		var x = Math.round(toX(t)) + 0.5;
+		g.beginPath(); g.moveTo(x, AXIS_H - 4); g.lineTo(x, cv.height); g.stroke();
+		g.fillText(t.toFixed(Math.max(0, -Math.floor(Math.log10(step)))) + 's', x + 2, 12);
+	}
+}
+
+function draw() {
+	g.clearRect(0, 0, cv.width, cv.height);
+	if (!tl) { return; }
+	var w = cv.width - LABEL_W, span = view.t1 - view.t0, bpx = tl.dur / span * w;
+	var rows = Math.floor((cv.height - AXIS_H) / ROW_H);
+	axis();
+	for (var r = 0; r < rows && rowOff + r < tl.nc; r++) {
+		var ci = rowOff + r, c = tl.ctx[ci], y = AXIS_H + r * ROW_H, rg = range(c);
+		if (r % 2) { g.fillStyle = 'rgba(0,0,0,0.04)'; g.fillRect(0, y, cv.width, ROW_H); }
+		g.fillStyle = '#333';
+		g.fillText(c.name.length > 38 ? c.name.substr(0, 37) + '\u2026' : c.name, 4, y + 12);
+		g.save(); g.beginPath(); g.rect(LABEL_W, y, w, ROW_H); g.clip();
+		g.fillStyle = c.color;
+		// Coarse zoom or dense rows use the bucket busy times
+		if (bpx < 4 || rg.to - rg.from > 2 * w) {
+			for (var b = bucket(view.t0); b <= bucket(view.t1); b++) {
+				if (c.busy[b] <= 0) { continue; }
+				g.globalAlpha = Math.min(1, 0.25 + 0.75 * c.busy[b] / tl.dur);
+				g.fillRect(toX(tl.start + b * tl.dur), y + 2, Math.max(1, bpx), ROW_H - 4);
+			}
+			g.globalAlpha = 1;
+		}
+		else {
+			var e = records(ci);
+			for (var i = 0; e && i < e.r.length; i += 2) {
+				var x0 = toX(e.r[i]), x1 = toX(e.r[i + 1]);
+				if (x1 >= LABEL_W && x0 <= cv.width) { g.fillRect(x0, y + 2, Math.max(1, x1 - x0), ROW_H - 4); }
+			}
+		}
+		g.restore();
+	}
+}
+
+// Show the event under the mouse (reads its id and tooltip from the strings table)
+function hover(ev) {
+	tip.style.display = 'none';
+	if (!tl || ev.offsetX < LABEL_W || ev.offsetY < AXIS_H) { return; }
+	var ci = rowOff + Math.floor((ev.offsetY - AXIS_H) / ROW_H), e = cache[ci];
+	if (ci >= tl.nc || !e) { return; }
+	var t = toT(ev.offsetX), eps = 2 * (view.t1 - view.t0) / (cv.width - LABEL_W);
+	for (var i = 0; i < e.r.length; i += 2) {
+		if (e.r[i] - eps <= t && t <= e.r[i + 1] + eps) {
+			var idx = tl.ctx[ci].first + e.from + i / 2, s = e.r[i], en = e.r[i + 1];
+			blob.slice(tl.strOff + idx * 4, tl.strOff + idx * 4 + 8).arrayBuffer().then(function (ob) {
+				var o = new Uint32Array(ob), base = tl.strOff + (tl.ne + 1) * 4;
+				return blob.slice(base + o[0], base + o[1]).text();
+			}).then(function (text) {
+				var parts = text.split('\t'), vals = [], m, re = /'([^']*)'/g;
+				while ((m = re.exec(parts[1] || '')) !== null) { vals.push(m[1]); }
+				var html = '<b>' + (en - s).toFixed(3) + 's</b> (' + s.toFixed(3) + 's - ' + en.toFixed(3) + 's)<br>' + parts[0];
+				for (var k = 0; k + 1 < vals.length; k += 2) { html += '<br><b>' + vals[k] + ':</b> ' + vals[k + 1]; }
+				tip.innerHTML = html;
+				tip.style.left = (ev.clientX + 12) + 'px'; tip.style.top = (ev.clientY + 12) + 'px';
+				tip.style.display = 'block';
+			});
+			return;
+		}
+	}
+}
+
+cv.addEventListener('wheel', function (ev) {
+	if (!tl) { return; }
+	ev.preventDefault();
+	if (ev.ctrlKey) {
+		var f = ev.deltaY > 0 ? 1.25 : 0.8, tm = toT(Math.max(ev.offsetX, LABEL_W));
+		view = { t0: tm - (tm - view.t0) * f, t1: tm + (view.t1 - tm) * f };
+	}
+	else {
+		rowOff = Math.max(0, Math.min(tl.nc - 1, rowOff + (ev.deltaY > 0 ? 3 : -3)));
+	}
+	draw();
+}, { passive: false });
+cv.addEventListener('mousedown', function (ev) { drag = { x: ev.offsetX, t0: view && view.t0, t1: view && view.t1 }; });
+window.addEventListener('mouseup', function () { drag = null; });
+cv.addEventListener('mousemove', function (ev) {
+	if (drag && tl) {
+		var dt = (drag.x - ev.offsetX) / (cv.width - LABEL_W) * (drag.t1 - drag.t0);
+		view = { t0: drag.t0 + dt, t1: drag.t1 + dt };
+		draw();
+	}
+	else { hover(ev); }
+});
+cv.addEventListener('dblclick', function () { if (tl) { reset(); } });
+window.addEventListener('resize', resize);
+document.getElementById('file').addEventListener('change', function (ev) { if (ev.target.files.length) { load(ev.target.files[0]); } });
+
+// Served pages load the data next to the page, local pages need the file to be selected
+fetch(DATA_FILE).then(function (r) { return r.ok ? r.blob() : Promise.reject(); })
+	.then(load).catch(function () { info.textContent = 'Select ' + DATA_FILE; });
+resize();
+</script>
+</body>
+</html>
+)SLTL";
+
+namespace
+{
+	// Event data of the timeline
+	struct FSLTimelineEvent
+	{
+		// Row index
+		int32 ContextIdx;
+
+		// Times
+		float Start;
+		float End;
+
+		// Id and tooltip
+		FString Text;
+	};
+
+	// Write the utf-8 string as length and bytes
+	void WriteUtf8(FArchive& Ar, const FString& Str)
+	{
+		FTCHARToUTF8 Converted(*Str);
+		uint32 Len = Converted.Length();
+		Ar << Len;
+		Ar.Serialize(const_cast<ANSICHAR*>(Converted.Get()), Len);
+	}
+}
+
+// Write the timeline data and the viewer page of the events
+bool FSLTimelineWriter::WriteTimelines(const TArray<TSharedPtr<ISLEvent>>& InEvents,
+	const FString& InLogDir,
+	const FString& InEpId)
+{
+	FString DirPath = FPaths::ProjectDir() + "/SemLog/" + InLogDir + "/";
+	FPaths::RemoveDuplicateSlashes(DirPath);
+	const FString DataFileName = InEpId + TEXT("_TL.bin");
+	return WriteData(InEvents, DirPath + DataFileName)
+		&& WriteViewer(DirPath + InEpId + TEXT("_TL.html"), DataFileName);
+}
+
+// Write the timeline data file
+bool FSLTimelineWriter::WriteData(const TArray<TSharedPtr<ISLEvent>>& InEvents, const FString& FilePath)
+{
+	// Group the events by context
+	TMap<FString, int32> ContextToIdx;
+	TArray<FString> Contexts;
+	TArray<FSLTimelineEvent> Events;
+	Events.Reserve(InEvents.Num());
+	float MinTime = TNumericLimits<float>::Max();
+	float MaxTime = TNumericLimits<float>::Lowest();
+	for (const auto& Ev : InEvents)
+	{
+		if (!Ev.IsValid())
+		{
+			continue;
+		}
+		const FString Context = Ev->Context();
+		int32* IdxPtr = ContextToIdx.Find(Context);
+		const int32 ContextIdx = IdxPtr ? *IdxPtr : ContextToIdx.Add(Context, Contexts.Add(Context));
+		Events.Add({ ContextIdx, Ev->Start, FMath::Max(Ev->Start, Ev->End), Ev->Id + TEXT("\t") + Ev->Tooltip() });
+		MinTime = FMath::Min(MinTime, Ev->Start);
+		MaxTime = FMath::Max(MaxTime, Ev->End);
+	}
+	if (Events.Num() == 0)
+	{
+		MinTime = MaxTime = 0.f;
+	}
+
+	// Rows sorted by name, records sorted by row and start time
+	TArray<int32> ContextOrder;
+	for (int32 Idx = 0; Idx < Contexts.Num(); ++Idx)
+	{
+		ContextOrder.Add(Idx);
+	}
+	ContextOrder.Sort([&Contexts](int32 A, int32 B) { return Contexts[A] < Contexts[B]; });
+	TArray<int32> ContextRank;
+	ContextRank.SetNum(Contexts.Num());
+	for (int32 Rank = 0; Rank < ContextOrder.Num(); ++Rank)
+	{
+		ContextRank[ContextOrder[Rank]] = Rank;
+	}
+	for (FSLTimelineEvent& Event : Events)
+	{
+		Event.ContextIdx = ContextRank[Event.ContextIdx];
+	}
+	Events.StableSort([](const FSLTimelineEvent& A, const FSLTimelineEvent& B)
+	{
+		return A.ContextIdx != B.ContextIdx ? A.ContextIdx < B.ContextIdx : A.Start < B.Start;
+	});
+
+	// Buckets, about a few events per bucket, bounded by the table size
+	const int32 NumContexts = Contexts.Num();
+	const int32 NumEvents = Events.Num();
+	int32 NumBuckets = FMath::Clamp(
+		static_cast<int32>(FMath::RoundUpToPowerOfTwo(FMath::Max(1, 2 * NumEvents / FMath::Max(1, NumContexts)))), 16, 1024);
+	while (NumBuckets > 16 && NumContexts * NumBuckets > SLTimelineMaxBucketEntries)
+	{
+		NumBuckets /= 2;
+	}
+	const float BucketDuration = FMath::Max((MaxTime - MinTime) / NumBuckets, 0.001f);
+	auto GetBucket = [&](float Time)
+	{
+		return FMath::Clamp(FMath::FloorToInt((Time - MinTime) / BucketDuration), 0, NumBuckets - 1);
+	};
+
+	// Context index (rows, record ranges, bucket record offsets and busy times)
+	TArray<uint8> Index;
+	FMemoryWriter IndexWriter(Index);
+	int32 RecordIdx = 0;
+	for (int32 Rank = 0; Rank < NumContexts; ++Rank)
+	{
+		const uint32 FirstRecord = RecordIdx;
+		float MaxDuration = 0.f;
+		TArray<uint32> BucketFirst;
+		BucketFirst.SetNumZeroed(NumBuckets + 1);
+		TArray<float> BucketBusy;
+		BucketBusy.SetNumZeroed(NumBuckets);
+		for (; RecordIdx < NumEvents && Events[RecordIdx].ContextIdx == Rank; ++RecordIdx)
+		{
+			const FSLTimelineEvent& Event = Events[RecordIdx];
+			MaxDuration = FMath::Max(MaxDuration, Event.End - Event.Start);
+			BucketFirst[GetBucket(Event.Start) + 1]++;
+			for (int32 Bucket = GetBucket(Event.Start); Bucket <= GetBucket(Event.End); ++Bucket)
+			{
+				const float BucketStart = MinTime + Bucket * BucketDuration;
+				BucketBusy[Bucket] += FMath::Max(0.f,
+					FMath::Min(Event.End, BucketStart + BucketDuration) - FMath::Max(Event.Start, BucketStart));
+			}
+		}
+		// Counts to first record offsets (relative to the context first record)
+		for (int32 Bucket = 1; Bucket <= NumBuckets; ++Bucket)
+		{
+			BucketFirst[Bucket] += BucketFirst[Bucket - 1];
+		}
+		uint32 NumRecords = RecordIdx - FirstRecord;
+		uint32 First = FirstRecord;
+
+		WriteUtf8(IndexWriter, Contexts[ContextOrder[Rank]]);
+		IndexWriter << MaxDuration;
+		IndexWriter << First;
+		IndexWriter << NumRecords;
+		IndexWriter.Serialize(BucketFirst.GetData(), BucketFirst.Num() * sizeof(uint32));
+		IndexWriter.Serialize(BucketBusy.GetData(), BucketBusy.Num() * sizeof(float));
+	}
+
+	// Strings blob
+	TArray<uint32> StringOffsets;
+	StringOffsets.Reserve(NumEvents + 1);
+	TArray<uint8> Strings;
+	for (const FSLTimelineEvent& Event : Events)
+	{
+		StringOffsets.Add(Strings.Num());
+		FTCHARToUTF8 Converted(*Event.Text);
+		Strings.Append(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+	}
+	StringOffsets.Add(Strings.Num());
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!Writer)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Could not create %s.."), *FString(__func__), __LINE__, *FilePath);
+		return false;
+	}
+
+	// Header
+	uint32 Magic = SLTimelineMagic;
+	uint32 Version = SLTimelineVersion;
+	float Start = MinTime;
+	float End = MaxTime;
+	float Duration = BucketDuration;
+	uint32 NumBucketsOut = NumBuckets;
+	uint32 NumContextsOut = NumContexts;
+	uint32 NumEventsOut = NumEvents;
+	uint32 RecordsOffset = SLTimelineHeaderSize + Index.Num();
+	uint32 StringsOffset = RecordsOffset + NumEvents * 2 * sizeof(float);
+	*Writer << Magic << Version << Start << End << Duration << NumBucketsOut << NumContextsOut << NumEventsOut
+		<< RecordsOffset << StringsOffset;
+	Writer->Serialize(Index.GetData(), Index.Num());
+
+	// Records
+	for (FSLTimelineEvent& Event : Events)
+	{
+		*Writer << Event.Start << Event.End;
+	}
+
+	// Strings
+	Writer->Serialize(StringOffsets.GetData(), StringOffsets.Num() * sizeof(uint32));
+	Writer->Serialize(Strings.GetData(), Strings.Num());
+	return Writer->Close();
+}
+
+// Write the viewer page, it loads the given data file name
+bool FSLTimelineWriter::WriteViewer(const FString& FilePath, const FString& DataFileName)
+{
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!Writer)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Could not create %s.."), *FString(__func__), __LINE__, *FilePath);
+		return false;
+	}
+
+	// The page is written in parts, the data is read by the page itself
+	FTCHARToUTF8 FileName(*DataFileName.Replace(TEXT("\\"), TEXT("/")).Replace(TEXT("\""), TEXT("")));
+	Writer->Serialize(const_cast<char*>(SLTimelineViewerHead), FCStringAnsi::Strlen(SLTimelineViewerHead));
+	Writer->Serialize(const_cast<ANSICHAR*>(FileName.Get()), FileName.Length());
+	Writer->Serialize(const_cast<char*>(SLTimelineViewerTail), FCStringAnsi::Strlen(SLTimelineViewerTail));
+	return Writer->Close();
+}
@@ -9,10 +9,8 @@
 #include "EngineUtils.h"
 #include "Async.h"
 #include "HighResScreenshot.h"
-#include "ImageUtils.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/GameViewportClient.h"
-#include "FileHelper.h"
 #include "Components/StaticMeshComponent.h"
 #include "Materials/Material.h"
 #include "Materials/MaterialInstanceDynamic.h"
@@ -72,6 +70,9 @@ void USLMetaScanner::Init(const FString& InTaskId, FSLMetaScannerParams ScanPara
 			SaveLocallyFolderName = "/SemLog/" + InTaskId + "/3dscan/";
 		}
 
+		// Start the image compression workers
+		ImagePipeline.Init(ScanParams.NumImageWorkers, ScanParams.MaxInFlightImagesMB);
+
 		// If no view modes are available, add a default one
 		if(ViewModes.Num() == 0)
 		{
@@ -176,6 +177,9 @@ void USLMetaScanner::Finish()
 {
 	if (!bIsFinished && (bIsInit || bIsStarted))
 	{
+		// Wait for the pending images and scan entries
+		ImagePipeline.Shutdown();
+
 		bIsStarted = false;
 		bIsInit = false;
 		bIsFinished = true;
@@ -220,18 +224,11 @@ void USLMetaScanner::ScreenshotCB(int32 SizeX, int32 SizeY, const TArray<FColor>
 	//// Remove const-ness from array
 	//TArray<FColor>& BitmapRef = const_cast<TArray<FColor>&>(Bitmap)
 
-	// Compress image
-	TArray<uint8> CompressedBitmap;
-	FImageUtils::CompressImageArray(SizeX, SizeY, Bitmap, CompressedBitmap);
+	// Add image current scan data, the binary is added once the image pipeline compressed it
+	const int32 ImageIdx = ScanPoseData.Images.Emplace(GetViewModeName(ViewModes[CurrViewModeIdx]), TArray<uint8>());
 
-	// Add image current scan data
-	ScanPoseData.Images.Emplace(GetViewModeName(ViewModes[CurrViewModeIdx]), CompressedBitmap);
-
-	// Save the png locally
-	if (!SaveLocallyFolderName.IsEmpty())
-	{
-		SaveImageLocally(CompressedBitmap);
-	}
+	// Hand over a copy of the image, it is compressed (and saved locally) on the image workers
+	ScanPoseImages.Emplace(ImageIdx, ImagePipeline.AddImage(SizeX, SizeY, TArray<FColor>(Bitmap), GetLocalImagePath()));
 
 	// Item and camera in position, check for other view modes
 	if (SetupNextViewMode())
@@ -249,7 +246,7 @@ void USLMetaScanner::ScreenshotCB(int32 SizeX, int32 SizeY, const TArray<FColor>
 		// Check for next camera poses
 		if (GotoNextScanPose())
 		{
-			MetadataLoggerParent->AddScanPoseEntry(ScanPoseData);
+			AddScanPoseEntry();
 			ScanPoseData.Images.Empty();
 			ScanPoseData.CameraPose = CameraPoseActor->GetActorTransform(); //ScanPoses[CurrPoseIdx];
 
@@ -257,9 +254,9 @@ void USLMetaScanner::ScreenshotCB(int32 SizeX, int32 SizeY, const TArray<FColor>
 		}
 		else
 		{
-			MetadataLoggerParent->AddScanPoseEntry(ScanPoseData);
+			AddScanPoseEntry();
 			ScanPoseData.Images.Empty();
-			MetadataLoggerParent->FinishScanEntry();
+			ImagePipeline.AddOrderedTask([this]() { MetadataLoggerParent->FinishScanEntry(); });
 
 			if (SetupNextItem())
 			{
@@ -273,7 +270,10 @@ void USLMetaScanner::ScreenshotCB(int32 SizeX, int32 SizeY, const TArray<FColor>
 				// No other scan poses found, set next item and first camera scan pose
 				GotoFirstScanPose();
 
-				MetadataLoggerParent->StartScanEntry(ScanItems[CurrItemIdx].Value, SizeX, SizeY);
+				ImagePipeline.AddOrderedTask([this, Class = ScanItems[CurrItemIdx].Value, SizeX, SizeY]()
+				{
+					MetadataLoggerParent->StartScanEntry(Class, SizeX, SizeY);
+				});
 				ScanPoseData.CameraPose = CameraPoseActor->GetActorTransform(); //ScanPoses[CurrPoseIdx];
 
 				RequestScreenshot();
@@ -904,13 +904,31 @@ void USLMetaScanner::QuitEditor()
 #endif // WITH_EDITOR
 }
 
-// Save the compressed screenshot image locally
-void USLMetaScanner::SaveImageLocally(const TArray<uint8>& CompressedBitmap)
+// Path of the current image if it should be saved locally (empty otherwise)
+FString USLMetaScanner::GetLocalImagePath() const
 {
+	if (SaveLocallyFolderName.IsEmpty())
+	{
+		return FString();
+	}
 	FString ItemClassFolder = ScanItems[CurrItemIdx].Value + "_" + ViewModePostfix + "/";
 	FString Path = FPaths::ProjectDir() + SaveLocallyFolderName + ItemClassFolder + CurrScanName + ".png";
 	FPaths::RemoveDuplicateSlashes(Path);
-	FFileHelper::SaveArrayToFile(CompressedBitmap, *Path);
+	return Path;
+}
+
+// Add the scan pose data to the parent once its images are compressed
+void USLMetaScanner::AddScanPoseEntry()
+{
+	ImagePipeline.AddOrderedTask([this, Data = ScanPoseData, Images = MoveTemp(ScanPoseImages)]() mutable
+	{
+		for (auto& Img : Images)
+		{
+			Data.Images[Img.Key].Value = MoveTemp(Img.Value->CompressedBitmap);
+		}
+		MetadataLoggerParent->AddScanPoseEntry(Data);
+	});
+	ScanPoseImages.Empty();
 }
 
 // Output progress to terminal
@@ -130,8 +130,11 @@ void USLContactBox::Start()
 		{
 			StartSupportedByUpdateCheck();
 		}
+
+		// The contacts with the other contact shapes are computed by the broadphase (if active)
+		RegisterWithContactBroadphase();
 		
-		// Enable overlap events
+		// Enable overlap events (the shapes registered with the broadphase do not overlap each other)
 		SetGenerateOverlapEvents(true);
 
 		// Broadcast currently overlapping components
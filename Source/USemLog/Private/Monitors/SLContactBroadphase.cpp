@@ -0,0 +1,264 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "Monitors/SLContactBroadphase.h"
+#include "Monitors/SLContactShapeInterface.h"
+#include "Components/ShapeComponent.h"
+
+TSharedPtr<FSLContactBroadphase> FSLContactBroadphase::StaticInstance;
+
+// Constructor
+FSLContactBroadphase::FSLContactBroadphase() : bIsInit(false), World(nullptr) {}
+
+// Get singleton
+FSLContactBroadphase* FSLContactBroadphase::GetInstance()
+{
+	if (!StaticInstance.IsValid())
+	{
+		StaticInstance = MakeShareable(new FSLContactBroadphase());
+	}
+	return StaticInstance.Get();
+}
+
+// Delete instance
+void FSLContactBroadphase::DeleteInstance()
+{
+	StaticInstance.Reset();
+}
+
+// Init with the world, the shapes started afterwards will register themselves (their overlap events ignore the other registered shapes)
+void FSLContactBroadphase::Init(UWorld* InWorld)
+{
+	if (!bIsInit && InWorld)
+	{
+		World = InWorld;
+		bIsInit = true;
+	}
+}
+
+// Register the shape, returns false if the broadphase is not init
+bool FSLContactBroadphase::AddShape(ISLContactShapeInterface* InShape)
+{
+	if (!bIsInit || !InShape || !InShape->ShapeComponent)
+	{
+		return false;
+	}
+
+	if (ShapeToProxyIdx.Contains(InShape))
+	{
+		return true;
+	}
+
+	// The engine skips the overlaps between the registered shapes, their contacts are computed here
+	UShapeComponent* ShapeComp = InShape->ShapeComponent;
+	FSLBroadphaseProxy Proxy;
+	Proxy.Shape = InShape;
+	Proxy.Bounds = ShapeComp->Bounds.GetBox();
+	Proxy.PrevObjectType = ShapeComp->GetCollisionObjectType();
+	Proxy.PrevChannelResponse = ShapeComp->GetCollisionResponseToChannel(ShapeChannel);
+	ShapeComp->SetCollisionObjectType(ShapeChannel);
+	ShapeComp->SetCollisionResponseToChannel(ShapeChannel, ECR_Ignore);
+
+	const int32 ProxyIdx = Proxies.Add(Proxy);
+	ShapeToProxyIdx.Add(InShape, ProxyIdx);
+
+	// Appended at the end, it is moved to its place with the next sort
+	SortedProxies.Add(ProxyIdx);
+	return true;
+}
+
+// Unregister the shape, the active contacts of the shape are ended
+void FSLContactBroadphase::RemoveShape(ISLContactShapeInterface* InShape)
+{
+	int32 ProxyIdx;
+	if (!ShapeToProxyIdx.RemoveAndCopyValue(InShape, ProxyIdx))
+	{
+		return;
+	}
+
+	// End the active contacts of the shape
+	TArray<uint64> ShapePairs;
+	for (const uint64 PairKey : ActivePairs)
+	{
+		int32 IdxA, IdxB;
+		GetPairIndexes(PairKey, IdxA, IdxB);
+		if (IdxA == ProxyIdx || IdxB == ProxyIdx)
+		{
+			ShapePairs.Add(PairKey);
+		}
+	}
+	for (const uint64 PairKey : ShapePairs)
+	{
+		ActivePairs.Remove(PairKey);
+		EndPairContact(PairKey);
+	}
+
+	// Restore the collision settings of the shape
+	const FSLBroadphaseProxy& Proxy = Proxies[ProxyIdx];
+	if (UShapeComponent* ShapeComp = InShape->ShapeComponent)
+	{
+		ShapeComp->SetCollisionResponseToChannel(ShapeChannel, Proxy.PrevChannelResponse);
+		ShapeComp->SetCollisionObjectType(Proxy.PrevObjectType);
+	}
+
+	SortedProxies.Remove(ProxyIdx);
+	Proxies.RemoveAt(ProxyIdx);
+}
+
+/** Begin FTickableGameObject interface */
+// Called after ticking all actors, DeltaTime is the time passed since the last call.
+void FSLContactBroadphase::Tick(float DeltaTime)
+{
+	UpdateBounds();
+	SortProxies();
+
+	TSet<uint64> OverlappingPairs;
+	OverlappingPairs.Reserve(ActivePairs.Num());
+	SweepAndTestPairs(OverlappingPairs);
+
+	// Diff with the previous contacts, the ends are published first (a pair can not both begin and end)
+	TArray<uint64> EndedPairs;
+	for (const uint64 PairKey : ActivePairs)
+	{
+		if (!OverlappingPairs.Contains(PairKey))
+		{
+			EndedPairs.Add(PairKey);
+		}
+	}
+	TArray<uint64> BegunPairs;
+	for (const uint64 PairKey : OverlappingPairs)
+	{
+		if (!ActivePairs.Contains(PairKey))
+		{
+			BegunPairs.Add(PairKey);
+		}
+	}
+	ActivePairs = MoveTemp(OverlappingPairs);
+
+	for (const uint64 PairKey : EndedPairs)
+	{
+		EndPairContact(PairKey);
+	}
+	for (const uint64 PairKey : BegunPairs)
+	{
+		BeginPairContact(PairKey);
+	}
+}
+
+// Return if object is ready to be ticked
+bool FSLContactBroadphase::IsTickable() const
+{
+	// A single shape cannot be in contact
+	return bIsInit && Proxies.Num() > 1;
+}
+
+// Return the world the manager is ticked with (ticked by the world tick, also when the world is ticked manually)
+UWorld* FSLContactBroadphase::GetTickableGameObjectWorld() const
+{
+	return World;
+}
+
+// Return the stat id to use for this tickable
+TStatId FSLContactBroadphase::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(FSLContactBroadphase, STATGROUP_Tickables);
+}
+/** End FTickableGameObject interface */
+
+// Read the world bounds of the shapes
+void FSLContactBroadphase::UpdateBounds()
+{
+	for (auto& Proxy : Proxies)
+	{
+		// The bounds are updated by the engine with the transform, reading them is cheap
+		Proxy.Bounds = Proxy.Shape->ShapeComponent->Bounds.GetBox();
+	}
+}
+
+// Insertion sort the proxies on the bounds min X (the order changes little between ticks)
+void FSLContactBroadphase::SortProxies()
+{
+	for (int32 Idx = 1; Idx < SortedProxies.Num(); ++Idx)
+	{
+		const int32 ProxyIdx = SortedProxies[Idx];
+		const float MinX = Proxies[ProxyIdx].Bounds.Min.X;
+		int32 PrevIdx = Idx - 1;
+		while (PrevIdx >= 0 && Proxies[SortedProxies[PrevIdx]].Bounds.Min.X > MinX)
+		{
+			SortedProxies[PrevIdx + 1] = SortedProxies[PrevIdx];
+			--PrevIdx;
+		}
+		SortedProxies[PrevIdx + 1] = ProxyIdx;
+	}
+}
+
+// Sweep the sorted proxies, test the candidate pairs, output the overlapping pairs
+void FSLContactBroadphase::SweepAndTestPairs(TSet<uint64>& OutOverlappingPairs) const
+{
+	for (int32 Idx = 0; Idx < SortedProxies.Num(); ++Idx)
+	{
+		const FSLBroadphaseProxy& Proxy = Proxies[SortedProxies[Idx]];
+
+		// Only the following proxies starting before the end of the current one can overlap it on X
+		for (int32 OtherIdx = Idx + 1; OtherIdx < SortedProxies.Num(); ++OtherIdx)
+		{
+			const FSLBroadphaseProxy& OtherProxy = Proxies[SortedProxies[OtherIdx]];
+			if (OtherProxy.Bounds.Min.X > Proxy.Bounds.Max.X)
+			{
+				break;
+			}
+
+			// Check the other axes
+			if (Proxy.Bounds.Min.Y > OtherProxy.Bounds.Max.Y || Proxy.Bounds.Max.Y < OtherProxy.Bounds.Min.Y ||
+				Proxy.Bounds.Min.Z > OtherProxy.Bounds.Max.Z || Proxy.Bounds.Max.Z < OtherProxy.Bounds.Min.Z)
+			{
+				continue;
+			}
+
+			// Shapes of the same owner are ignored (same as the self overlaps)
+			if (Proxy.Shape->ShapeComponent->GetOwner() == OtherProxy.Shape->ShapeComponent->GetOwner())
+			{
+				continue;
+			}
+
+			// Narrow phase
+			if (ShapesOverlap(Proxy.Shape, OtherProxy.Shape))
+			{
+				OutOverlappingPairs.Add(GetPairKey(SortedProxies[Idx], SortedProxies[OtherIdx]));
+			}
+		}
+	}
+}
+
+// Check if the geometry of the two shapes overlaps
+bool FSLContactBroadphase::ShapesOverlap(ISLContactShapeInterface* A, ISLContactShapeInterface* B)
+{
+	UShapeComponent* ShapeA = A->ShapeComponent;
+	UShapeComponent* ShapeB = B->ShapeComponent;
+	return ShapeA->OverlapComponent(ShapeB->GetComponentLocation(), ShapeB->GetComponentQuat(), ShapeB->GetCollisionShape());
+}
+
+// Forward the contact begin of the pair to both shapes
+void FSLContactBroadphase::BeginPairContact(uint64 PairKey)
+{
+	int32 IdxA, IdxB;
+	GetPairIndexes(PairKey, IdxA, IdxB);
+	UShapeComponent* ShapeA = Proxies[IdxA].Shape->ShapeComponent;
+	UShapeComponent* ShapeB = Proxies[IdxB].Shape->ShapeComponent;
+
+	// Both shapes receive the begin, as with the overlap events (one of them is filtered out by the shape)
+	Proxies[IdxA].Shape->BeginOverlap(ShapeB->GetOwner(), ShapeB);
+	Proxies[IdxB].Shape->BeginOverlap(ShapeA->GetOwner(), ShapeA);
+}
+
+// Forward the contact end of the pair to both shapes
+void FSLContactBroadphase::EndPairContact(uint64 PairKey)
+{
+	int32 IdxA, IdxB;
+	GetPairIndexes(PairKey, IdxA, IdxB);
+	UShapeComponent* ShapeA = Proxies[IdxA].Shape->ShapeComponent;
+	UShapeComponent* ShapeB = Proxies[IdxB].Shape->ShapeComponent;
+
+	Proxies[IdxA].Shape->EndOverlap(ShapeB->GetOwner(), ShapeB);
+	Proxies[IdxB].Shape->EndOverlap(ShapeA->GetOwner(), ShapeA);
+}
@@ -134,8 +134,11 @@ void USLContactCapsule::Start()
 		{
 			StartSupportedByUpdateCheck();
 		}
+
+		// The contacts with the other contact shapes are computed by the broadphase (if active)
+		RegisterWithContactBroadphase();
 		
-		// Enable overlap events
+		// Enable overlap events (the shapes registered with the broadphase do not overlap each other)
 		SetGenerateOverlapEvents(true);
 
 		// Broadcast currently overlapping components
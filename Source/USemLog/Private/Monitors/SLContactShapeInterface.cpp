@@ -2,6 +2,9 @@
 // Author: Andrei Haidu (http://haidu.eu)
 
 #include "Monitors/SLContactShapeInterface.h"
+#include "Monitors/SLSupportedByManager.h"
+#include "Monitors/SLOverlapEndDebouncer.h"
+#include "Monitors/SLContactBroadphase.h"
 #include "SLEntitiesManager.h"
 #include "Components/MeshComponent.h"
 
@@ -14,16 +17,24 @@ void ISLContactShapeInterface::Finish(bool bForced)
 {
 	if (!bIsFinished && (bIsInit || bIsStarted))
 	{
-		// Publish any pending delayed events	
-		for(const auto& Ev : RecentlyEndedOverlapEvents)
-		{
-			PublishDelayedOverlapEndEvent(Ev);
-		}
-		RecentlyEndedOverlapEvents.Empty();
-		
 		// Disable overlap events
 		ShapeComponent->SetGenerateOverlapEvents(false);
 
+		// End the contacts computed by the broadphase (if registered)
+		if (FSLContactBroadphase::HasInstance())
+		{
+			FSLContactBroadphase::GetInstance()->RemoveShape(this);
+		}
+
+		// Publish any pending delayed events
+		FSLOverlapEndDebouncer::GetInstance()->FlushOwner(this);
+
+		// Remove any pending supported by candidates
+		if (bLogSupportedByEvents)
+		{
+			FSLSupportedByManager::GetInstance()->RemoveCandidates(this);
+		}
+
 		// Mark as finished
 		bIsStarted = false;
 		bIsInit = false;
@@ -38,7 +49,7 @@ bool ISLContactShapeInterface::InitInterface(UShapeComponent* InShapeComponent,
 	{
 		World = InWorld;
 		ShapeComponent = InShapeComponent;
-		DelayTimerDelegate.BindRaw(this, &ISLContactShapeInterface::DelayedOverlapEndEventCallback);
+		FSLOverlapEndDebouncer::GetInstance()->Init(InWorld);
 		return true;
 	}
 	return false;
@@ -59,89 +70,58 @@ void ISLContactShapeInterface::TriggerInitialOverlaps()
 	}
 }
 
-// Start checking for supported by events
+// Register the shape with the contact broadphase if it is active (the contacts with the other registered shapes are computed by it)
+void ISLContactShapeInterface::RegisterWithContactBroadphase()
+{
+	// The overlap events stay enabled for the components without a contact shape (walls, counters, unannotated props)
+	if (FSLContactBroadphase::HasInstance())
+	{
+		FSLContactBroadphase::GetInstance()->AddShape(this);
+	}
+}
+
+// Start checking for supported by events (registers the shape candidates with the supported by manager)
 void ISLContactShapeInterface::StartSupportedByUpdateCheck()
 {
 	if(World)
 	{
-		// Start updating the timer, will be paused if there are no candidates
-		SBTimerDelegate.BindRaw(this, &ISLContactShapeInterface::SupportedByUpdateCheckBegin);
-		World->GetTimerManager().SetTimer(SBTimerHandle, SBTimerDelegate, SBUpdateRate, true);
+		// The candidates of all shapes are evaluated in one batch by the manager
+		FSLSupportedByManager::GetInstance()->Init(World);
 	}
 }
 
-// Supported by update
+// Add supported by candidate to the manager
+void ISLContactShapeInterface::AddSupportedByCandidate(const FSLContactResult& InCandidate)
+{
+	FSLSupportedByManager::GetInstance()->AddCandidate(this, InCandidate);
+}
+
+// Called by the supported by manager when the candidate is in a supported by event
 // TODO is a supported by end update look required?
-void ISLContactShapeInterface::SupportedByUpdateCheckBegin()
+void ISLContactShapeInterface::OnSupportedByCandidateResolved(const FSLContactResult& InCandidate, bool bIsSelfSupported, float Time)
 {
-	// Check if candidates are in a supported by event
-	for (auto CandidateItr(SBCandidates.CreateIterator()); CandidateItr; ++CandidateItr)
+	if (bIsSelfSupported)
 	{
-		// Get relative vertical speed
-		const float RelVertSpeed = FMath::Abs(CandidateItr->SelfMeshComponent->GetComponentVelocity().Z -
-			CandidateItr->OtherMeshComponent->GetComponentVelocity().Z);
-		
-		// Check that the relative speed on Z between the two objects is smaller than the threshold
-		if (RelVertSpeed < SBMaxVertSpeed)
-		{
-			if (CandidateItr->bIsOtherASemanticOverlapArea)
-			{
-				// Check which is supporting and which is supported
-				// TODO simple height comparison for now
-				if (CandidateItr->SelfMeshComponent->GetComponentLocation().Z >
-					CandidateItr->OtherMeshComponent->GetComponentLocation().Z)
-				{
-					FSLEntity Supported = CandidateItr->Self;
-					FSLEntity Supporting = CandidateItr->Other;
-					const uint64 PairId = FIds::PairEncodeCantor(Supported.Obj->GetUniqueID(), Supporting.Obj->GetUniqueID());
-					OnBeginSLSupportedBy.Broadcast(Supported, Supporting, World->GetTimeSeconds(), PairId);
-					IsSupportedByPariIds.Add(PairId);
-				}
-				else
-				{
-					FSLEntity Supported = CandidateItr->Other;
-					FSLEntity Supporting = CandidateItr->Self;
-					const uint64 PairId = FIds::PairEncodeCantor(Supported.Obj->GetUniqueID(), Supporting.Obj->GetUniqueID());
-					OnBeginSLSupportedBy.Broadcast(Supported, Supporting, World->GetTimeSeconds(), PairId);
-					// Self item is supporting another, to not add it to the supportedby events id
-				}
-			}
-			else 
-			{
-				// Other can only support, self can only be supported
-				FSLEntity Supported = CandidateItr->Self;
-				FSLEntity Supporting = CandidateItr->Other;
-				const uint64 PairId = FIds::PairEncodeCantor(Supported.Obj->GetUniqueID(), Supporting.Obj->GetUniqueID());
-				OnBeginSLSupportedBy.Broadcast(Supported, Supporting, World->GetTimeSeconds(), PairId);
-				IsSupportedByPariIds.Add(PairId);
-			}
-			// Remove candidate, it is now part of a started event
-			CandidateItr.RemoveCurrent();
-		}
+		const FSLEntity& Supported = InCandidate.Self;
+		const FSLEntity& Supporting = InCandidate.Other;
+		const uint64 PairId = FIds::PairEncodeCantor(Supported.Obj->GetUniqueID(), Supporting.Obj->GetUniqueID());
+		OnBeginSLSupportedBy.Broadcast(Supported, Supporting, Time, PairId);
+		IsSupportedByPariIds.Add(PairId);
 	}
-	
-	// PauseGraspDetection timer
-	if (SBCandidates.Num() == 0)
+	else
 	{
-		World->GetTimerManager().PauseTimer(SBTimerHandle);
+		const FSLEntity& Supported = InCandidate.Other;
+		const FSLEntity& Supporting = InCandidate.Self;
+		const uint64 PairId = FIds::PairEncodeCantor(Supported.Obj->GetUniqueID(), Supporting.Obj->GetUniqueID());
+		OnBeginSLSupportedBy.Broadcast(Supported, Supporting, Time, PairId);
+		// Self item is supporting another, to not add it to the supportedby events id
 	}
 }
 
-// Remove candidate from array
+// Remove candidate from the manager
 bool ISLContactShapeInterface::CheckAndRemoveIfJustCandidate(UObject* InOther)
 {
-	// Use iterator to be able to remove the entry from the array
-	for (auto CandidateItr(SBCandidates.CreateIterator()); CandidateItr; ++CandidateItr)
-	{
-		if ((*CandidateItr).Other.Obj == InOther)
-		{
-			// Remove candidate from the list
-			CandidateItr.RemoveCurrent();
-
-			return true; // Found
-		}
-	}
-	return false; // Not in list
+	return FSLSupportedByManager::GetInstance()->RemoveCandidate(this, InOther);
 }
 
 // Called on overlap begin events
@@ -151,6 +131,21 @@ void ISLContactShapeInterface::OnOverlapBegin(UPrimitiveComponent* OverlappedCom
 	int32 OtherBodyIndex,
 	bool bFromSweep,
 	const FHitResult& SweepResult)
+{
+	BeginOverlap(OtherActor, OtherComp);
+}
+
+// Called on overlap end events
+void ISLContactShapeInterface::OnOverlapEnd(UPrimitiveComponent* OverlappedComp,
+	AActor* OtherActor,
+	UPrimitiveComponent* OtherComp,
+	int32 OtherBodyIndex)
+{
+	EndOverlap(OtherActor, OtherComp);
+}
+
+// Process the overlap begin (from the overlap events or the broadphase)
+void ISLContactShapeInterface::BeginOverlap(AActor* OtherActor, UPrimitiveComponent* OtherComp)
 {
 	// Ignore self overlaps (area with static mesh)
 	if (OtherActor == ShapeComponent->GetOwner())
@@ -190,12 +185,8 @@ void ISLContactShapeInterface::OnOverlapBegin(UPrimitiveComponent* OverlappedCom
 
 		if(bLogSupportedByEvents)
 		{
-			// Add candidate and re-start (if paused) timer cb
-			SBCandidates.Emplace(SemanticOverlapResult);
-			if(World->GetTimerManager().IsTimerPaused(SBTimerHandle))
-			{
-				World->GetTimerManager().UnPauseTimer(SBTimerHandle);
-			}
+			// Add candidate to the batched supported by evaluation
+			AddSupportedByCandidate(SemanticOverlapResult);
 		}
 	}
 	else if (ISLContactShapeInterface* OtherContactTrigger = Cast<ISLContactShapeInterface>(OtherComp))
@@ -216,22 +207,15 @@ void ISLContactShapeInterface::OnOverlapBegin(UPrimitiveComponent* OverlappedCom
 			
 			if(bLogSupportedByEvents)
 			{
-				// Add candidate and re-start (if paused) timer cb
-				SBCandidates.Emplace(SemanticOverlapResult);
-				if(World->GetTimerManager().IsTimerPaused(SBTimerHandle))
-				{
-					World->GetTimerManager().UnPauseTimer(SBTimerHandle);
-				}
+				// Add candidate to the batched supported by evaluation
+				AddSupportedByCandidate(SemanticOverlapResult);
 			}
 		}
 	}
 }
 
-// Called on overlap end events
-void ISLContactShapeInterface::OnOverlapEnd(UPrimitiveComponent* OverlappedComp,
-	AActor* OtherActor,
-	UPrimitiveComponent* OtherComp,
-	int32 OtherBodyIndex)
+// Process the overlap end (from the overlap events or the broadphase)
+void ISLContactShapeInterface::EndOverlap(AActor* OtherActor, UPrimitiveComponent* OtherComp)
 {
 	// Ignore self overlaps (area with static mesh)
 	if (OtherActor == ShapeComponent->GetOwner())
@@ -251,111 +235,64 @@ void ISLContactShapeInterface::OnOverlapEnd(UPrimitiveComponent* OverlappedComp,
 		}
 	}
 
-	// Delay publishing the overlap event in case of possible concatenations
-	RecentlyEndedOverlapEvents.Emplace(FSLOverlapEndEvent(OtherComp, OtherItem, World->GetTimeSeconds()));
-
 	// Delay publishing for a while, in case the new event is of the same type and should be concatenated
-	if(!World->GetTimerManager().IsTimerActive(DelayTimerHandle))
-	{
-		World->GetTimerManager().SetTimer(DelayTimerHandle, DelayTimerDelegate,MaxOverlapEventTimeGap*1.12f, false);
-	}
+	const FSLOverlapEndEvent Ev(OtherComp, OtherItem, World->GetTimeSeconds());
+	FSLOverlapEndDebouncer::GetInstance()->Schedule(this, GetOverlapPairId(OtherItem), Ev.Time, MaxOverlapEventTimeGap,
+		[this, Ev]() { PublishDelayedOverlapEndEvent(Ev); });
 }
 
-// Delayed call of sending the finished event to check for possible concatenation of jittering events of the same type
-void ISLContactShapeInterface::DelayedOverlapEndEventCallback()
+// Broadcast the delayed overlap end (called by the debouncer if no concatenation happened)
+void ISLContactShapeInterface::PublishDelayedOverlapEndEvent(const FSLOverlapEndEvent& Ev)
 {
-	// Curr time (keep very recently added events for another delay)
-	const float CurrTime = World->GetTimeSeconds();
-	
-	for (auto OverlapEndEvItr(RecentlyEndedOverlapEvents.CreateIterator()); OverlapEndEvItr; ++OverlapEndEvItr)
-	{
-		if(PublishDelayedOverlapEndEvent(*OverlapEndEvItr, CurrTime))
-		{
-			// Remove event from the pending list
-			OverlapEndEvItr.RemoveCurrent();
-		}
-	}
-
-	// There are very recent events still available, spin another delay callback to give them a chance to concatenate
-	if(RecentlyEndedOverlapEvents.Num() > 0)
+	// Check the type of the other component
+	if (UMeshComponent* OtherAsMeshComp = Cast<UMeshComponent>(Ev.OtherComp))
 	{
-		World->GetTimerManager().SetTimer(DelayTimerHandle, DelayTimerDelegate,MaxOverlapEventTimeGap * 1.12f, false);
+		// Broadcast end of semantic overlap event
+		OnEndSLContact.Broadcast(SemanticOwner, Ev.OtherItem, Ev.Time);
 	}
-}
-
-// Broadcast delayed overlaps, if curr time < 0, it guarantees a publish
-bool ISLContactShapeInterface::PublishDelayedOverlapEndEvent(const FSLOverlapEndEvent& Ev, float CurrTime)
-{
-	// Check if the event is old enough that it had it chance to be concatenated
-	// if CurrTime < 0, it forces publishing
-	if(CurrTime < 0 ||
-		CurrTime - Ev.Time > MaxOverlapEventTimeGap)
+	else if (ISLContactShapeInterface* OtherContactTrigger = Cast<ISLContactShapeInterface>(Ev.OtherComp))
 	{
-		// Check the type of the other component
-		if (UMeshComponent* OtherAsMeshComp = Cast<UMeshComponent>(Ev.OtherComp))
+		// If both areas are trigger areas, they will both concurrently trigger overlap events.
+		// To avoid this we consistently ignore one trigger event. This is chosen using
+		// the unique ids of the overlapping actors (GetUniqueID), we compare the two values 
+		// and consistently pick the event with a given (larger or smaller) value.
+		// This allows us to be in sync with the overlap end event 
+		// since the unique ids and the rule of ignoring the one event will not change
+		// Filter out one of the trigger areas (compare unique ids)
+		if (Ev.OtherItem.Obj->GetUniqueID() > SemanticOwner.Obj->GetUniqueID())
 		{
 			// Broadcast end of semantic overlap event
 			OnEndSLContact.Broadcast(SemanticOwner, Ev.OtherItem, Ev.Time);
 		}
-		else if (ISLContactShapeInterface* OtherContactTrigger = Cast<ISLContactShapeInterface>(Ev.OtherComp))
-		{
-			// If both areas are trigger areas, they will both concurrently trigger overlap events.
-			// To avoid this we consistently ignore one trigger event. This is chosen using
-			// the unique ids of the overlapping actors (GetUniqueID), we compare the two values 
-			// and consistently pick the event with a given (larger or smaller) value.
-			// This allows us to be in sync with the overlap end event 
-			// since the unique ids and the rule of ignoring the one event will not change
-			// Filter out one of the trigger areas (compare unique ids)
-			if (Ev.OtherItem.Obj->GetUniqueID() > SemanticOwner.Obj->GetUniqueID())
-			{
-				// Broadcast end of semantic overlap event
-				OnEndSLContact.Broadcast(SemanticOwner, Ev.OtherItem, Ev.Time);
-			}
-		}
+	}
 
-		if(bLogSupportedByEvents)
+	if(bLogSupportedByEvents)
+	{
+		// Ignore and remove if it is a candidate only
+		// (it cannot be a candidate and an event, e.g. contact ended with a candidate only)
+		if(!CheckAndRemoveIfJustCandidate(Ev.OtherItem.Obj))
 		{
-			// Ignore and remove if it is a candidate only
-			// (it cannot be a candidate and an event, e.g. contact ended with a candidate only)
-			if(!CheckAndRemoveIfJustCandidate(Ev.OtherItem.Obj))
+			const uint64 PairId1 = FIds::PairEncodeCantor(SemanticOwner.Obj->GetUniqueID(),Ev.OtherItem.Obj->GetUniqueID());
+			const uint64 PairId2 = FIds::PairEncodeCantor(Ev.OtherItem.Obj->GetUniqueID(), SemanticOwner.Obj->GetUniqueID());
+			OnEndSLSupportedBy.Broadcast(PairId1, PairId2, Ev.Time);
+			PrevSupportedByEndTime =  Ev.Time;
+			if(IsSupportedByPariIds.Remove(PairId1) == 0)
 			{
-				const uint64 PairId1 = FIds::PairEncodeCantor(SemanticOwner.Obj->GetUniqueID(),Ev.OtherItem.Obj->GetUniqueID());
-				const uint64 PairId2 = FIds::PairEncodeCantor(Ev.OtherItem.Obj->GetUniqueID(), SemanticOwner.Obj->GetUniqueID());
-				OnEndSLSupportedBy.Broadcast(PairId1, PairId2, Ev.Time);
-				PrevSupportedByEndTime =  Ev.Time;
-				if(IsSupportedByPariIds.Remove(PairId1) == 0)
-				{
-					IsSupportedByPariIds.Remove(PairId2);
-				}
+				IsSupportedByPariIds.Remove(PairId2);
 			}
 		}
-		return true;
 	}
-	return false;
 }
 
 // Skip publishing overlap event if it can be concatenated with the current event start
 bool ISLContactShapeInterface::SkipOverlapEndEventBroadcast(const FSLEntity& InItem, float StartTime)
 {
-	for (auto OverlapEndEvItr(RecentlyEndedOverlapEvents.CreateIterator()); OverlapEndEvItr; ++OverlapEndEvItr)
-	{
-		// Check if it is an event between the same entities
-		if(OverlapEndEvItr->OtherItem.EqualsFast(InItem))
-		{
-			// Check time difference
-			if(StartTime - OverlapEndEvItr->Time < MaxOverlapEventTimeGap)
-			{
-				OverlapEndEvItr.RemoveCurrent();
+	// Cancels the delayed overlap end if it is recent enough
+	return FSLOverlapEndDebouncer::GetInstance()->CancelIfRecent(this, GetOverlapPairId(InItem), StartTime);
+}
 
-				// Check if it was the last event, if so, pause the delay publisher
-				if(RecentlyEndedOverlapEvents.Num() == 0)
-				{
-					World->GetTimerManager().ClearTimer(DelayTimerHandle);
-				}
-				
-				return true;
-			}
-		}
-	}
-	return false;
+// Get the pair id of the owner and the other item (used as key for the delayed overlap ends)
+uint64 ISLContactShapeInterface::GetOverlapPairId(const FSLEntity& InItem) const
+{
+	return FIds::PairEncodeCantor(SemanticOwner.Obj->GetUniqueID(), InItem.Obj->GetUniqueID());
 }
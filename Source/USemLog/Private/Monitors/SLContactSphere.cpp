@@ -133,8 +133,11 @@ void USLContactSphere::Start()
 		{
 			StartSupportedByUpdateCheck();
 		}
+
+		// The contacts with the other contact shapes are computed by the broadphase (if active)
+		RegisterWithContactBroadphase();
 		
-		// Enable overlap events
+		// Enable overlap events (the shapes registered with the broadphase do not overlap each other)
 		SetGenerateOverlapEvents(true);
 
 		// Broadcast currently overlapping components
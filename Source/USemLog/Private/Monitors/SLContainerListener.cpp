@@ -4,12 +4,7 @@
 #include "Monitors/SLContainerListener.h"
 #include "SLManipulatorListener.h"
 #include "SLEntitiesManager.h"
-
-#include "PhysicsEngine/PhysicsConstraintActor.h"
-#include "PhysicsEngine/PhysicsConstraintComponent.h"
-
-// UUtils
-#include "Tags.h"
+#include "SLArticulationGraph.h"
 
 // Sets default values for this component's properties
 USLContainerListener::USLContainerListener()
@@ -47,6 +42,9 @@ bool USLContainerListener::Init()
 			FSLEntitiesManager::GetInstance()->Init(GetWorld());
 		}
 
+		// Init the articulation graph (attachments, constraints, containers)
+		FSLArticulationGraph::GetInstance()->Init(GetWorld());
+
 		// Check that the owner is part of the semantic entities
 		SemanticOwner = FSLEntitiesManager::GetInstance()->GetEntity(GetOwner());
 		if (!SemanticOwner.IsSet())
@@ -111,6 +109,7 @@ void USLContainerListener::OnSLGraspBegin(const FSLEntity& Self, AActor* Other,
 	CurrGraspedObj = Other;
 	GraspTime = Time;
 
+	// Only the distances at the grasp begin and end are compared, nothing is tracked during the grasp
 	SetContainersAndDistances();
 }
 
@@ -126,7 +125,6 @@ void USLContainerListener::OnSLGraspEnd(const FSLEntity& Self, AActor* Other, fl
 
 	if(CurrGraspedObj == Other)
 	{
-
 		// Publish close/open events
 		for(const auto Pair : ContainerToDistance)
 		{
@@ -156,54 +154,29 @@ void USLContainerListener::OnSLGraspEnd(const FSLEntity& Self, AActor* Other, fl
 // Search which container will be manipulated and save their current distance to the grasped item
 bool USLContainerListener::SetContainersAndDistances()
 {
-	// Get the outermost attachment parent of the actor
-	const auto GetOutermostAttachmentLambda = [](AActor* Actor)
-	{
-		if(AActor* OutermostAttachParent = Actor->GetAttachParentActor())
-		{
-			while(AActor* CurrAttParent = OutermostAttachParent->GetAttachParentActor())
-			{
-				OutermostAttachParent = CurrAttParent;
-			}
-			return OutermostAttachParent;
-		}
-		return (AActor*)nullptr;
-	};
+	FSLArticulationGraph* Graph = FSLArticulationGraph::GetInstance();
+
+	// The attachments of the grasped hierarchy might have changed since the last grasp (the rest of the world is not re-synced)
+	Graph->RefreshHierarchy(CurrGraspedObj);
 
-	// Set of all the other actors connected with constraints
+	// Set of all the other actors connected with constraints to the hierarchy of the grasped object
 	// (containers can only be linked through constrained actors, since otherwise they would be moving together)
-	TSet<AActor*> OtherConstraintActors;
-	// Get outermost attachment
-	if(AActor* OutermostAttachParent = GetOutermostAttachmentLambda(CurrGraspedObj))
-	{
-		GetAllConstraintsOtherActors(OutermostAttachParent, OtherConstraintActors);
-	}
-	else
-	{
-		GetAllConstraintsOtherActors(CurrGraspedObj, OtherConstraintActors);
-	}
+	const TSet<AActor*>& OtherConstraintActors = Graph->GetConstrainedActors(Graph->GetAttachmentRoot(CurrGraspedObj));
 
 	// Set of the found containers
 	TSet<AActor*> Containers;
 	// TODO recurse over all constraint chain links, we now stop at the second link
-	// Iterate the other constraint and search for containers
+	// Iterate the other constraint and search for containers starting with the outermost
 	for(const auto& OtherConstrAct : OtherConstraintActors)
 	{
-		// Search for containers starting with the outermost
-		if(AActor* OutermostAttachParent = GetOutermostAttachmentLambda(OtherConstrAct))
-		{
-			GetAllAttachedContainers(OutermostAttachParent, Containers);
-		}
-		else
-		{
-			GetAllAttachedContainers(OtherConstrAct, Containers);
-		}
+		Containers.Append(Graph->GetContainers(Graph->GetAttachmentRoot(OtherConstrAct)));
 	}
 
 	// Store the containers and their distances to the manipulator
 	for(const auto& C : Containers)
 	{
-		ContainerToDistance.Emplace(C, FVector::Distance(C->GetActorLocation(), CurrGraspedObj->GetActorLocation()));
+		const float Distance = FVector::Distance(C->GetActorLocation(), CurrGraspedObj->GetActorLocation());
+		ContainerToDistance.Emplace(C, Distance);
 		//UE_LOG(LogTemp, Warning, TEXT("%s::%d [%f] Container=%s; Dist=%f"),
 		//	*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds(), *C->GetName(), FVector::Distance(C->GetActorLocation(), CurrGraspedObj->GetActorLocation()));
 	}
@@ -221,59 +194,3 @@ void USLContainerListener::FinishActiveEvents()
 		OnSLGraspEnd(SemanticOwner, CurrGraspedObj, GetWorld()->GetTimeSeconds());
 	}	
 }
-
-// Iterate recursively attached constraints actors of parent, append other constrained actors to set
-void USLContainerListener::GetAllConstraintsOtherActors(AActor* Actor, TSet<AActor*>& OutOtherConstraintActors)
-{
-	if(APhysicsConstraintActor* AttAsPCA = Cast<APhysicsConstraintActor>(Actor))
-	{
-		if(AttAsPCA->GetConstraintComp()->ConstraintActor1 != Actor)
-		{
-			OutOtherConstraintActors.Emplace(AttAsPCA->GetConstraintComp()->ConstraintActor1);
-		}
-		else if(AttAsPCA->GetConstraintComp()->ConstraintActor2 != Actor)
-		{
-			OutOtherConstraintActors.Emplace(AttAsPCA->GetConstraintComp()->ConstraintActor2);
-		}
-	}
-
-	TArray<AActor*> AttActors;
-	Actor->GetAttachedActors(AttActors);
-	for(const auto& AttAct : AttActors)
-	{
-		if(APhysicsConstraintActor* AttAsPCA = Cast<APhysicsConstraintActor>(AttAct))
-		{
-			if(AttAsPCA->GetConstraintComp()->ConstraintActor1 != Actor)
-			{
-				OutOtherConstraintActors.Emplace(AttAsPCA->GetConstraintComp()->ConstraintActor1);
-			}
-			else if(AttAsPCA->GetConstraintComp()->ConstraintActor2 != Actor)
-			{
-				OutOtherConstraintActors.Emplace(AttAsPCA->GetConstraintComp()->ConstraintActor2);
-			}
-		}
-
-		GetAllConstraintsOtherActors(AttAct, OutOtherConstraintActors);
-	}
-}
-
-// Iterate recursively on the attached actors, and search for container type
-void USLContainerListener::GetAllAttachedContainers(AActor* Actor, TSet<AActor*>& OutContainers)
-{
-	if(FTags::HasKey(Actor, "SemLog", "Container"))
-	{
-		OutContainers.Emplace(Actor);
-	}
-
-	TArray<AActor*> AttActors;
-	Actor->GetAttachedActors(AttActors);
-	for(const auto& AttAct : AttActors)
-	{
-		if(FTags::HasKey(AttAct, "SemLog", "Container"))
-		{
-			OutContainers.Emplace(AttAct);
-		}
-
-		GetAllConstraintsOtherActors(AttAct, OutContainers);
-	}
-}
@@ -28,6 +28,7 @@ USLManipulatorListener::USLManipulatorListener()
 	InputAxisName = "LeftGrasp";
 	bIsNotSkeletal = false;
 	UnPauseTriggerVal = 0.5;
+	bIgnoreGraspInput = false;
 	
 #if WITH_EDITOR
 	// Default values
@@ -107,7 +108,12 @@ void USLManipulatorListener::Start()
 	if (!bIsStarted && bIsInit)
 	{
 		// Bind grasp trigger input and update check functions
-		if (APlayerController* PC = GetWorld()->GetFirstPlayerController())
+		if (bIgnoreGraspInput)
+		{
+			// Without the trigger the grasps are detected from the finger overlaps only
+			PauseGraspDetection(false);
+		}
+		else if (APlayerController* PC = GetWorld()->GetFirstPlayerController())
 		{
 			if (UInputComponent* IC = PC->InputComponent)
 			{
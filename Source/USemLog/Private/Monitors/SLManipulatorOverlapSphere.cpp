@@ -2,7 +2,7 @@
 // Author: Andrei Haidu (http://haidu.eu)
 
 #include "SLManipulatorOverlapSphere.h"
-#include "TimerManager.h"
+#include "Monitors/SLOverlapEndDebouncer.h"
 
 // Ctor
 USLManipulatorOverlapSphere::USLManipulatorOverlapSphere()
@@ -78,6 +78,9 @@ void USLManipulatorOverlapSphere::Start()
 			bGraspPaused ? SetColor(FColor::Yellow) : SetColor(FColor::Red);
 		}
 
+		// Delayed overlap ends are published by the debouncer
+		FSLOverlapEndDebouncer::GetInstance()->Init(GetWorld());
+
 		// Enable overlap events
 		SetGenerateOverlapEvents(true);
 
@@ -143,18 +146,7 @@ void USLManipulatorOverlapSphere::Finish(bool bForced)
 	if (!bIsFinished && (bIsInit || bIsStarted))
 	{
 		// Publish dangling recently finished events
-		for (const auto& EvItr : RecentlyEndedGraspOverlapEvents)
-		{
-			OnEndManipulatorGraspOverlap.Broadcast(EvItr.OtherActor);
-		}
-		RecentlyEndedGraspOverlapEvents.Empty();
-
-		// Publish dangling recently finished events
-		for (const auto& EvItr : RecentlyEndedContactOverlapEvents)
-		{
-			OnEndManipulatorContactOverlap.Broadcast(EvItr.OtherActor);
-		}
-		RecentlyEndedContactOverlapEvents.Empty();
+		FSLOverlapEndDebouncer::GetInstance()->FlushOwner(this);
 
 		SetGenerateOverlapEvents(false);
 		
@@ -377,16 +369,10 @@ void USLManipulatorOverlapSphere::OnGraspOverlapEnd(UPrimitiveComponent* Overlap
 	{
 		if (ActiveContacts.Remove(OtherActor) > 0)
 		{
-			// Grasp overlap ended ended
-			RecentlyEndedGraspOverlapEvents.Emplace(FSLManipulatorOverlapEndEvent(
-				OtherActor, GetWorld()->GetTimeSeconds()));
-			
 			// Delay publishing for a while, in case the new event is of the same type and should be concatenated
-			if(!GetWorld()->GetTimerManager().IsTimerActive(GraspDelayTimerHandle))
-			{
-				GetWorld()->GetTimerManager().SetTimer(GraspDelayTimerHandle, this, 
-					&USLManipulatorOverlapSphere::DelayedGraspOverlapEndEventCallback, MaxOverlapEventTimeGap*1.1f, false);
-			}
+			FSLOverlapEndDebouncer::GetInstance()->Schedule(this, OtherActor->GetUniqueID(), GetWorld()->GetTimeSeconds(),
+				MaxOverlapEventTimeGap, [this, OtherActor]() { OnEndManipulatorGraspOverlap.Broadcast(OtherActor); },
+				GraspDebounceChannel);
 		}
 
 		if (bVisualDebug)
@@ -399,56 +385,10 @@ void USLManipulatorOverlapSphere::OnGraspOverlapEnd(UPrimitiveComponent* Overlap
 	}
 }
 
-// Delayed call of sending the finished event to check for possible concatenation of jittering events of the same type
-void USLManipulatorOverlapSphere::DelayedGraspOverlapEndEventCallback()
-{
-	// Curr time (keep very recently added events for another delay)
-	const float CurrTime = GetWorld()->GetTimeSeconds();
-	
-	for (auto EvItr(RecentlyEndedGraspOverlapEvents.CreateIterator()); EvItr; ++EvItr)
-	{
-		// If enough time has passed, publish the event
-		if(CurrTime - EvItr->Time > MaxOverlapEventTimeGap)
-		{
-			// Broadcast delayed event
-			OnEndManipulatorGraspOverlap.Broadcast(EvItr->OtherActor);
-			
-			// Remove event from the pending list
-			EvItr.RemoveCurrent();
-		}
-	}
-
-	// There are very recent events still available, spin another delay callback to give them a chance to concatenate
-	if(RecentlyEndedGraspOverlapEvents.Num() > 0)
-	{
-		GetWorld()->GetTimerManager().SetTimer(GraspDelayTimerHandle, this, &USLManipulatorOverlapSphere::DelayedGraspOverlapEndEventCallback,
-			MaxOverlapEventTimeGap*1.1f, false);
-	}
-}
-
-// Check if this begin event happened right after the previous one ended, if so remove it from the array, and cancel publishing the begin event
+// Check if this begin event happened right after the previous one ended, if so cancel the pending end and skip publishing the begin event
 bool USLManipulatorOverlapSphere::SkipRecentGraspOverlapEndEventBroadcast(AActor* OtherActor, float StartTime)
 {
-	for (auto EvItr(RecentlyEndedGraspOverlapEvents.CreateIterator()); EvItr; ++EvItr)
-	{
-		// Check if it is an event between the same entities
-		if(EvItr->OtherActor == OtherActor)
-		{
-			// Check time difference
-			if(StartTime - EvItr->Time < MaxOverlapEventTimeGap)
-			{
-				EvItr.RemoveCurrent();
-
-				// Check if it was the last event, if so, pause the delay publisher
-				if(RecentlyEndedGraspOverlapEvents.Num() == 0)
-				{
-					GetWorld()->GetTimerManager().ClearTimer(GraspDelayTimerHandle);
-				}
-				return true;
-			}
-		}
-	}
-	return false;
+	return FSLOverlapEndDebouncer::GetInstance()->CancelIfRecent(this, OtherActor->GetUniqueID(), StartTime, GraspDebounceChannel);
 }
 
 
@@ -506,68 +446,16 @@ void USLManipulatorOverlapSphere::OnContactOverlapEnd(UPrimitiveComponent* Overl
 	if (OtherActor->IsA(AStaticMeshActor::StaticClass())
 		&& !IgnoreList.Contains(OtherActor))
 	{
-		// Contact overlap ended ended
-		RecentlyEndedContactOverlapEvents.Emplace(FSLManipulatorOverlapEndEvent(
-			OtherActor, GetWorld()->GetTimeSeconds()));
-		
 		// Delay publishing for a while, in case the new event is of the same type and should be concatenated
-		if(!GetWorld()->GetTimerManager().IsTimerActive(ContactDelayTimerHandle))
-		{
-			GetWorld()->GetTimerManager().SetTimer(ContactDelayTimerHandle, this, 
-				&USLManipulatorOverlapSphere::DelayedContactOverlapEndEventCallback, MaxOverlapEventTimeGap*1.1f, false);
-		}
-	}
-}
-
-// Delayed call of sending the finished event to check for possible concatenation of jittering events of the same type
-void USLManipulatorOverlapSphere::DelayedContactOverlapEndEventCallback()
-{
-	// Curr time (keep very recently added events for another delay)
-	const float CurrTime = GetWorld()->GetTimeSeconds();
-	
-	for (auto EvItr(RecentlyEndedContactOverlapEvents.CreateIterator()); EvItr; ++EvItr)
-	{
-		// If enough time has passed, publish the event
-		if(CurrTime - EvItr->Time > MaxOverlapEventTimeGap)
-		{
-			// Broadcast delayed event
-			OnEndManipulatorContactOverlap.Broadcast(EvItr->OtherActor);
-			
-			// Remove event from the pending list
-			EvItr.RemoveCurrent();
-		}
-	}
-
-	// There are very recent events still available, spin another delay callback to give them a chance to concatenate
-	if(RecentlyEndedContactOverlapEvents.Num() > 0)
-	{
-		GetWorld()->GetTimerManager().SetTimer(ContactDelayTimerHandle, this, &USLManipulatorOverlapSphere::DelayedContactOverlapEndEventCallback,
-			MaxOverlapEventTimeGap*1.1f, false);
+		FSLOverlapEndDebouncer::GetInstance()->Schedule(this, OtherActor->GetUniqueID(), GetWorld()->GetTimeSeconds(),
+			MaxOverlapEventTimeGap, [this, OtherActor]() { OnEndManipulatorContactOverlap.Broadcast(OtherActor); },
+			ContactDebounceChannel);
 	}
 }
 
 // Check if this begin event happened right after the previous one ended
-// if so remove it from the array, and cancel publishing the begin event
+// if so cancel the pending end and skip publishing the begin event
 bool USLManipulatorOverlapSphere::SkipRecentContactOverlapEndEventBroadcast(AActor* OtherActor, float StartTime)
 {
-	for (auto EvItr(RecentlyEndedContactOverlapEvents.CreateIterator()); EvItr; ++EvItr)
-	{
-		// Check if it is an event between the same entities
-		if(EvItr->OtherActor == OtherActor)
-		{
-			// Check time difference
-			if(StartTime - EvItr->Time < MaxOverlapEventTimeGap)
-			{
-				EvItr.RemoveCurrent();
-
-				// Check if it was the last event, if so, pause the delay publisher
-				if(RecentlyEndedContactOverlapEvents.Num() == 0)
-				{
-					GetWorld()->GetTimerManager().ClearTimer(ContactDelayTimerHandle);
-				}
-				return true;
-			}
-		}
-	}
-	return false;
+	return FSLOverlapEndDebouncer::GetInstance()->CancelIfRecent(this, OtherActor->GetUniqueID(), StartTime, ContactDebounceChannel);
 }
@@ -0,0 +1,138 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "Monitors/SLMotionHistory.h"
+
+// Ctor
+FSLMotionHistory::FSLMotionHistory(int32 InCapacity, float InMaxDuration) :
+	Capacity(FMath::Max(InCapacity, 1)), MaxDuration(InMaxDuration), OldestSeq(0), NextSeq(0)
+{
+	Times.SetNumZeroed(Capacity);
+	Locations.SetNumZeroed(Capacity);
+	MaxHeightQueue.Seqs.SetNumZeroed(Capacity);
+	MinHeightQueue.Seqs.SetNumZeroed(Capacity);
+}
+
+// Remove all samples
+void FSLMotionHistory::Reset()
+{
+	OldestSeq = NextSeq;
+	MaxHeightQueue.Head = MaxHeightQueue.Count = 0;
+	MinHeightQueue.Head = MinHeightQueue.Count = 0;
+}
+
+// Add the newest sample, samples older than the max duration are dropped
+void FSLMotionHistory::Add(float Time, const FVector& Location)
+{
+	// Buffer full, overwrite the oldest sample
+	if (Num() == Capacity)
+	{
+		++OldestSeq;
+	}
+
+	const int32 Slot = ToSlot(NextSeq);
+	Times[Slot] = Time;
+	Locations[Slot] = Location;
+	++NextSeq;
+
+	// Drop the expired samples (the newest is always kept)
+	while (Num() > 1 && Time - Times[ToSlot(OldestSeq)] > MaxDuration)
+	{
+		++OldestSeq;
+	}
+
+	TrimQueue(MaxHeightQueue);
+	TrimQueue(MinHeightQueue);
+	PushToQueue(MaxHeightQueue, NextSeq - 1, true);
+	PushToQueue(MinHeightQueue, NextSeq - 1, false);
+}
+
+// Index of the first sample with the time equal or later than the given one (Num() if there is none)
+int32 FSLMotionHistory::FindFirstSince(float Time) const
+{
+	int32 Low = 0;
+	int32 High = Num();
+	while (Low < High)
+	{
+		const int32 Mid = Low + (High - Low) / 2;
+		if (GetTime(Mid) < Time)
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+	return Low;
+}
+
+// Max height of the samples from the index to the newest one (the index of the max is returned as well)
+float FSLMotionHistory::GetMaxHeightSince(int32 Idx, int32* OutMaxIdx) const
+{
+	const int64 Seq = FindInQueue(MaxHeightQueue, OldestSeq + FMath::Clamp(Idx, 0, Num() - 1));
+	if (OutMaxIdx)
+	{
+		*OutMaxIdx = int32(Seq - OldestSeq);
+	}
+	return Locations[ToSlot(Seq)].Z;
+}
+
+// Min height of the samples from the index to the newest one (the index of the min is returned as well)
+float FSLMotionHistory::GetMinHeightSince(int32 Idx, int32* OutMinIdx) const
+{
+	const int64 Seq = FindInQueue(MinHeightQueue, OldestSeq + FMath::Clamp(Idx, 0, Num() - 1));
+	if (OutMinIdx)
+	{
+		*OutMinIdx = int32(Seq - OldestSeq);
+	}
+	return Locations[ToSlot(Seq)].Z;
+}
+
+// Push the newest sample into the queue, removes the samples which can no longer be the extreme (bMax for max heights)
+void FSLMotionHistory::PushToQueue(FSLHeightQueue& Queue, int64 Seq, bool bMax)
+{
+	const float Z = Locations[ToSlot(Seq)].Z;
+	while (Queue.Count > 0)
+	{
+		const float BackZ = Locations[ToSlot(Queue.Get(Queue.Count - 1))].Z;
+		if (bMax ? BackZ > Z : BackZ < Z)
+		{
+			break;
+		}
+		--Queue.Count;
+	}
+	Queue.Seqs[(Queue.Head + Queue.Count) % Queue.Seqs.Num()] = Seq;
+	++Queue.Count;
+}
+
+// Remove the expired sequence numbers from the front of the queue
+void FSLMotionHistory::TrimQueue(FSLHeightQueue& Queue)
+{
+	while (Queue.Count > 0 && Queue.Get(0) < OldestSeq)
+	{
+		Queue.Head = (Queue.Head + 1) % Queue.Seqs.Num();
+		--Queue.Count;
+	}
+}
+
+// Get the queue entry of the extreme of the samples since the sequence number
+int64 FSLMotionHistory::FindInQueue(const FSLHeightQueue& Queue, int64 SinceSeq) const
+{
+	// The queue is sorted by sequence numbers, the first entry not older than the given one is the extreme of the suffix
+	int32 Low = 0;
+	int32 High = Queue.Count - 1;
+	while (Low < High)
+	{
+		const int32 Mid = Low + (High - Low) / 2;
+		if (Queue.Get(Mid) < SinceSeq)
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+	return Queue.Get(Low);
+}
@@ -0,0 +1,302 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "Monitors/SLOverlapEndDebouncer.h"
+#include "Engine/World.h"
+
+TSharedPtr<FSLOverlapEndDebouncer> FSLOverlapEndDebouncer::StaticInstance;
+
+// Constructor
+FSLOverlapEndDebouncer::FSLOverlapEndDebouncer() : bIsInit(false), World(nullptr), CurrentTick(0)
+{
+	SlotHeads.Init(INDEX_NONE, RootSize + (NumLevels - 1) * LevelSize);
+}
+
+// Get singleton
+FSLOverlapEndDebouncer* FSLOverlapEndDebouncer::GetInstance()
+{
+	if (!StaticInstance.IsValid())
+	{
+		StaticInstance = MakeShareable(new FSLOverlapEndDebouncer());
+	}
+	return StaticInstance.Get();
+}
+
+// Delete instance
+void FSLOverlapEndDebouncer::DeleteInstance()
+{
+	StaticInstance.Reset();
+}
+
+// Init with the world
+void FSLOverlapEndDebouncer::Init(UWorld* InWorld)
+{
+	if (!bIsInit && InWorld)
+	{
+		World = InWorld;
+		CurrentTick = ToTicks(World->GetTimeSeconds());
+		bIsInit = true;
+	}
+}
+
+// Schedule the end of the pair, it is fired if no re-begin happens within the time gap (returns false if already pending)
+bool FSLOverlapEndDebouncer::Schedule(const void* InOwner, uint64 InPairId, float EndTime, float MaxTimeGap,
+	TFunction<void()>&& InOnExpired, uint32 InChannel)
+{
+	if (!bIsInit)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Debouncer is not init, firing the end without delay.."), *FString(__func__), __LINE__);
+		InOnExpired();
+		return false;
+	}
+
+	const FSLDebounceKey Key(InOwner, InPairId, InChannel);
+	if (KeyToEntryIdx.Contains(Key))
+	{
+		return false;
+	}
+
+	// The wheel is empty, catch up with the current time
+	if (Entries.Num() == 0)
+	{
+		CurrentTick = ToTicks(World->GetTimeSeconds());
+	}
+
+	const int32 EntryIdx = Entries.Emplace();
+	FSLDebounceEntry& Entry = Entries[EntryIdx];
+	Entry.Key = Key;
+	Entry.EndTime = EndTime;
+	Entry.MaxTimeGap = MaxTimeGap;
+	Entry.ExpireTick = ToTicks(EndTime + MaxTimeGap) + 1;
+	Entry.OnExpired = MoveTemp(InOnExpired);
+	KeyToEntryIdx.Add(Key, EntryIdx);
+	LinkEntry(EntryIdx);
+	return true;
+}
+
+// Called on a re-begin, cancels the pending end if it is within its time gap (returns true if the end was cancelled),
+// if the end is pending but too old, it is fired before returning
+bool FSLOverlapEndDebouncer::CancelIfRecent(const void* InOwner, uint64 InPairId, float BeginTime, uint32 InChannel)
+{
+	if (const int32* EntryIdxPtr = KeyToEntryIdx.Find(FSLDebounceKey(InOwner, InPairId, InChannel)))
+	{
+		const int32 EntryIdx = *EntryIdxPtr;
+		const bool bIsRecent = BeginTime - Entries[EntryIdx].EndTime < Entries[EntryIdx].MaxTimeGap;
+		TFunction<void()> OnExpired = RemoveEntry(EntryIdx);
+		if (bIsRecent)
+		{
+			return true;
+		}
+
+		// The end is older than the gap, it was not fired yet since the wheel did not tick
+		OnExpired();
+	}
+	return false;
+}
+
+// Check if the end of the pair is pending
+bool FSLOverlapEndDebouncer::IsPending(const void* InOwner, uint64 InPairId, uint32 InChannel) const
+{
+	return KeyToEntryIdx.Contains(FSLDebounceKey(InOwner, InPairId, InChannel));
+}
+
+// Fire all the pending ends of the owner
+void FSLOverlapEndDebouncer::FlushOwner(const void* InOwner)
+{
+	TArray<int32> OwnerEntries;
+	for (auto EntryItr(Entries.CreateConstIterator()); EntryItr; ++EntryItr)
+	{
+		if (EntryItr->Key.Owner == InOwner)
+		{
+			OwnerEntries.Add(EntryItr.GetIndex());
+		}
+	}
+
+	// Remove all entries before firing, the callbacks might schedule new ones
+	TArray<TFunction<void()>> Expired;
+	for (const int32 EntryIdx : OwnerEntries)
+	{
+		Expired.Emplace(RemoveEntry(EntryIdx));
+	}
+	for (auto& OnExpired : Expired)
+	{
+		OnExpired();
+	}
+}
+
+// Drop all the pending ends of the owner without firing them
+void FSLOverlapEndDebouncer::CancelOwner(const void* InOwner)
+{
+	TArray<int32> OwnerEntries;
+	for (auto EntryItr(Entries.CreateConstIterator()); EntryItr; ++EntryItr)
+	{
+		if (EntryItr->Key.Owner == InOwner)
+		{
+			OwnerEntries.Add(EntryItr.GetIndex());
+		}
+	}
+	for (const int32 EntryIdx : OwnerEntries)
+	{
+		RemoveEntry(EntryIdx);
+	}
+}
+
+/** Begin FTickableGameObject interface */
+// Called after ticking all actors, DeltaTime is the time passed since the last call.
+void FSLOverlapEndDebouncer::Tick(float DeltaTime)
+{
+	// Collect all expired ends, fire them in one batch
+	TArray<TFunction<void()>> Expired;
+	Advance(ToTicks(World->GetTimeSeconds()), Expired);
+	for (auto& OnExpired : Expired)
+	{
+		OnExpired();
+	}
+}
+
+// Return if object is ready to be ticked
+bool FSLOverlapEndDebouncer::IsTickable() const
+{
+	// Sleep while there are no pending ends
+	return bIsInit && Entries.Num() > 0;
+}
+
+// Return the world the manager is ticked with (ticked by the world tick, also when the world is ticked manually)
+UWorld* FSLOverlapEndDebouncer::GetTickableGameObjectWorld() const
+{
+	return World;
+}
+
+// Return the stat id to use for this tickable
+TStatId FSLOverlapEndDebouncer::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(FSLOverlapEndDebouncer, STATGROUP_Tickables);
+}
+/** End FTickableGameObject interface */
+
+// Link entry into the wheel slot given by its expire tick
+void FSLOverlapEndDebouncer::LinkEntry(int32 EntryIdx)
+{
+	FSLDebounceEntry& Entry = Entries[EntryIdx];
+
+	// Already expired entries are fired with the current tick
+	int64 Expire = FMath::Max(Entry.ExpireTick, CurrentTick);
+	int64 Delta = Expire - CurrentTick;
+
+	int32 Slot;
+	if (Delta < RootSize)
+	{
+		Slot = Expire & (RootSize - 1);
+	}
+	else
+	{
+		// Find the level covering the delta, entries too far in the future are clamped to the last level
+		int32 Level = 1;
+		while (Level < NumLevels - 1 && Delta >= (int64(1) << (RootBits + Level * LevelBits)))
+		{
+			++Level;
+		}
+		const int64 MaxDelta = (int64(1) << (RootBits + (NumLevels - 1) * LevelBits)) - 1;
+		if (Delta > MaxDelta)
+		{
+			Expire = CurrentTick + MaxDelta;
+		}
+		const int32 Shift = RootBits + (Level - 1) * LevelBits;
+		Slot = RootSize + (Level - 1) * LevelSize + ((Expire >> Shift) & (LevelSize - 1));
+	}
+
+	// Insert at the head of the slot list
+	Entry.Slot = Slot;
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = SlotHeads[Slot];
+	if (Entry.Next != INDEX_NONE)
+	{
+		Entries[Entry.Next].Prev = EntryIdx;
+	}
+	SlotHeads[Slot] = EntryIdx;
+}
+
+// Unlink entry from its wheel slot
+void FSLOverlapEndDebouncer::UnlinkEntry(int32 EntryIdx)
+{
+	FSLDebounceEntry& Entry = Entries[EntryIdx];
+	if (Entry.Prev != INDEX_NONE)
+	{
+		Entries[Entry.Prev].Next = Entry.Next;
+	}
+	else
+	{
+		SlotHeads[Entry.Slot] = Entry.Next;
+	}
+	if (Entry.Next != INDEX_NONE)
+	{
+		Entries[Entry.Next].Prev = Entry.Prev;
+	}
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = INDEX_NONE;
+}
+
+// Remove entry, returns its callback
+TFunction<void()> FSLOverlapEndDebouncer::RemoveEntry(int32 EntryIdx)
+{
+	UnlinkEntry(EntryIdx);
+	KeyToEntryIdx.Remove(Entries[EntryIdx].Key);
+	TFunction<void()> OnExpired = MoveTemp(Entries[EntryIdx].OnExpired);
+	Entries.RemoveAt(EntryIdx);
+	return OnExpired;
+}
+
+// Re-link the entries of the upper level slot into the lower levels, returns the slot index
+int32 FSLOverlapEndDebouncer::Cascade(int32 Level, int32 Index)
+{
+	const int32 Slot = RootSize + (Level - 1) * LevelSize + Index;
+	int32 EntryIdx = SlotHeads[Slot];
+	SlotHeads[Slot] = INDEX_NONE;
+	while (EntryIdx != INDEX_NONE)
+	{
+		const int32 NextIdx = Entries[EntryIdx].Next;
+		LinkEntry(EntryIdx);
+		EntryIdx = NextIdx;
+	}
+	return Index;
+}
+
+// Advance the wheel to the given tick, collect the expired entries
+void FSLOverlapEndDebouncer::Advance(int64 ToTick, TArray<TFunction<void()>>& OutExpired)
+{
+	while (CurrentTick <= ToTick && Entries.Num() > 0)
+	{
+		const int32 Index = CurrentTick & (RootSize - 1);
+
+		// Root level wrapped around, move the entries of the upper levels down
+		if (Index == 0)
+		{
+			int32 Level = 1;
+			while (Level < NumLevels &&
+				Cascade(Level, (CurrentTick >> (RootBits + (Level - 1) * LevelBits)) & (LevelSize - 1)) == 0)
+			{
+				++Level;
+			}
+		}
+
+		// Expire the entries of the current root slot
+		int32 EntryIdx = SlotHeads[Index];
+		SlotHeads[Index] = INDEX_NONE;
+		while (EntryIdx != INDEX_NONE)
+		{
+			const int32 NextIdx = Entries[EntryIdx].Next;
+			KeyToEntryIdx.Remove(Entries[EntryIdx].Key);
+			OutExpired.Emplace(MoveTemp(Entries[EntryIdx].OnExpired));
+			Entries.RemoveAt(EntryIdx);
+			EntryIdx = NextIdx;
+		}
+
+		++CurrentTick;
+	}
+
+	// Nothing left to expire, jump to the current time
+	if (Entries.Num() == 0)
+	{
+		CurrentTick = ToTick + 1;
+	}
+}
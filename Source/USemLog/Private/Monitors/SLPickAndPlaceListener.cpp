@@ -5,6 +5,7 @@
 #include "SLManipulatorListener.h"
 #include "Animation/SkeletalMeshActor.h"
 #include "SLEntitiesManager.h"
+#include "Monitors/SLSpatialQueryManager.h"
 #include "GameFramework/PlayerController.h"
 
 // Sets default values for this component's properties
@@ -24,12 +25,10 @@ USLPickAndPlaceListener::USLPickAndPlaceListener()
 	CurrGraspedObj = nullptr;
 	EventCheck = ESLPaPStateCheck::NONE;
 	UpdateFunctionPtr = &USLPickAndPlaceListener::Update_NONE;
+	SpatialQueryHandle = INDEX_NONE;
 
 	/* PickUp */
 	bLiftOffHappened = false;
-
-	/* PutDown */
-	RecentMovementBuffer.Reserve(RecentMovementBufferSize);
 }
 
 // Dtor
@@ -69,6 +68,10 @@ bool USLPickAndPlaceListener::Init()
 		EventCheck = ESLPaPStateCheck::NONE;
 		UpdateFunctionPtr = &USLPickAndPlaceListener::Update_NONE;
 
+		// The movement history is sized from the (possibly edited or overridden) thresholds
+		RecentMovementBuffer = FSLMotionHistory(Thresholds.RecentMovementBufferSize,
+			Thresholds.RecentMovementBufferDuration);
+
 		bIsInit = true;
 		return true;
 	}
@@ -83,9 +86,8 @@ void USLPickAndPlaceListener::Start()
 		// Subscribe for grasp notifications from sibling component
 		if(SubscribeForGraspEvents())
 		{
-			// Start update callback (will directly be paused until a grasp is active)
-			GetWorld()->GetTimerManager().SetTimer(UpdateTimerHandle, this, &USLPickAndPlaceListener::Update, UpdateRate, true);
-			GetWorld()->GetTimerManager().PauseTimer(UpdateTimerHandle);
+			// The grasped object is sampled by the shared spatial query manager (only while a grasp is active)
+			FSLSpatialQueryManager::GetInstance()->Init(GetWorld());
 			
 			// Mark as started
 			bIsStarted = true;
@@ -102,6 +104,10 @@ void USLPickAndPlaceListener::Finish(float EndTime, bool bForced)
 		// Finish any active event
 		FinishActiveEvent(EndTime);
 
+		// Stop sampling the grasped object
+		FSLSpatialQueryManager::GetInstance()->RemoveQuery(SpatialQueryHandle);
+		SpatialQueryHandle = INDEX_NONE;
+
 		// Mark as finished
 		bIsStarted = false;
 		bIsInit = false;
@@ -164,6 +170,10 @@ void USLPickAndPlaceListener::OnSLGraspBegin(const FSLEntity& Self, AActor* Othe
 		PrevRelevantLocation = Other->GetActorLocation();
 		PrevRelevantTime = GetWorld()->GetTimeSeconds();
 
+		// Start a new movement history for the grasped object
+		RecentMovementBuffer.Reset();
+		RecentMovementBuffer.Add(PrevRelevantTime, PrevRelevantLocation);
+
 		if(GraspedObjectContactShape->IsSupportedBySomething())
 		{
 			EventCheck = ESLPaPStateCheck::Slide;
@@ -182,13 +192,15 @@ void USLPickAndPlaceListener::OnSLGraspBegin(const FSLEntity& Self, AActor* Othe
 		}
 
 		
-		if(GetWorld()->GetTimerManager().IsTimerPaused(UpdateTimerHandle))
+		if(SpatialQueryHandle == INDEX_NONE)
 		{
-			GetWorld()->GetTimerManager().UnPauseTimer(UpdateTimerHandle);
+			// Sample the grasped object location with the batched spatial queries
+			SpatialQueryHandle = FSLSpatialQueryManager::GetInstance()->AddQuery(Other->GetRootComponent(), 0.f, 0.f, Thresholds.UpdateRate,
+				FSLSpatialQueryResultSignature::CreateUObject(this, &USLPickAndPlaceListener::Update));
 		}
 		else
 		{
-			UE_LOG(LogTemp, Error, TEXT("%s::%d [%f] This should not happen, timer should have been paused here.."),
+			UE_LOG(LogTemp, Error, TEXT("%s::%d [%f] This should not happen, the update query should have been removed here.."),
 				*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds());
 		}
 	}
@@ -223,13 +235,14 @@ void USLPickAndPlaceListener::OnSLGraspEnd(const FSLEntity& Self, AActor* Other,
 		//	*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds(), *Other->GetName());
 
 
-		if(!GetWorld()->GetTimerManager().IsTimerPaused(UpdateTimerHandle))
+		if(SpatialQueryHandle != INDEX_NONE)
 		{
-			GetWorld()->GetTimerManager().PauseTimer(UpdateTimerHandle);
+			FSLSpatialQueryManager::GetInstance()->RemoveQuery(SpatialQueryHandle);
+			SpatialQueryHandle = INDEX_NONE;
 		}
 		else
 		{
-			UE_LOG(LogTemp, Error, TEXT("%s::%d [%f] This should not happen, timer should have been running here.."),
+			UE_LOG(LogTemp, Error, TEXT("%s::%d [%f] This should not happen, the update query should have been running here.."),
 				*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds());
 		}
 	}
@@ -269,35 +282,56 @@ void USLPickAndPlaceListener::FinishActiveEvent(float CurrTime)
 	UpdateFunctionPtr = &USLPickAndPlaceListener::Update_NONE;
 }
 
-// Backtrace and check if a put-down event happened
-bool USLPickAndPlaceListener::HasPutDownEventHappened(const float CurrTime, const FVector& CurrObjLocation, uint32& OutPutDownEndIdx)
+// Backtrace the transport movement and check if a put-down event happened (outputs the history index of the put-down end)
+bool USLPickAndPlaceListener::HasPutDownEventHappened(const float CurrTime, const FVector& CurrObjLocation, int32& OutPutDownEndIdx) const
 {
+	// Only the movements since the transport start are relevant
+	const int32 BacktrackStartIdx = RecentMovementBuffer.FindFirstSince(
+		FMath::Max(PrevRelevantTime, CurrTime - Thresholds.PutDownMovementBacktrackDuration));
+	if (BacktrackStartIdx >= RecentMovementBuffer.Num())
+	{
+		return false;
+	}
+
+	// Quick check, the object should have been higher than the current location during the backtrack window
+	if (RecentMovementBuffer.GetMaxHeightSince(BacktrackStartIdx) - CurrObjLocation.Z <= Thresholds.MinPutDownHeight)
+	{
+		return false;
+	}
+
+	// Find the most recent sample above the put-down height
 	OutPutDownEndIdx = RecentMovementBuffer.Num() - 1;
-	while(OutPutDownEndIdx > 0 && CurrTime - RecentMovementBuffer[OutPutDownEndIdx].Key < PutDownMovementBacktrackDuration)
+	while (OutPutDownEndIdx >= BacktrackStartIdx)
 	{
-		UE_LOG(LogTemp, Error, TEXT("%s::%d [%f] \t\t\t [%f] [%f/%f] MinPutDownHeight"),
-			*FString(__func__), __LINE__,
-			GetWorld()->GetTimeSeconds(), 
-			RecentMovementBuffer[OutPutDownEndIdx].Key,
-			RecentMovementBuffer[OutPutDownEndIdx].Value.Z - CurrObjLocation.Z,
-			MinPutDownHeight);
-
-		if(RecentMovementBuffer[OutPutDownEndIdx].Value.Z - CurrObjLocation.Z > MinPutDownHeight)
+		if (RecentMovementBuffer.GetLocation(OutPutDownEndIdx).Z - CurrObjLocation.Z > Thresholds.MinPutDownHeight)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("%s::%d [%f]  \t\t\t\t PUT DOWN HAPPENED"),
-				*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds());
 			return true;
 		}
 		OutPutDownEndIdx--;
 	}
-	UE_LOG(LogTemp, Error, TEXT("%s::%d [%f]  \t\t\t\t PUT DOWN HAS NOT HAPPENED"),
-		*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds());
 	return false;
 }
 
-// Update callback
-void USLPickAndPlaceListener::Update()
+// Displacement of the grasped object since the previous relevant time (from the history while it still holds that time)
+FVector USLPickAndPlaceListener::GetDisplacementSincePrevRelevant() const
+{
+	if (RecentMovementBuffer.GetTime(0) <= PrevRelevantTime)
+	{
+		const int32 SinceIdx = FMath::Min(RecentMovementBuffer.FindFirstSince(PrevRelevantTime), RecentMovementBuffer.Num() - 1);
+		return RecentMovementBuffer.GetDisplacementSince(SinceIdx);
+	}
+	return RecentMovementBuffer.GetLastLocation() - PrevRelevantLocation;
+}
+
+// Spatial query callback with the grasped object location
+void USLPickAndPlaceListener::Update(const FVector& OriginLocation, const TArray<FSLSpatialQueryHit>& Hits, float Time)
 {
+	// Sample the grasped object once per update, the state checks query the movement history
+	if (CurrGraspedObj)
+	{
+		RecentMovementBuffer.Add(Time, OriginLocation);
+	}
+
 	// Call the state update function
 	(this->*UpdateFunctionPtr)();
 }
@@ -318,9 +352,9 @@ void USLPickAndPlaceListener::Update_Slide()
 		return;
 	}
 
-	const FVector CurrObjLocation = CurrGraspedObj->GetActorLocation();
-	const float CurrTime = GetWorld()->GetTimeSeconds();
-	const float CurrDistXY = FVector::DistXY(PrevRelevantLocation, CurrObjLocation);
+	const FVector CurrObjLocation = RecentMovementBuffer.GetLastLocation();
+	const float CurrTime = RecentMovementBuffer.GetLastTime();
+	const float CurrDistXY = GetDisplacementSincePrevRelevant().Size2D();
 
 	// Sliding events can only end when the object is not supported by the surface anymore
 	if(!GraspedObjectContactShape->IsSupportedBySomething())
@@ -328,7 +362,7 @@ void USLPickAndPlaceListener::Update_Slide()
 		UE_LOG(LogTemp, Error, TEXT("%s::%d [%f]  \t\t **** END SupportedBy ****"), *FString(__func__), __LINE__, GetWorld()->GetTimeSeconds());
 
 		// Check if enough distance and time has passed for a sliding event
-		if(CurrDistXY > MinSlideDistXY && CurrTime - PrevRelevantTime > MinSlideDuration)
+		if(CurrDistXY > Thresholds.MinSlideDistXY && CurrTime - PrevRelevantTime > Thresholds.MinSlideDuration)
 		{
 			const float ExactSupportedByEndTime = GraspedObjectContactShape->GetLastSupportedByEndTime();
 
@@ -352,15 +386,15 @@ void USLPickAndPlaceListener::Update_Slide()
 // Check for pick-up events
 void USLPickAndPlaceListener::Update_PickUp()
 {
-	const FVector CurrObjLocation = CurrGraspedObj->GetActorLocation();
-	const float CurrTime = GetWorld()->GetTimeSeconds();
+	const FVector CurrObjLocation = RecentMovementBuffer.GetLastLocation();
+	const float CurrTime = RecentMovementBuffer.GetLastTime();
 
 	if(!GraspedObjectContactShape->IsSupportedBySomething())
 	{
 		if(bLiftOffHappened)
 		{
-			if(CurrObjLocation.Z - LiftOffLocation.Z > MaxPickUpHeight ||
-				FVector::DistXY(LiftOffLocation, CurrObjLocation) > MaxPickUpDistXY)
+			if(CurrObjLocation.Z - LiftOffLocation.Z > Thresholds.MaxPickUpHeight ||
+				FVector::DistXY(LiftOffLocation, CurrObjLocation) > Thresholds.MaxPickUpDistXY)
 			{
 
 				UE_LOG(LogTemp, Error, TEXT("%s::%d [%f] \t ############## PICK UP ##############  [%f <--> %f]"),
@@ -376,7 +410,7 @@ void USLPickAndPlaceListener::Update_PickUp()
 				UpdateFunctionPtr = &USLPickAndPlaceListener::Update_TransportOrPutDown;
 			}
 		}
-		else if(CurrObjLocation.Z - PrevRelevantLocation.Z > MinPickUpHeight)
+		else if(CurrObjLocation.Z - PrevRelevantLocation.Z > Thresholds.MinPickUpHeight)
 		{
 			UE_LOG(LogTemp, Warning, TEXT("%s::%d [%f]  \t **** LiftOFF **** \t\t\t\t\t\t\t\t LIFTOFF"), *FString(__func__), __LINE__, GetWorld()->GetTimeSeconds());
 
@@ -385,7 +419,7 @@ void USLPickAndPlaceListener::Update_PickUp()
 			bLiftOffHappened = true;
 			LiftOffLocation = CurrObjLocation;
 		}
-		else if(FVector::DistXY(LiftOffLocation, PrevRelevantLocation) > MaxPickUpDistXY)
+		else if(GetDisplacementSincePrevRelevant().Size2D() > Thresholds.MaxPickUpDistXY)
 		{
 			UE_LOG(LogTemp, Warning, TEXT("%s::%d [%f]  \t **** Skip PickUp **** \t\t\t\t\t\t\t\t SKIP PICKUP"), *FString(__func__), __LINE__, GetWorld()->GetTimeSeconds());
 			EventCheck = ESLPaPStateCheck::TransportOrPutDown;
@@ -414,25 +448,28 @@ void USLPickAndPlaceListener::Update_PickUp()
 // Check for put-down or transport events
 void USLPickAndPlaceListener::Update_TransportOrPutDown()
 {
-	const float CurrTime = GetWorld()->GetTimeSeconds();
-	const FVector CurrObjLocation = CurrGraspedObj->GetActorLocation();
+	const float CurrTime = RecentMovementBuffer.GetLastTime();
+	const FVector CurrObjLocation = RecentMovementBuffer.GetLastLocation();
 
 	if(GraspedObjectContactShape->IsSupportedBySomething())
 	{
 		UE_LOG(LogTemp, Warning, TEXT("%s::%d [%f]  \t\t **** START SupportedBy ****"), *FString(__func__), __LINE__, GetWorld()->GetTimeSeconds());
 
 		// Check for the PutDown movement start time
-		uint32 PutDownEndIdx = 0;
+		int32 PutDownEndIdx = 0;
 		if(HasPutDownEventHappened(CurrTime, CurrObjLocation, PutDownEndIdx))
 		{
+			// Backtrack until the transport start
+			const int32 TransportStartIdx = RecentMovementBuffer.FindFirstSince(PrevRelevantTime);
 			float PutDownStartTime = -1.f;
-			while(PutDownEndIdx > 0)
+			while(PutDownEndIdx >= TransportStartIdx)
 			{
-				// Check when the 
-				if(RecentMovementBuffer[PutDownEndIdx].Value.Z - CurrObjLocation.Z > MaxPutDownHeight
-					|| FVector::Distance(RecentMovementBuffer[PutDownEndIdx].Value, CurrObjLocation) > MaxPutDownDistXY)
+				// Check when the object crossed the put-down limits
+				const FVector& PastLocation = RecentMovementBuffer.GetLocation(PutDownEndIdx);
+				if(PastLocation.Z - CurrObjLocation.Z > Thresholds.MaxPutDownHeight
+					|| FVector::Distance(PastLocation, CurrObjLocation) > Thresholds.MaxPutDownDistXY)
 				{
-					PutDownStartTime = RecentMovementBuffer[PutDownEndIdx].Key;
+					PutDownStartTime = RecentMovementBuffer.GetTime(PutDownEndIdx);
 
 					UE_LOG(LogTemp, Error, TEXT("%s::%d [%f] \t ############## TRANSPORT ##############  [%f <--> %f]"),
 						*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds(), PrevRelevantTime, PutDownStartTime);
@@ -452,11 +489,11 @@ void USLPickAndPlaceListener::Update_TransportOrPutDown()
 			{
 				UE_LOG(LogTemp, Error, TEXT("%s::%d [%f] The limits were not crossed in the available data in the buffer, the oldest available time is used"),
 					*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds());
-				PutDownStartTime = RecentMovementBuffer[0].Key;
+				PutDownStartTime = RecentMovementBuffer.GetTime(FMath::Min(TransportStartIdx, RecentMovementBuffer.Num() - 1));
 
 				UE_LOG(LogTemp, Error, TEXT("%s::%d [%f] \t ############## TRANSPORT ##############  [%f <--> %f]"),
 					*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds(), PrevRelevantTime, PutDownStartTime);
-				OnManipulatorPutDownEvent.Broadcast(SemanticOwner, CurrGraspedObj, PrevRelevantTime, PutDownStartTime);
+				OnManipulatorTransportEvent.Broadcast(SemanticOwner, CurrGraspedObj, PrevRelevantTime, PutDownStartTime);
 
 				UE_LOG(LogTemp, Error, TEXT("%s::%d [%f] \t ############## PUT DOWN ##############  [%f <--> %f]"),
 					*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds(), PutDownStartTime, CurrTime);
@@ -470,35 +507,9 @@ void USLPickAndPlaceListener::Update_TransportOrPutDown()
 			OnManipulatorTransportEvent.Broadcast(SemanticOwner, CurrGraspedObj, PrevRelevantTime, CurrTime);
 		}
 
-		RecentMovementBuffer.Reset(RecentMovementBufferSize);
-
 		PrevRelevantTime = CurrTime;
 		PrevRelevantLocation = CurrObjLocation;
 		EventCheck = ESLPaPStateCheck::Slide;
 		UpdateFunctionPtr = &USLPickAndPlaceListener::Update_Slide;
 	}
-	else
-	{
-		// Cache recent movements 
-		if(RecentMovementBuffer.Num() > 1)
-		{
-			RecentMovementBuffer.Push(TPair<float, FVector>(CurrTime, CurrObjLocation));
-
-			// Remove values older than RecentMovementBufferDuration
-			int32 Count = 0;
-			while(RecentMovementBuffer.Last().Key - RecentMovementBuffer[Count].Key > RecentMovementBufferDuration)
-			{
-				Count++;
-			}
-			if(Count > 0)
-			{
-				RecentMovementBuffer.RemoveAt(0, Count, false);
-			}
-		}
-		else
-		{
-			RecentMovementBuffer.Push(TPair<float, FVector>(CurrTime, CurrObjLocation));
-		}
-	}
 }
-
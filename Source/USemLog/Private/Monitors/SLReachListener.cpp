@@ -4,10 +4,10 @@
 #include "Monitors/SLReachListener.h"
 #include "Animation/SkeletalMeshActor.h"
 #include "Engine/StaticMeshActor.h"
-#include "TimerManager.h"
 #include "Components/StaticMeshComponent.h"
 #include "SLManipulatorListener.h"
 #include "SLEntitiesManager.h"
+#include "Monitors/SLOverlapEndDebouncer.h"
 
 // Set default values
 USLReachListener::USLReachListener()
@@ -24,6 +24,7 @@ USLReachListener::USLReachListener()
 	bCallbacksAreBound = false;
 
 	CurrGraspedObj = nullptr;
+	SpatialQueryHandle = INDEX_NONE;
 	
 	ShapeColor = FColor::Orange.WithAlpha(64);
 }
@@ -71,9 +72,14 @@ void USLReachListener::Start()
 {
 	if (!bIsStarted && bIsInit)
 	{
-		// Bind to the update callback function
-		GetWorld()->GetTimerManager().SetTimer(UpdateTimerHandle, this, &USLReachListener::ReachUpdate, UpdateRate, true);
-		GetWorld()->GetTimerManager().PauseTimer(UpdateTimerHandle);
+		// Track the candidates distances to the hand with the shared spatial query manager (idle while there are no candidates),
+		// the candidates themselves come from the sphere overlaps (exact begin times)
+		FSLSpatialQueryManager::GetInstance()->Init(GetWorld());
+		SpatialQueryHandle = FSLSpatialQueryManager::GetInstance()->AddQuery(GetOwner()->GetRootComponent(), 0.f, MinDist, UpdateRate,
+			FSLSpatialQueryResultSignature::CreateUObject(this, &USLReachListener::ReachUpdate));
+
+		// Delayed manipulator contact ends are handled by the debouncer
+		FSLOverlapEndDebouncer::GetInstance()->Init(GetWorld());
 
 		SetGenerateOverlapEvents(true);
 
@@ -102,6 +108,13 @@ void USLReachListener::Finish(bool bForced)
 			OnComponentEndOverlap.RemoveDynamic(this, &USLReachListener::OnOverlapEnd);
 			bCallbacksAreBound = false;
 		}
+
+		// Drop the pending contact ends, no reach time needs to be reset anymore
+		FSLOverlapEndDebouncer::GetInstance()->CancelOwner(this);
+
+		// Stop the candidates distance query
+		FSLSpatialQueryManager::GetInstance()->RemoveQuery(SpatialQueryHandle);
+		SpatialQueryHandle = INDEX_NONE;
 		
 		// Mark as finished
 		bIsStarted = false;
@@ -171,60 +184,30 @@ bool USLReachListener::SubscribeForManipulatorEvents()
 	return false;
 }
 
-// Update callback, checks distance to hand, if it increases it resets the start time
-void USLReachListener::ReachUpdate()
+// Spatial query callback, checks distance to hand, if it increases it resets the start time
+void USLReachListener::ReachUpdate(const FVector& OriginLocation, const TArray<FSLSpatialQueryHit>& Hits, float Time)
 {
-	const float CurrTime = GetWorld()->GetTimeSeconds();
-	
-	for(auto& C : CandidatesWithTimeAndDistance)
+	for (const auto& Hit : Hits)
 	{
-		const float CurrDist = FVector::Distance(GetOwner()->GetActorLocation(), C.Key->GetActorLocation());
-		const float PrevDist = C.Value.Get<1>();
-		const float DiffDist = PrevDist - CurrDist;
-
-		// Ignore small difference changes (MinDist)
-		if(DiffDist > MinDist)
+		FSLTimeAndDist* TimeAndDist = CandidatesWithTimeAndDistance.Find(static_cast<AStaticMeshActor*>(Hit.Entity));
+		if (!TimeAndDist)
 		{
-			// Positive difference makes the hand closer to the object, update the distance
-			C.Value.Get<ESLTimeAndDist::Dist>() = CurrDist;
-
-			//UE_LOG(LogTemp, Warning, TEXT("%s::%d [%f] %s is moving closer to %s; PrevDist=%f; CurrDist=%f; DiffDist=%f; [%s - %s];"),
-			//	*FString(__func__), __LINE__, 
-			//	CurrTime, 
-			//	*SemanticOwner.Obj->GetName(), 
-			//	*C.Key->GetName(),
-			//	PrevDist, CurrDist, DiffDist,
-			//	*GetOwner()->GetActorLocation().ToString(),
-			//	*C.Key->GetActorLocation().ToString());
+			continue;
 		}
-		else if(DiffDist < -MinDist)
+
+		// Small difference changes (MinDist) are reported as idle
+		if (Hit.Trend == ESLDistanceTrend::Closer)
 		{
-			// Negative difference makes the hand further away from the object, update distance, reset the start time
-			C.Value.Get<ESLTimeAndDist::Time>() = CurrTime;
-			C.Value.Get<ESLTimeAndDist::Dist>() = CurrDist;
-
-			//UE_LOG(LogTemp, Error, TEXT("%s::%d [%f] %s is moving further to %s; PrevDist=%f; CurrDist=%f; DiffDist=%f; [%s - %s];"),
-			//	*FString(__func__), __LINE__, 
-			//	CurrTime, 
-			//	*SemanticOwner.Obj->GetName(), 
-			//	*C.Key->GetName(),
-			//	PrevDist, CurrDist, DiffDist,
-			//	*GetOwner()->GetActorLocation().ToString(),
-			//	*C.Key->GetActorLocation().ToString());
+			// The hand is closer to the object, update the distance
+			TimeAndDist->Get<ESLTimeAndDist::Dist>() = Hit.Distance;
 		}
-		else
+		else if (Hit.Trend == ESLDistanceTrend::Further)
 		{
-			// TODO reset time when idling for a longer period
-			//UE_LOG(LogTemp, Log, TEXT("%s::%d [%f] %s is idling relative to %s; PrevDist=%f; CurrDist=%f; DiffDist=%f; [%s - %s];"),
-			//	*FString(__func__), __LINE__, 
-			//	CurrTime, 
-			//	*SemanticOwner.Obj->GetName(), 
-			//	*C.Key->GetName(),
-			//	PrevDist, CurrDist, DiffDist,
-			//	*GetOwner()->GetActorLocation().ToString(),
-			//	*C.Key->GetActorLocation().ToString());
+			// The hand is further away from the object, update distance, reset the start time
+			TimeAndDist->Get<ESLTimeAndDist::Time>() = Time;
+			TimeAndDist->Get<ESLTimeAndDist::Dist>() = Hit.Distance;
 		}
-
+		// TODO reset time when idling for a longer period
 	}
 }
 
@@ -302,8 +285,8 @@ void USLReachListener::OnOverlapBegin(UPrimitiveComponent* OverlappedComp,
 			//UE_LOG(LogTemp, Warning, TEXT("%s::%d [%f] %s added as candidate.."),
 			//	*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds(), *AsSMA->GetName());
 			
-			// New candidate added, make sure update callback timer is running
-			GetWorld()->GetTimerManager().UnPauseTimer(UpdateTimerHandle);
+			// New candidate added, track its distance to the hand
+			FSLSpatialQueryManager::GetInstance()->TrackEntity(SpatialQueryHandle, AsSMA);
 		}
 	}
 }
@@ -322,11 +305,8 @@ void USLReachListener::OnOverlapEnd(UPrimitiveComponent* OverlappedComp,
 			//UE_LOG(LogTemp, Error, TEXT("%s::%d [%f] %s removed as candidate.."),
 			//	*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds(), *AsSMA->GetName());
 
-			// If it was the last element, pause timer
-			if(CandidatesWithTimeAndDistance.Num() == 0)
-			{
-				GetWorld()->GetTimerManager().PauseTimer(UpdateTimerHandle);
-			}
+			// Stop tracking, the query is idle when there are no candidates left
+			FSLSpatialQueryManager::GetInstance()->UntrackEntity(SpatialQueryHandle, AsSMA);
 		}
 	}
 }
@@ -357,8 +337,8 @@ void USLReachListener::OnSLGraspBegin(const FSLEntity& Self, AActor* Other, floa
 				//UE_LOG(LogTemp, Warning, TEXT("%s::%d [%f] %s set as grasped object.."),
 				//	*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds(), *Other->GetName());
 
-				// Cancel delay callback if active
-				GetWorld()->GetTimerManager().ClearTimer(ManipulatorContactDelayTimerHandle);
+				// Cancel delay callbacks if active
+				FSLOverlapEndDebouncer::GetInstance()->CancelOwner(this);
 
 				// Broadcast reach and pre grasp events
 				const float ReachStartTime = CandidateTimeAndDist->Get<ESLTimeAndDist::Time>();
@@ -368,7 +348,7 @@ void USLReachListener::OnSLGraspBegin(const FSLEntity& Self, AActor* Other, floa
 				// Remove existing candidates and pause the update callback while the hand is grasping
 				CandidatesWithTimeAndDistance.Empty();
 				ObjectsInContactWithManipulator.Empty();
-				GetWorld()->GetTimerManager().PauseTimer(UpdateTimerHandle);
+				FSLSpatialQueryManager::GetInstance()->UntrackAllEntities(SpatialQueryHandle);
 
 
 				// Remove overlap callbacks while grasp is active
@@ -473,9 +453,6 @@ void USLReachListener::OnSLManipulatorContactEnd(const FSLEntity& Self, const FS
 		// Check contact with manipulator (remove in delay callback, give concatenation a chance)
 		if (ObjectsInContactWithManipulator.Contains(AsSMA))
 		{
-			// Cache the event
-			RecentlyEndedManipulatorContactEvents.Emplace(AsSMA, Time);
-
 			if (!GetWorld())
 			{
 				// The episode finished, going further is futile
@@ -483,11 +460,8 @@ void USLReachListener::OnSLManipulatorContactEnd(const FSLEntity& Self, const FS
 			}
 
 			// Delay reseting the reach time, it might be a small disconnection with the hand
-			if(!GetWorld()->GetTimerManager().IsTimerActive(ManipulatorContactDelayTimerHandle))
-			{
-				GetWorld()->GetTimerManager().SetTimer(ManipulatorContactDelayTimerHandle, this, &USLReachListener::DelayedManipulatorContactEndEventCallback,
-					MaxPreGraspEventTimeGap * 1.2f, false);
-			}
+			FSLOverlapEndDebouncer::GetInstance()->Schedule(this, AsSMA->GetUniqueID(), Time, MaxPreGraspEventTimeGap,
+				[this, AsSMA, Time]() { DelayedManipulatorContactEndEventCallback(AsSMA, Time); });
 		}
 		else
 		{
@@ -499,74 +473,34 @@ void USLReachListener::OnSLManipulatorContactEnd(const FSLEntity& Self, const FS
 	}
 }
 
-// Delayed call of setting finished event to check for possible concatenation of jittering events of the same type
-void USLReachListener::DelayedManipulatorContactEndEventCallback()
+// Delayed call of resetting the reach time, called if no concatenation of the jittering contact happened
+void USLReachListener::DelayedManipulatorContactEndEventCallback(AStaticMeshActor* Other, float EndTime)
 {
-	// Curr time (keep very recently added events for another delay)
-	const float CurrTime = GetWorld()->GetTimeSeconds();
-	
-	for (auto EvItr(RecentlyEndedManipulatorContactEvents.CreateIterator()); EvItr; ++EvItr)
+	// Reset reach start in the candidate
+	if(FSLTimeAndDist* TimeAndDist = CandidatesWithTimeAndDistance.Find(Other))
 	{
-		// If enough time has passed, reset the reach time
-		if(CurrTime - EvItr->Time > MaxPreGraspEventTimeGap)
+		// No new contact happened, remove and reset reach time
+		if(ObjectsInContactWithManipulator.Remove(Other) > 0)
 		{
-			// Reset reach start in the candidate
-			if(FSLTimeAndDist* TimeAndDist = CandidatesWithTimeAndDistance.Find(EvItr->Other))
-			{
-				// No new contact happened, remove and reset reach time
-				if(ObjectsInContactWithManipulator.Remove(EvItr->Other) > 0)
-				{
-					//UE_LOG(LogTemp, Warning, TEXT("%s::%d [%f] %s removed as object in contact with the manipulator.. (after delay, contact end time=%f)"),
-					//	*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds(), *EvItr->Other->GetName(), EvItr->Time);
-					TimeAndDist->Get<ESLTimeAndDist::Time>() = GetWorld()->GetTimeSeconds();
-				}
-				else
-				{
-					UE_LOG(LogTemp, Error, TEXT("%s::%d [%f] %s is not in the contact list.. this should not happen.."),
-						*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds(), *EvItr->Other->GetName());
-				}
-			}
-			else
-			{
-				UE_LOG(LogTemp, Error, TEXT("%s::%d [%f] %s is not in the candidates list.. this should not happen.."),
-					*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds(), *EvItr->Other->GetName());
-			}
-			
-			EvItr.RemoveCurrent();
+			//UE_LOG(LogTemp, Warning, TEXT("%s::%d [%f] %s removed as object in contact with the manipulator.. (after delay, contact end time=%f)"),
+			//	*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds(), *Other->GetName(), EndTime);
+			TimeAndDist->Get<ESLTimeAndDist::Time>() = GetWorld()->GetTimeSeconds();
+		}
+		else
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s::%d [%f] %s is not in the contact list.. this should not happen.."),
+				*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds(), *Other->GetName());
 		}
 	}
-
-	// There are very recent events still available, spin another delay callback to give them a chance to concatenate
-	if(RecentlyEndedManipulatorContactEvents.Num() > 0)
+	else
 	{
-		GetWorld()->GetTimerManager().SetTimer(ManipulatorContactDelayTimerHandle, this, &USLReachListener::DelayedManipulatorContactEndEventCallback,
-			MaxPreGraspEventTimeGap * 1.2f, false);
+		UE_LOG(LogTemp, Error, TEXT("%s::%d [%f] %s is not in the candidates list.. this should not happen.."),
+			*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds(), *Other->GetName());
 	}
 }
 
-// Check if this begin event happened right after the previous one ended, if so remove it from the array, and cancel publishing the begin event
+// Check if this begin event happened right after the previous one ended, if so cancel the pending end and skip the begin event
 bool USLReachListener::SkipRecentManipulatorContactEndEventTime(AStaticMeshActor* Other, float StartTime)
 {
-	for (auto EvItr(RecentlyEndedManipulatorContactEvents.CreateIterator()); EvItr; ++EvItr)
-	{
-		// Check if it is an event between the same entities
-		if(EvItr->Other == Other)
-		{
-			// Check time difference between the previous and current event
-			const float TimeGap = StartTime - EvItr->Time;
-			if(TimeGap < MaxPreGraspEventTimeGap)
-			{
-				// Event will be concatenated
-				EvItr.RemoveCurrent();
-
-				// Check if it was the last event, if so, pause the delay publisher
-				if(RecentlyEndedManipulatorContactEvents.Num() == 0)
-				{
-					GetWorld()->GetTimerManager().ClearTimer(ManipulatorContactDelayTimerHandle);
-				}
-				return true;
-			}
-		}
-	}
-	return false;
+	return FSLOverlapEndDebouncer::GetInstance()->CancelIfRecent(this, Other->GetUniqueID(), StartTime);
 }
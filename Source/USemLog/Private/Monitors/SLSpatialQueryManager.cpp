@@ -0,0 +1,435 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "Monitors/SLSpatialQueryManager.h"
+#include "SLEntitiesManager.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+
+TSharedPtr<FSLSpatialQueryManager> FSLSpatialQueryManager::StaticInstance;
+
+// Constructor
+FSLSpatialQueryManager::FSLSpatialQueryManager() : bIsInit(false), World(nullptr) {}
+
+// Destructor, unbinds from the moving entities
+FSLSpatialQueryManager::~FSLSpatialQueryManager()
+{
+	for (const auto& Entity : Entities)
+	{
+		if (Entity.TransformUpdatedHandle.IsValid())
+		{
+			// Destroyed actors already dropped their bindings
+			if (AActor* Actor = Entity.Actor.Get())
+			{
+				if (USceneComponent* RootComp = Actor->GetRootComponent())
+				{
+					RootComp->TransformUpdated.Remove(Entity.TransformUpdatedHandle);
+				}
+			}
+		}
+	}
+}
+
+// Get singleton
+FSLSpatialQueryManager* FSLSpatialQueryManager::GetInstance()
+{
+	if (!StaticInstance.IsValid())
+	{
+		StaticInstance = MakeShareable(new FSLSpatialQueryManager());
+	}
+	return StaticInstance.Get();
+}
+
+// Delete instance
+void FSLSpatialQueryManager::DeleteInstance()
+{
+	StaticInstance.Reset();
+}
+
+// Init with the world, adds the semantic entities to the grid
+void FSLSpatialQueryManager::Init(UWorld* InWorld)
+{
+	if (!bIsInit && InWorld)
+	{
+		World = InWorld;
+
+		// Make sure the semantic entities are set
+		if (!FSLEntitiesManager::GetInstance()->IsInit())
+		{
+			FSLEntitiesManager::GetInstance()->Init(InWorld);
+		}
+
+		TArray<AStaticMeshActor*> SMActors;
+		FSLEntitiesManager::GetInstance()->GetStaticMeshActors(SMActors);
+		Entities.Reserve(SMActors.Num());
+		for (AStaticMeshActor* SMA : SMActors)
+		{
+			USceneComponent* RootComp = SMA->GetRootComponent();
+			if (!RootComp)
+			{
+				continue;
+			}
+
+			const int32 EntityIdx = Entities.AddDefaulted();
+			FSLGridEntity& Entity = Entities[EntityIdx];
+			Entity.Actor = SMA;
+			Entity.Location = SMA->GetActorLocation();
+
+			// The bounds sphere does not have to be centered on the actor location
+			Entity.Radius = RootComp->Bounds.SphereRadius + FVector::Distance(RootComp->Bounds.Origin, Entity.Location);
+			Entity.bIsLarge = Entity.Radius > CellSize;
+			if (Entity.bIsLarge)
+			{
+				LargeEntities.Add(EntityIdx);
+			}
+			else
+			{
+				Entity.Cell = GetCell(Entity.Location);
+				Cells.FindOrAdd(Entity.Cell).Add(EntityIdx);
+			}
+			ActorToEntityIdx.Add(SMA, EntityIdx);
+
+			// Static entities are bucketed once, the movable ones report their moves
+			if (SMA->IsRootComponentMovable())
+			{
+				Entity.TransformUpdatedHandle = RootComp->TransformUpdated.AddRaw(
+					this, &FSLSpatialQueryManager::OnEntityMoved, EntityIdx);
+			}
+		}
+
+		bIsInit = true;
+	}
+}
+
+// Add a query around the component, returns its handle (INDEX_NONE if the manager is not init)
+int32 FSLSpatialQueryManager::AddQuery(USceneComponent* InOrigin, float InRadius, float InMinTrendDist, float InUpdateRate,
+	const FSLSpatialQueryResultSignature& InOnResult)
+{
+	if (!bIsInit || !InOrigin)
+	{
+		return INDEX_NONE;
+	}
+
+	FSLSpatialQuery Query;
+	Query.Origin = InOrigin;
+	Query.Radius = InRadius;
+	Query.MinTrendDist = InMinTrendDist;
+	Query.UpdateRate = InUpdateRate;
+	Query.TimeSinceLastUpdate = 0.f;
+	Query.bIsPaused = false;
+	Query.OnResult = InOnResult;
+	return Queries.Add(MoveTemp(Query));
+}
+
+// Remove the query
+void FSLSpatialQueryManager::RemoveQuery(int32 QueryHandle)
+{
+	if (Queries.IsValidIndex(QueryHandle))
+	{
+		Queries.RemoveAt(QueryHandle);
+	}
+}
+
+// Pause or resume the updates of the query
+void FSLSpatialQueryManager::SetQueryPaused(int32 QueryHandle, bool bPaused)
+{
+	if (Queries.IsValidIndex(QueryHandle))
+	{
+		FSLSpatialQuery& Query = Queries[QueryHandle];
+		if (Query.bIsPaused != bPaused)
+		{
+			Query.bIsPaused = bPaused;
+			Query.TimeSinceLastUpdate = 0.f;
+
+			// The entities found after the pause start from their new distances
+			Query.RefDistances.Empty();
+			for (const auto& Entity : Query.TrackedEntities)
+			{
+				if (Entity.IsValid() && Query.Origin.IsValid())
+				{
+					Query.RefDistances.Add(Entity,
+						FVector::Distance(Query.Origin->GetComponentLocation(), GetEntityLocation(Entity.Get())));
+				}
+			}
+		}
+	}
+}
+
+// Track the distance of the entity to the query origin (starts from the current distance)
+void FSLSpatialQueryManager::TrackEntity(int32 QueryHandle, AActor* InEntity)
+{
+	if (Queries.IsValidIndex(QueryHandle) && InEntity)
+	{
+		FSLSpatialQuery& Query = Queries[QueryHandle];
+		if (Query.Origin.IsValid())
+		{
+			Query.TrackedEntities.Add(InEntity);
+			Query.RefDistances.Add(InEntity,
+				FVector::Distance(Query.Origin->GetComponentLocation(), GetEntityLocation(InEntity)));
+		}
+	}
+}
+
+// Stop tracking the entity
+void FSLSpatialQueryManager::UntrackEntity(int32 QueryHandle, AActor* InEntity)
+{
+	if (Queries.IsValidIndex(QueryHandle))
+	{
+		FSLSpatialQuery& Query = Queries[QueryHandle];
+		if (Query.TrackedEntities.Remove(InEntity) > 0)
+		{
+			Query.RefDistances.Remove(InEntity);
+		}
+	}
+}
+
+// Stop tracking all the entities of the query
+void FSLSpatialQueryManager::UntrackAllEntities(int32 QueryHandle)
+{
+	if (Queries.IsValidIndex(QueryHandle))
+	{
+		FSLSpatialQuery& Query = Queries[QueryHandle];
+		for (const auto& Entity : Query.TrackedEntities)
+		{
+			Query.RefDistances.Remove(Entity);
+		}
+		Query.TrackedEntities.Empty();
+	}
+}
+
+/** Begin FTickableGameObject interface */
+// Called after ticking all actors, DeltaTime is the time passed since the last call.
+void FSLSpatialQueryManager::Tick(float DeltaTime)
+{
+	// Check which queries are due
+	TArray<int32> DueQueries;
+	for (auto QueryItr(Queries.CreateIterator()); QueryItr; ++QueryItr)
+	{
+		if (QueryItr->bIsPaused)
+		{
+			continue;
+		}
+
+		QueryItr->TimeSinceLastUpdate += DeltaTime;
+		if (QueryItr->TimeSinceLastUpdate > QueryItr->UpdateRate)
+		{
+			QueryItr->TimeSinceLastUpdate = 0.f;
+
+			// Skip the queries of destroyed origins (removed by their owners)
+			if (QueryItr->Origin.IsValid())
+			{
+				DueQueries.Add(QueryItr.GetIndex());
+			}
+		}
+	}
+
+	if (DueQueries.Num() == 0)
+	{
+		return;
+	}
+
+	// Update the grid once for all queries
+	UpdateGrid();
+
+	// Run all queries before publishing, the listeners might change the queries in the callbacks
+	TArray<FVector> Origins;
+	TArray<TArray<FSLSpatialQueryHit>> Results;
+	Origins.SetNum(DueQueries.Num());
+	Results.SetNum(DueQueries.Num());
+	for (int32 Idx = 0; Idx < DueQueries.Num(); ++Idx)
+	{
+		FSLSpatialQuery& Query = Queries[DueQueries[Idx]];
+		Origins[Idx] = Query.Origin->GetComponentLocation();
+		RunQuery(Query, Origins[Idx], Results[Idx]);
+	}
+
+	const float Time = World->GetTimeSeconds();
+	for (int32 Idx = 0; Idx < DueQueries.Num(); ++Idx)
+	{
+		if (Queries.IsValidIndex(DueQueries[Idx]))
+		{
+			Queries[DueQueries[Idx]].OnResult.ExecuteIfBound(Origins[Idx], Results[Idx], Time);
+		}
+	}
+}
+
+// Return if object is ready to be ticked
+bool FSLSpatialQueryManager::IsTickable() const
+{
+	return bIsInit && Queries.Num() > 0;
+}
+
+// Return the world the manager is ticked with (ticked by the world tick, also when the world is ticked manually)
+UWorld* FSLSpatialQueryManager::GetTickableGameObjectWorld() const
+{
+	return World;
+}
+
+// Return the stat id to use for this tickable
+TStatId FSLSpatialQueryManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(FSLSpatialQueryManager, STATGROUP_Tickables);
+}
+/** End FTickableGameObject interface */
+
+// Called by the root component of a movable entity when its transform changes
+void FSLSpatialQueryManager::OnEntityMoved(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags,
+	ETeleportType Teleport, int32 EntityIdx)
+{
+	// The location is read once per grid update, no matter how many times the entity moved
+	MovedEntities.Add(EntityIdx);
+}
+
+// Re-bucket the moved entities
+void FSLSpatialQueryManager::UpdateGrid()
+{
+	for (const int32 EntityIdx : MovedEntities)
+	{
+		FSLGridEntity& Entity = Entities[EntityIdx];
+		AActor* Actor = Entity.Actor.Get();
+		if (!Actor)
+		{
+			continue;
+		}
+		Entity.Location = Actor->GetActorLocation();
+
+		// Move to the new cell
+		if (!Entity.bIsLarge)
+		{
+			const FIntVector CurrCell = GetCell(Entity.Location);
+			if (CurrCell != Entity.Cell)
+			{
+				if (TArray<int32>* PrevCellEntities = Cells.Find(Entity.Cell))
+				{
+					PrevCellEntities->RemoveSingleSwap(EntityIdx, false);
+					if (PrevCellEntities->Num() == 0)
+					{
+						Cells.Remove(Entity.Cell);
+					}
+				}
+				Cells.FindOrAdd(CurrCell).Add(EntityIdx);
+				Entity.Cell = CurrCell;
+			}
+		}
+	}
+	MovedEntities.Reset();
+}
+
+// Run the query, output the hits
+void FSLSpatialQueryManager::RunQuery(FSLSpatialQuery& Query, const FVector& Origin, TArray<FSLSpatialQueryHit>& OutHits) const
+{
+	// Remove the destroyed tracked entities
+	for (auto TrackedItr(Query.TrackedEntities.CreateIterator()); TrackedItr; ++TrackedItr)
+	{
+		if (!TrackedItr->IsValid())
+		{
+			Query.RefDistances.Remove(*TrackedItr);
+			TrackedItr.RemoveCurrent();
+		}
+	}
+
+	// Entities within the radius, the reference distance is kept while they are in the radius
+	if (Query.Radius > 0.f)
+	{
+		TSet<AActor*> InRadius;
+
+		// The bucketed entities are at most a cell large, their locations can be outside the radius by that much
+		const FIntVector MinCell = GetCell(Origin - FVector(Query.Radius + CellSize));
+		const FIntVector MaxCell = GetCell(Origin + FVector(Query.Radius + CellSize));
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+			{
+				for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+				{
+					if (const TArray<int32>* CellEntities = Cells.Find(FIntVector(X, Y, Z)))
+					{
+						for (const int32 EntityIdx : *CellEntities)
+						{
+							TestEntity(Query, Origin, Entities[EntityIdx], InRadius, OutHits);
+						}
+					}
+				}
+			}
+		}
+		for (const int32 EntityIdx : LargeEntities)
+		{
+			TestEntity(Query, Origin, Entities[EntityIdx], InRadius, OutHits);
+		}
+
+		// Forget the reference distances of the entities which left the radius (or were destroyed)
+		for (auto RefItr(Query.RefDistances.CreateIterator()); RefItr; ++RefItr)
+		{
+			if (!InRadius.Contains(RefItr->Key.Get()) && !Query.TrackedEntities.Contains(RefItr->Key))
+			{
+				RefItr.RemoveCurrent();
+			}
+		}
+	}
+
+	// Tracked entities are always returned
+	for (const auto& Entity : Query.TrackedEntities)
+	{
+		const float Dist = FVector::Distance(Origin, GetEntityLocation(Entity.Get()));
+		OutHits.Emplace(Entity.Get(), Dist, UpdateTrend(Query.RefDistances.FindOrAdd(Entity), Dist, Query.MinTrendDist));
+	}
+}
+
+// Add the entity to the hits if it is within the radius of the query
+void FSLSpatialQueryManager::TestEntity(FSLSpatialQuery& Query, const FVector& Origin, const FSLGridEntity& Entity,
+	TSet<AActor*>& OutInRadius, TArray<FSLSpatialQueryHit>& OutHits) const
+{
+	AActor* Actor = Entity.Actor.Get();
+	if (!Actor || Actor == Query.Origin->GetOwner() || Query.TrackedEntities.Contains(Actor))
+	{
+		return;
+	}
+
+	// The entity is in the radius if its bounds are
+	const float Dist = FVector::Distance(Origin, Entity.Location);
+	if (Dist - Entity.Radius < Query.Radius)
+	{
+		OutInRadius.Add(Actor);
+		if (float* RefDist = Query.RefDistances.Find(Actor))
+		{
+			OutHits.Emplace(Actor, Dist, UpdateTrend(*RefDist, Dist, Query.MinTrendDist));
+		}
+		else
+		{
+			Query.RefDistances.Add(Actor, Dist);
+			OutHits.Emplace(Actor, Dist, ESLDistanceTrend::Idle);
+		}
+	}
+}
+
+// Get the location of the entity (the cached one if it is in the grid)
+FVector FSLSpatialQueryManager::GetEntityLocation(AActor* InEntity) const
+{
+	if (const int32* EntityIdx = ActorToEntityIdx.Find(InEntity))
+	{
+		// The address could belong to a new actor if the entity was destroyed
+		const FSLGridEntity& Entity = Entities[*EntityIdx];
+		if (Entity.Actor.Get() == InEntity && !MovedEntities.Contains(*EntityIdx))
+		{
+			return Entity.Location;
+		}
+	}
+	return InEntity->GetActorLocation();
+}
+
+// Compute the trend against the reference distance, updates the reference on significant changes
+ESLDistanceTrend FSLSpatialQueryManager::UpdateTrend(float& RefDistance, float CurrDistance, float MinTrendDist)
+{
+	const float DiffDist = RefDistance - CurrDistance;
+	if (DiffDist > MinTrendDist)
+	{
+		RefDistance = CurrDistance;
+		return ESLDistanceTrend::Closer;
+	}
+	else if (DiffDist < -MinTrendDist)
+	{
+		RefDistance = CurrDistance;
+		return ESLDistanceTrend::Further;
+	}
+	return ESLDistanceTrend::Idle;
+}
@@ -0,0 +1,187 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "Monitors/SLSupportedByManager.h"
+#include "Monitors/SLContactShapeInterface.h"
+#include "Components/MeshComponent.h"
+
+TSharedPtr<FSLSupportedByManager> FSLSupportedByManager::StaticInstance;
+
+// Get the vertical velocity of the component, sleeping rigid bodies are not queried
+static FORCEINLINE float GetVerticalVelocity(UPrimitiveComponent* Comp)
+{
+	if (Comp->IsSimulatingPhysics())
+	{
+		// Idle (sleeping) bodies do not move, avoid querying the physics scene
+		return Comp->IsAnyRigidBodyAwake() ? Comp->GetComponentVelocity().Z : 0.f;
+	}
+	return Comp->GetComponentVelocity().Z;
+}
+
+// Constructor
+FSLSupportedByManager::FSLSupportedByManager() : bIsInit(false), World(nullptr), TimeSinceLastUpdate(0.f) {}
+
+// Get singleton
+FSLSupportedByManager* FSLSupportedByManager::GetInstance()
+{
+	if (!StaticInstance.IsValid())
+	{
+		StaticInstance = MakeShareable(new FSLSupportedByManager());
+	}
+	return StaticInstance.Get();
+}
+
+// Delete instance
+void FSLSupportedByManager::DeleteInstance()
+{
+	StaticInstance.Reset();
+}
+
+// Init with the world
+void FSLSupportedByManager::Init(UWorld* InWorld)
+{
+	if (!bIsInit && InWorld)
+	{
+		World = InWorld;
+		bIsInit = true;
+	}
+}
+
+// Add a supported by candidate of the shape (Self is the owner of the shape)
+void FSLSupportedByManager::AddCandidate(ISLContactShapeInterface* InShape, const FSLContactResult& InCandidate)
+{
+	if (!bIsInit)
+	{
+		return;
+	}
+
+	CandidateShapes.Emplace(InShape);
+	CandidateResults.Emplace(InCandidate);
+	SelfVelZ.AddUninitialized();
+	OtherVelZ.AddUninitialized();
+	SelfZ.AddUninitialized();
+	OtherZ.AddUninitialized();
+	bIsCandidateValid.Emplace(true);
+}
+
+// Remove the candidate of the shape, return false if the pair is not a candidate
+bool FSLSupportedByManager::RemoveCandidate(ISLContactShapeInterface* InShape, UObject* InOther)
+{
+	for (int32 Idx = 0; Idx < CandidateShapes.Num(); ++Idx)
+	{
+		if (CandidateShapes[Idx] == InShape && CandidateResults[Idx].Other.Obj == InOther)
+		{
+			RemoveCandidateAt(Idx);
+			return true;
+		}
+	}
+	return false;
+}
+
+// Remove all the candidates of the shape
+void FSLSupportedByManager::RemoveCandidates(ISLContactShapeInterface* InShape)
+{
+	for (int32 Idx = CandidateShapes.Num() - 1; Idx >= 0; --Idx)
+	{
+		if (CandidateShapes[Idx] == InShape)
+		{
+			RemoveCandidateAt(Idx);
+		}
+	}
+}
+
+/** Begin FTickableGameObject interface */
+// Called after ticking all actors, DeltaTime is the time passed since the last call.
+void FSLSupportedByManager::Tick(float DeltaTime)
+{
+	TimeSinceLastUpdate += DeltaTime;
+	if (TimeSinceLastUpdate > UpdateRate)
+	{
+		TimeSinceLastUpdate = 0.f;
+		Update();
+	}
+}
+
+// Return if object is ready to be ticked
+bool FSLSupportedByManager::IsTickable() const
+{
+	// Sleep while there are no candidates
+	return bIsInit && CandidateShapes.Num() > 0;
+}
+
+// Return the world the manager is ticked with (ticked by the world tick, also when the world is ticked manually)
+UWorld* FSLSupportedByManager::GetTickableGameObjectWorld() const
+{
+	return World;
+}
+
+// Return the stat id to use for this tickable
+TStatId FSLSupportedByManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(FSLSupportedByManager, STATGROUP_Tickables);
+}
+/** End FTickableGameObject interface */
+
+// Evaluate all the candidates in one batch
+void FSLSupportedByManager::Update()
+{
+	// Read the data of all candidates
+	GatherCandidatesData();
+
+	// Check which candidates are in a supported by event
+	const float Time = World->GetTimeSeconds();
+	for (int32 Idx = CandidateShapes.Num() - 1; Idx >= 0; --Idx)
+	{
+		if (!bIsCandidateValid[Idx])
+		{
+			RemoveCandidateAt(Idx);
+			continue;
+		}
+
+		// Check that the relative speed on Z between the two objects is smaller than the threshold
+		if (FMath::Abs(SelfVelZ[Idx] - OtherVelZ[Idx]) < MaxVertSpeed)
+		{
+			const FSLContactResult& Candidate = CandidateResults[Idx];
+
+			// Other can only support if it is not a contact shape, otherwise use a simple height comparison
+			const bool bIsSelfSupported = !Candidate.bIsOtherASemanticOverlapArea || SelfZ[Idx] > OtherZ[Idx];
+			CandidateShapes[Idx]->OnSupportedByCandidateResolved(Candidate, bIsSelfSupported, Time);
+
+			// Remove candidate, it is now part of a started event
+			RemoveCandidateAt(Idx);
+		}
+	}
+}
+
+// Read the velocities and heights of the candidates
+void FSLSupportedByManager::GatherCandidatesData()
+{
+	for (int32 Idx = 0; Idx < CandidateResults.Num(); ++Idx)
+	{
+		UMeshComponent* SelfComp = CandidateResults[Idx].SelfMeshComponent.Get();
+		UMeshComponent* OtherComp = CandidateResults[Idx].OtherMeshComponent.Get();
+		if (SelfComp && OtherComp)
+		{
+			SelfVelZ[Idx] = GetVerticalVelocity(SelfComp);
+			OtherVelZ[Idx] = GetVerticalVelocity(OtherComp);
+			SelfZ[Idx] = SelfComp->GetComponentLocation().Z;
+			OtherZ[Idx] = OtherComp->GetComponentLocation().Z;
+		}
+		else
+		{
+			bIsCandidateValid[Idx] = false;
+		}
+	}
+}
+
+// Remove candidate at the given index (swaps with the last one)
+void FSLSupportedByManager::RemoveCandidateAt(int32 Index)
+{
+	CandidateShapes.RemoveAtSwap(Index, 1, false);
+	CandidateResults.RemoveAtSwap(Index, 1, false);
+	SelfVelZ.RemoveAtSwap(Index, 1, false);
+	OtherVelZ.RemoveAtSwap(Index, 1, false);
+	SelfZ.RemoveAtSwap(Index, 1, false);
+	OtherZ.RemoveAtSwap(Index, 1, false);
+	bIsCandidateValid.RemoveAtSwap(Index, 1, false);
+}
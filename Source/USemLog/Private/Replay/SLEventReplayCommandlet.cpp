@@ -0,0 +1,634 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "Replay/SLEventReplayCommandlet.h"
+#include "Replay/SLWorldStateReader.h"
+#include "SLEventLogger.h"
+#include "SLManager.h"
+#include "SLEntitiesManager.h"
+#include "SLArticulationGraph.h"
+#include "Monitors/SLSupportedByManager.h"
+#include "Monitors/SLOverlapEndDebouncer.h"
+#include "Monitors/SLContactBroadphase.h"
+#include "Monitors/SLSpatialQueryManager.h"
+#include "Monitors/SLManipulatorListener.h"
+#include "Monitors/SLPickAndPlaceListener.h"
+#include "Skeletal/SLSkeletalDataComponent.h"
+#include "Events/SLEventPool.h"
+#include "Events/SLEventIndex.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Components/PrimitiveComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "EngineUtils.h"
+#include "UObject/UObjectIterator.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+// Ctor
+USLEventReplayCommandlet::USLEventReplayCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+
+	bFromJson = false;
+	ServerIp = TEXT("127.0.0.1");
+	ServerPort = 27017;
+	MaxStep = 0.033f;
+	ExperimentTemplateType = ESLOwlExperimentTemplate::Default;
+	bLogContactEvents = true;
+	bLogSupportedByEvents = true;
+	bLogGraspEvents = true;
+	bLogPickAndPlaceEvents = true;
+	bLogSlicingEvents = false;
+	bWriteTimelines = false;
+	bUseContactBroadphase = false;
+	WorkerTimeout = 0.f;
+	bCheckEvents = false;
+	CheckTolerance = 0.1f;
+}
+
+// Commandlet entry point
+int32 USLEventReplayCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	ParseCommandLine(*Params, Tokens, Switches);
+	CmdLineParams = Params;
+
+	FString EpisodesStr;
+	if (!FParse::Value(*Params, TEXT("Map="), MapName) || !FParse::Value(*Params, TEXT("Episodes="), EpisodesStr))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Usage: -run=SLEventReplay -Map=<MapPackage> -TaskId=<TaskId> -Episodes=<Id>[+<Id>..] [-Workers=N].."),
+			*FString(__func__), __LINE__);
+		return 1;
+	}
+
+	TArray<FString> Episodes;
+	EpisodesStr.ParseIntoArray(Episodes, TEXT("+"), true);
+
+	FParse::Value(*Params, TEXT("TaskId="), TaskId);
+	FParse::Value(*Params, TEXT("ServerIp="), ServerIp);
+	FParse::Value(*Params, TEXT("ServerPort="), ServerPort);
+	FParse::Value(*Params, TEXT("MaxStep="), MaxStep);
+	MaxStep = FMath::Max(MaxStep, KINDA_SMALL_NUMBER);
+
+	FString Source;
+	if (FParse::Value(*Params, TEXT("Source="), Source))
+	{
+		bFromJson = Source.Equals(TEXT("Json"), ESearchCase::IgnoreCase);
+	}
+
+	FString TemplateName;
+	if (FParse::Value(*Params, TEXT("Template="), TemplateName))
+	{
+		const int64 TemplateValue = StaticEnum<ESLOwlExperimentTemplate>()->GetValueByNameString(TemplateName);
+		if (TemplateValue != INDEX_NONE)
+		{
+			ExperimentTemplateType = static_cast<ESLOwlExperimentTemplate>(TemplateValue);
+		}
+	}
+
+	bLogContactEvents = !FParse::Param(*Params, TEXT("NoContacts"));
+	bLogSupportedByEvents = !FParse::Param(*Params, TEXT("NoSupportedBy"));
+	bLogGraspEvents = !FParse::Param(*Params, TEXT("NoGrasps"));
+	bLogPickAndPlaceEvents = !FParse::Param(*Params, TEXT("NoPickAndPlace"));
+	bLogSlicingEvents = FParse::Param(*Params, TEXT("Slicing"));
+	bWriteTimelines = FParse::Param(*Params, TEXT("Timelines"));
+	bUseContactBroadphase = FParse::Param(*Params, TEXT("Broadphase"));
+	bCheckEvents = FParse::Param(*Params, TEXT("Check"));
+	FParse::Value(*Params, TEXT("CheckTolerance="), CheckTolerance);
+	FParse::Value(*Params, TEXT("WorkerTimeout="), WorkerTimeout);
+
+	// Several episodes are replayed in parallel worker processes
+	int32 NumWorkers = 1;
+	FParse::Value(*Params, TEXT("Workers="), NumWorkers);
+	if (Episodes.Num() > 1 && NumWorkers > 1)
+	{
+		return RunWorkers(Episodes, NumWorkers, Switches);
+	}
+
+	int32 NumFailed = 0;
+	for (const FString& EpisodeId : Episodes)
+	{
+		if (!ReplayEpisode(EpisodeId))
+		{
+			NumFailed++;
+		}
+	}
+	return NumFailed;
+}
+
+// Run one worker process per episode (at most NumWorkers at the same time), returns the number of failed episodes
+int32 USLEventReplayCommandlet::RunWorkers(const TArray<FString>& Episodes, int32 NumWorkers, const TArray<FString>& Switches) const
+{
+	// Forward all the switches except the episodes and the workers
+	FString SharedArgs = TEXT("-run=SLEventReplay -unattended -nopause -nullrhi");
+	for (const FString& Switch : Switches)
+	{
+		if (!Switch.StartsWith(TEXT("Episodes="), ESearchCase::IgnoreCase) &&
+			!Switch.StartsWith(TEXT("Workers="), ESearchCase::IgnoreCase) &&
+			!Switch.StartsWith(TEXT("WorkerTimeout="), ESearchCase::IgnoreCase) &&
+			!Switch.StartsWith(TEXT("run="), ESearchCase::IgnoreCase))
+		{
+			SharedArgs += TEXT(" -") + Switch;
+		}
+	}
+	const FString ProjectPath = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
+
+	// Running workers with their start time
+	TArray<TTuple<FString, FProcHandle, double>> Running;
+	int32 NextEpisodeIdx = 0;
+	int32 NumFailed = 0;
+	while (NextEpisodeIdx < Episodes.Num() || Running.Num() > 0)
+	{
+		// Fill the free slots
+		while (NextEpisodeIdx < Episodes.Num() && Running.Num() < NumWorkers)
+		{
+			const FString& EpisodeId = Episodes[NextEpisodeIdx++];
+			const FString Args = FString::Printf(TEXT("\"%s\" %s -Episodes=%s"), *ProjectPath, *SharedArgs, *EpisodeId);
+			FProcHandle Proc = FPlatformProcess::CreateProc(FPlatformProcess::ExecutablePath(), *Args,
+				false, true, true, nullptr, 0, nullptr, nullptr);
+			if (Proc.IsValid())
+			{
+				UE_LOG(LogTemp, Display, TEXT("%s::%d Started worker for episode %s.."), *FString(__func__), __LINE__, *EpisodeId);
+				Running.Emplace(EpisodeId, Proc, FPlatformTime::Seconds());
+			}
+			else
+			{
+				UE_LOG(LogTemp, Error, TEXT("%s::%d Could not start worker for episode %s.."), *FString(__func__), __LINE__, *EpisodeId);
+				NumFailed++;
+			}
+		}
+
+		// Collect the finished workers, kill the ones running past the timeout
+		for (int32 Idx = Running.Num() - 1; Idx >= 0; --Idx)
+		{
+			const FString& EpisodeId = Running[Idx].Get<0>();
+			FProcHandle& Proc = Running[Idx].Get<1>();
+			if (!FPlatformProcess::IsProcRunning(Proc))
+			{
+				int32 ReturnCode = 0;
+				FPlatformProcess::GetProcReturnCode(Proc, &ReturnCode);
+				if (ReturnCode != 0)
+				{
+					UE_LOG(LogTemp, Error, TEXT("%s::%d Worker for episode %s failed (%d).."),
+						*FString(__func__), __LINE__, *EpisodeId, ReturnCode);
+					NumFailed++;
+				}
+				FPlatformProcess::CloseProc(Proc);
+				Running.RemoveAtSwap(Idx);
+			}
+			else if (WorkerTimeout > 0.f && FPlatformTime::Seconds() - Running[Idx].Get<2>() > WorkerTimeout)
+			{
+				UE_LOG(LogTemp, Error, TEXT("%s::%d Worker for episode %s did not finish in %.0fs, killing it.."),
+					*FString(__func__), __LINE__, *EpisodeId, WorkerTimeout);
+				FPlatformProcess::TerminateProc(Proc, true);
+				FPlatformProcess::CloseProc(Proc);
+				Running.RemoveAtSwap(Idx);
+				NumFailed++;
+			}
+		}
+
+		FPlatformProcess::Sleep(0.1f);
+	}
+	return NumFailed;
+}
+
+// Replay the episode in the map and write its events, returns true on success
+bool USLEventReplayCommandlet::ReplayEpisode(const FString& EpisodeId)
+{
+	UWorld* World = LoadReplayWorld();
+	if (!World)
+	{
+		return false;
+	}
+
+	if (TaskId.IsEmpty())
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d No task id given and no semantic logging manager in the map.."), *FString(__func__), __LINE__);
+		UnloadReplayWorld(World);
+		return false;
+	}
+
+	// Read the recorded world state
+	TArray<FSLWorldStateFrame> Frames;
+	const bool bRead = bFromJson
+		? FSLWorldStateReader::ReadFromJsonFile(TaskId, EpisodeId, Frames)
+		: FSLWorldStateReader::ReadFromMongo(TaskId, EpisodeId, ServerIp, ServerPort, Frames);
+	if (!bRead)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Could not read the world state of episode %s.."), *FString(__func__), __LINE__, *EpisodeId);
+		UnloadReplayWorld(World);
+		return false;
+	}
+
+	// The replay overwrites the events of the live episode
+	FSLEventIndex LiveIndex;
+	if (bCheckEvents && !LoadLiveIndex(EpisodeId, LiveIndex))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d No live events index of episode %s to check against.."), *FString(__func__), __LINE__, *EpisodeId);
+		UnloadReplayWorld(World);
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Same setup as the manager, the events are written to SemLog/<TaskId>/<EpisodeId>_ED.owl
+	FSLEntitiesManager::GetInstance()->Init(World);
+	ApplyMonitorOverrides(World);
+
+	// The world clock starts at the first entry, the events begin at the recorded times
+	SetWorldTime(World, Frames[0].Timestamp);
+
+	USLEventLogger* EventLogger = NewObject<USLEventLogger>(World);
+	EventLogger->Init(ExperimentTemplateType, FSLEventWriterParams(TaskId, EpisodeId),
+		bLogContactEvents, bLogSupportedByEvents, bLogGraspEvents, bLogPickAndPlaceEvents, bLogSlicingEvents, bWriteTimelines,
+		bUseContactBroadphase);
+	EventLogger->Start();
+
+	ReplayFrames(World, Frames);
+	if (!DrainPendingEvents(World))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d Episode %s still had pending events after %.2fs, they are published with the finish.."),
+			*FString(__func__), __LINE__, *EpisodeId, MaxDrainDuration);
+	}
+
+	EventLogger->Finish(World->GetTimeSeconds());
+
+	UE_LOG(LogTemp, Display, TEXT("%s::%d Episode %s (%d entries, %.2fs recorded) replayed in %.2fs.."),
+		*FString(__func__), __LINE__, *EpisodeId, Frames.Num(), World->GetTimeSeconds(), FPlatformTime::Seconds() - StartTime);
+
+	const bool bCheckPassed = !bCheckEvents || CheckEventCounts(EpisodeId, LiveIndex);
+
+	UnloadReplayWorld(World);
+	return bCheckPassed;
+}
+
+// Load the map as a game world without any semantic logging manager
+UWorld* USLEventReplayCommandlet::LoadReplayWorld()
+{
+	UPackage* Package = LoadPackage(nullptr, *MapName, LOAD_None);
+	UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+	if (!World)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Could not load map %s.."), *FString(__func__), __LINE__, *MapName);
+		return nullptr;
+	}
+
+	World->AddToRoot();
+	World->WorldType = EWorldType::Game;
+	if (!World->bIsWorldInitialized)
+	{
+		World->InitWorld(UWorld::InitializationValues()
+			.AllowAudioPlayback(false)
+			.RequiresHitProxies(false)
+			.CreateNavigation(false)
+			.CreateAISystem(false)
+			.ShouldSimulatePhysics(true)
+			.SetTransactional(false));
+	}
+
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	// The manager would start logging in BeginPlay, the commandlet drives the event logger instead
+	for (TActorIterator<ASLManager> ManagerItr(World); ManagerItr; ++ManagerItr)
+	{
+		// Use the task id of the manager if none is given
+		if (TaskId.IsEmpty())
+		{
+			TaskId = ManagerItr->GetTaskId();
+		}
+		World->DestroyActor(*ManagerItr);
+	}
+
+	World->UpdateWorldComponents(true, false);
+	World->SetGameMode(FURL());
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+	return World;
+}
+
+// Tear down the replay world and the semantic logging singletons
+void USLEventReplayCommandlet::UnloadReplayWorld(UWorld* World) const
+{
+	FSLEntitiesManager::DeleteInstance();
+	FSLSupportedByManager::DeleteInstance();
+	FSLOverlapEndDebouncer::DeleteInstance();
+	FSLContactBroadphase::DeleteInstance();
+	FSLSpatialQueryManager::DeleteInstance();
+	FSLArticulationGraph::DeleteInstance();
+	FSLEventPool::DeleteInstance();
+
+	World->EndPlay(EEndPlayReason::Quit);
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	World->RemoveFromRoot();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+// Apply the command line overrides to the monitors of the world (before the event logger inits them)
+void USLEventReplayCommandlet::ApplyMonitorOverrides(UWorld* World) const
+{
+	for (TObjectIterator<USLPickAndPlaceListener> Itr; Itr; ++Itr)
+	{
+		if (Itr->GetWorld() == World)
+		{
+			FSLPaPThresholds Thresholds = Itr->GetThresholds();
+			FParse::Value(*CmdLineParams, TEXT("PaPUpdateRate="), Thresholds.UpdateRate);
+			FParse::Value(*CmdLineParams, TEXT("PaPMinSlideDistXY="), Thresholds.MinSlideDistXY);
+			FParse::Value(*CmdLineParams, TEXT("PaPMinSlideDuration="), Thresholds.MinSlideDuration);
+			FParse::Value(*CmdLineParams, TEXT("PaPMaxPickUpDistXY="), Thresholds.MaxPickUpDistXY);
+			FParse::Value(*CmdLineParams, TEXT("PaPMinPickUpHeight="), Thresholds.MinPickUpHeight);
+			FParse::Value(*CmdLineParams, TEXT("PaPMaxPickUpHeight="), Thresholds.MaxPickUpHeight);
+			FParse::Value(*CmdLineParams, TEXT("PaPRecentMovementBufferSize="), Thresholds.RecentMovementBufferSize);
+			FParse::Value(*CmdLineParams, TEXT("PaPRecentMovementBufferDuration="), Thresholds.RecentMovementBufferDuration);
+			FParse::Value(*CmdLineParams, TEXT("PaPPutDownMovementBacktrackDuration="), Thresholds.PutDownMovementBacktrackDuration);
+			FParse::Value(*CmdLineParams, TEXT("PaPMinPutDownHeight="), Thresholds.MinPutDownHeight);
+			FParse::Value(*CmdLineParams, TEXT("PaPMaxPutDownHeight="), Thresholds.MaxPutDownHeight);
+			FParse::Value(*CmdLineParams, TEXT("PaPMaxPutDownDistXY="), Thresholds.MaxPutDownDistXY);
+			Itr->SetThresholds(Thresholds);
+		}
+	}
+
+	// There is no trigger input to replay, the grasps follow the finger bones
+	for (TObjectIterator<USLManipulatorListener> Itr; Itr; ++Itr)
+	{
+		if (Itr->GetWorld() == World)
+		{
+			Itr->SetIgnoreGraspInput(true);
+		}
+	}
+}
+
+// Set the world clock without ticking (the replay starts at the first recorded entry)
+void USLEventReplayCommandlet::SetWorldTime(UWorld* World, float Time) const
+{
+	World->TimeSeconds = Time;
+	World->UnpausedTimeSeconds = Time;
+	World->RealTimeSeconds = Time;
+	World->AudioTimeSeconds = Time;
+}
+
+// Move the recorded entities and bones, advance the world time until the next frame
+void USLEventReplayCommandlet::ReplayFrames(UWorld* World, const TArray<FSLWorldStateFrame>& Frames) const
+{
+	// Map the logged ids to the moved components (actors are moved by their root)
+	TMap<FString, USceneComponent*> IdToComponent;
+	for (const auto& Pair : FSLEntitiesManager::GetInstance()->GetObjectsSemanticData())
+	{
+		USceneComponent* SceneComp = Cast<USceneComponent>(Pair.Key);
+		if (AActor* AsActor = Cast<AActor>(Pair.Key))
+		{
+			SceneComp = AsActor->GetRootComponent();
+		}
+		if (SceneComp)
+		{
+			IdToComponent.Emplace(Pair.Value.Id, SceneComp);
+
+			// The recorded poses are applied kinematically
+			if (UPrimitiveComponent* AsPrimitive = Cast<UPrimitiveComponent>(SceneComp))
+			{
+				AsPrimitive->SetSimulatePhysics(false);
+			}
+		}
+	}
+
+	/**
+	 * Replayed skeletal entity, the recorded pose is of its skeletal data component,
+	 * the components attached to the bones (e.g. the finger overlaps) are detached and follow the recorded bones
+	 */
+	struct FSLReplaySkeletal
+	{
+		// Moved root component
+		USceneComponent* Root;
+
+		// Transform of the skeletal data component relative to the root
+		FTransform DataToRoot;
+
+		// Bone attached components and their transform relative to the bone
+		TMultiMap<FName, TPair<USceneComponent*, FTransform>> BoneChildren;
+	};
+	TMap<FString, FSLReplaySkeletal> IdToSkeletal;
+	for (const auto& Pair : FSLEntitiesManager::GetInstance()->GetObjectsSkeletalSemanticData())
+	{
+		USLSkeletalDataComponent* DataComp = Pair.Value;
+		USceneComponent* const* RootPtr = DataComp ? IdToComponent.Find(DataComp->GetId()) : nullptr;
+		if (!RootPtr)
+		{
+			continue;
+		}
+
+		FSLReplaySkeletal& Skeletal = IdToSkeletal.Add(DataComp->GetId());
+		Skeletal.Root = *RootPtr;
+		Skeletal.DataToRoot = DataComp->GetComponentTransform().GetRelativeTransform(Skeletal.Root->GetComponentTransform());
+
+		if (USkeletalMeshComponent* SkelComp = DataComp->SkeletalMeshParent)
+		{
+			SkelComp->SetSimulatePhysics(false);
+
+			TArray<USceneComponent*> Children;
+			SkelComp->GetChildrenComponents(false, Children);
+			for (USceneComponent* Child : Children)
+			{
+				const FName BoneName = SkelComp->GetSocketBoneName(Child->GetAttachSocketName());
+				if (BoneName != NAME_None && SkelComp->GetBoneIndex(BoneName) != INDEX_NONE)
+				{
+					const FTransform ChildToBone = Child->GetComponentTransform().GetRelativeTransform(
+						SkelComp->GetSocketTransform(BoneName));
+					Child->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+					Skeletal.BoneChildren.Add(BoneName, TPair<USceneComponent*, FTransform>(Child, ChildToBone));
+				}
+			}
+		}
+	}
+
+	// Components moved by the current and by the previous entry (the ones not moved again are stopped)
+	TSet<USceneComponent*> MovedComps;
+	TSet<USceneComponent*> PrevMovedComps;
+
+	float CurrTime = Frames.Num() > 0 ? Frames[0].Timestamp : World->GetTimeSeconds();
+	float PrevFrameTime = CurrTime;
+	for (const FSLWorldStateFrame& Frame : Frames)
+	{
+		// Advance in max sized steps until the entry time
+		while (Frame.Timestamp - CurrTime > KINDA_SMALL_NUMBER)
+		{
+			const float Step = FMath::Min(MaxStep, Frame.Timestamp - CurrTime);
+			TickWorld(World, Step);
+			CurrTime += Step;
+		}
+
+		// Only the changed poses are recorded, the displacement happened since the previous entry
+		const float FrameDeltaTime = Frame.Timestamp - PrevFrameTime;
+		PrevFrameTime = Frame.Timestamp;
+		MovedComps.Reset();
+
+		for (const auto& Pose : Frame.Poses)
+		{
+			if (USceneComponent** SceneCompPtr = IdToComponent.Find(Pose.Key))
+			{
+				MoveComponent(*SceneCompPtr, Pose.Value, FrameDeltaTime);
+				MovedComps.Add(*SceneCompPtr);
+			}
+		}
+
+		for (const FSLWorldStateSkeletalPose& SkeletalPose : Frame.SkeletalPoses)
+		{
+			if (const FSLReplaySkeletal* Skeletal = IdToSkeletal.Find(SkeletalPose.Id))
+			{
+				MoveComponent(Skeletal->Root, Skeletal->DataToRoot.Inverse() * SkeletalPose.Pose, FrameDeltaTime);
+				MovedComps.Add(Skeletal->Root);
+
+				TArray<TPair<USceneComponent*, FTransform>> Children;
+				for (const auto& BonePose : SkeletalPose.BonePoses)
+				{
+					Children.Reset();
+					Skeletal->BoneChildren.MultiFind(BonePose.Key, Children);
+					for (const auto& Child : Children)
+					{
+						Child.Key->SetWorldTransform(Child.Value * BonePose.Value, false, nullptr, ETeleportType::TeleportPhysics);
+					}
+				}
+			}
+		}
+
+		for (USceneComponent* SceneComp : PrevMovedComps)
+		{
+			if (!MovedComps.Contains(SceneComp))
+			{
+				SetComponentVelocity(SceneComp, FVector::ZeroVector);
+			}
+		}
+		Swap(MovedComps, PrevMovedComps);
+	}
+}
+
+// Teleport the component to the recorded pose, the velocity is derived from its previous location (kinematic moves do not set it)
+void USLEventReplayCommandlet::MoveComponent(USceneComponent* SceneComp, const FTransform& Pose, float DeltaTime) const
+{
+	const FVector PrevLocation = SceneComp->GetComponentLocation();
+	SceneComp->SetWorldTransform(Pose, false, nullptr, ETeleportType::TeleportPhysics);
+	SetComponentVelocity(SceneComp, DeltaTime > KINDA_SMALL_NUMBER
+		? (Pose.GetLocation() - PrevLocation) / DeltaTime
+		: FVector::ZeroVector);
+}
+
+// Set the velocity of the component and of its attached children
+void USLEventReplayCommandlet::SetComponentVelocity(USceneComponent* SceneComp, const FVector& Velocity) const
+{
+	// The rotation is ignored, the children (e.g. the meshes of the actor) move with the root
+	SceneComp->ComponentVelocity = Velocity;
+	TArray<USceneComponent*> Children;
+	SceneComp->GetChildrenComponents(true, Children);
+	for (USceneComponent* Child : Children)
+	{
+		Child->ComponentVelocity = Velocity;
+	}
+}
+
+// Tick until the pending (delayed) events of the monitors are published, returns false if the max duration was reached
+bool USLEventReplayCommandlet::DrainPendingEvents(UWorld* World) const
+{
+	float DrainedTime = 0.f;
+	while (HasPendingEvents(World))
+	{
+		if (DrainedTime >= MaxDrainDuration)
+		{
+			return false;
+		}
+		TickWorld(World, MaxStep);
+		DrainedTime += MaxStep;
+	}
+	return true;
+}
+
+// True if any monitor still holds delayed events
+bool USLEventReplayCommandlet::HasPendingEvents(UWorld* World) const
+{
+	if (FSLOverlapEndDebouncer::GetInstance()->HasPending())
+	{
+		return true;
+	}
+	for (TObjectIterator<USLManipulatorListener> Itr; Itr; ++Itr)
+	{
+		if (Itr->GetWorld() == World && Itr->HasPendingEvents())
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// Tick the world (the managers are ticked with it)
+void USLEventReplayCommandlet::TickWorld(UWorld* World, float DeltaSeconds) const
+{
+	// The managers return their world as the tickable world, the world tick updates them after the actors
+	World->Tick(LEVELTICK_All, DeltaSeconds);
+}
+
+// Load the events index of the live episode, it is copied aside the first time since the replay overwrites it
+bool USLEventReplayCommandlet::LoadLiveIndex(const FString& EpisodeId, FSLEventIndex& OutIndex) const
+{
+	const FString IndexPath = FSLEventIndex::GetEpisodeFilePath(TaskId, EpisodeId);
+	const FString LiveIndexPath = FPaths::ChangeExtension(IndexPath, TEXT("live.bin"));
+	IFileManager& FileManager = IFileManager::Get();
+	if (!FileManager.FileExists(*LiveIndexPath))
+	{
+		if (!FileManager.FileExists(*IndexPath) || FileManager.Copy(*LiveIndexPath, *IndexPath) != COPY_OK)
+		{
+			return false;
+		}
+	}
+	return OutIndex.LoadFromFile(LiveIndexPath);
+}
+
+// Compare the number of events of each type of the replay with the live episode, returns false on mismatch
+bool USLEventReplayCommandlet::CheckEventCounts(const FString& EpisodeId, const FSLEventIndex& LiveIndex) const
+{
+	FSLEventIndex ReplayIndex;
+	if (!ReplayIndex.LoadFromFile(FSLEventIndex::GetEpisodeFilePath(TaskId, EpisodeId)))
+	{
+		return false;
+	}
+
+	TMap<FString, int32> LiveCounts;
+	TMap<FString, int32> ReplayCounts;
+	LiveIndex.GetTypeCounts(LiveCounts);
+	ReplayIndex.GetTypeCounts(ReplayCounts);
+
+	TSet<FString> TypeNames;
+	for (const auto& Pair : LiveCounts)
+	{
+		TypeNames.Add(Pair.Key);
+	}
+	for (const auto& Pair : ReplayCounts)
+	{
+		TypeNames.Add(Pair.Key);
+	}
+
+	bool bPassed = true;
+	for (const FString& TypeName : TypeNames)
+	{
+		const int32 NumLive = LiveCounts.FindRef(TypeName);
+		const int32 NumReplay = ReplayCounts.FindRef(TypeName);
+		if (FMath::Abs(NumReplay - NumLive) <= FMath::CeilToInt(CheckTolerance * NumLive))
+		{
+			UE_LOG(LogTemp, Display, TEXT("%s::%d Episode %s %s events: live=%d replay=%d.."),
+				*FString(__func__), __LINE__, *EpisodeId, *TypeName, NumLive, NumReplay);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s::%d Episode %s %s events: live=%d replay=%d, outside the %.0f%% tolerance.."),
+				*FString(__func__), __LINE__, *EpisodeId, *TypeName, NumLive, NumReplay, CheckTolerance * 100.f);
+			bPassed = false;
+		}
+	}
+	return bPassed;
+}
@@ -0,0 +1,375 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "Replay/SLWorldStateReader.h"
+#include "Misc/Paths.h"
+#include "Misc/FileHelper.h"
+
+#if SL_WITH_LIBMONGO_C
+THIRD_PARTY_INCLUDES_START
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <mongoc/mongoc.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+#else
+#include <mongoc/mongoc.h>
+#endif // #if PLATFORM_WINDOWS
+THIRD_PARTY_INCLUDES_END
+#endif //SL_WITH_LIBMONGO_C
+
+#if SL_WITH_JSON
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#endif // SL_WITH_JSON
+
+// UUtils
+#if SL_WITH_ROS_CONVERSIONS
+#include "Conversions.h"
+#endif // SL_WITH_ROS_CONVERSIONS
+
+// Convert the logged pose to the unreal coordinates
+static FORCEINLINE FTransform SLLoggedToUPose(const FVector& Loc, const FQuat& Quat)
+{
+#if SL_WITH_ROS_CONVERSIONS
+	return FConversions::ROSToU(FTransform(Quat, Loc));
+#else
+	return FTransform(Quat, Loc);
+#endif // SL_WITH_ROS_CONVERSIONS
+}
+
+#if SL_WITH_JSON
+// Read the id (or bone name) and the pose of the json entity
+static bool SLReadJsonPose(const TSharedPtr<FJsonObject>& JsonEntity, const FString& IdKey, FString& OutId, FTransform& OutPose)
+{
+	const TSharedPtr<FJsonObject>* LocObj;
+	const TSharedPtr<FJsonObject>* RotObj;
+	if (JsonEntity->TryGetStringField(IdKey, OutId)
+		&& JsonEntity->TryGetObjectField("loc", LocObj) && JsonEntity->TryGetObjectField("rot", RotObj))
+	{
+		const FVector Loc((*LocObj)->GetNumberField("x"), (*LocObj)->GetNumberField("y"), (*LocObj)->GetNumberField("z"));
+		const FQuat Quat((*RotObj)->GetNumberField("x"), (*RotObj)->GetNumberField("y"),
+			(*RotObj)->GetNumberField("z"), (*RotObj)->GetNumberField("w"));
+		OutPose = SLLoggedToUPose(Loc, Quat);
+		return true;
+	}
+	return false;
+}
+#endif // SL_WITH_JSON
+
+#if SL_WITH_LIBMONGO_C
+// Read the xyz(w) values of the sub document
+static void SLReadBsonVector(bson_iter_t* iter, double OutValues[4])
+{
+	bson_iter_t sub_iter;
+	if (bson_iter_recurse(iter, &sub_iter))
+	{
+		while (bson_iter_next(&sub_iter))
+		{
+			const char* key = bson_iter_key(&sub_iter);
+			const int32 Idx = key[0] == 'w' ? 3 : key[0] - 'x';
+			if (Idx >= 0 && Idx < 4 && key[1] == '\0')
+			{
+				OutValues[Idx] = bson_iter_as_double(&sub_iter);
+			}
+		}
+	}
+}
+
+// Read the id (or bone name) and the pose of the entity sub document, the bones are read as well if an output is given
+static void SLReadBsonEntity(bson_iter_t* iter, const char* IdKey, FString& OutId, FTransform& OutPose,
+	TArray<TPair<FName, FTransform>>* OutBonePoses = nullptr)
+{
+	bson_iter_t entity_iter;
+	if (!bson_iter_recurse(iter, &entity_iter))
+	{
+		return;
+	}
+
+	double Loc[4] = { 0., 0., 0., 0. };
+	double Rot[4] = { 0., 0., 0., 1. };
+	while (bson_iter_next(&entity_iter))
+	{
+		const char* entity_key = bson_iter_key(&entity_iter);
+		if (strcmp(entity_key, IdKey) == 0)
+		{
+			OutId = FString(UTF8_TO_TCHAR(bson_iter_utf8(&entity_iter, NULL)));
+		}
+		else if (strcmp(entity_key, "loc") == 0)
+		{
+			SLReadBsonVector(&entity_iter, Loc);
+		}
+		else if (strcmp(entity_key, "rot") == 0)
+		{
+			SLReadBsonVector(&entity_iter, Rot);
+		}
+		else if (OutBonePoses && strcmp(entity_key, "bones") == 0)
+		{
+			bson_iter_t bones_iter;
+			if (bson_iter_recurse(&entity_iter, &bones_iter))
+			{
+				while (bson_iter_next(&bones_iter))
+				{
+					FString BoneName;
+					FTransform BonePose;
+					SLReadBsonEntity(&bones_iter, "name", BoneName, BonePose);
+					if (!BoneName.IsEmpty())
+					{
+						OutBonePoses->Emplace(FName(*BoneName), BonePose);
+					}
+				}
+			}
+		}
+	}
+	OutPose = SLLoggedToUPose(FVector(Loc[0], Loc[1], Loc[2]), FQuat(Rot[0], Rot[1], Rot[2], Rot[3]));
+}
+#endif //SL_WITH_LIBMONGO_C
+
+// Read the episode from the mongo collection (database is the task id, collection the episode id)
+bool FSLWorldStateReader::ReadFromMongo(const FString& TaskId, const FString& EpisodeId,
+	const FString& ServerIp, uint16 ServerPort, TArray<FSLWorldStateFrame>& OutFrames)
+{
+#if SL_WITH_LIBMONGO_C
+	mongoc_init();
+
+	bson_error_t error;
+	const FString Uri = TEXT("mongodb://") + ServerIp + TEXT(":") + FString::FromInt(ServerPort);
+	mongoc_uri_t* uri = mongoc_uri_new_with_error(TCHAR_TO_UTF8(*Uri), &error);
+	if (!uri)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Err.:%s; [Uri=%s]"),
+			*FString(__func__), __LINE__, *FString(error.message), *Uri);
+		mongoc_cleanup();
+		return false;
+	}
+
+	mongoc_client_t* client = mongoc_client_new_from_uri(uri);
+	if (!client)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Could not create a mongo client.."), *FString(__func__), __LINE__);
+		mongoc_uri_destroy(uri);
+		mongoc_cleanup();
+		return false;
+	}
+	mongoc_client_set_appname(client, TCHAR_TO_UTF8(*("SLREPLAY_" + EpisodeId)));
+	mongoc_collection_t* collection = mongoc_client_get_collection(client, TCHAR_TO_UTF8(*TaskId), TCHAR_TO_UTF8(*EpisodeId));
+
+	bson_t* pipeline = BCON_NEW("pipeline", "[",
+		"{",
+			"$match",
+			"{",
+				"timestamp",
+				"{",
+					"$exists", BCON_BOOL(true),
+				"}",
+			"}",
+		"}",
+		"{",
+			"$sort",
+			"{",
+				"timestamp", BCON_INT32(1),
+			"}",
+		"}",
+		"{",
+			"$project",
+			"{",
+				"_id", BCON_INT32(0),
+				"timestamp", BCON_INT32(1),
+				"entities", BCON_UTF8("$entities"),
+				"skel_entities", BCON_UTF8("$skel_entities"),
+			"}",
+		"}",
+	"]");
+
+	bson_t opts;
+	bson_init(&opts);
+	BSON_APPEND_BOOL(&opts, "allowDiskUse", true);
+
+	mongoc_cursor_t* cursor = mongoc_collection_aggregate(collection, MONGOC_QUERY_NONE, pipeline, &opts, NULL);
+	const bson_t* doc;
+	while (mongoc_cursor_next(cursor, &doc))
+	{
+		FSLWorldStateFrame Frame;
+
+		bson_iter_t doc_iter;
+		if (!bson_iter_init(&doc_iter, doc))
+		{
+			continue;
+		}
+
+		// Single pass over the document fields
+		while (bson_iter_next(&doc_iter))
+		{
+			const char* key = bson_iter_key(&doc_iter);
+			if (strcmp(key, "timestamp") == 0)
+			{
+				Frame.Timestamp = bson_iter_as_double(&doc_iter);
+			}
+			else if (strcmp(key, "entities") == 0)
+			{
+				bson_iter_t entities_iter;
+				if (!bson_iter_recurse(&doc_iter, &entities_iter))
+				{
+					continue;
+				}
+				while (bson_iter_next(&entities_iter))
+				{
+					FString Id;
+					FTransform Pose;
+					SLReadBsonEntity(&entities_iter, "id", Id, Pose);
+					if (!Id.IsEmpty())
+					{
+						Frame.Poses.Emplace(Id, Pose);
+					}
+				}
+			}
+			else if (strcmp(key, "skel_entities") == 0)
+			{
+				bson_iter_t entities_iter;
+				if (!bson_iter_recurse(&doc_iter, &entities_iter))
+				{
+					continue;
+				}
+				while (bson_iter_next(&entities_iter))
+				{
+					FSLWorldStateSkeletalPose SkeletalPose;
+					SLReadBsonEntity(&entities_iter, "id", SkeletalPose.Id, SkeletalPose.Pose, &SkeletalPose.BonePoses);
+					if (!SkeletalPose.Id.IsEmpty())
+					{
+						Frame.SkeletalPoses.Emplace(MoveTemp(SkeletalPose));
+					}
+				}
+			}
+		}
+
+		if (Frame.Poses.Num() > 0 || Frame.SkeletalPoses.Num() > 0)
+		{
+			OutFrames.Emplace(MoveTemp(Frame));
+		}
+	}
+
+	const bool bSuccess = !mongoc_cursor_error(cursor, &error);
+	if (!bSuccess)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Failed to iterate all documents.. Err. %s"),
+			*FString(__func__), __LINE__, *FString(error.message));
+	}
+
+	mongoc_cursor_destroy(cursor);
+	bson_destroy(&opts);
+	bson_destroy(pipeline);
+	mongoc_collection_destroy(collection);
+	mongoc_client_destroy(client);
+	mongoc_uri_destroy(uri);
+	mongoc_cleanup();
+	return bSuccess && OutFrames.Num() > 0;
+#else
+	UE_LOG(LogTemp, Error, TEXT("%s::%d Mongo support is not included.."), *FString(__func__), __LINE__);
+	return false;
+#endif //SL_WITH_LIBMONGO_C
+}
+
+// Read the episode from the json world state file (SemLog/<TaskId>/Episodes/<EpisodeId>_WS.json)
+bool FSLWorldStateReader::ReadFromJsonFile(const FString& TaskId, const FString& EpisodeId, TArray<FSLWorldStateFrame>& OutFrames)
+{
+#if SL_WITH_JSON
+	FString FilePath = FPaths::ProjectDir() + "/SemLog/" + TaskId + TEXT("/Episodes/") + EpisodeId + TEXT("_WS.json");
+	FPaths::RemoveDuplicateSlashes(FilePath);
+
+	FString FileContent;
+	if (!FFileHelper::LoadFileToString(FileContent, *FilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Could not read %s.."), *FString(__func__), __LINE__, *FilePath);
+		return false;
+	}
+
+	// The entries are written back to back, split them on the top level braces
+	int32 Depth = 0;
+	int32 EntryStart = INDEX_NONE;
+	bool bInString = false;
+	for (int32 CharIdx = 0; CharIdx < FileContent.Len(); ++CharIdx)
+	{
+		const TCHAR Char = FileContent[CharIdx];
+		if (bInString)
+		{
+			if (Char == TEXT('\\'))
+			{
+				++CharIdx;
+			}
+			else if (Char == TEXT('"'))
+			{
+				bInString = false;
+			}
+			continue;
+		}
+
+		if (Char == TEXT('"'))
+		{
+			bInString = true;
+		}
+		else if (Char == TEXT('{'))
+		{
+			if (Depth++ == 0)
+			{
+				EntryStart = CharIdx;
+			}
+		}
+		else if (Char == TEXT('}') && Depth > 0 && --Depth == 0)
+		{
+			TSharedPtr<FJsonObject> JsonEntry;
+			TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(FileContent.Mid(EntryStart, CharIdx - EntryStart + 1));
+			if (!FJsonSerializer::Deserialize(JsonReader, JsonEntry) || !JsonEntry.IsValid())
+			{
+				continue;
+			}
+
+			FSLWorldStateFrame Frame;
+			Frame.Timestamp = JsonEntry->GetNumberField("timestamp");
+			for (const auto& JsonValue : JsonEntry->GetArrayField("entities"))
+			{
+				const TSharedPtr<FJsonObject> JsonEntity = JsonValue->AsObject();
+				FString Id;
+				FTransform Pose;
+				if (JsonEntity.IsValid() && SLReadJsonPose(JsonEntity, "id", Id, Pose))
+				{
+					// The skeletal entities are written in the same array, with their bones
+					const TArray<TSharedPtr<FJsonValue>>* JsonBones;
+					if (JsonEntity->TryGetArrayField("bones", JsonBones))
+					{
+						FSLWorldStateSkeletalPose SkeletalPose;
+						SkeletalPose.Id = Id;
+						SkeletalPose.Pose = Pose;
+						for (const auto& JsonBoneValue : *JsonBones)
+						{
+							const TSharedPtr<FJsonObject> JsonBone = JsonBoneValue->AsObject();
+							FString BoneName;
+							FTransform BonePose;
+							if (JsonBone.IsValid() && SLReadJsonPose(JsonBone, "bone", BoneName, BonePose))
+							{
+								SkeletalPose.BonePoses.Emplace(FName(*BoneName), BonePose);
+							}
+						}
+						Frame.SkeletalPoses.Emplace(MoveTemp(SkeletalPose));
+					}
+					else
+					{
+						Frame.Poses.Emplace(Id, Pose);
+					}
+				}
+			}
+
+			if (Frame.Poses.Num() > 0 || Frame.SkeletalPoses.Num() > 0)
+			{
+				OutFrames.Emplace(MoveTemp(Frame));
+			}
+		}
+	}
+
+	// Entries are appended in time order, sort anyhow in case of concatenated files
+	OutFrames.StableSort([](const FSLWorldStateFrame& A, const FSLWorldStateFrame& B) { return A.Timestamp < B.Timestamp; });
+	return OutFrames.Num() > 0;
+#else
+	UE_LOG(LogTemp, Error, TEXT("%s::%d Json support is not included.."), *FString(__func__), __LINE__);
+	return false;
+#endif // SL_WITH_JSON
+}
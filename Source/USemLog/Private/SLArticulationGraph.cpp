@@ -0,0 +1,360 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "SLArticulationGraph.h"
+#include "EngineUtils.h"
+#include "PhysicsEngine/PhysicsConstraintActor.h"
+#include "PhysicsEngine/PhysicsConstraintComponent.h"
+
+// UUtils
+#include "Tags.h"
+
+TSharedPtr<FSLArticulationGraph> FSLArticulationGraph::StaticInstance;
+
+// Constructor
+FSLArticulationGraph::FSLArticulationGraph() : bIsInit(false) {}
+
+// Destructor
+FSLArticulationGraph::~FSLArticulationGraph()
+{
+	Reset();
+}
+
+// Get singleton
+FSLArticulationGraph* FSLArticulationGraph::GetInstance()
+{
+	if (!StaticInstance.IsValid())
+	{
+		StaticInstance = MakeShareable(new FSLArticulationGraph());
+	}
+	return StaticInstance.Get();
+}
+
+// Delete instance
+void FSLArticulationGraph::DeleteInstance()
+{
+	StaticInstance.Reset();
+}
+
+// Build the graph of the world (no-op if it is already built for the world)
+void FSLArticulationGraph::Init(UWorld* InWorld)
+{
+	if (bIsInit && World.Get() == InWorld)
+	{
+		return;
+	}
+	Rebuild(InWorld);
+}
+
+// Re-build the graph of the world (e.g. the tags or the attachments changed in the editor)
+void FSLArticulationGraph::Rebuild(UWorld* InWorld)
+{
+	Reset();
+	if (!InWorld)
+	{
+		return;
+	}
+
+	World = InWorld;
+	for (TActorIterator<AActor> ActorItr(InWorld); ActorItr; ++ActorItr)
+	{
+		AddActor(*ActorItr);
+	}
+
+	// Keep the graph up to date with the newly spawned actors
+	ActorSpawnedHandle = InWorld->AddOnActorSpawnedHandler(
+		FOnActorSpawned::FDelegate::CreateRaw(this, &FSLArticulationGraph::OnActorSpawned));
+
+	bIsInit = true;
+}
+
+// Re-sync the attachment edges of all the actors (attaches and detaches), clears the cached results if anything changed
+void FSLArticulationGraph::Refresh()
+{
+	bool bChanged = false;
+	for (const auto& Actor : Actors)
+	{
+		// Destroyed actors keep their last edges
+		if (Actor.IsValid())
+		{
+			bChanged |= SyncAttachParent(Actor.Get());
+		}
+	}
+
+	if (bChanged)
+	{
+		// The hierarchies changed, the transitive results are outdated
+		ConstrainedActorsCache.Empty();
+		ContainersCache.Empty();
+	}
+}
+
+// Re-sync the attachment parent of the actor and of the actors attached to it (detaches), clears the cached results if anything changed
+void FSLArticulationGraph::RefreshActor(AActor* Actor)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	bool bChanged = SyncAttachParent(Actor);
+
+	// The sync of a detached child removes it from the children array
+	if (const TArray<AActor*>* ChildrenPtr = AttachChildren.Find(Actor))
+	{
+		const TArray<AActor*> Children = *ChildrenPtr;
+		for (AActor* Child : Children)
+		{
+			bChanged |= SyncAttachParent(Child);
+		}
+	}
+
+	if (bChanged)
+	{
+		// The hierarchies changed, the transitive results are outdated
+		ConstrainedActorsCache.Empty();
+		ContainersCache.Empty();
+	}
+}
+
+// Re-sync the attachment parents of the actor ancestors and of its root hierarchy, clears the cached results if anything changed
+void FSLArticulationGraph::RefreshHierarchy(AActor* Actor)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	// The ancestors first, the root might have changed
+	bool bChanged = false;
+	AActor* Root = Actor;
+	while (Root)
+	{
+		bChanged |= SyncAttachParent(Root);
+		AActor* Parent = GetAttachParent(Root);
+		if (!Parent)
+		{
+			break;
+		}
+		Root = Parent;
+	}
+
+	// Detached descendants are removed from the hierarchy by their sync
+	TArray<AActor*> Hierarchy;
+	GetAttachmentHierarchy(Root, Hierarchy);
+	for (int32 Idx = 1; Idx < Hierarchy.Num(); ++Idx)
+	{
+		bChanged |= SyncAttachParent(Hierarchy[Idx]);
+	}
+
+	if (bChanged)
+	{
+		// The hierarchies changed, the transitive results are outdated
+		ConstrainedActorsCache.Empty();
+		ContainersCache.Empty();
+	}
+}
+
+// Get the attachment parent of the actor (nullptr if none)
+AActor* FSLArticulationGraph::GetAttachParent(AActor* Actor) const
+{
+	if (AActor* const* ParentPtr = AttachParent.Find(Actor))
+	{
+		return *ParentPtr;
+	}
+	return nullptr;
+}
+
+// Get the actors directly attached to the actor
+const TArray<AActor*>& FSLArticulationGraph::GetAttachedActors(AActor* Actor) const
+{
+	static const TArray<AActor*> Empty;
+	if (const TArray<AActor*>* ChildrenPtr = AttachChildren.Find(Actor))
+	{
+		return *ChildrenPtr;
+	}
+	return Empty;
+}
+
+// Get the outermost attachment parent of the actor (the actor itself if it is not attached)
+AActor* FSLArticulationGraph::GetAttachmentRoot(AActor* Actor) const
+{
+	AActor* Root = Actor;
+	while (AActor* Parent = GetAttachParent(Root))
+	{
+		Root = Parent;
+	}
+	return Root;
+}
+
+// Get the actors constrained to the attachment hierarchy of the root (the root's hierarchy is excluded), cached (valid until the next query or refresh)
+const TSet<AActor*>& FSLArticulationGraph::GetConstrainedActors(AActor* Root)
+{
+	if (const TSet<AActor*>* CachedPtr = ConstrainedActorsCache.Find(Root))
+	{
+		return *CachedPtr;
+	}
+
+	TArray<AActor*> Hierarchy;
+	GetAttachmentHierarchy(Root, Hierarchy);
+	const TSet<AActor*> HierarchySet(Hierarchy);
+
+	TSet<AActor*> ConstrainedActors;
+	for (AActor* Actor : Hierarchy)
+	{
+		if (const TArray<AActor*>* NeighboursPtr = ConstraintNeighbours.Find(Actor))
+		{
+			for (AActor* Neighbour : *NeighboursPtr)
+			{
+				if (!HierarchySet.Contains(Neighbour))
+				{
+					ConstrainedActors.Add(Neighbour);
+				}
+			}
+		}
+	}
+	return ConstrainedActorsCache.Emplace(Root, MoveTemp(ConstrainedActors));
+}
+
+// Get the containers in the attachment hierarchy of the root (including the root), cached (valid until the next query or refresh)
+const TSet<AActor*>& FSLArticulationGraph::GetContainers(AActor* Root)
+{
+	if (const TSet<AActor*>* CachedPtr = ContainersCache.Find(Root))
+	{
+		return *CachedPtr;
+	}
+
+	TArray<AActor*> Hierarchy;
+	GetAttachmentHierarchy(Root, Hierarchy);
+
+	TSet<AActor*> Containers;
+	for (AActor* Actor : Hierarchy)
+	{
+		if (ContainerActors.Contains(Actor))
+		{
+			Containers.Add(Actor);
+		}
+	}
+	return ContainersCache.Emplace(Root, MoveTemp(Containers));
+}
+
+// Get the semantic id of the actor (empty if the actor has no id and class)
+FString FSLArticulationGraph::GetSemanticId(AActor* Actor) const
+{
+	if (const FString* IdPtr = SemanticIds.Find(Actor))
+	{
+		return *IdPtr;
+	}
+	return FString();
+}
+
+// Add the actor with its edges
+void FSLArticulationGraph::AddActor(AActor* Actor)
+{
+	Actors.Add(Actor);
+
+	// Parse the tags once
+	const FString Id = FTags::GetValue(Actor, "SemLog", "Id");
+	if (!Id.IsEmpty() && FTags::HasKey(Actor, "SemLog", "Class"))
+	{
+		SemanticIds.Emplace(Actor, Id);
+	}
+	if (FTags::HasKey(Actor, "SemLog", "Container"))
+	{
+		ContainerActors.Add(Actor);
+	}
+
+	// Constraint edges (the constraint actor is linked to both constrained actors, and they to each other)
+	if (APhysicsConstraintActor* AsPCA = Cast<APhysicsConstraintActor>(Actor))
+	{
+		if (UPhysicsConstraintComponent* ConstrComp = AsPCA->GetConstraintComp())
+		{
+			AActor* Actor1 = ConstrComp->ConstraintActor1;
+			AActor* Actor2 = ConstrComp->ConstraintActor2;
+			for (AActor* Constrained : { Actor1, Actor2 })
+			{
+				if (Constrained && Constrained != Actor)
+				{
+					ConstraintNeighbours.FindOrAdd(Actor).AddUnique(Constrained);
+					ConstraintNeighbours.FindOrAdd(Constrained).AddUnique(Actor);
+				}
+			}
+			if (Actor1 && Actor2 && Actor1 != Actor2)
+			{
+				ConstraintNeighbours.FindOrAdd(Actor1).AddUnique(Actor2);
+				ConstraintNeighbours.FindOrAdd(Actor2).AddUnique(Actor1);
+			}
+		}
+	}
+
+	// Attachment edge
+	SyncAttachParent(Actor);
+}
+
+// Sync the attachment parent of the actor, returns true if it changed
+bool FSLArticulationGraph::SyncAttachParent(AActor* Actor)
+{
+	AActor* CurrParent = Actor->GetAttachParentActor();
+	AActor** CachedParentPtr = AttachParent.Find(Actor);
+	AActor* CachedParent = CachedParentPtr ? *CachedParentPtr : nullptr;
+	if (CurrParent == CachedParent)
+	{
+		return false;
+	}
+
+	if (CachedParent)
+	{
+		if (TArray<AActor*>* PrevSiblingsPtr = AttachChildren.Find(CachedParent))
+		{
+			PrevSiblingsPtr->Remove(Actor);
+		}
+		AttachParent.Remove(Actor);
+	}
+	if (CurrParent)
+	{
+		AttachParent.Emplace(Actor, CurrParent);
+		AttachChildren.FindOrAdd(CurrParent).AddUnique(Actor);
+	}
+	return true;
+}
+
+// Collect the attachment hierarchy of the root (including the root)
+void FSLArticulationGraph::GetAttachmentHierarchy(AActor* Root, TArray<AActor*>& OutActors) const
+{
+	OutActors.Add(Root);
+	for (int32 Idx = 0; Idx < OutActors.Num(); ++Idx)
+	{
+		if (const TArray<AActor*>* ChildrenPtr = AttachChildren.Find(OutActors[Idx]))
+		{
+			OutActors.Append(*ChildrenPtr);
+		}
+	}
+}
+
+// Called when an actor is spawned in the world
+void FSLArticulationGraph::OnActorSpawned(AActor* Actor)
+{
+	AddActor(Actor);
+	ConstrainedActorsCache.Empty();
+	ContainersCache.Empty();
+}
+
+// Remove the graph data
+void FSLArticulationGraph::Reset()
+{
+	if (World.IsValid() && ActorSpawnedHandle.IsValid())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+	ActorSpawnedHandle.Reset();
+	World.Reset();
+	Actors.Empty();
+	AttachParent.Empty();
+	AttachChildren.Empty();
+	ConstraintNeighbours.Empty();
+	ContainerActors.Empty();
+	SemanticIds.Empty();
+	ConstrainedActorsCache.Empty();
+	ContainersCache.Empty();
+	bIsInit = false;
+}
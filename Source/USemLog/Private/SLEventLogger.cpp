@@ -10,11 +10,13 @@
 #include "Events/SLPickAndPlaceEventsHandler.h"
 #include "Events/SLContainerEventHandler.h"
 #include "Monitors/SLContactShapeInterface.h"
+#include "Monitors/SLContactBroadphase.h"
 #include "Monitors/SLManipulatorListener.h"
 #include "Monitors/SLReachListener.h"
 #include "Monitors/SLPickAndPlaceListener.h"
 #include "Monitors/SLContainerListener.h"
-#include "Events/SLGoogleCharts.h"
+#include "Events/SLTimelineWriter.h"
+#include "Events/SLEventPool.h"
 
 #include "Misc/Paths.h"
 #include "Misc/FileHelper.h"
@@ -44,6 +46,7 @@ USLEventLogger::USLEventLogger()
 	bIsStarted = false;
 	bIsFinished = false;
 	bWriteTimelines = false;
+	DocFormat = ESLOwlDocFormat::RdfXml;
 }
 
 // Destructor
@@ -63,18 +66,23 @@ void USLEventLogger::Init(ESLOwlExperimentTemplate TemplateType,
 	bool bInLogGraspEvents,
 	bool bInPickAndPlaceEvents,
 	bool bInLogSlicingEvents,
-	bool bInWriteTimelines)
+	bool bInWriteTimelines,
+	bool bInUseContactBroadphase)
 {
 	if (!bIsInit)
 	{
 		LogDirectory = WriterParams.TaskId;
 		EpisodeId = WriterParams.EpisodeId;
+		DocFormat = WriterParams.DocFormat;
 		OwlDocTemplate = TemplateType;
 		bWriteTimelines = bInWriteTimelines;
 
 		// Init the semantic mappings (if not already init)
 		FSLEntitiesManager::GetInstance()->Init(GetWorld());
 
+		// New event ids prefix for the episode
+		FSLEventPool::GetInstance()->Init();
+
 		// Create the document template
 		ExperimentDoc = CreateEventsDocTemplate(TemplateType, EpisodeId);
 
@@ -84,6 +92,12 @@ void USLEventLogger::Init(ESLOwlExperimentTemplate TemplateType,
 		// Parent -> TArray Parents
 		// rename FSLContactEventHandler,FSLSupportedByEventHandler,FSLFixationGraspEventHandler -> Events
 
+		// Contact shapes started afterwards register with the broadphase (it computes the shape-vs-shape contacts)
+		if (bInUseContactBroadphase)
+		{
+			FSLContactBroadphase::GetInstance()->Init(GetWorld());
+		}
+
 		// Init all contact trigger handlers
 		for (TObjectIterator<UShapeComponent> Itr; Itr; ++Itr)
 		{
@@ -431,6 +445,7 @@ void USLEventLogger::OnSemanticEvent(TSharedPtr<ISLEvent> Event)
 	//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Yellow, FString::Printf(TEXT("%s::%d %s"), *FString(__func__), __LINE__, *Event->ToString()));
 	//UE_LOG(LogTemp, Error, TEXT(">> %s::%d %s"), *FString(__func__), __LINE__, *Event->ToString());
 	FinishedEvents.Add(Event);
+	EventIndex.Add(*Event);
 }
 
 // Write to file
@@ -439,19 +454,20 @@ bool USLEventLogger::WriteToFile()
 	// Write events timelines to file
 	if (bWriteTimelines)
 	{
-		FSLGoogleChartsParameters Params;
-		Params.bTooltips = true;
-		FSLGoogleCharts::WriteTimelines(FinishedEvents, LogDirectory, EpisodeId, Params);
+		FSLTimelineWriter::WriteTimelines(FinishedEvents, LogDirectory, EpisodeId);
 	}
 
+	// Write the events interval index to file
+	EventIndex.SaveToFile(FSLEventIndex::GetEpisodeFilePath(LogDirectory, EpisodeId));
+
 	if (!ExperimentDoc.IsValid())
 		return false;
 
-	// Write experiment to file
+	// Write experiment to file (rdf/xml, n-triples or turtle)
 	FString FullFilePath = FPaths::ProjectDir() + "/SemLog/" +
-		LogDirectory /*+ TEXT("/Episodes/")*/+ "/" + EpisodeId + TEXT("_ED.owl");
+		LogDirectory /*+ TEXT("/Episodes/")*/+ "/" + EpisodeId + TEXT("_ED.") + FSLOwlTripleWriter::GetFileExtension(DocFormat);
 	FPaths::RemoveDuplicateSlashes(FullFilePath);
-	return FFileHelper::SaveStringToFile(ExperimentDoc->ToString(), *FullFilePath);
+	return FSLOwlTripleWriter::WriteToFile(*ExperimentDoc.Get(), FullFilePath, DocFormat);
 }
 
 // Create events doc (experiment) template
@@ -3,7 +3,15 @@
 
 #include "SLManager.h"
 #include "SLEntitiesManager.h"
+#include "Monitors/SLSupportedByManager.h"
+#include "Monitors/SLOverlapEndDebouncer.h"
+#include "Monitors/SLContactBroadphase.h"
+#include "Monitors/SLSpatialQueryManager.h"
+#include "SLArticulationGraph.h"
+#include "Events/SLEventPool.h"
 #include "Ids.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
 
 // Sets default values
 ASLManager::ASLManager()
@@ -57,12 +65,14 @@ ASLManager::ASLManager()
 	bLogEventData = true;
 	bLogContactEvents = true;
 	bLogSupportedByEvents = true;
+	bUseContactBroadphase = false;
 	bLogGraspEvents = true;
 	bLogPickAndPlaceEvents = true;
 	bLogSlicingEvents = true;
 	bWriteTimelines = true;
 	bWriteEpisodeMetadata = false;
 	ExperimentTemplateType = ESLOwlExperimentTemplate::Default;
+	EventsDocFormat = ESLOwlDocFormat::RdfXml;
 
 	
 	// Vision data logger default values
@@ -72,6 +82,17 @@ ASLManager::ASLManager()
 	VisionImageResolution = FIntPoint(1920, 1080);
 	bCalculateOverlaps = true;
 	OverlapResolutionDivisor = 4;
+	OverlapMethod = ESLVisionOverlapMethod::Screenshots;
+	bReuseOverlaps = true;
+	bSkipUnchangedViews = false;
+	MaskColorTolerance = 13;
+	VisionImageWorkers = 2;
+	VisionMaxInFlightImagesMB = 512;
+	bEncodeVisionMasks = false;
+	VisionPrefetchSeconds = 5.f;
+	VisionMaxBufferedFrames = 512;
+	VisionShardIdx = INDEX_NONE;
+	VisionNumShards = 1;
 	bIncludeImagesLocally = false;
 
 	// Editor Logger default values
@@ -189,9 +210,27 @@ void ASLManager::Init()
 		}
 		else if (bLogVisionData)
 		{
+			// Shard processes started by the SLVisionShards commandlet get the episode and the shard from the command line
+			FParse::Value(FCommandLine::Get(), TEXT("SLTaskId="), TaskId);
+			FParse::Value(FCommandLine::Get(), TEXT("SLEpisodeId="), EpisodeId);
+			FParse::Value(FCommandLine::Get(), TEXT("SLServerIp="), ServerIp);
+			FParse::Value(FCommandLine::Get(), TEXT("SLServerPort="), ServerPort);
+			FParse::Value(FCommandLine::Get(), TEXT("SLVisionShard="), VisionShardIdx);
+			FParse::Value(FCommandLine::Get(), TEXT("SLVisionShards="), VisionNumShards);
+
 			VisionDataLogger = NewObject<USLVisionLogger>(this);
-			VisionDataLogger->Init(TaskId, EpisodeId, ServerIp, ServerPort, bOverwriteVisionData,
-				FSLVisionLoggerParams(VisionUpdateRate, VisionImageResolution, bIncludeImagesLocally, bCalculateOverlaps, OverlapResolutionDivisor));
+			FSLVisionLoggerParams VisionParams(VisionUpdateRate, VisionImageResolution, bIncludeImagesLocally, bCalculateOverlaps, OverlapResolutionDivisor, MaskColorTolerance);
+			VisionParams.NumImageWorkers = VisionImageWorkers;
+			VisionParams.MaxInFlightImagesMB = VisionMaxInFlightImagesMB;
+			VisionParams.bEncodeMasks = bEncodeVisionMasks;
+			VisionParams.OverlapMethod = OverlapMethod;
+			VisionParams.bReuseOverlaps = bReuseOverlaps;
+			VisionParams.bSkipUnchangedViews = bSkipUnchangedViews;
+			VisionParams.EpisodePrefetchSeconds = VisionPrefetchSeconds;
+			VisionParams.MaxBufferedFrames = VisionMaxBufferedFrames;
+			VisionParams.ShardIdx = VisionShardIdx;
+			VisionParams.NumShards = VisionNumShards;
+			VisionDataLogger->Init(TaskId, EpisodeId, ServerIp, ServerPort, bOverwriteVisionData, VisionParams);
 		}
 		else if (bVisualizeData)
 		{
@@ -216,8 +255,9 @@ void ASLManager::Init()
 			if (bLogEventData)
 			{
 				EventDataLogger = NewObject<USLEventLogger>(this);
-				EventDataLogger->Init(ExperimentTemplateType, FSLEventWriterParams(TaskId, EpisodeId),
-					bLogContactEvents, bLogSupportedByEvents, bLogGraspEvents, bLogPickAndPlaceEvents, bLogSlicingEvents, bWriteTimelines);
+				EventDataLogger->Init(ExperimentTemplateType, FSLEventWriterParams(TaskId, EpisodeId, EventsDocFormat),
+					bLogContactEvents, bLogSupportedByEvents, bLogGraspEvents, bLogPickAndPlaceEvents, bLogSlicingEvents, bWriteTimelines,
+					bUseContactBroadphase);
 			}
 		}
 
@@ -321,6 +361,24 @@ void ASLManager::Finish(const float Time, bool bForced)
 		// Delete the semantic items content instance
 		FSLEntitiesManager::DeleteInstance();
 
+		// Delete the supported by candidates evaluator instance
+		FSLSupportedByManager::DeleteInstance();
+
+		// Delete the delayed overlap ends scheduler instance
+		FSLOverlapEndDebouncer::DeleteInstance();
+
+		// Delete the contact broadphase instance
+		FSLContactBroadphase::DeleteInstance();
+
+		// Delete the spatial query manager instance
+		FSLSpatialQueryManager::DeleteInstance();
+
+		// Delete the articulation graph instance
+		FSLArticulationGraph::DeleteInstance();
+
+		// Delete the event pool instance (the memory is kept while the finished events are referenced)
+		FSLEventPool::DeleteInstance();
+
 		// Mark manager as finished
 		bIsStarted = false;
 		bIsInit = false;
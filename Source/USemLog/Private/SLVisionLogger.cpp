@@ -13,10 +13,9 @@
 #include "Materials/Material.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Engine/GameViewportClient.h"
+#include "Camera/CameraComponent.h"
 #include "HighResScreenshot.h"
-#include "ImageUtils.h"
 #include "Async.h"
-#include "FileHelper.h"
 
 // UUtils
 #include "Tags.h"
@@ -28,6 +27,10 @@ USLVisionLogger::USLVisionLogger() : bIsInit(false), bIsStarted(false), bIsFinis
 	CurrVirtualCameraIdx = INDEX_NONE;
 	CurrTimestamp = -1.f;
 	PrevViewMode = ESLVisionViewMode::NONE;
+	bEncodeMasks = false;
+	ShardIdx = INDEX_NONE;
+	NumShards = 1;
+	bIsEpisodeDone = false;
 
 	ViewModes.Add(ESLVisionViewMode::Color);
 	ViewModes.Add(ESLVisionViewMode::Unlit);
@@ -44,7 +47,8 @@ USLVisionLogger::~USLVisionLogger()
 		Finish(true);
 	}
 
-	// Disconnect and clean db connection
+	// Stop the episode loader and disconnect and clean db connection
+	DBHandler.StopEpisodeStream();
 	DBHandler.Disconnect();
 }
 
@@ -77,24 +81,44 @@ void USLVisionLogger::Init(const FString& InTaskId, const FString& InEpisodeId,
 		// Create movable clones of the skeletal meshes, hide originals (call before loading the episode data)
 		CreatePoseableMeshesClones();
 
+		// Start the image compression workers
+		ImagePipeline.Init(Params.NumImageWorkers, Params.MaxInFlightImagesMB);
+		bEncodeMasks = Params.bEncodeMasks;
+
+		// A shard replays a part of the episode into its own staging collection (merged by the SLVisionShards commandlet)
+		if (Params.NumShards > 1 && Params.ShardIdx >= 0 && Params.ShardIdx < Params.NumShards)
+		{
+			ShardIdx = Params.ShardIdx;
+			NumShards = Params.NumShards;
+		}
+
 		// Connect to the database for writing the image data
-		if (!DBHandler.Connect(InTaskId, InEpisodeId, InServerIp, InServerPort, bOverwriteVisionData))
+		if (!DBHandler.Connect(InTaskId, InEpisodeId, InServerIp, InServerPort, bOverwriteVisionData, ShardIdx))
 		{
 			UE_LOG(LogTemp, Warning, TEXT("%s::%d Could not connect to the DB.."), *FString(__func__), __LINE__);
+			QuitFailedShard(false);
 			return;
 		}
 
-		// Download the whole episode data (make sure the poseable mesh clones are created before this)
-		if (!DBHandler.GetEpisodeData(Params.UpdateRate, SkelToPoseableMap, Episode))
+		// Stream the episode data ahead of the rendering (make sure the poseable mesh clones are created before this)
+		Episode.Init(Params.EpisodePrefetchSeconds, Params.MaxBufferedFrames);
+		if (!DBHandler.StartEpisodeStream(Params.UpdateRate, SkelToPoseableMap, Episode, NumShards))
 		{
-			UE_LOG(LogTemp, Warning, TEXT("%s::%d Could not download the episode data.."), *FString(__func__), __LINE__);
+			UE_LOG(LogTemp, Warning, TEXT("%s::%d Could not start loading the episode data.."), *FString(__func__), __LINE__);
+			QuitFailedShard(true);
 			return;
 		}
 
+		if (ShardIdx != INDEX_NONE)
+		{
+			DBHandler.WriteShardState(ShardIdx, NumShards, TEXT("running"));
+		}
+
 		// Make sure rendering modes are selected
 		if(ViewModes.Num() == 0)
 		{
 			UE_LOG(LogTemp, Warning, TEXT("%s::%d No view modes found.."), *FString(__func__), __LINE__);
+			QuitFailedShard(true);
 			return;
 		}
 
@@ -102,14 +126,22 @@ void USLVisionLogger::Init(const FString& InTaskId, const FString& InEpisodeId,
 		if(!LoadVirtualCameras())
 		{
 			UE_LOG(LogTemp, Warning, TEXT("%s::%d No virtual cameras found.."), *FString(__func__), __LINE__);
+			QuitFailedShard(true);
 			return;
 		}
 
+		// Detect the views which are not affected by the frame changes
+		if (Params.bSkipUnchangedViews)
+		{
+			ChangeDetector.Init(VirtualCameras.Num(), Resolution);
+		}
+
 		// Access the viewport (used for the screenshot requests)
 		ViewportClient = GetWorld()->GetGameViewport();
 		if(!ViewportClient)
 		{
 			UE_LOG(LogTemp, Error, TEXT("%s::%d Could not access the GameViewport.."), *FString(__func__), __LINE__);
+			QuitFailedShard(true);
 			return;
 		}
 		// Bind the screenshot captured callback
@@ -121,7 +153,7 @@ void USLVisionLogger::Init(const FString& InTaskId, const FString& InEpisodeId,
 			if(CreateMaskClones())
 			{
 				// Create color to semantic data mappings on the image handler, setup the rendered to original mask mapping
-				if (!MaskImgHandler.Init())
+				if (!MaskImgHandler.Init(Params.MaskColorTolerance))
 				{
 					UE_LOG(LogTemp, Error, TEXT("%s::%d Could not init image handler, removing mask view type.."), *FString(__func__), __LINE__);
 					ViewModes.Remove(ESLVisionViewMode::Mask);
@@ -132,10 +164,23 @@ void USLVisionLogger::Init(const FString& InTaskId, const FString& InEpisodeId,
 
 				if (Params.bCalculateOverlaps)
 				{
-					// Create the overlap calc object
-					OverlapCalc = NewObject<USLVisionOverlapCalc>(this);
-					// Give control to the overlap calc to pause and start the vision logger
-					OverlapCalc->Init(this, Resolution/Params.OverlapResolutionDivisor, SaveLocallyFolderName);
+					if (Params.OverlapMethod != ESLVisionOverlapMethod::Rasterizer)
+					{
+						// Create the overlap calc object
+						OverlapCalc = NewObject<USLVisionOverlapCalc>(this);
+						// Give control to the overlap calc to pause and start the vision logger
+						OverlapCalc->Init(this, Resolution/Params.OverlapResolutionDivisor, SaveLocallyFolderName);
+					}
+					if (Params.OverlapMethod != ESLVisionOverlapMethod::Screenshots)
+					{
+						// Rasterize the mask clones geometry, in validation mode the results are only compared to the screenshot values
+						SoftwareOcclusion.Init(this, Resolution/Params.OverlapResolutionDivisor);
+					}
+					if (Params.bReuseOverlaps)
+					{
+						// Keep the overlaps of every view, reused for the entities that did not change
+						OverlapCache.Init(this, VirtualCameras.Num(), Resolution);
+					}
 				}
 			}
 			else
@@ -168,7 +213,12 @@ void USLVisionLogger::Start(const FString& EpisodeId)
 			// Start recursion
 			RequestScreenshot();
 			bIsStarted = true;
-		}		
+		}
+		else
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s::%d Could not setup the first frame, camera and view mode.."), *FString(__func__), __LINE__);
+			QuitFailedShard(true);
+		}
 	}
 }
 
@@ -177,9 +227,28 @@ void USLVisionLogger::Finish(bool bForced)
 {
 	if (!bIsFinished && (bIsInit || bIsStarted))
 	{
+		// Wait for the pending images and frame writes
+		ImagePipeline.Shutdown();
+
+		// Stop the episode loader (if the episode was not replayed until the end)
+		DBHandler.StopEpisodeStream();
+
+		// Output the software occlusion errors (if validated) and the reused overlaps
+		SoftwareOcclusion.LogValidationSummary();
+		OverlapCache.LogSummary();
+		ChangeDetector.LogSummary();
+
 		// Index the entries in the db
 		DBHandler.CreateIndexes();
 
+		// The merge only accepts the shards which processed all their frames
+		if (ShardIdx != INDEX_NONE)
+		{
+			const bool bIsShardDone = bIsEpisodeDone && DBHandler.IsEpisodeStreamComplete();
+			DBHandler.WriteShardState(ShardIdx, NumShards, bIsShardDone ? TEXT("finished") : TEXT("failed"),
+				Episode.GetFramesNum(), Episode.GetFirstTimestamp(), Episode.GetLastTimestamp());
+		}
+
 		// Mark logger as finished
 		bIsStarted = false;
 		bIsInit = false;
@@ -210,6 +279,15 @@ void USLVisionLogger::Pause(bool Value)
 				// Set the captured image resolution
 				InitScreenshotResolution(Resolution);	
 
+				// Compare the rasterized overlaps against the ones from the screenshots
+				if (OverlapCalc && SoftwareOcclusion.IsInit())
+				{
+					SoftwareOcclusion.Validate(CurrViewData);
+				}
+
+				// Cache the calculated overlaps of the view
+				OverlapCache.Update(CurrVirtualCameraIdx, CurrViewData);
+
 				// Go to next frame/camera/view mode
 				if (NextStep())
 				{
@@ -219,6 +297,7 @@ void USLVisionLogger::Pause(bool Value)
 				{
 					UE_LOG(LogTemp, Warning, TEXT("%s::%d [%f] Finished visual logger.."),
 						*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds());
+					bIsEpisodeDone = true;
 					QuitEditor();
 				}
 
@@ -298,8 +377,8 @@ void USLVisionLogger::ScreenshotCB(int32 SizeX, int32 SizeY, const TArray<FColor
 	// Terminal output with the log progress
 	PrintProgress();
 
-	// Compress image
-	TArray<uint8> CompressedBitmap;
+	// Cache the image entry, the binary is added once the image pipeline compressed it
+	const int32 ImageIdx = CurrViewData.Images.Emplace(FSLVisionImageData(GetViewModeName(ViewModes[CurrViewModeIdx]), TArray<uint8>()));
 
 	// If mask mode is currently active, restore the colors and get the entity data
 	if (ViewModes[CurrViewModeIdx] == ESLVisionViewMode::Mask)
@@ -308,44 +387,63 @@ void USLVisionLogger::ScreenshotCB(int32 SizeX, int32 SizeY, const TArray<FColor
 		TArray<FColor>& BitmapRef = const_cast<TArray<FColor>&>(Bitmap);
 
 		// Get information from the mask image and restore any rendering artefacts to the original mask colors
-		MaskImgHandler.GetDataAndRestoreImage(BitmapRef, SizeX, SizeY, CurrViewData);
+		if (bEncodeMasks)
+		{
+			// The encoded mask is produced in the same pass and stored instead of the png
+			FSLVisionImageData& Img = CurrViewData.Images[ImageIdx];
+			MaskImgHandler.GetDataAndRestoreImage(BitmapRef, SizeX, SizeY, CurrViewData, &Img.Data);
+			Img.Format = FSLVisionMaskCodec::FormatName;
+		}
+		else
+		{
+			MaskImgHandler.GetDataAndRestoreImage(BitmapRef, SizeX, SizeY, CurrViewData);
+		}
+	}
 
-		// Compress the restored bitmap image
-		FImageUtils::CompressImageArray(SizeX, SizeY, BitmapRef, CompressedBitmap);
-	
-		if (OverlapCalc)
+	// Hand over a copy of the image, it is compressed (and saved locally) on the image workers
+	if (!bEncodeMasks || ViewModes[CurrViewModeIdx] != ESLVisionViewMode::Mask)
+	{
+		CurrFrameImages.Emplace(CurrFrameData.Views.Num(), ImageIdx,
+			ImagePipeline.AddImage(SizeX, SizeY, TArray<FColor>(Bitmap), GetLocalImagePath()));
+	}
+	else if (!SaveLocallyFolderName.IsEmpty())
+	{
+		// Local copies are still png
+		ImagePipeline.AddImage(SizeX, SizeY, TArray<FColor>(Bitmap), GetLocalImagePath());
+	}
+
+	if ((OverlapCalc || SoftwareOcclusion.IsInit()) && ViewModes[CurrViewModeIdx] == ESLVisionViewMode::Mask)
+	{
+		const UCameraComponent* Camera = VirtualCameras[CurrVirtualCameraIdx]->GetCameraComponent();
+
+		// Entities whose screen footprint could not have changed keep their overlaps from the previous frame
+		if (!OverlapCache.IsInit() || OverlapCache.ReuseOverlaps(CurrVirtualCameraIdx, Camera, CurrViewData) > 0)
 		{
-			// Check if the image should be saved locally as well
-			if (!SaveLocallyFolderName.IsEmpty())
+			if (SoftwareOcclusion.IsInit())
 			{
-				SaveImageLocally(CompressedBitmap);
+				// Rasterize the overlaps in a single pass, kept aside for validation if the screenshots are used as well
+				if (OverlapCalc)
+				{
+					SoftwareOcclusion.CalculateForValidation(Camera, CurrViewData);
+				}
+				else
+				{
+					SoftwareOcclusion.Calculate(Camera, CurrViewData);
+				}
 			}
 
-			// Cache the image binary
-			CurrViewData.Images.Emplace(FSLVisionImageData(GetViewModeName(ViewModes[CurrViewModeIdx]), CompressedBitmap));
-
 			// Bind the screenshot callback for calculating overlaps
-			OverlapCalc->Start(&CurrViewData, CurrTimestamp, Episode.GetCurrIndex());
-
-			// Wait for next step until the overlaps were calculated
-			return;
+			if (OverlapCalc && OverlapCalc->Start(&CurrViewData, CurrTimestamp, Episode.GetCurrIndex()))
+			{
+				// Wait for next step until the overlaps were calculated (the view is cached when the parent is un-paused)
+				return;
+			}
 		}
-	}
-	else
-	{
-		// Compress the original bitmap image
-		FImageUtils::CompressImageArray(SizeX, SizeY, Bitmap, CompressedBitmap);
-	}
 
-	// Check if the image should be saved locally as well
-	if(!SaveLocallyFolderName.IsEmpty())
-	{
-		SaveImageLocally(CompressedBitmap);
+		// Cache the overlaps of the view
+		OverlapCache.Update(CurrVirtualCameraIdx, CurrViewData);
 	}
 
-	// Cache the image binary
-	CurrViewData.Images.Emplace(FSLVisionImageData(GetViewModeName(ViewModes[CurrViewModeIdx]), CompressedBitmap));
-
 	// Go to next frame/camera/view mode
 	if (NextStep())
 	{
@@ -355,6 +453,7 @@ void USLVisionLogger::ScreenshotCB(int32 SizeX, int32 SizeY, const TArray<FColor
 	{
 		UE_LOG(LogTemp, Warning, TEXT("%s::%d [%f] Finished visual logger.."),
 			*FString(__func__), __LINE__, GetWorld()->GetTimeSeconds());
+		bIsEpisodeDone = true;
 		QuitEditor();
 	}
 }
@@ -396,44 +495,74 @@ bool USLVisionLogger::NextStep()
 	else
 	{
 		// Current view is processed, cache the data
+		ChangeDetector.SetRenderedView(CurrVirtualCameraIdx, CurrViewData, CurrTimestamp,
+			VirtualCameras[CurrVirtualCameraIdx]->GetCameraComponent());
 		CurrFrameData.Views.Emplace(CurrViewData);
 
 		SetupFirstViewMode();
 
-		if (GotoNextCameraView())
-		{
-			// Start a new view data
-			CurrViewData.Clear();
-			CurrViewData.Init(VirtualCameras[CurrVirtualCameraIdx]->GetId(), VirtualCameras[CurrVirtualCameraIdx]->GetClassName());
-
-			return true;
-		}
-		else
+		// Skip the views which are not affected by the frame changes
+		do
 		{
-			// Write vision frame data to the database
-			DBHandler.WriteFrame(CurrFrameData);
-
-			if (SetupNextEpisodeFrame())
+			if (GotoNextCameraView())
 			{
-				GotoFirstCameraView();
-
+				// Start a new view data
 				CurrViewData.Clear();
 				CurrViewData.Init(VirtualCameras[CurrVirtualCameraIdx]->GetId(), VirtualCameras[CurrVirtualCameraIdx]->GetClassName());
-
-				CurrFrameData.Clear();
-				CurrFrameData.Init(CurrTimestamp, Resolution);
-
-				return true;
 			}
 			else
 			{
-				// Last episode frame, with the last camera location and the last view mode was proccessed
-				return false;
+				// Write vision frame data to the database once its images are compressed
+				ImagePipeline.AddOrderedTask([this, Frame = MoveTemp(CurrFrameData), Images = MoveTemp(CurrFrameImages)]() mutable
+				{
+					for (auto& Img : Images)
+					{
+						Frame.Views[Img.ViewIdx].Images[Img.ImageIdx].Data = MoveTemp(Img.Job->CompressedBitmap);
+					}
+					DBHandler.WriteFrame(Frame);
+				});
+
+				if (SetupNextEpisodeFrame())
+				{
+					GotoFirstCameraView();
+
+					CurrViewData.Clear();
+					CurrViewData.Init(VirtualCameras[CurrVirtualCameraIdx]->GetId(), VirtualCameras[CurrVirtualCameraIdx]->GetClassName());
+
+					CurrFrameData.Clear();
+					CurrFrameData.Init(CurrTimestamp, Resolution);
+				}
+				else
+				{
+					// Last episode frame, with the last camera location and the last view mode was proccessed
+					return false;
+				}
 			}
-		}
+		} while (ReuseUnchangedView());
+
+		return true;
 	}
 }
 
+// Reference the previous data of the current view if nothing in it changed, return true if reused
+bool USLVisionLogger::ReuseUnchangedView()
+{
+	if (!ChangeDetector.IsInit() ||
+		!ChangeDetector.IsViewUnchanged(CurrVirtualCameraIdx, VirtualCameras[CurrVirtualCameraIdx]->GetCameraComponent()))
+	{
+		return false;
+	}
+
+	// The images are referenced from the frame the view was rendered in
+	const FSLVisionRenderedView& RenderedView = ChangeDetector.GetRenderedView(CurrVirtualCameraIdx);
+	CurrViewData.Entities = RenderedView.Data.Entities;
+	CurrViewData.SkelEntities = RenderedView.Data.SkelEntities;
+	CurrViewData.RefTimestamp = RenderedView.Timestamp;
+	CurrFrameData.Views.Emplace(CurrViewData);
+	ChangeDetector.AddReusedView();
+	return true;
+}
+
 // Goto the first episode frame
 bool USLVisionLogger::SetupFirstEpisodeFrame()
 {
@@ -448,11 +577,49 @@ bool USLVisionLogger::SetupFirstEpisodeFrame()
 // Goto next episode frame, return false if there are no other left
 bool USLVisionLogger::SetupNextEpisodeFrame()
 {
+	// Cache the bounds of the actors before they are moved
+	if (ChangeDetector.IsInit())
+	{
+		if (const FSLVisionFrame* NextFrame = Episode.GetNextFrame())
+		{
+			ChangeDetector.BeginFrame(*NextFrame);
+		}
+	}
+
 	if(!Episode.SetupNextFrame(CurrTimestamp, true, OrigToMaskClones, PoseableOrigToMaskClones))
 	{
 		//UE_LOG(LogTemp, Error, TEXT("%s::%d No new frames.."), *FString(__func__), __LINE__);
 		return false;
 	}
+
+	if (ChangeDetector.IsInit())
+	{
+		ChangeDetector.EndFrame();
+	}
+
+	// Mark the moved mask clones as dirty for the overlap reuse
+	if (OverlapCache.IsInit())
+	{
+		if (const FSLVisionFrame* Frame = Episode.GetCurrFrame())
+		{
+			TArray<AActor*> MovedClones;
+			for (const auto& Pair : Frame->ActorPoses)
+			{
+				if (AStaticMeshActor** SMAClone = OrigToMaskClones.Find(Pair.Key))
+				{
+					MovedClones.Add(*SMAClone);
+				}
+			}
+			for (const auto& Pair : Frame->SkeletalPoses)
+			{
+				if (ASLVisionPoseableMeshActor** PMAClone = PoseableOrigToMaskClones.Find(Pair.Key))
+				{
+					MovedClones.Add(*PMAClone);
+				}
+			}
+			OverlapCache.AddMovedActors(MovedClones);
+		}
+	}
 	return true;
 }
 
@@ -934,18 +1101,36 @@ void USLVisionLogger::QuitEditor()
 	// Make sure you can quit even if Init or Start could not work out
 	if (GEngine)
 	{
-		GEngine->DeferredCommands.Add(TEXT("QUIT_EDITOR"));
+		// Standalone game processes (e.g. the shards) exit the game instead
+		GEngine->DeferredCommands.Add(GIsEditor ? TEXT("QUIT_EDITOR") : TEXT("QUIT"));
 	}
 #endif // WITH_EDITOR
 }
 
-// Save the compressed screenshot image locally
-void USLVisionLogger::SaveImageLocally(const TArray<uint8>& CompressedBitmap)
+// A shard which can not run marks itself as failed (if connected) and exits, otherwise the shards commandlet would wait on it
+void USLVisionLogger::QuitFailedShard(bool bIsConnected)
 {
+	if (ShardIdx != INDEX_NONE)
+	{
+		if (bIsConnected)
+		{
+			DBHandler.WriteShardState(ShardIdx, NumShards, TEXT("failed"));
+		}
+		QuitEditor();
+	}
+}
+
+// Path of the current image if it should be saved locally (empty otherwise)
+FString USLVisionLogger::GetLocalImagePath() const
+{
+	if (SaveLocallyFolderName.IsEmpty())
+	{
+		return FString();
+	}
 	const FString FolderName = VirtualCameras[CurrVirtualCameraIdx]->GetClassName() + "_" + CurrViewModePostfix;
 	FString Path = FPaths::ProjectDir() + "/SemLog/" + SaveLocallyFolderName + "/" + FolderName + "/" + CurrImageFilename + ".png";
 	FPaths::RemoveDuplicateSlashes(Path);
-	FFileHelper::SaveArrayToFile(CompressedBitmap, *Path);
+	return Path;
 }
 
 // Output progress to terminal
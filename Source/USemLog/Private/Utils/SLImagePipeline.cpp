@@ -0,0 +1,253 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "Utils/SLImagePipeline.h"
+#include "Misc/QueuedThreadPool.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/FileHelper.h"
+#include "HAL/PlatformProcess.h"
+#include "ImageUtils.h"
+
+namespace
+{
+	// Worker side of a compression job, deletes itself when done
+	class FSLImageWork : public IQueuedWork
+	{
+	public:
+		// Ctor
+		FSLImageWork(FSLImagePipeline* InPipeline, const TSharedPtr<FSLImageJob, ESPMode::ThreadSafe>& InJob) :
+			Pipeline(InPipeline), Job(InJob) {};
+
+		// Compress the image then run the ordered tasks which were waiting for it
+		virtual void DoThreadedWork() override
+		{
+			if (Job.IsValid())
+			{
+				Job->Run();
+				Pipeline->OnJobDone(*Job);
+			}
+			Pipeline->Drain();
+			delete this;
+		}
+
+		// Called if the pool is destroyed before the work started
+		virtual void Abandon() override
+		{
+			DoThreadedWork();
+		}
+
+	private:
+		// Owner
+		FSLImagePipeline* Pipeline;
+
+		// Compression job (invalid if only a drain is requested)
+		TSharedPtr<FSLImageJob, ESPMode::ThreadSafe> Job;
+	};
+}
+
+// Compress the bitmap and save it if required
+void FSLImageJob::Run()
+{
+	FImageUtils::CompressImageArray(SizeX, SizeY, Bitmap, CompressedBitmap);
+	Bitmap.Empty();
+	if (!SavePath.IsEmpty())
+	{
+		FFileHelper::SaveArrayToFile(CompressedBitmap, *SavePath);
+	}
+	bIsDone = true;
+}
+
+// Ctor
+FSLImagePipeline::FSLImagePipeline() :
+	bIsInit(false),
+	ThreadPool(nullptr),
+	MaxInFlightBytes(0),
+	InFlightBytes(0),
+	MemoryEvent(nullptr),
+	FirstEntryIdx(0),
+	bIsDraining(false),
+	bDrainAgain(false)
+{
+}
+
+// Dtor
+FSLImagePipeline::~FSLImagePipeline()
+{
+	Shutdown();
+}
+
+// Create the workers
+void FSLImagePipeline::Init(int32 InNumWorkers, int32 InMaxInFlightMB)
+{
+	if (!bIsInit && InNumWorkers > 0)
+	{
+		ThreadPool = FQueuedThreadPool::Allocate();
+		if (!ThreadPool->Create(InNumWorkers, 128 * 1024))
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s::%d Could not create the image workers, images will be compressed synchronously.."),
+				*FString(__func__), __LINE__);
+			delete ThreadPool;
+			ThreadPool = nullptr;
+			return;
+		}
+		MemoryEvent = FPlatformProcess::GetSynchEventFromPool(false);
+		MaxInFlightBytes = FMath::Max(1, InMaxInFlightMB) * 1024LL * 1024LL;
+		bIsInit = true;
+	}
+}
+
+// Queue the image compression (and save), the result is in the job once it is done
+TSharedRef<FSLImageJob, ESPMode::ThreadSafe> FSLImagePipeline::AddImage(int32 SizeX, int32 SizeY, TArray<FColor>&& Bitmap,
+	const FString& SavePath)
+{
+	TSharedRef<FSLImageJob, ESPMode::ThreadSafe> Job = MakeShared<FSLImageJob, ESPMode::ThreadSafe>();
+	Job->SizeX = SizeX;
+	Job->SizeY = SizeY;
+	Job->Bitmap = MoveTemp(Bitmap);
+	Job->SavePath = SavePath;
+
+	if (!bIsInit)
+	{
+		Job->Run();
+		return Job;
+	}
+
+	// Wait for the workers if too much memory is in flight (at least one image is always accepted)
+	const int64 Bytes = static_cast<int64>(SizeX) * SizeY * sizeof(FColor);
+	while (true)
+	{
+		{
+			FScopeLock ScopeLock(&Lock);
+			if (InFlightBytes == 0 || InFlightBytes + Bytes <= MaxInFlightBytes)
+			{
+				InFlightBytes += Bytes;
+				Entries.Add({ Job, nullptr });
+				break;
+			}
+		}
+		MemoryEvent->Wait(10);
+	}
+
+	ThreadPool->AddQueuedWork(new FSLImageWork(this, Job));
+	return Job;
+}
+
+// Run the task after all the previously added images and tasks are done (tasks run in order, one at a time)
+void FSLImagePipeline::AddOrderedTask(TFunction<void()>&& Task)
+{
+	if (!bIsInit)
+	{
+		Task();
+		return;
+	}
+
+	{
+		FScopeLock ScopeLock(&Lock);
+		Entries.Add({ nullptr, MoveTemp(Task) });
+	}
+	ThreadPool->AddQueuedWork(new FSLImageWork(this, nullptr));
+}
+
+// Wait until all the images and tasks are done
+void FSLImagePipeline::Flush()
+{
+	if (!bIsInit)
+	{
+		return;
+	}
+
+	while (true)
+	{
+		{
+			FScopeLock ScopeLock(&Lock);
+			if (FirstEntryIdx == Entries.Num() && !bIsDraining)
+			{
+				Entries.Reset();
+				FirstEntryIdx = 0;
+				return;
+			}
+		}
+		FPlatformProcess::Sleep(0.001f);
+	}
+}
+
+// Finish the pending work and stop the workers
+void FSLImagePipeline::Shutdown()
+{
+	if (bIsInit)
+	{
+		Flush();
+		ThreadPool->Destroy();
+		delete ThreadPool;
+		ThreadPool = nullptr;
+		FPlatformProcess::ReturnSynchEventToPool(MemoryEvent);
+		MemoryEvent = nullptr;
+		bIsInit = false;
+	}
+}
+
+// Called by the workers when a job is done
+void FSLImagePipeline::OnJobDone(FSLImageJob& Job)
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+		InFlightBytes -= static_cast<int64>(Job.SizeX) * Job.SizeY * sizeof(FColor);
+	}
+	MemoryEvent->Trigger();
+}
+
+// Run the tasks which have all their previous images done
+void FSLImagePipeline::Drain()
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (bIsDraining)
+		{
+			bDrainAgain = true;
+			return;
+		}
+		bIsDraining = true;
+	}
+
+	while (true)
+	{
+		TFunction<void()> Task;
+		{
+			FScopeLock ScopeLock(&Lock);
+
+			// Skip the finished images
+			while (FirstEntryIdx < Entries.Num() && Entries[FirstEntryIdx].Job.IsValid() && Entries[FirstEntryIdx].Job->bIsDone)
+			{
+				Entries[FirstEntryIdx].Job.Reset();
+				FirstEntryIdx++;
+			}
+
+			if (FirstEntryIdx < Entries.Num() && !Entries[FirstEntryIdx].Job.IsValid())
+			{
+				Task = MoveTemp(Entries[FirstEntryIdx].Task);
+				FirstEntryIdx++;
+			}
+			else if (bDrainAgain)
+			{
+				bDrainAgain = false;
+				continue;
+			}
+			else
+			{
+				// Compact the processed entries
+				if (FirstEntryIdx > 1024)
+				{
+					Entries.RemoveAt(0, FirstEntryIdx, false);
+					FirstEntryIdx = 0;
+				}
+				bIsDraining = false;
+				return;
+			}
+		}
+
+		if (Task)
+		{
+			Task();
+		}
+	}
+}
@@ -0,0 +1,147 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "Vision/SLVisionChangeDetector.h"
+#include "Engine/StaticMeshActor.h"
+#include "Camera/CameraComponent.h"
+
+#include "Vision/SLVisionPoseableMeshActor.h"
+
+// Ctor
+FSLVisionChangeDetector::FSLVisionChangeDetector() : bIsInit(false)
+{
+	NumRendered = 0;
+	NumReused = 0;
+}
+
+// Set the number of views and the image resolution
+void FSLVisionChangeDetector::Init(int32 NumViews, FIntPoint InResolution)
+{
+	if (!bIsInit)
+	{
+		Resolution = InResolution;
+		Views.SetNum(NumViews);
+		if (NumViews > 0)
+		{
+			bIsInit = true;
+		}
+	}
+}
+
+// Cache the bounds of the actors the frame is going to move (call before applying the frame)
+void FSLVisionChangeDetector::BeginFrame(const FSLVisionFrame& Frame)
+{
+	MovedActors.Reset();
+	MovedBounds.Reset();
+	for (const auto& Pair : Frame.ActorPoses)
+	{
+		MovedActors.Add(Pair.Key);
+	}
+	for (const auto& Pair : Frame.SkeletalPoses)
+	{
+		MovedActors.Add(Pair.Key);
+	}
+	for (AActor* Actor : MovedActors)
+	{
+		MovedBounds.Add(Actor->GetComponentsBoundingBox());
+	}
+}
+
+// Add the bounds of the moved actors after the frame was applied
+void FSLVisionChangeDetector::EndFrame()
+{
+	for (AActor* Actor : MovedActors)
+	{
+		MovedBounds.Add(Actor->GetComponentsBoundingBox());
+	}
+	MovedActors.Reset();
+}
+
+// Check if nothing in the frustum of the camera changed since the last rendering of the view
+bool FSLVisionChangeDetector::IsViewUnchanged(int32 ViewIdx, const UCameraComponent* Camera) const
+{
+	if (!bIsInit || !Camera || !Views.IsValidIndex(ViewIdx) || !Views[ViewIdx].bIsValid)
+	{
+		return false;
+	}
+
+	const FTransform ViewPose = Camera->GetComponentTransform();
+	if (!Views[ViewIdx].CameraPose.Equals(ViewPose, CameraPoseTolerance))
+	{
+		return false;
+	}
+
+	const float Focal = (Resolution.X * 0.5f) / FMath::Tan(FMath::DegreesToRadians(Camera->FieldOfView) * 0.5f);
+	for (const FBox& Box : MovedBounds)
+	{
+		if (IsInFrustum(Box, ViewPose, Focal))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+// Store the rendered view
+void FSLVisionChangeDetector::SetRenderedView(int32 ViewIdx, const FSLVisionViewData& ViewData, float Timestamp, const UCameraComponent* Camera)
+{
+	if (!bIsInit || !Camera || !Views.IsValidIndex(ViewIdx))
+	{
+		return;
+	}
+
+	FSLVisionRenderedView& View = Views[ViewIdx];
+	View.bIsValid = true;
+	View.Timestamp = Timestamp;
+	View.CameraPose = Camera->GetComponentTransform();
+	View.Data.Init(ViewData.Id, ViewData.Class);
+	View.Data.Entities = ViewData.Entities;
+	View.Data.SkelEntities = ViewData.SkelEntities;
+	NumRendered++;
+}
+
+// Log the number of rendered and reused views
+void FSLVisionChangeDetector::LogSummary() const
+{
+	if (bIsInit)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d Views: Rendered=%lld; Reused=%lld;"),
+			*FString(__func__), __LINE__, NumRendered, NumReused);
+	}
+}
+
+// Check if any part of the box can be seen from the pose
+bool FSLVisionChangeDetector::IsInFrustum(const FBox& Box, const FTransform& ViewPose, float Focal) const
+{
+	if (!Box.IsValid)
+	{
+		return false;
+	}
+
+	FBox2D ScreenBounds(ForceInit);
+	int32 NumBehind = 0;
+	for (int32 Corner = 0; Corner < 8; ++Corner)
+	{
+		const FVector Point = ViewPose.InverseTransformPosition(FVector(
+			(Corner & 1) ? Box.Max.X : Box.Min.X,
+			(Corner & 2) ? Box.Max.Y : Box.Min.Y,
+			(Corner & 4) ? Box.Max.Z : Box.Min.Z));
+		if (Point.X < KINDA_SMALL_NUMBER)
+		{
+			NumBehind++;
+			continue;
+		}
+		ScreenBounds += FVector2D(Resolution.X * 0.5f + Point.Y / Point.X * Focal, Resolution.Y * 0.5f - Point.Z / Point.X * Focal);
+	}
+
+	// Fully behind the camera, or crossing the camera plane (could reach into the image)
+	if (NumBehind == 8)
+	{
+		return false;
+	}
+	if (NumBehind > 0)
+	{
+		return true;
+	}
+	return ScreenBounds.Intersect(FBox2D(FVector2D::ZeroVector, FVector2D(Resolution.X, Resolution.Y)));
+}
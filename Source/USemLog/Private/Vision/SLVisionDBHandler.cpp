@@ -3,21 +3,252 @@
 
 #include "Vision/SLVisionDBHandler.h"
 #include "SLEntitiesManager.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/Crc.h"
+#include "Components/PoseableMeshComponent.h"
 
 // UUtils
 #if SL_WITH_ROS_CONVERSIONS
 #include "Conversions.h"
 #endif // SL_WITH_ROS_CONVERSIONS
 
+namespace
+{
+	/**
+	* Runs the episode loading on its own thread
+	*/
+	class FSLVisionEpisodeLoader : public FRunnable
+	{
+	public:
+		// Ctor
+		FSLVisionEpisodeLoader(TFunction<void()>&& InLoadFunc) : LoadFunc(MoveTemp(InLoadFunc)) {}
+
+		// Load the episode frames
+		virtual uint32 Run() override
+		{
+			LoadFunc();
+			return 0;
+		}
+
+	private:
+		// Loads the frames until the end of the episode or until the episode is stopped
+		TFunction<void()> LoadFunc;
+	};
+
+#if SL_WITH_LIBMONGO_C
+	// Read the single letter fields of the sub-document in one pass
+	void ReadXYZW(const bson_iter_t* iter, float& X, float& Y, float& Z, float* W = nullptr)
+	{
+		bson_iter_t child_iter;
+		if (!bson_iter_recurse(iter, &child_iter))
+		{
+			return;
+		}
+		while (bson_iter_next(&child_iter))
+		{
+			const char* key = bson_iter_key(&child_iter);
+			if (key[0] == '\0' || key[1] != '\0')
+			{
+				continue;
+			}
+			switch (key[0])
+			{
+			case 'x': X = bson_iter_double(&child_iter); break;
+			case 'y': Y = bson_iter_double(&child_iter); break;
+			case 'z': Z = bson_iter_double(&child_iter); break;
+			case 'w': if (W) { *W = bson_iter_double(&child_iter); } break;
+			default: break;
+			}
+		}
+	}
+
+	// Read the field if it is the location or the rotation, returns false otherwise
+	bool ReadPoseField(const bson_iter_t* field_iter, const char* key, FVector& OutLoc, FQuat& OutQuat)
+	{
+		if (FCStringAnsi::Strcmp(key, "loc") == 0)
+		{
+			ReadXYZW(field_iter, OutLoc.X, OutLoc.Y, OutLoc.Z);
+			return true;
+		}
+		if (FCStringAnsi::Strcmp(key, "rot") == 0)
+		{
+			ReadXYZW(field_iter, OutQuat.X, OutQuat.Y, OutQuat.Z, &OutQuat.W);
+			return true;
+		}
+		return false;
+	}
+
+	// Create the unreal transform from the stored values
+	FORCEINLINE FTransform ToTransform(const FVector& Loc, const FQuat& Quat)
+	{
+#if SL_WITH_ROS_CONVERSIONS
+		return FConversions::ROSToU(FTransform(Quat, Loc));
+#else
+		return FTransform(Quat, Loc);
+#endif // SL_WITH_ROS_CONVERSIONS
+	}
+
+	// Get the first and the last timestamp of the episode, returns false if there are none
+	bool GetTimestampRange(mongoc_collection_t* coll, float& OutFirstTs, float& OutLastTs)
+	{
+		int32 NumFound = 0;
+		for (int32 SortOrder : { 1, -1 })
+		{
+			bson_t* filter = BCON_NEW("timestamp", "{", "$exists", BCON_BOOL(true), "}");
+			bson_t* opts = BCON_NEW(
+				"sort", "{", "timestamp", BCON_INT32(SortOrder), "}",
+				"projection", "{", "_id", BCON_INT32(0), "timestamp", BCON_INT32(1), "}",
+				"limit", BCON_INT64(1));
+			mongoc_cursor_t* cursor = mongoc_collection_find_with_opts(coll, filter, opts, NULL);
+
+			const bson_t* doc;
+			bson_iter_t iter;
+			if (mongoc_cursor_next(cursor, &doc) && bson_iter_init_find(&iter, doc, "timestamp"))
+			{
+				(SortOrder > 0 ? OutFirstTs : OutLastTs) = bson_iter_double(&iter);
+				NumFound++;
+			}
+
+			mongoc_cursor_destroy(cursor);
+			bson_destroy(opts);
+			bson_destroy(filter);
+		}
+		return NumFound == 2;
+	}
+
+	// Insert the documents of the source into the destination collection (in timestamp order if requested), returns false on errors
+	bool CopyCollection(mongoc_collection_t* src, mongoc_collection_t* dst, bool bSortByTimestamp, int64& OutNumCopied)
+	{
+		// The inserts are sent in batches of a few MB (the gridfs chunks are large)
+		static constexpr uint32 MaxBatchBytes = 16 * 1024 * 1024;
+
+		bson_error_t error;
+		bson_t filter;
+		bson_init(&filter);
+		bson_t* opts = bSortByTimestamp ? BCON_NEW("sort", "{", "timestamp", BCON_INT32(1), "}") : bson_new();
+		mongoc_cursor_t* cursor = mongoc_collection_find_with_opts(src, &filter, opts, NULL);
+
+		mongoc_bulk_operation_t* bulk = nullptr;
+		uint32 BatchBytes = 0;
+		bool bSuccess = true;
+		auto ExecuteBatch = [&]()
+		{
+			bson_t reply;
+			if (!mongoc_bulk_operation_execute(bulk, &reply, &error))
+			{
+				UE_LOG(LogTemp, Error, TEXT("%s::%d Could not insert the documents, err.:%s;"),
+					*FString(__func__), __LINE__, *FString(error.message));
+				bSuccess = false;
+			}
+			bson_destroy(&reply);
+			mongoc_bulk_operation_destroy(bulk);
+			bulk = nullptr;
+			BatchBytes = 0;
+		};
+
+		const bson_t* doc;
+		while (bSuccess && mongoc_cursor_next(cursor, &doc))
+		{
+			if (!bulk)
+			{
+				bulk = mongoc_collection_create_bulk_operation_with_opts(dst, NULL);
+			}
+			mongoc_bulk_operation_insert(bulk, doc);
+			BatchBytes += doc->len;
+			OutNumCopied++;
+			if (BatchBytes >= MaxBatchBytes)
+			{
+				ExecuteBatch();
+			}
+		}
+		if (bulk)
+		{
+			if (bSuccess)
+			{
+				ExecuteBatch();
+			}
+			else
+			{
+				mongoc_bulk_operation_destroy(bulk);
+			}
+		}
+
+		if (mongoc_cursor_error(cursor, &error))
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s::%d Failed to iterate all documents.. Err. %s"),
+				*FString(__func__), __LINE__, *FString(error.message));
+			bSuccess = false;
+		}
+
+		mongoc_cursor_destroy(cursor);
+		bson_destroy(opts);
+		bson_destroy(&filter);
+		return bSuccess;
+	}
+#endif //SL_WITH_LIBMONGO_C
+}
+
+// Add a key, returns its slot (the existing slot if the key was already added)
+int32 FSLVisionDBKeyTable::Add(const FString& Key)
+{
+	FTCHARToUTF8 Utf8Key(*Key);
+	const int32 ExistingSlot = Find(Utf8Key.Get(), Utf8Key.Length());
+	if (ExistingSlot != INDEX_NONE)
+	{
+		return ExistingSlot;
+	}
+
+	const uint32 Hash = FCrc::MemCrc32(Utf8Key.Get(), Utf8Key.Length());
+	const int32 Slot = Keys.Emplace(Utf8Key.Get(), Utf8Key.Length());
+	const int32* FirstSlot = HashToSlot.Find(Hash);
+	NextSlots.Add(FirstSlot ? *FirstSlot : INDEX_NONE);
+	HashToSlot.Add(Hash, Slot);
+	return Slot;
+}
+
+// Get the slot of the utf8 key (INDEX_NONE if not found)
+int32 FSLVisionDBKeyTable::Find(const char* Key, uint32 Length) const
+{
+	if (!Key)
+	{
+		return INDEX_NONE;
+	}
+	const int32* FirstSlot = HashToSlot.Find(FCrc::MemCrc32(Key, Length));
+	for (int32 Slot = FirstSlot ? *FirstSlot : INDEX_NONE; Slot != INDEX_NONE; Slot = NextSlots[Slot])
+	{
+		if (Keys[Slot].Num() == (int32)Length && FMemory::Memcmp(Keys[Slot].GetData(), Key, Length) == 0)
+		{
+			return Slot;
+		}
+	}
+	return INDEX_NONE;
+}
 
 // Ctor
-FSLVisionDBHandler::FSLVisionDBHandler() {}
+FSLVisionDBHandler::FSLVisionDBHandler() :
+	EpisodeLoader(nullptr),
+	EpisodeLoaderThread(nullptr),
+	StreamedEpisode(nullptr),
+	bIsEpisodeStreamComplete(false),
+	ShardIdx(INDEX_NONE)
+{
+}
+
+// Dtor
+FSLVisionDBHandler::~FSLVisionDBHandler()
+{
+	StopEpisodeStream();
+}
 
-// Connect to the database
+// Connect to the database (a shard writes to its own staging vision collection)
 bool FSLVisionDBHandler::Connect(const FString& DBName, const FString& CollName, const FString& ServerIp,
-	uint16 ServerPort, bool bRemovePrevEntries)
+	uint16 ServerPort, bool bRemovePrevEntries, int32 InShardIdx)
 {
-	const FString VisCollName = CollName + ".vis";
+	const FString VisCollName = GetVisCollName(CollName, InShardIdx);
+	this->DBName = DBName;
+	this->CollName = CollName;
+	ShardIdx = InShardIdx;
 
 #if SL_WITH_LIBMONGO_C
 	// Required to initialize libmongoc's internals	
@@ -294,10 +525,120 @@ void FSLVisionDBHandler::CreateIndexes() const
 #endif //SL_WITH_LIBMONGO_C
 }
 
-// Get episode data from the database (UpdateRate = 0 means all the data)
-bool FSLVisionDBHandler::GetEpisodeData(float UpdateRate, const TMap<ASkeletalMeshActor*,
+// Start streaming the episode data (or the timestamp range of the shard) into the episode buffer (UpdateRate = 0 means all the data)
+bool FSLVisionDBHandler::StartEpisodeStream(float UpdateRate, const TMap<ASkeletalMeshActor*,
 	ASLVisionPoseableMeshActor*>& InSkelToPoseableMap,
-	FSLVisionEpisode& OutEpisode)
+	FSLVisionEpisode& OutEpisode, int32 NumShards)
+{
+#if SL_WITH_LIBMONGO_C
+	if (EpisodeLoaderThread)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d Episode stream already started.."), *FString(__func__), __LINE__);
+		return false;
+	}
+
+	// The loader only reads the slots, the entities manager is not accessed outside the game thread
+	CreateEntitySlots(InSkelToPoseableMap);
+
+	StreamedEpisode = &OutEpisode;
+	EpisodeLoader = new FSLVisionEpisodeLoader([this, UpdateRate, NumShards, &OutEpisode]()
+	{
+		bIsEpisodeStreamComplete = LoadEpisodeFrames(UpdateRate, NumShards, OutEpisode);
+		if (!bIsEpisodeStreamComplete)
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s::%d Episode loading stopped before the end of the episode.."), *FString(__func__), __LINE__);
+		}
+		OutEpisode.SetLoadingFinished();
+	});
+	EpisodeLoaderThread = FRunnableThread::Create(EpisodeLoader, TEXT("SLVisionEpisodeLoader"));
+	if (!EpisodeLoaderThread)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Could not create the episode loader thread.."), *FString(__func__), __LINE__);
+		delete EpisodeLoader;
+		EpisodeLoader = nullptr;
+		StreamedEpisode = nullptr;
+		return false;
+	}
+	return true;
+#else
+	return false;
+#endif //SL_WITH_LIBMONGO_C
+}
+
+// Stop the episode stream and wait for the loader thread
+void FSLVisionDBHandler::StopEpisodeStream()
+{
+	if (EpisodeLoaderThread)
+	{
+		// Unblock the loader if it waits for free space in the buffer
+		StreamedEpisode->Stop();
+		EpisodeLoaderThread->WaitForCompletion();
+		delete EpisodeLoaderThread;
+		EpisodeLoaderThread = nullptr;
+	}
+	if (EpisodeLoader)
+	{
+		delete EpisodeLoader;
+		EpisodeLoader = nullptr;
+	}
+	StreamedEpisode = nullptr;
+}
+
+// Map the entity ids and bone names of the episode data to their actors and names (call before loading)
+void FSLVisionDBHandler::CreateEntitySlots(const TMap<ASkeletalMeshActor*, ASLVisionPoseableMeshActor*>& InSkelToPoseableMap)
+{
+	EntityIds.Reset();
+	EntitySlots.Reset();
+	BoneNameKeys.Reset();
+	BoneNames.Reset();
+
+	auto GetSlot = [this](const FString& Id) -> FSLVisionDBEntitySlot&
+	{
+		const int32 Slot = EntityIds.Add(Id);
+		if (Slot >= EntitySlots.Num())
+		{
+			EntitySlots.SetNum(Slot + 1);
+		}
+		return EntitySlots[Slot];
+	};
+
+	FSLEntitiesManager* EntitiesManager = FSLEntitiesManager::GetInstance();
+	for (const auto& Pair : *EntitiesManager->GetIdToStaticMeshActorMap())
+	{
+		GetSlot(Pair.Key).StaticMeshActor = Pair.Value;
+	}
+	for (const auto& Pair : *EntitiesManager->GetIdToVisionCameraMap())
+	{
+		GetSlot(Pair.Key).VisionCamera = Pair.Value;
+	}
+	for (const auto& Pair : *EntitiesManager->GetIdToSkeletalMeshActorMap())
+	{
+		ASLVisionPoseableMeshActor* const* PMA = InSkelToPoseableMap.Find(Pair.Value);
+		if (!PMA)
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s::%d Could not find poseable mesh clone actor for %s, did you run the setup before?"),
+				*FString(__func__), __LINE__, *Pair.Value->GetName());
+			continue;
+		}
+		GetSlot(Pair.Key).PoseableMeshActor = *PMA;
+
+		// Bone names are created once instead of for every bone of every frame
+		if (UPoseableMeshComponent* PMC = (*PMA)->GetPoseableMeshComponent())
+		{
+			for (int32 BoneIdx = 0; BoneIdx < PMC->GetNumBones(); ++BoneIdx)
+			{
+				const FName BoneName = PMC->GetBoneName(BoneIdx);
+				if (BoneNameKeys.Add(BoneName.ToString()) == BoneNames.Num())
+				{
+					BoneNames.Add(BoneName);
+				}
+			}
+		}
+	}
+}
+
+// Read the episode frames (of the shard) into the episode buffer (runs on the loader thread with its own client)
+bool FSLVisionDBHandler::LoadEpisodeFrames(float UpdateRate, int32 NumShards, FSLVisionEpisode& OutEpisode) const
 {
 	float CurrTs = 0.f;
 	float PrevTs = -BIG_NUMBER; // this to make sure the first entry is loaded every time
@@ -309,6 +650,44 @@ bool FSLVisionDBHandler::GetEpisodeData(float UpdateRate, const TMap<ASkeletalMe
 	mongoc_cursor_t *cursor;
 	bson_t *pipeline;
 
+	// Clients are not thread safe, the loader uses its own
+	mongoc_client_t* loader_client = mongoc_client_new_from_uri(uri);
+	if (!loader_client)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Could not create a mongo client.."), *FString(__func__), __LINE__);
+		return false;
+	}
+	mongoc_client_set_appname(loader_client, TCHAR_TO_UTF8(*("SLVIS_LOAD_" + CollName)));
+	mongoc_collection_t* loader_collection = mongoc_client_get_collection(loader_client,
+		TCHAR_TO_UTF8(*DBName), TCHAR_TO_UTF8(*CollName));
+
+	// A shard replays an equal part of the timestamp range, the changes before its range are accumulated into its first frame
+	float ShardStartTs = -BIG_NUMBER;
+	float ShardEndTs = BIG_NUMBER;
+	if (ShardIdx != INDEX_NONE && NumShards > 1)
+	{
+		float FirstTs = 0.f;
+		float LastTs = 0.f;
+		if (!GetTimestampRange(loader_collection, FirstTs, LastTs))
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s::%d Could not read the timestamp range of the episode.."), *FString(__func__), __LINE__);
+			mongoc_collection_destroy(loader_collection);
+			mongoc_client_destroy(loader_client);
+			return false;
+		}
+		const float ShardLength = (LastTs - FirstTs) / NumShards;
+		if (ShardIdx > 0)
+		{
+			ShardStartTs = FirstTs + ShardIdx * ShardLength;
+		}
+		if (ShardIdx < NumShards - 1)
+		{
+			ShardEndTs = FirstTs + (ShardIdx + 1) * ShardLength;
+		}
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d Shard %ld/%ld replays the timestamps [%.3f, %.3f) of [%.3f, %.3f].."),
+			*FString(__func__), __LINE__, ShardIdx, NumShards, FMath::Max(ShardStartTs, FirstTs), FMath::Min(ShardEndTs, LastTs), FirstTs, LastTs);
+	}
+
 	pipeline = BCON_NEW("pipeline", "[",
 		"{",
 			"$match",
@@ -340,60 +719,95 @@ bool FSLVisionDBHandler::GetEpisodeData(float UpdateRate, const TMap<ASkeletalMe
 	BSON_APPEND_BOOL(&opts, "allowDiskUse", true);
 
 	cursor = mongoc_collection_aggregate(
-		collection, MONGOC_QUERY_NONE, pipeline, &opts, NULL);
+		loader_collection, MONGOC_QUERY_NONE, pipeline, &opts, NULL);
 
-	while (mongoc_cursor_next(cursor, &doc))
-	{
-		// Store the changes from the previous frame until this one
-		FSLVisionFrame Frame;
+	// Store the changes from the previous frame until this one
+	FSLVisionFrame Frame;
+	bool bIsStopped = false;
+
+	// Index of the pose of each entity slot in the frame, the changes of the later documents overwrite it
+	TArray<int32> SlotToPoseIdx;
+	SlotToPoseIdx.Init(INDEX_NONE, EntitySlots.Num());
 
+	// Decoding statistics
+	int32 NumDocs = 0;
+	int32 NumFrames = 0;
+	double DecodeSeconds = 0.0;
+
+	while (!bIsStopped && mongoc_cursor_next(cursor, &doc))
+	{
 		bson_iter_t doc_iter;
 		if (bson_iter_init(&doc_iter, doc))
 		{
-			// Get the current timestamp
-			if (bson_iter_find(&doc_iter, "timestamp"))
+			const double DecodeStart = FPlatformTime::Seconds();
+
+			// Walk the document fields once, accumulate the entity changes in the frame until the desired update rate is reached
+			while (bson_iter_next(&doc_iter))
 			{
-				CurrTs = bson_iter_double(&doc_iter);
+				const char* key = bson_iter_key(&doc_iter);
+				if (FCStringAnsi::Strcmp(key, "timestamp") == 0)
+				{
+					CurrTs = bson_iter_double(&doc_iter);
+				}
+				else if (FCStringAnsi::Strcmp(key, "entities") == 0)
+				{
+					GetEntitiesData(&doc_iter, Frame.ActorPoses, Frame.VisionCameraPoses, SlotToPoseIdx);
+				}
+				else if (FCStringAnsi::Strcmp(key, "skel_entities") == 0)
+				{
+					GetSkeletalEntitiesData(&doc_iter, Frame.SkeletalPoses, Frame.BonePoses, SlotToPoseIdx);
+				}
 			}
 
-			// Accumulate entity changes in the frame until the desired update rate is reached
-			GetEntitiesData(&doc_iter, Frame.ActorPoses, Frame.VisionCameraPoses);
+			DecodeSeconds += FPlatformTime::Seconds() - DecodeStart;
+			NumDocs++;
 
-			// Accumulate skeletal entity changes in the frame until the desired update rate is reached
-			GetSkeletalEntitiesData(&doc_iter, InSkelToPoseableMap, Frame.SkeletalPoses);
+			// The remaining documents belong to the next shard
+			if (CurrTs >= ShardEndTs)
+			{
+				break;
+			}
 
-			// Check if the desired update rate is reached
+			// Check if the desired update rate is reached (the frame times are the same for every shard count)
 			if (CurrTs - PrevTs >= UpdateRate)
 			{
 				// Update the previous timestamp
 				PrevTs = CurrTs;
 
-				// Add frame to episode and clear it for new data
-				if (Frame.ActorPoses.Num() != 0 || Frame.SkeletalPoses.Num() != 0)
+				// Add frame to episode (blocks while the buffer is full) and clear it for new data
+				if (CurrTs >= ShardStartTs && Frame.HasEntityPoses())
 				{
 					Frame.Timestamp = CurrTs;
-					OutEpisode.AddFrame(Frame);
+					bIsStopped = !OutEpisode.PushFrame(MoveTemp(Frame));
 					Frame.Clear();
+					SlotToPoseIdx.Init(INDEX_NONE, EntitySlots.Num());
+					NumFrames++;
 				}
 			}
 		}
 	}
 
 	// Check if any errors appeared while iterating the cursor
-	if (mongoc_cursor_error(cursor, &error))
+	const bool bHasError = mongoc_cursor_error(cursor, &error);
+	if (bHasError)
 	{
 		UE_LOG(LogTemp, Error, TEXT("%s::%d Failed to iterate all documents.. Err. %s"),
 			*FString(__func__), __LINE__, *FString(error.message));
-		return false;
 	}
 
+	UE_LOG(LogTemp, Log, TEXT("%s::%d Loaded %ld frames from %ld documents, decoding took %.3f s (%.2f us/doc);"),
+		*FString(__func__), __LINE__, NumFrames, NumDocs, DecodeSeconds, NumDocs > 0 ? DecodeSeconds * 1.e6 / NumDocs : 0.0);
+
 	mongoc_cursor_destroy(cursor);
 	bson_destroy(pipeline);
+	bson_destroy(&opts);
+	mongoc_collection_destroy(loader_collection);
+	mongoc_client_destroy(loader_client);
 
-	return true;
+	return !bHasError && !bIsStopped;
 #else
 	return false;
-#endif //SL_WITH_LIBMONGO_C
+#endif //SL_WITH_LIBMONGO_C
 }
 
 // Write current frame
@@ -453,6 +867,10 @@ void FSLVisionDBHandler::WriteFrame(const FSLVisionFrameData& Frame) const
 
 		BSON_APPEND_UTF8(&views_arr_obj, "class", TCHAR_TO_UTF8(*ViewData.Class));
 		BSON_APPEND_UTF8(&views_arr_obj, "id", TCHAR_TO_UTF8(*ViewData.Id));
+		if (ViewData.RefTimestamp >= 0.f)
+		{
+			BSON_APPEND_DOUBLE(&views_arr_obj, "ref_ts", ViewData.RefTimestamp);
+		}
 
 		// Create the entities array
 		j = 0;
@@ -515,18 +933,38 @@ void FSLVisionDBHandler::WriteFrame(const FSLVisionFrameData& Frame) const
 		}
 		bson_append_array_end(&views_arr_obj, &entities_arr);
 
+		// Upload the images, or reference the previously uploaded ones if the view was not rendered
+		if (ViewData.RefTimestamp < 0.f)
+		{
+			TArray<FSLVisionDBImageRef>& ImageRefs = PrevViewImages.FindOrAdd(ViewData.Id);
+			ImageRefs.Reset();
+			for (const auto& Img : ViewData.Images)
+			{
+				if (AddToGridFs(Img.Data, &file_oid))
+				{
+					ImageRefs.Add(FSLVisionDBImageRef{ Img.Type, Img.Format, file_oid });
+				}
+			}
+		}
+		else if (!PrevViewImages.Contains(ViewData.Id))
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s::%d View %s references images which were not written, continuing.."),
+				*FString(__func__), __LINE__, *ViewData.Class);
+		}
+
 		// Create the images array
 		k = 0;
 		BSON_APPEND_ARRAY_BEGIN(&views_arr_obj, "images", &imgs_arr);
-		for (const auto& Img : ViewData.Images)
+		if (const TArray<FSLVisionDBImageRef>* ImageRefs = PrevViewImages.Find(ViewData.Id))
 		{
-			if (AddToGridFs(Img.Data, &file_oid))
+			for (const auto& ImgRef : *ImageRefs)
 			{
 				bson_uint32_to_string(k, &k_key, k_str, sizeof k_str);
 				BSON_APPEND_DOCUMENT_BEGIN(&imgs_arr, k_key, &imgs_arr_obj);
 
-				BSON_APPEND_UTF8(&imgs_arr_obj, "type", TCHAR_TO_UTF8(*Img.Type));
-				BSON_APPEND_OID(&imgs_arr_obj, "file_id", (const bson_oid_t*)&file_oid);
+				BSON_APPEND_UTF8(&imgs_arr_obj, "type", TCHAR_TO_UTF8(*ImgRef.Type));
+				BSON_APPEND_UTF8(&imgs_arr_obj, "format", TCHAR_TO_UTF8(*ImgRef.Format));
+				BSON_APPEND_OID(&imgs_arr_obj, "file_id", &ImgRef.FileId);
 
 				bson_append_document_end(&imgs_arr, &imgs_arr_obj);
 				k++;
@@ -548,6 +986,174 @@ void FSLVisionDBHandler::WriteFrame(const FSLVisionFrameData& Frame) const
 #endif //SL_WITH_LIBMONGO_C
 }
 
+// Store the state of the shard (running, finished, failed, merged) in the shards collection
+void FSLVisionDBHandler::WriteShardState(int32 InShardIdx, int32 NumShards, const FString& State,
+	int32 NumFrames, float FirstTs, float LastTs) const
+{
+#if SL_WITH_LIBMONGO_C
+	bson_error_t error;
+	mongoc_collection_t* shards_collection = mongoc_database_get_collection(database, TCHAR_TO_UTF8(*GetShardsCollName(CollName)));
+
+	bson_t* selector = BCON_NEW("shard", BCON_INT32(InShardIdx));
+	bson_t* update = BCON_NEW("$set", "{",
+		"num_shards", BCON_INT32(NumShards),
+		"state", BCON_UTF8(TCHAR_TO_UTF8(*State)),
+		"num_frames", BCON_INT32(NumFrames),
+		"first_ts", BCON_DOUBLE(FirstTs),
+		"last_ts", BCON_DOUBLE(LastTs),
+		"host", BCON_UTF8(TCHAR_TO_UTF8(FPlatformProcess::ComputerName())),
+		"updated", BCON_DATE_TIME(FDateTime::UtcNow().ToUnixTimestamp() * 1000),
+	"}");
+	bson_t* opts = BCON_NEW("upsert", BCON_BOOL(true));
+
+	if (!mongoc_collection_update_one(shards_collection, selector, update, opts, NULL, &error))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Could not write the state (%s) of shard %ld, err.:%s;"),
+			*FString(__func__), __LINE__, *State, InShardIdx, *FString(error.message));
+	}
+
+	bson_destroy(opts);
+	bson_destroy(update);
+	bson_destroy(selector);
+	mongoc_collection_destroy(shards_collection);
+#endif //SL_WITH_LIBMONGO_C
+}
+
+// Copy the finished shards into the connected (canonical) vision collection in timestamp order, drop their staging collections
+bool FSLVisionDBHandler::MergeShards(int32 NumShards) const
+{
+#if SL_WITH_LIBMONGO_C
+	if (!database || ShardIdx != INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d The shards are merged into the vision collection of the episode, connect to it first.."),
+			*FString(__func__), __LINE__);
+		return false;
+	}
+
+	// The shards are consecutive timestamp ranges, copying them in order keeps the frames ordered
+	const FString VisCollName = GetVisCollName(CollName);
+	const TArray<FString> Suffixes = { TEXT(""), TEXT(".files"), TEXT(".chunks") };
+	for (int32 Idx = 0; Idx < NumShards; ++Idx)
+	{
+		const FString ShardCollName = GetVisCollName(CollName, Idx);
+		for (const FString& Suffix : Suffixes)
+		{
+			mongoc_collection_t* src = mongoc_database_get_collection(database, TCHAR_TO_UTF8(*(ShardCollName + Suffix)));
+			mongoc_collection_t* dst = mongoc_database_get_collection(database, TCHAR_TO_UTF8(*(VisCollName + Suffix)));
+			int64 NumCopied = 0;
+			const bool bCopied = CopyCollection(src, dst, Suffix.IsEmpty(), NumCopied);
+			mongoc_collection_destroy(dst);
+			mongoc_collection_destroy(src);
+			if (!bCopied)
+			{
+				UE_LOG(LogTemp, Error, TEXT("%s::%d Could not copy %s%s, the merge is incomplete.."),
+					*FString(__func__), __LINE__, *ShardCollName, *Suffix);
+				return false;
+			}
+			UE_LOG(LogTemp, Log, TEXT("%s::%d Copied %lld documents from %s%s.."),
+				*FString(__func__), __LINE__, NumCopied, *ShardCollName, *Suffix);
+		}
+	}
+
+	// Remove the staging collections once every shard is copied
+	bson_error_t error;
+	for (int32 Idx = 0; Idx < NumShards; ++Idx)
+	{
+		const FString ShardCollName = GetVisCollName(CollName, Idx);
+		for (const FString& Suffix : Suffixes)
+		{
+			mongoc_collection_t* staging = mongoc_database_get_collection(database, TCHAR_TO_UTF8(*(ShardCollName + Suffix)));
+			if (!mongoc_collection_drop(staging, &error))
+			{
+				UE_LOG(LogTemp, Error, TEXT("%s::%d Could not drop collection %s%s, err.:%s;"),
+					*FString(__func__), __LINE__, *ShardCollName, *Suffix, *FString(error.message));
+			}
+			mongoc_collection_destroy(staging);
+		}
+		WriteShardState(Idx, NumShards, TEXT("merged"));
+	}
+	return true;
+#else
+	return false;
+#endif //SL_WITH_LIBMONGO_C
+}
+
+// Read the state of every shard of the episode (empty if the shard never started)
+bool FSLVisionDBHandler::GetShardStates(const FString& DBName, const FString& CollName, const FString& ServerIp,
+	uint16 ServerPort, int32 NumShards, TArray<FString>& OutStates)
+{
+	OutStates.Init(FString(), NumShards);
+
+#if SL_WITH_LIBMONGO_C
+	mongoc_init();
+
+	bson_error_t error;
+	const FString Uri = TEXT("mongodb://") + ServerIp + TEXT(":") + FString::FromInt(ServerPort);
+	mongoc_client_t* states_client = mongoc_client_new(TCHAR_TO_UTF8(*Uri));
+	if (!states_client)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Could not create a mongo client for %s.."), *FString(__func__), __LINE__, *Uri);
+		return false;
+	}
+	mongoc_collection_t* shards_collection = mongoc_client_get_collection(states_client,
+		TCHAR_TO_UTF8(*DBName), TCHAR_TO_UTF8(*GetShardsCollName(CollName)));
+
+	// States of another shard count are ignored
+	bson_t* filter = BCON_NEW("num_shards", BCON_INT32(NumShards));
+	mongoc_cursor_t* cursor = mongoc_collection_find_with_opts(shards_collection, filter, NULL, NULL);
+
+	const bson_t* doc;
+	while (mongoc_cursor_next(cursor, &doc))
+	{
+		bson_iter_t iter;
+		int32 Idx = INDEX_NONE;
+		FString State;
+		if (bson_iter_init(&iter, doc))
+		{
+			while (bson_iter_next(&iter))
+			{
+				const char* key = bson_iter_key(&iter);
+				if (FCStringAnsi::Strcmp(key, "shard") == 0)
+				{
+					Idx = bson_iter_int32(&iter);
+				}
+				else if (FCStringAnsi::Strcmp(key, "state") == 0)
+				{
+					State = FString(UTF8_TO_TCHAR(bson_iter_utf8(&iter, NULL)));
+				}
+			}
+		}
+		if (OutStates.IsValidIndex(Idx))
+		{
+			OutStates[Idx] = State;
+		}
+	}
+
+	const bool bHasError = mongoc_cursor_error(cursor, &error);
+	if (bHasError)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Could not read the shard states.. Err. %s"),
+			*FString(__func__), __LINE__, *FString(error.message));
+	}
+
+	mongoc_cursor_destroy(cursor);
+	bson_destroy(filter);
+	mongoc_collection_destroy(shards_collection);
+	mongoc_client_destroy(states_client);
+	return !bHasError;
+#else
+	return false;
+#endif //SL_WITH_LIBMONGO_C
+}
+
+// Get the name of the vision collection, or the staging collection of the shard
+FString FSLVisionDBHandler::GetVisCollName(const FString& CollName, int32 ShardIdx)
+{
+	return ShardIdx == INDEX_NONE
+		? CollName + TEXT(".vis")
+		: CollName + TEXT(".vis.shard") + FString::FromInt(ShardIdx);
+}
+
 // Remove any previously added vision data from the database
 void FSLVisionDBHandler::DropPreviousEntriesFromWorldColl_Legacy(const FString& DBName, const FString& CollName) const
 {
@@ -625,184 +1231,219 @@ void FSLVisionDBHandler::DropPreviousEntries(const FString& DBName, const FStrin
 }
 
 #if SL_WITH_LIBMONGO_C
-// Get the entities data out of the bson iterator
-bool FSLVisionDBHandler::GetEntitiesData(bson_iter_t* doc,
-	TMap<AStaticMeshActor*, FTransform>& OutEntityPoses,
-	TMap<ASLVisionCamera*, FTransform>& OutVirtualCameraPoses) const
+// Get the entities data out of the entities array iterator (single pass), returns false if there are no entities
+bool FSLVisionDBHandler::GetEntitiesData(const bson_iter_t* entities_iter,
+	TArray<TPair<AStaticMeshActor*, FTransform>>& OutEntityPoses,
+	TArray<TPair<ASLVisionCamera*, FTransform>>& OutVirtualCameraPoses,
+	TArray<int32>& InOutSlotToPoseIdx) const
 {
-	// Iterate entities
-	if (bson_iter_find(doc, "entities"))
+	bson_iter_t child_iter;			// entities
+	bson_iter_t sub_child_iter;		// id, loc, rot
+
+	if (!BSON_ITER_HOLDS_ARRAY(entities_iter) || !bson_iter_recurse(entities_iter, &child_iter))
 	{
-		bson_iter_t child_iter;				// entities,
-		bson_iter_t sub_child_iter;			// id, loc, rot
-		bson_iter_t sub_sub_child_iter;		// x,y,z,w (entity)
+		return false;
+	}
 
-		// Check if there are any entities
-		if (bson_iter_recurse(doc, &child_iter))
+	bool bHasEntityPoses = false;
+	while (bson_iter_next(&child_iter))
+	{
+		if (!bson_iter_recurse(&child_iter, &sub_child_iter))
 		{
-			FString Id;
-			FVector Loc;
-			FQuat Quat;
+			continue;
+		}
 
-			while (bson_iter_next(&child_iter))
+		int32 Slot = INDEX_NONE;
+		FVector Loc(0.f);
+		FQuat Quat(FQuat::Identity);
+		while (bson_iter_next(&sub_child_iter))
+		{
+			const char* key = bson_iter_key(&sub_child_iter);
+			if (FCStringAnsi::Strcmp(key, "id") == 0)
 			{
-				if (bson_iter_recurse(&child_iter, &sub_child_iter) && bson_iter_find(&sub_child_iter, "id"))
-				{
-					Id = FString(bson_iter_utf8(&sub_child_iter, NULL));
-				}
-				if (bson_iter_recurse(&child_iter, &sub_child_iter) && bson_iter_find_descendant(&sub_child_iter, "loc.x", &sub_sub_child_iter))
-				{
-					Loc.X = bson_iter_double(&sub_sub_child_iter);
-				}
-				if (bson_iter_recurse(&child_iter, &sub_child_iter) && bson_iter_find_descendant(&sub_child_iter, "loc.y", &sub_sub_child_iter))
-				{
-					Loc.Y = bson_iter_double(&sub_sub_child_iter);
-				}
-				if (bson_iter_recurse(&child_iter, &sub_child_iter) && bson_iter_find_descendant(&sub_child_iter, "loc.z", &sub_sub_child_iter))
-				{
-					Loc.Z = bson_iter_double(&sub_sub_child_iter);
-				}
-				if (bson_iter_recurse(&child_iter, &sub_child_iter) && bson_iter_find_descendant(&sub_child_iter, "rot.x", &sub_sub_child_iter))
+				uint32 id_len = 0;
+				const char* id = bson_iter_utf8(&sub_child_iter, &id_len);
+				Slot = EntityIds.Find(id, id_len);
+			}
+			else
+			{
+				ReadPoseField(&sub_child_iter, key, Loc, Quat);
+			}
+		}
+
+		// Add entity, or overwrite its previous pose in the frame
+		if (Slot != INDEX_NONE)
+		{
+			const FSLVisionDBEntitySlot& Entity = EntitySlots[Slot];
+			int32& PoseIdx = InOutSlotToPoseIdx[Slot];
+			if (Entity.StaticMeshActor)
+			{
+				if (PoseIdx == INDEX_NONE)
 				{
-					Quat.X = bson_iter_double(&sub_sub_child_iter);
+					PoseIdx = OutEntityPoses.Emplace(Entity.StaticMeshActor, ToTransform(Loc, Quat));
 				}
-				if (bson_iter_recurse(&child_iter, &sub_child_iter) && bson_iter_find_descendant(&sub_child_iter, "rot.y", &sub_sub_child_iter))
+				else
 				{
-					Quat.Y = bson_iter_double(&sub_sub_child_iter);
+					OutEntityPoses[PoseIdx].Value = ToTransform(Loc, Quat);
 				}
-				if (bson_iter_recurse(&child_iter, &sub_child_iter) && bson_iter_find_descendant(&sub_child_iter, "rot.z", &sub_sub_child_iter))
+				bHasEntityPoses = true;
+			}
+			else if (Entity.VisionCamera)
+			{
+				if (PoseIdx == INDEX_NONE)
 				{
-					Quat.Z = bson_iter_double(&sub_sub_child_iter);
+					PoseIdx = OutVirtualCameraPoses.Emplace(Entity.VisionCamera, ToTransform(Loc, Quat));
 				}
-				if (bson_iter_recurse(&child_iter, &sub_child_iter) && bson_iter_find_descendant(&sub_child_iter, "rot.w", &sub_sub_child_iter))
+				else
 				{
-					Quat.W = bson_iter_double(&sub_sub_child_iter);
-				}
-
-				// Add entity
-				if (AStaticMeshActor* SMA = FSLEntitiesManager::GetInstance()->GetStaticMeshActor(Id))
-				{
-#if SL_WITH_ROS_CONVERSIONS
-					OutEntityPoses.Emplace(SMA, FConversions::ROSToU(FTransform(Quat, Loc)));
-#else
-					OutEntityPoses.Emplace(SMA, FTransform(Quat, Loc));
-#endif // SL_WITH_ROS_CONVERSIONS
-				}
-				else if (ASLVisionCamera* VCA = FSLEntitiesManager::GetInstance()->GetVisionCameraActor(Id))
-				{					
-#if SL_WITH_ROS_CONVERSIONS
-					OutVirtualCameraPoses.Emplace(VCA, FConversions::ROSToU(FTransform(Quat, Loc)));
-#else
-					OutVirtualCameraPoses.Emplace(VCA, FTransform(Quat, Loc));
-#endif // SL_WITH_ROS_CONVERSIONS
+					OutVirtualCameraPoses[PoseIdx].Value = ToTransform(Loc, Quat);
 				}
 			}
 		}
-		return OutEntityPoses.Num() > 0;
-	}
-	else
-	{
-		return false;
 	}
+	return bHasEntityPoses;
 }
 
-// Get the entities data out of the bson iterator, returns false if there are no entities
-bool FSLVisionDBHandler::GetSkeletalEntitiesData(bson_iter_t* doc, 
-	const TMap<ASkeletalMeshActor*, ASLVisionPoseableMeshActor*>& InSkelToPoseableMap,
-	TMap<ASLVisionPoseableMeshActor*, TMap<FName, FTransform>>& OutSkeletalPoses) const
+// Get the skeletal entities data out of the skeletal entities array iterator (single pass), returns false if there are no entities
+bool FSLVisionDBHandler::GetSkeletalEntitiesData(const bson_iter_t* skel_entities_iter,
+	TArray<TPair<ASLVisionPoseableMeshActor*, int32>>& OutSkeletalPoses,
+	TArray<TPair<FName, FTransform>>& OutBonePoses,
+	TArray<int32>& InOutSlotToPoseIdx) const
 {
-	// Iterate skeletal entities
-	if (bson_iter_find(doc, "skel_entities"))
+	bson_iter_t child_iter;				// skel_entities
+	bson_iter_t sub_child_iter;			// id, bones
+	bson_iter_t bones_child;			// bones (array)
+	bson_iter_t bones_sub_child;		// name, loc, rot
+
+	if (!BSON_ITER_HOLDS_ARRAY(skel_entities_iter) || !bson_iter_recurse(skel_entities_iter, &child_iter))
 	{
-		bson_iter_t child_iter;				// skel_entities
-		bson_iter_t sub_child_iter;			// bones
-		bson_iter_t sub_sub_child_iter;		// bones (array)
+		return false;
+	}
 
-		if (bson_iter_recurse(doc, &child_iter))
+	bool bHasSkeletalPoses = false;
+	TArray<TPair<FName, FTransform>> NewBonePoses;
+	while (bson_iter_next(&child_iter))
+	{
+		if (!bson_iter_recurse(&child_iter, &sub_child_iter))
 		{
-			FString Id;
-			TMap<FName, FTransform> BonesMap;
+			continue;
+		}
 
-			while (bson_iter_next(&child_iter))
+		// The bones are appended directly, and removed if the entity has no poseable clone or is already in the frame
+		const int32 FirstBoneIdx = OutBonePoses.Num();
+		int32 Slot = INDEX_NONE;
+		while (bson_iter_next(&sub_child_iter))
+		{
+			const char* key = bson_iter_key(&sub_child_iter);
+			if (FCStringAnsi::Strcmp(key, "id") == 0)
 			{
-				if (bson_iter_recurse(&child_iter, &sub_child_iter) && bson_iter_find(&sub_child_iter, "id"))
-				{
-					Id = FString(bson_iter_utf8(&sub_child_iter, NULL));
-				}
-
-				if (bson_iter_recurse(&child_iter, &sub_sub_child_iter) && bson_iter_find(&sub_sub_child_iter, "bones"))
+				uint32 id_len = 0;
+				const char* id = bson_iter_utf8(&sub_child_iter, &id_len);
+				Slot = EntityIds.Find(id, id_len);
+			}
+			else if (FCStringAnsi::Strcmp(key, "bones") == 0 && bson_iter_recurse(&sub_child_iter, &bones_child))
+			{
+				while (bson_iter_next(&bones_child))
 				{
-					bson_iter_t bones_child;			// array  obj
-					bson_iter_t bones_sub_child;		// name, loc, rot
-					bson_iter_t bones_sub_sub_child;	// x, y , z, w
-
-					FName BoneName;
-					FVector Loc;
-					FQuat Quat;
+					if (!bson_iter_recurse(&bones_child, &bones_sub_child))
+					{
+						continue;
+					}
 
-					if (bson_iter_recurse(&sub_sub_child_iter, &bones_child))
+					FName BoneName = NAME_None;
+					FVector Loc(0.f);
+					FQuat Quat(FQuat::Identity);
+					while (bson_iter_next(&bones_sub_child))
 					{
-						while (bson_iter_next(&bones_child))
+						const char* bone_key = bson_iter_key(&bones_sub_child);
+						if (FCStringAnsi::Strcmp(bone_key, "name") == 0)
 						{
-							if (bson_iter_recurse(&bones_child, &bones_sub_child) && bson_iter_find(&bones_sub_child, "name"))
-							{
-								BoneName = FName(bson_iter_utf8(&bones_sub_child, NULL));
-							}
-							if (bson_iter_recurse(&bones_child, &bones_sub_child) && bson_iter_find_descendant(&bones_sub_child, "loc.x", &bones_sub_sub_child))
-							{
-								Loc.X = bson_iter_double(&bones_sub_sub_child);
-							}
-							if (bson_iter_recurse(&bones_child, &bones_sub_child) && bson_iter_find_descendant(&bones_sub_child, "loc.y", &bones_sub_sub_child))
-							{
-								Loc.Y = bson_iter_double(&bones_sub_sub_child);
-							}
-							if (bson_iter_recurse(&bones_child, &bones_sub_child) && bson_iter_find_descendant(&bones_sub_child, "loc.z", &bones_sub_sub_child))
-							{
-								Loc.Z = bson_iter_double(&bones_sub_sub_child);
-							}
-							if (bson_iter_recurse(&bones_child, &bones_sub_child) && bson_iter_find_descendant(&bones_sub_child, "rot.x", &bones_sub_sub_child))
-							{
-								Quat.X = bson_iter_double(&bones_sub_sub_child);
-							}
-							if (bson_iter_recurse(&bones_child, &bones_sub_child) && bson_iter_find_descendant(&bones_sub_child, "rot.y", &bones_sub_sub_child))
+							uint32 name_len = 0;
+							const char* name = bson_iter_utf8(&bones_sub_child, &name_len);
+							const int32 BoneSlot = BoneNameKeys.Find(name, name_len);
+							if (BoneSlot != INDEX_NONE)
 							{
-								Quat.Y = bson_iter_double(&bones_sub_sub_child);
+								BoneName = BoneNames[BoneSlot];
 							}
-							if (bson_iter_recurse(&bones_child, &bones_sub_child) && bson_iter_find_descendant(&bones_sub_child, "rot.z", &bones_sub_sub_child))
+							else if (name)
 							{
-								Quat.Z = bson_iter_double(&bones_sub_sub_child);
+								BoneName = FName(UTF8_TO_TCHAR(name));
 							}
-							if (bson_iter_recurse(&bones_child, &bones_sub_child) && bson_iter_find_descendant(&bones_sub_child, "rot.w", &bones_sub_sub_child))
-							{
-								Quat.W = bson_iter_double(&bones_sub_sub_child);
-							}
-#if SL_WITH_ROS_CONVERSIONS
-							BonesMap.Add(BoneName, FConversions::ROSToU(FTransform(Quat, Loc)));
-#else
-							BonesMap.Add(BoneName, FTransform(Quat, Loc));
-#endif // SL_WITH_ROS_CONVERSIONS
+						}
+						else
+						{
+							ReadPoseField(&bones_sub_child, bone_key, Loc, Quat);
 						}
 					}
+					OutBonePoses.Emplace(BoneName, ToTransform(Loc, Quat));
 				}
+			}
+		}
 
-				// Add skeletal entity
-				if (ASkeletalMeshActor* SkMA = FSLEntitiesManager::GetInstance()->GetSkeletalMeshActor((Id)))
+		// Add skeletal entity
+		ASLVisionPoseableMeshActor* PMA = Slot != INDEX_NONE ? EntitySlots[Slot].PoseableMeshActor : nullptr;
+		if (!PMA)
+		{
+			OutBonePoses.SetNum(FirstBoneIdx, false);
+			continue;
+		}
+
+		bHasSkeletalPoses = true;
+		int32& PoseIdx = InOutSlotToPoseIdx[Slot];
+		if (PoseIdx == INDEX_NONE)
+		{
+			PoseIdx = OutSkeletalPoses.Emplace(PMA, OutBonePoses.Num() - FirstBoneIdx);
+			continue;
+		}
+
+		// Already in the frame, overwrite its bones with the appended ones (the documents usually have the same bone order)
+		int32 EntityFirstBoneIdx = 0;
+		for (int32 Idx = 0; Idx < PoseIdx; ++Idx)
+		{
+			EntityFirstBoneIdx += OutSkeletalPoses[Idx].Value;
+		}
+		int32& NumEntityBones = OutSkeletalPoses[PoseIdx].Value;
+		NewBonePoses.Reset();
+		for (int32 NewIdx = FirstBoneIdx; NewIdx < OutBonePoses.Num(); ++NewIdx)
+		{
+			const TPair<FName, FTransform>& NewBonePose = OutBonePoses[NewIdx];
+			const int32 SameOrderIdx = EntityFirstBoneIdx + NewIdx - FirstBoneIdx;
+			int32 BoneIdx = INDEX_NONE;
+			if (NewIdx - FirstBoneIdx < NumEntityBones && OutBonePoses[SameOrderIdx].Key == NewBonePose.Key)
+			{
+				BoneIdx = SameOrderIdx;
+			}
+			else
+			{
+				for (int32 Idx = EntityFirstBoneIdx; Idx < EntityFirstBoneIdx + NumEntityBones; ++Idx)
 				{
-					if (ASLVisionPoseableMeshActor* const* PMA = InSkelToPoseableMap.Find(SkMA))
+					if (OutBonePoses[Idx].Key == NewBonePose.Key)
 					{
-						OutSkeletalPoses.Emplace(*PMA, BonesMap);
-					}
-					else
-					{
-						UE_LOG(LogTemp, Error, TEXT("%s::%d Could not find poseable mesh clone actor for %s, did you run the setup before?"),
-							*FString(__func__), __LINE__, *SkMA->GetName());
+						BoneIdx = Idx;
+						break;
 					}
 				}
 			}
+
+			if (BoneIdx != INDEX_NONE)
+			{
+				OutBonePoses[BoneIdx].Value = NewBonePose.Value;
+			}
+			else
+			{
+				NewBonePoses.Add(NewBonePose);
+			}
+		}
+		OutBonePoses.SetNum(FirstBoneIdx, false);
+
+		// Bones missing from the previous entry are added to its range
+		if (NewBonePoses.Num() > 0)
+		{
+			OutBonePoses.Insert(NewBonePoses, EntityFirstBoneIdx + NumEntityBones);
+			NumEntityBones += NewBonePoses.Num();
 		}
-		return OutSkeletalPoses.Num() > 0;
 	}
-	return false;
+	return bHasSkeletalPoses;
 }
 
 // Save image to gridfs, get the file oid and return true if succeeded
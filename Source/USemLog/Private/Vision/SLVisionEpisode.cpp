@@ -0,0 +1,191 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "Vision/SLVisionEpisode.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/ScopeLock.h"
+
+// Default ctor
+FSLVisionEpisode::FSLVisionEpisode() :
+	PrefetchSeconds(5.f),
+	MaxBufferedFrames(512),
+	FrameIdx(INDEX_NONE),
+	NumLoadedFrames(0),
+	FirstTimestamp(-1.f),
+	LastTimestamp(-1.f),
+	bIsLoadingFinished(false),
+	bIsStopped(false)
+{
+	FrameAddedEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	FrameRemovedEvent = FPlatformProcess::GetSynchEventFromPool(false);
+}
+
+// Dtor
+FSLVisionEpisode::~FSLVisionEpisode()
+{
+	FPlatformProcess::ReturnSynchEventToPool(FrameAddedEvent);
+	FPlatformProcess::ReturnSynchEventToPool(FrameRemovedEvent);
+}
+
+// Set the buffer limits (episode seconds ahead of the active frame, and max number of buffered frames)
+void FSLVisionEpisode::Init(float InPrefetchSeconds, int32 InMaxBufferedFrames)
+{
+	FScopeLock ScopeLock(&Lock);
+	PrefetchSeconds = FMath::Max(InPrefetchSeconds, 0.f);
+	MaxBufferedFrames = FMath::Max(InMaxBufferedFrames, 2);
+
+	// The buffer never reallocates, the next frame can be read while the loader adds new ones
+	Buffer.Reserve(MaxBufferedFrames);
+}
+
+// Add a new frame (loader side), blocks while the buffer is full, returns false if the episode was stopped
+bool FSLVisionEpisode::PushFrame(FSLVisionFrame&& Frame)
+{
+	while (true)
+	{
+		{
+			FScopeLock ScopeLock(&Lock);
+			if (bIsStopped)
+			{
+				return false;
+			}
+			if (!IsBufferFull())
+			{
+				if (NumLoadedFrames == 0)
+				{
+					FirstTimestamp = Frame.Timestamp;
+				}
+				LastTimestamp = Frame.Timestamp;
+				NumLoadedFrames++;
+				Buffer.Emplace(MoveTemp(Frame));
+				break;
+			}
+		}
+		FrameRemovedEvent->Wait();
+	}
+	FrameAddedEvent->Trigger();
+	return true;
+}
+
+// No more frames will be added (loader side)
+void FSLVisionEpisode::SetLoadingFinished()
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+		bIsLoadingFinished = true;
+	}
+	FrameAddedEvent->Trigger();
+}
+
+// Unblock the loader and the renderer, no more frames will be returned
+void FSLVisionEpisode::Stop()
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+		bIsStopped = true;
+	}
+	FrameAddedEvent->Trigger();
+	FrameRemovedEvent->Trigger();
+}
+
+// Get the number of loaded frames (the total once the loading is finished)
+int32 FSLVisionEpisode::GetFramesNum() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return NumLoadedFrames;
+}
+
+// Get the frame following the active one, waits for the loader (nullptr if none is left, valid until the next setup)
+const FSLVisionFrame* FSLVisionEpisode::GetNextFrame()
+{
+	if (!WaitForNextFrame())
+	{
+		return nullptr;
+	}
+
+	// Only the renderer removes frames, and adding new ones does not reallocate the buffer
+	FScopeLock ScopeLock(&Lock);
+	return &Buffer[0];
+}
+
+// Move actors to the first frame
+bool FSLVisionEpisode::SetupFirstFrame(float& OutTimestamp,
+	bool bIncludeMasks,
+	TMap<AStaticMeshActor*, AStaticMeshActor*>& MaskClones,
+	TMap<ASLVisionPoseableMeshActor*, ASLVisionPoseableMeshActor*>& SkelMaskClones)
+{
+	FrameIdx = INDEX_NONE;
+	return SetupNextFrame(OutTimestamp, bIncludeMasks, MaskClones, SkelMaskClones);
+}
+
+// Move actors to the next frame transformations, return false if no more frames are available
+bool FSLVisionEpisode::SetupNextFrame(float& OutTimestamp,
+	bool bIncludeMasks,
+	TMap<AStaticMeshActor*, AStaticMeshActor*>& MaskClones,
+	TMap<ASLVisionPoseableMeshActor*, ASLVisionPoseableMeshActor*>& SkelMaskClones)
+{
+	if (!WaitForNextFrame())
+	{
+		FrameIdx = INDEX_NONE;
+		return false;
+	}
+
+	{
+		FScopeLock ScopeLock(&Lock);
+		CurrFrame = MoveTemp(Buffer[0]);
+		Buffer.RemoveAt(0, 1, false);
+	}
+	FrameRemovedEvent->Trigger();
+
+	FrameIdx++;
+	OutTimestamp = CurrFrame.ApplyTransformations(bIncludeMasks, MaskClones, SkelMaskClones);
+	return true;
+}
+
+// Get first timestamp
+float FSLVisionEpisode::GetFirstTimestamp() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return FirstTimestamp;
+}
+
+// Get the timestamp of the last loaded frame (the last one once the loading is finished)
+float FSLVisionEpisode::GetLastTimestamp() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return LastTimestamp;
+}
+
+// Wait until the frame after the active one is buffered, false if there are no more frames
+bool FSLVisionEpisode::WaitForNextFrame()
+{
+	while (true)
+	{
+		{
+			FScopeLock ScopeLock(&Lock);
+			if (bIsStopped)
+			{
+				return false;
+			}
+			if (Buffer.Num() > 0)
+			{
+				return true;
+			}
+			if (bIsLoadingFinished)
+			{
+				return false;
+			}
+		}
+		FrameAddedEvent->Wait();
+	}
+}
+
+// Check if the loader has to wait (call with the lock)
+bool FSLVisionEpisode::IsBufferFull() const
+{
+	if (Buffer.Num() >= MaxBufferedFrames)
+	{
+		return true;
+	}
+	return Buffer.Num() > 1 && Buffer.Last().Timestamp - Buffer[0].Timestamp >= PrefetchSeconds;
+}
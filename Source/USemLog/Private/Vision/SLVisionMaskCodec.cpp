@@ -0,0 +1,188 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "Vision/SLVisionMaskCodec.h"
+#include "Misc/Compression.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+
+// File identifier and version
+static const uint32 SLMaskMagic = 0x4b4d4c53; // SLMK
+static const uint32 SLMaskVersion = 1;
+
+// Payload is zlib compressed
+static const uint32 SLMaskFlagZlib = 1;
+
+// Max image side (engine max texture size), bounds the decoded allocations
+static const uint32 SLMaskMaxDim = 16384;
+
+// Max payload bytes per pixel (a run of one pixel, two 5 byte varints)
+static const int64 SLMaskMaxBytesPerPixel = 10;
+
+const FString FSLVisionMaskCodec::FormatName = TEXT("slmk");
+const uint32 FSLVisionMaskCodec::UnknownCode = MAX_uint32;
+
+namespace
+{
+	// Append the unsigned value as a varint
+	FORCEINLINE void WriteVarInt(TArray<uint8>& Out, uint32 Value)
+	{
+		while (Value >= 0x80)
+		{
+			Out.Add(static_cast<uint8>(Value | 0x80));
+			Value >>= 7;
+		}
+		Out.Add(static_cast<uint8>(Value));
+	}
+
+	// Read a varint, returns false if the data ends
+	FORCEINLINE bool ReadVarInt(const uint8*& Ptr, const uint8* End, uint32& OutValue)
+	{
+		OutValue = 0;
+		for (int32 Shift = 0; Shift < 35 && Ptr < End; Shift += 7)
+		{
+			const uint8 Byte = *Ptr++;
+			OutValue |= static_cast<uint32>(Byte & 0x7F) << Shift;
+			if (!(Byte & 0x80))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+// Encode the runs (in raster order), the palette holds the colors of the codes (e.g. the original mask colors)
+void FSLVisionMaskCodec::Encode(int32 Width, int32 Height, const TArray<FSLVisionMaskRun>& Runs, const TArray<FColor>& CodeColors,
+	bool bCompress, TArray<uint8>& OutData)
+{
+	// Palette of the used colors, in the order of their first run
+	TArray<FColor> Palette;
+	TMap<uint32, uint32> CodeToPaletteIdx;
+	TMap<FColor, uint32> UnknownToPaletteIdx;
+	TArray<uint8> Payload;
+	Payload.Reserve(Runs.Num() * 3);
+	for (const FSLVisionMaskRun& Run : Runs)
+	{
+		uint32 PaletteIdx;
+		if (Run.Code == UnknownCode)
+		{
+			const uint32* Found = UnknownToPaletteIdx.Find(Run.Color);
+			PaletteIdx = Found ? *Found : UnknownToPaletteIdx.Add(Run.Color, Palette.Add(Run.Color));
+		}
+		else
+		{
+			const uint32* Found = CodeToPaletteIdx.Find(Run.Code);
+			PaletteIdx = Found ? *Found : CodeToPaletteIdx.Add(Run.Code, Palette.Add(CodeColors[Run.Code]));
+		}
+		WriteVarInt(Payload, Run.Len);
+		WriteVarInt(Payload, PaletteIdx);
+	}
+
+	OutData.Reset();
+	FMemoryWriter Writer(OutData);
+	uint32 Magic = SLMaskMagic;
+	uint32 Version = SLMaskVersion;
+	uint32 W = Width;
+	uint32 H = Height;
+	uint32 Flags = 0;
+	uint32 NumColors = Palette.Num();
+
+	// Compress the payload if it pays off
+	TArray<uint8> Compressed;
+	if (bCompress && Payload.Num() > 0)
+	{
+		int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Payload.Num());
+		Compressed.SetNumUninitialized(CompressedSize);
+		if (FCompression::CompressMemory(NAME_Zlib, Compressed.GetData(), CompressedSize, Payload.GetData(), Payload.Num())
+			&& CompressedSize + static_cast<int32>(sizeof(uint32)) < Payload.Num())
+		{
+			Compressed.SetNum(CompressedSize, false);
+			Flags |= SLMaskFlagZlib;
+		}
+	}
+
+	Writer << Magic << Version << W << H << Flags << NumColors;
+	for (FColor& Color : Palette)
+	{
+		Writer << Color.R << Color.G << Color.B << Color.A;
+	}
+	if (Flags & SLMaskFlagZlib)
+	{
+		uint32 RawSize = Payload.Num();
+		Writer << RawSize;
+		Writer.Serialize(Compressed.GetData(), Compressed.Num());
+	}
+	else
+	{
+		Writer.Serialize(Payload.GetData(), Payload.Num());
+	}
+}
+
+// Decode the image, returns false if the data is not a valid encoded mask
+bool FSLVisionMaskCodec::Decode(const TArray<uint8>& InData, int32& OutWidth, int32& OutHeight, TArray<FColor>& OutBitmap)
+{
+	FMemoryReader Reader(InData);
+	uint32 Magic = 0, Version = 0, W = 0, H = 0, Flags = 0, NumColors = 0;
+	if (InData.Num() < 24)
+	{
+		return false;
+	}
+	Reader << Magic << Version << W << H << Flags << NumColors;
+	if (Magic != SLMaskMagic || Version != SLMaskVersion || W > SLMaskMaxDim || H > SLMaskMaxDim
+		|| Reader.TotalSize() - Reader.Tell() < static_cast<int64>(NumColors) * 4)
+	{
+		return false;
+	}
+
+	TArray<FColor> Palette;
+	Palette.SetNumUninitialized(NumColors);
+	for (FColor& Color : Palette)
+	{
+		Reader << Color.R << Color.G << Color.B << Color.A;
+	}
+
+	// Payload, inflated if compressed
+	TArray<uint8> Inflated;
+	const uint8* Ptr = InData.GetData() + Reader.Tell();
+	const uint8* End = InData.GetData() + InData.Num();
+	if (Flags & SLMaskFlagZlib)
+	{
+		uint32 RawSize = 0;
+		Reader << RawSize;
+		if (Reader.IsError() || static_cast<int64>(RawSize) > FMath::Min<int64>(static_cast<int64>(W) * H * SLMaskMaxBytesPerPixel, MAX_int32))
+		{
+			return false;
+		}
+		Ptr = InData.GetData() + Reader.Tell();
+		Inflated.SetNumUninitialized(RawSize);
+		if (!FCompression::UncompressMemory(NAME_Zlib, Inflated.GetData(), RawSize, Ptr, End - Ptr))
+		{
+			return false;
+		}
+		Ptr = Inflated.GetData();
+		End = Ptr + Inflated.Num();
+	}
+
+	// Runs
+	const int64 NumPixels = static_cast<int64>(W) * H;
+	OutBitmap.SetNumUninitialized(NumPixels);
+	int64 PixelIdx = 0;
+	while (PixelIdx < NumPixels)
+	{
+		uint32 Len, PaletteIdx;
+		if (!ReadVarInt(Ptr, End, Len) || !ReadVarInt(Ptr, End, PaletteIdx)
+			|| PaletteIdx >= NumColors || Len == 0 || PixelIdx + Len > NumPixels)
+		{
+			return false;
+		}
+		const FColor Color = Palette[PaletteIdx];
+		for (uint32 Idx = 0; Idx < Len; ++Idx)
+		{
+			OutBitmap[PixelIdx++] = Color;
+		}
+	}
+	OutWidth = W;
+	OutHeight = H;
+	return true;
+}
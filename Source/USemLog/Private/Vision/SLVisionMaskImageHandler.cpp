@@ -3,6 +3,7 @@
 
 #include "Vision/SLVisionMaskImageHandler.h"
 #include "SLEntitiesManager.h"
+#include "Async/ParallelFor.h"
 
 // Ctor
 FSLVisionMaskImageHandler::FSLVisionMaskImageHandler()
@@ -11,7 +12,7 @@ FSLVisionMaskImageHandler::FSLVisionMaskImageHandler()
 }
 
 // Load the color to entities mapping
-bool FSLVisionMaskImageHandler::Init()
+bool FSLVisionMaskImageHandler::Init(uint8 InColorTolerance)
 {
 	if(!bIsInit)
 	{
@@ -68,6 +69,41 @@ bool FSLVisionMaskImageHandler::Init()
 			return false;
 		}
 
+		// Dense color indices (the entity masks have priority over the bone masks)
+		TSet<FColor> AddedColors;
+		auto AddDenseColor = [this, &AddedColors](const FColor& RenderedColor, const FString& OrigMaskColor)
+		{
+			if (RenderedColor.A != 255 || RenderedColor == FColor::Black || AddedColors.Contains(RenderedColor))
+			{
+				return;
+			}
+			if (DenseRenderedColors.Num() >= MAX_uint16)
+			{
+				UE_LOG(LogTemp, Error, TEXT("%s::%d Too many mask colors, %s will be ignored.."),
+					*FString(__func__), __LINE__, *RenderedColor.ToString());
+				return;
+			}
+			AddedColors.Add(RenderedColor);
+			DenseRenderedColors.Add(RenderedColor);
+			DenseOrigMaskColors.Add(FColor::FromHex(OrigMaskColor));
+		};
+		for (const auto& Pair : RenderedColorToEntityInfo)
+		{
+			AddDenseColor(Pair.Key, Pair.Value.OrigMaskColor);
+		}
+		for (const auto& Pair : RenderedColorToSkelInfo)
+		{
+			AddDenseColor(Pair.Key, Pair.Value.OrigMaskColor);
+		}
+
+		// Map every color within the tolerance of a rendered mask color
+		BuildColorLookupTable(InColorTolerance);
+
+		// Colors of the encoded mask runs
+		RunCodeColors.Reset(DenseOrigMaskColors.Num() + 1);
+		RunCodeColors.Add(FColor::Black);
+		RunCodeColors.Append(DenseOrigMaskColors);
+
 		//// DEBUG
 		//for(const auto& Pair : RenderedColorToEntityInfo)
 		//{
@@ -94,107 +130,107 @@ void FSLVisionMaskImageHandler::Reset()
 	bIsInit = false;
 	RenderedColorToEntityInfo.Empty();
 	RenderedColorToSkelInfo.Empty();
+	RenderedColorToIdx.Empty();
+	DenseRenderedColors.Empty();
+	DenseOrigMaskColors.Empty();
+	RunCodeColors.Empty();
 }
 
 // Restore image (the screenshot image pixel colors are a bit offseted from the supposed mask value) and get the entities from mask image
 void FSLVisionMaskImageHandler::GetDataAndRestoreImage(TArray<FColor>& MaskBitmapToRestore, int32 ImgWidth, int32 ImgHeight,
-	FSLVisionViewData& OutViewData) const
+	FSLVisionViewData& OutViewData, TArray<uint8>* OutEncodedMask) const
 {
 	// Used to calculate the percentage of an entity in the image
 	const int64 ImgTotalPixels = ImgWidth * ImgHeight;
 
-	// Index position of the image matrix in rows and columns (used for storing the bounding box of the entities)
-	int32 RowIdx = 0;
-	int32 ColIdx = 0;
-
-	// Store the occurance of every color in the image to its data
-	TMap<FColor, FSLVisionImageColorInfo> TempRenderedColorsData;
+	// Split the rows between the workers, each keeps its own statistics
+	const int32 NumChunks = FMath::Max(1, FMath::Min(ImgHeight, FTaskGraphInterface::Get().GetNumWorkerThreads() + 1));
+	const int32 RowsPerChunk = FMath::DivideAndRoundUp(ImgHeight, NumChunks);
+	TArray<TArray<FSLVisionMaskPixelStats>> ChunkStats;
+	ChunkStats.SetNum(NumChunks);
+	TArray<TSet<FColor>> ChunkUnknownColors;
+	ChunkUnknownColors.SetNum(NumChunks);
+	TArray<TArray<FSLVisionMaskRun>> ChunkRuns;
+	ChunkRuns.SetNum(OutEncodedMask ? NumChunks : 0);
+	FColor* Pixels = MaskBitmapToRestore.GetData();
+	ParallelFor(NumChunks, [&](int32 ChunkIdx)
+	{
+		FSLVisionMaskPixelStats EmptyStats;
+		EmptyStats.MinBB = FIntPoint(ImgWidth, ImgHeight);
+		EmptyStats.MaxBB = FIntPoint(0, 0);
+		ChunkStats[ChunkIdx].Init(EmptyStats, DenseRenderedColors.Num());
+		ProcessRows(Pixels, ImgWidth, ChunkIdx * RowsPerChunk, FMath::Min((ChunkIdx + 1) * RowsPerChunk, ImgHeight) - 1,
+			ChunkStats[ChunkIdx], ChunkUnknownColors[ChunkIdx], OutEncodedMask ? &ChunkRuns[ChunkIdx] : nullptr);
+	});
+
+	// Encode the restored image from the runs of the workers (in raster order)
+	if (OutEncodedMask)
+	{
+		TArray<FSLVisionMaskRun> Runs;
+		for (auto& Chunk : ChunkRuns)
+		{
+			Runs.Append(MoveTemp(Chunk));
+		}
+		FSLVisionMaskCodec::Encode(ImgWidth, ImgHeight, Runs, RunCodeColors, true, *OutEncodedMask);
+	}
 
-	// Array of rendered colors without a semantic match (store in array to avoid smapping the logger everytime the color appears)
-	TSet<FColor> UnknownColors;
+	// Colors found in the image, in the order of their first appearance
+	TArray<int32> FirstPixels;
+	FirstPixels.Init(MAX_int32, DenseRenderedColors.Num());
+	for (const auto& Stats : ChunkStats)
+	{
+		for (int32 DenseIdx = 0; DenseIdx < Stats.Num(); ++DenseIdx)
+		{
+			FirstPixels[DenseIdx] = FMath::Min(FirstPixels[DenseIdx], Stats[DenseIdx].FirstPixel);
+		}
+	}
+	TArray<int32> FoundIndices;
+	for (int32 DenseIdx = 0; DenseIdx < FirstPixels.Num(); ++DenseIdx)
+	{
+		if (FirstPixels[DenseIdx] != MAX_int32)
+		{
+			FoundIndices.Add(DenseIdx);
+		}
+	}
+	FoundIndices.Sort([&FirstPixels](int32 A, int32 B) { return FirstPixels[A] < FirstPixels[B]; });
 
-	// Restore image colors and create a mapping of all the rendered pixel colors to its data
-	for (auto& PixelColor : MaskBitmapToRestore)
+	// Merge the statistics, the first pixels of the later chunks are part of the bounding box
+	TMap<FColor, FSLVisionImageColorInfo> TempRenderedColorsData;
+	for (int32 DenseIdx : FoundIndices)
 	{
-		// Ignore color black (represents semantically unknown areas, normally there should not be any
-		if (PixelColor != FColor::Black)
+		FSLVisionImageColorInfo ColorInfo(0, FIntPoint(ImgWidth, ImgHeight), FIntPoint(0, 0));
+		ColorInfo.OriginalMaskColor = DenseOrigMaskColors[DenseIdx];
+		bool bFirstChunk = true;
+		for (const auto& Stats : ChunkStats)
 		{
-			// Check if the color is new
-			if (FSLVisionImageColorInfo* ColorData = TempRenderedColorsData.Find(PixelColor))
+			const FSLVisionMaskPixelStats& ChunkColorStats = Stats[DenseIdx];
+			if (ChunkColorStats.Num == 0)
 			{
-				// Color already stored, update its data
-				(*ColorData).Num++;
-
-				// Update the bounding box in the image
-				if (RowIdx < (*ColorData).MinBB.Y)
-				{
-					(*ColorData).MinBB.Y = RowIdx;
-				}
-				if (RowIdx > (*ColorData).MaxBB.Y)
-				{
-					(*ColorData).MaxBB.Y = RowIdx;
-				}
-				if (ColIdx < (*ColorData).MinBB.X)
-				{
-					(*ColorData).MinBB.X = ColIdx;
-				}
-				if (ColIdx > (*ColorData).MaxBB.X)
-				{
-					(*ColorData).MaxBB.X = ColIdx;
-				}
-
-				// Fix image by changing the rendered color to the original value
-				PixelColor = (*ColorData).OriginalMaskColor;
+				continue;
 			}
-			else
+			ColorInfo.Num += ChunkColorStats.Num;
+			ColorInfo.MinBB = ColorInfo.MinBB.ComponentMin(ChunkColorStats.MinBB);
+			ColorInfo.MaxBB = ColorInfo.MaxBB.ComponentMax(ChunkColorStats.MaxBB);
+			if (!bFirstChunk)
 			{
-				// Cache rendered color, since the pixel color will be restored to the original mask (if found)
-				const FColor RenderedColor = PixelColor;
-
-				// New color, cache its info
-				FSLVisionImageColorInfo ColorInfo(1, FIntPoint(ImgWidth, ImgHeight), FIntPoint(0, 0));
-
-				// Get the original mask color value
-				if (const FSLVisionMaskEntityInfo* EntityInfo = RenderedColorToEntityInfo.Find(RenderedColor))
-				{
-					// Color found as an entity visual mask
-					ColorInfo.OriginalMaskColor = FColor::FromHex((*EntityInfo).OrigMaskColor);
-
-					// Cache the color info in the local map
-					TempRenderedColorsData.Emplace(RenderedColor, ColorInfo);
-
-					// Fix image by changing the rendered color to the original value
-					PixelColor = ColorInfo.OriginalMaskColor;
-				}
-				else if (const FSLVisionMaskSkelInfo* SkelInfo = RenderedColorToSkelInfo.Find(RenderedColor))
-				{
-					// Color found as a skeletal visual mask
-					ColorInfo.OriginalMaskColor = FColor::FromHex((*SkelInfo).OrigMaskColor);
-
-					// Cache the color info in the local map
-					TempRenderedColorsData.Emplace(RenderedColor, ColorInfo);
-
-					// Fix image by changing the rendered color to the original value
-					PixelColor = ColorInfo.OriginalMaskColor;
-				}
-				else if(!UnknownColors.Contains(PixelColor))
-				{
-					UnknownColors.Add(PixelColor);
-					UE_LOG(LogTemp, Error, TEXT("%s::%d Rendered color %s - %s has no mapping to any entity.. this should not happen.."),
-						*FString(__func__), __LINE__, *RenderedColor.ToString(), *RenderedColor.ToHex());
-				}
+				ColorInfo.MinBB = ColorInfo.MinBB.ComponentMin(ChunkColorStats.FirstPixelPos);
+				ColorInfo.MaxBB = ColorInfo.MaxBB.ComponentMax(ChunkColorStats.FirstPixelPos);
 			}
+			bFirstChunk = false;
 		}
+		TempRenderedColorsData.Emplace(DenseRenderedColors[DenseIdx], ColorInfo);
+	}
 
-		// Update current pixel index position
-		ColIdx++;
-
-		// Check for row change
-		if (ColIdx > ImgWidth - 1)
-		{
-			ColIdx = 0;
-			RowIdx++;
-		}
+	// Rendered colors without a semantic match
+	TSet<FColor> UnknownColors;
+	for (const auto& ChunkUnknown : ChunkUnknownColors)
+	{
+		UnknownColors.Append(ChunkUnknown);
+	}
+	for (const auto& RenderedColor : UnknownColors)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Rendered color %s - %s has no mapping to any entity.. this should not happen.."),
+			*FString(__func__), __LINE__, *RenderedColor.ToString(), *RenderedColor.ToHex());
 	}
 
 	// Store skeletal related data in a temp map, this will need an extra processing to calculcate the data as a whole skeleton (from bones)
@@ -260,15 +296,142 @@ void FSLVisionMaskImageHandler::GetDataAndRestoreImage(TArray<FColor>& MaskBitma
 	}
 }
 
-// Restore the color of the pixel to its original mask value (offseted by screenshot rendering artifacts), returns true if restoration happened
-bool FSLVisionMaskImageHandler::RestoreColorValueFromArray(FColor& RenderedPixelColor, const TArray<FColor>& InOriginalMaskColors, uint8 Tolerance) const
+// Count the pixels of the rows and restore their colors, runs of equal pixels are processed at once
+void FSLVisionMaskImageHandler::ProcessRows(FColor* Pixels, int32 ImgWidth, int32 FirstRow, int32 LastRow,
+	TArray<FSLVisionMaskPixelStats>& OutStats, TSet<FColor>& OutUnknownColors, TArray<FSLVisionMaskRun>* OutRuns) const
 {
-	// Check if the PixelColor is almost equal to any of the stored original mask color values
-	if(const FColor* OrigColor = InOriginalMaskColors.FindByPredicate(
-		[&RenderedPixelColor, &Tolerance](const FColor& Item) { return AlmostEqual(RenderedPixelColor, Item, Tolerance);} ))
+	// Add the run, equal neighbours in the same row are merged (e.g. two rendered colors restored to the same mask)
+	auto AddRun = [OutRuns](int32 ColIdx, int32 Len, uint32 Code, const FColor& Color)
 	{
-		RenderedPixelColor = *OrigColor;
-		return true;
+		if (ColIdx > 0 && OutRuns->Num() > 0)
+		{
+			FSLVisionMaskRun& Last = OutRuns->Last();
+			if (Last.Code == Code && (Code != FSLVisionMaskCodec::UnknownCode || Last.Color == Color))
+			{
+				Last.Len += Len;
+				return;
+			}
+		}
+		OutRuns->Add({ Len, Code, Color });
+	};
+
+	for (int32 RowIdx = FirstRow; RowIdx <= LastRow; ++RowIdx)
+	{
+		FColor* Row = Pixels + RowIdx * ImgWidth;
+		int32 ColIdx = 0;
+		while (ColIdx < ImgWidth)
+		{
+			// Find the end of the run of equal (not yet restored) pixels
+			const FColor RenderedColor = Row[ColIdx];
+			int32 RunEnd = ColIdx + 1;
+			while (RunEnd < ImgWidth && Row[RunEnd] == RenderedColor)
+			{
+				RunEnd++;
+			}
+
+			// Ignore color black (represents semantically unknown areas, normally there should not be any
+			if (RenderedColor == FColor::Black)
+			{
+				if (OutRuns)
+				{
+					AddRun(ColIdx, RunEnd - ColIdx, 0, RenderedColor);
+				}
+			}
+			else
+			{
+				const uint16 Idx = RenderedColor.A == 255 ? RenderedColorToIdx[RenderedColor.DWColor() & 0xFFFFFF] : 0;
+				if (Idx != 0)
+				{
+					FSLVisionMaskPixelStats& Stats = OutStats[Idx - 1];
+					int32 BBStart = ColIdx;
+					if (Stats.Num == 0)
+					{
+						// The first pixel only inits the data
+						Stats.FirstPixel = RowIdx * ImgWidth + ColIdx;
+						Stats.FirstPixelPos = FIntPoint(ColIdx, RowIdx);
+						BBStart++;
+					}
+					Stats.Num += RunEnd - ColIdx;
+					if (BBStart < RunEnd)
+					{
+						Stats.MinBB = Stats.MinBB.ComponentMin(FIntPoint(BBStart, RowIdx));
+						Stats.MaxBB = Stats.MaxBB.ComponentMax(FIntPoint(RunEnd - 1, RowIdx));
+					}
+
+					// Fix image by changing the rendered color to the original value
+					const FColor OrigMaskColor = DenseOrigMaskColors[Idx - 1];
+					for (int32 Col = ColIdx; Col < RunEnd; ++Col)
+					{
+						Row[Col] = OrigMaskColor;
+					}
+					if (OutRuns)
+					{
+						AddRun(ColIdx, RunEnd - ColIdx, Idx, OrigMaskColor);
+					}
+				}
+				else
+				{
+					OutUnknownColors.Add(RenderedColor);
+					if (OutRuns)
+					{
+						AddRun(ColIdx, RunEnd - ColIdx, FSLVisionMaskCodec::UnknownCode, RenderedColor);
+					}
+				}
+			}
+			ColIdx = RunEnd;
+		}
+	}
+}
+
+// Map every color within the tolerance of a rendered mask color to its dense index, the closest mask wins,
+// colors at the same distance from two masks are left unknown
+void FSLVisionMaskImageHandler::BuildColorLookupTable(uint8 Tolerance)
+{
+	RenderedColorToIdx.Init(0, 1 << 24);
+
+	// Manhattan distance of the mapped color to its mask color
+	TArray<uint8> Distances;
+	Distances.Init(MAX_uint8, 1 << 24);
+
+	// Pairs of masks with overlapping tolerance balls
+	TSet<TPair<int32, int32>> Conflicts;
+
+	const int32 Tol = FMath::Min<int32>(Tolerance, MAX_uint8 - 1);
+	for (int32 DenseIdx = 0; DenseIdx < DenseRenderedColors.Num(); ++DenseIdx)
+	{
+		const FColor& Color = DenseRenderedColors[DenseIdx];
+		for (int32 R = FMath::Max(0, Color.R - Tol); R <= FMath::Min(255, Color.R + Tol); ++R)
+		{
+			const int32 DistR = FMath::Abs(R - Color.R);
+			for (int32 G = FMath::Max(0, Color.G - (Tol - DistR)); G <= FMath::Min(255, Color.G + (Tol - DistR)); ++G)
+			{
+				const int32 DistRG = DistR + FMath::Abs(G - Color.G);
+				for (int32 B = FMath::Max(0, Color.B - (Tol - DistRG)); B <= FMath::Min(255, Color.B + (Tol - DistRG)); ++B)
+				{
+					const int32 LUTIdx = (R << 16) | (G << 8) | B;
+					const uint8 Dist = DistRG + FMath::Abs(B - Color.B);
+					if (Dist < Distances[LUTIdx])
+					{
+						RenderedColorToIdx[LUTIdx] = DenseIdx + 1;
+						Distances[LUTIdx] = Dist;
+					}
+					else if (Dist == Distances[LUTIdx] && RenderedColorToIdx[LUTIdx] != 0)
+					{
+						// Same distance from two masks, the color is ambiguous
+						Conflicts.Add(TPair<int32, int32>(RenderedColorToIdx[LUTIdx] - 1, DenseIdx));
+						RenderedColorToIdx[LUTIdx] = 0;
+					}
+				}
+			}
+		}
+	}
+
+	// Avoid the black color (represents semantically unknown areas)
+	RenderedColorToIdx[0] = 0;
+
+	for (const auto& Pair : Conflicts)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d Mask colors %s and %s are within the tolerance (%d) of each other, the colors in between are ignored.."),
+			*FString(__func__), __LINE__, *DenseRenderedColors[Pair.Key].ToString(), *DenseRenderedColors[Pair.Value].ToString(), Tol);
 	}
-	return false;
 }
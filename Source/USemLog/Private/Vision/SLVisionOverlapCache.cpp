@@ -0,0 +1,247 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "Vision/SLVisionOverlapCache.h"
+#include "Engine/StaticMeshActor.h"
+#include "Camera/CameraComponent.h"
+
+#include "SLVisionLogger.h"
+
+// Ctor
+FSLVisionOverlapCache::FSLVisionOverlapCache() : bIsInit(false)
+{
+	Parent = nullptr;
+	NumReused = 0;
+	NumCalculated = 0;
+}
+
+// Set the parent (access to the mask clones), the number of views and the image resolution
+void FSLVisionOverlapCache::Init(USLVisionLogger* InParent, int32 NumViews, FIntPoint InResolution)
+{
+	if (!bIsInit)
+	{
+		Parent = InParent;
+		Resolution = InResolution;
+		Views.SetNum(NumViews);
+		if (Parent && NumViews > 0)
+		{
+			bIsInit = true;
+		}
+	}
+}
+
+// Mark the mask clones moved by the new episode frame as dirty in every view
+void FSLVisionOverlapCache::AddMovedActors(const TArray<AActor*>& MovedActors)
+{
+	for (FSLVisionOverlapViewCache& View : Views)
+	{
+		View.MovedActors.Append(MovedActors);
+	}
+}
+
+// Copy the cached overlaps to the unchanged entities of the view, return the number of entities left to calculate
+int32 FSLVisionOverlapCache::ReuseOverlaps(int32 ViewIdx, const UCameraComponent* Camera, FSLVisionViewData& ViewData)
+{
+	const int32 NumEntities = ViewData.Entities.Num() + ViewData.SkelEntities.Num();
+	if (!bIsInit || !Camera || !Views.IsValidIndex(ViewIdx))
+	{
+		return NumEntities;
+	}
+	FSLVisionOverlapViewCache& View = Views[ViewIdx];
+
+	// Current footprints of the visible entities
+	CurrCameraPose = Camera->GetComponentTransform();
+	const float Focal = (Resolution.X * 0.5f) / FMath::Tan(FMath::DegreesToRadians(Camera->FieldOfView) * 0.5f);
+	CurrScreenBounds.Reset();
+	TArray<AActor*> EntityClones;
+	EntityClones.Reserve(ViewData.Entities.Num());
+	for (const FSLVisionViewEntityData& Entity : ViewData.Entities)
+	{
+		EntityClones.Add(Parent->GetStaticMeshMaskCloneFromId(Entity.Id));
+	}
+	TArray<AActor*> SkelClones;
+	SkelClones.Reserve(ViewData.SkelEntities.Num());
+	for (const FSLVisionViewSkelData& Skel : ViewData.SkelEntities)
+	{
+		SkelClones.Add(Parent->GetPoseableSkeletalMaskCloneFromId(Skel.Id));
+	}
+	for (AActor* Clone : EntityClones)
+	{
+		FBox2D Bounds(ForceInit);
+		if (Clone && GetScreenBounds(Clone, CurrCameraPose, Focal, Bounds))
+		{
+			CurrScreenBounds.Add(Clone, Bounds);
+		}
+	}
+	for (AActor* Clone : SkelClones)
+	{
+		FBox2D Bounds(ForceInit);
+		if (Clone && GetScreenBounds(Clone, CurrCameraPose, Focal, Bounds))
+		{
+			CurrScreenBounds.Add(Clone, Bounds);
+		}
+	}
+
+	// Everything is recalculated if the camera moved
+	if (!View.bIsValid || !View.CameraPose.Equals(CurrCameraPose, CameraPoseTolerance))
+	{
+		NumCalculated += NumEntities;
+		return NumEntities;
+	}
+
+	// Previous and current footprints of the moved entities
+	TArray<FBox2D> DirtyRegions;
+	for (AActor* Moved : View.MovedActors)
+	{
+		if (const FBox2D* PrevBounds = View.ScreenBounds.Find(Moved))
+		{
+			DirtyRegions.Add(*PrevBounds);
+		}
+		if (const FBox2D* CurrBounds = CurrScreenBounds.Find(Moved))
+		{
+			DirtyRegions.Add(*CurrBounds);
+		}
+	}
+
+	auto IsDirty = [&](AActor* Clone)
+	{
+		const FBox2D* Bounds = Clone ? CurrScreenBounds.Find(Clone) : nullptr;
+		if (!Bounds || View.MovedActors.Contains(Clone))
+		{
+			return true;
+		}
+		for (const FBox2D& Region : DirtyRegions)
+		{
+			if (Bounds->Intersect(Region))
+			{
+				return true;
+			}
+		}
+		return false;
+	};
+
+	int32 NumDirty = 0;
+	for (int32 Idx = 0; Idx < ViewData.Entities.Num(); ++Idx)
+	{
+		FSLVisionViewEntityData& Entity = ViewData.Entities[Idx];
+		const FSLVisionViewEntityData* Cached = View.Entities.Find(Entity.Id);
+		if (Cached && Cached->OcclusionPercentage >= 0.f && !IsDirty(EntityClones[Idx]))
+		{
+			Entity.OcclusionPercentage = Cached->OcclusionPercentage;
+			Entity.bIsClipped = Cached->bIsClipped;
+		}
+		else
+		{
+			NumDirty++;
+		}
+	}
+
+	for (int32 Idx = 0; Idx < ViewData.SkelEntities.Num(); ++Idx)
+	{
+		FSLVisionViewSkelData& Skel = ViewData.SkelEntities[Idx];
+		const FSLVisionViewSkelData* Cached = View.SkelEntities.Find(Skel.Id);
+		if (!Cached || Cached->OcclusionPercentage < 0.f || IsDirty(SkelClones[Idx]))
+		{
+			NumDirty++;
+			continue;
+		}
+
+		// The skeleton is reused as a whole, only if every visible bone was cached
+		TArray<const FSLVisionViewSkelBoneData*> CachedBones;
+		for (const FSLVisionViewSkelBoneData& Bone : Skel.Bones)
+		{
+			const FSLVisionViewSkelBoneData* CachedBone = Cached->Bones.FindByPredicate([&Bone](const FSLVisionViewSkelBoneData& B)
+			{
+				return B.Class.Equals(Bone.Class);
+			});
+			if (!CachedBone)
+			{
+				break;
+			}
+			CachedBones.Add(CachedBone);
+		}
+		if (CachedBones.Num() != Skel.Bones.Num())
+		{
+			NumDirty++;
+			continue;
+		}
+
+		Skel.OcclusionPercentage = Cached->OcclusionPercentage;
+		Skel.bIsClipped = Cached->bIsClipped;
+		for (int32 BoneIdx = 0; BoneIdx < Skel.Bones.Num(); ++BoneIdx)
+		{
+			Skel.Bones[BoneIdx].OcclusionPercentage = CachedBones[BoneIdx]->OcclusionPercentage;
+			Skel.Bones[BoneIdx].bIsClipped = CachedBones[BoneIdx]->bIsClipped;
+		}
+	}
+
+	NumCalculated += NumDirty;
+	NumReused += NumEntities - NumDirty;
+	return NumDirty;
+}
+
+// Store the overlaps of the view (call after ReuseOverlaps once the overlaps are calculated)
+void FSLVisionOverlapCache::Update(int32 ViewIdx, const FSLVisionViewData& ViewData)
+{
+	if (!bIsInit || !Views.IsValidIndex(ViewIdx))
+	{
+		return;
+	}
+	FSLVisionOverlapViewCache& View = Views[ViewIdx];
+
+	View.Entities.Reset();
+	for (const FSLVisionViewEntityData& Entity : ViewData.Entities)
+	{
+		View.Entities.Add(Entity.Id, Entity);
+	}
+	View.SkelEntities.Reset();
+	for (const FSLVisionViewSkelData& Skel : ViewData.SkelEntities)
+	{
+		View.SkelEntities.Add(Skel.Id, Skel);
+	}
+	View.CameraPose = CurrCameraPose;
+	View.ScreenBounds = MoveTemp(CurrScreenBounds);
+	View.MovedActors.Reset();
+	View.bIsValid = true;
+}
+
+// Log the number of reused and calculated overlaps
+void FSLVisionOverlapCache::LogSummary() const
+{
+	if (bIsInit)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d Overlaps: Reused=%lld; Calculated=%lld;"),
+			*FString(__func__), __LINE__, NumReused, NumCalculated);
+	}
+}
+
+// Project the bounds of the mask clone to the screen, false if not possible
+bool FSLVisionOverlapCache::GetScreenBounds(AActor* MaskClone, const FTransform& ViewPose, float Focal, FBox2D& OutBounds) const
+{
+	FVector Origin;
+	FVector Extent;
+	MaskClone->GetActorBounds(false, Origin, Extent);
+	if (Extent.IsNearlyZero())
+	{
+		return false;
+	}
+
+	const FVector2D HalfRes(Resolution.X * 0.5f, Resolution.Y * 0.5f);
+	OutBounds.Init();
+	for (int32 Corner = 0; Corner < 8; ++Corner)
+	{
+		const FVector Point = ViewPose.InverseTransformPosition(Origin + FVector(
+			(Corner & 1) ? Extent.X : -Extent.X,
+			(Corner & 2) ? Extent.Y : -Extent.Y,
+			(Corner & 4) ? Extent.Z : -Extent.Z));
+
+		// Bounds reaching behind the camera could cover any part of the image
+		if (Point.X < KINDA_SMALL_NUMBER)
+		{
+			OutBounds = FBox2D(FVector2D(-MAX_flt, -MAX_flt), FVector2D(MAX_flt, MAX_flt));
+			return true;
+		}
+		OutBounds += FVector2D(HalfRes.X + Point.Y / Point.X * Focal, HalfRes.Y - Point.Z / Point.X * Focal);
+	}
+	return true;
+}
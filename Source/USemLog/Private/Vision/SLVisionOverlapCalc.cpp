@@ -10,9 +10,7 @@
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Engine/GameViewportClient.h"
 #include "HighResScreenshot.h"
-#include "ImageUtils.h"
 #include "Async.h"
-#include "FileHelper.h"
 
 #include "Vision/SLVisionStructs.h"
 #include "SLSkeletalDataComponent.h"
@@ -70,7 +68,7 @@ void USLVisionOverlapCalc::Init(USLVisionLogger* InParent, FIntPoint InResolutio
 }
 
 // Calculate overlaps for the given scene
-void USLVisionOverlapCalc::Start(FSLVisionViewData* CurrViewData, float Timestamp, int32 FrameIdx)
+bool USLVisionOverlapCalc::Start(FSLVisionViewData* CurrViewData, float Timestamp, int32 FrameIdx)
 {
 	if (!bIsStarted && bIsInit)
 	{
@@ -81,18 +79,31 @@ void USLVisionOverlapCalc::Start(FSLVisionViewData* CurrViewData, float Timestam
 		Entities = &CurrViewData->Entities;
 		SkelEntities = &CurrViewData->SkelEntities;
 
-		CurrOverlapCalcIdx = 0;		
-		int32 NumBones = 0;
+		// Entities with known overlaps (reused from previous frames) are skipped
+		CurrOverlapCalcIdx = 0;
+		TotalOverlapCalcNum = 0;
+		for (const auto& E : *Entities)
+		{
+			if (E.OcclusionPercentage < 0.f)
+			{
+				TotalOverlapCalcNum++;
+			}
+		}
 		for (const auto& SkE : *SkelEntities)
 		{
-			NumBones += SkE.Bones.Num();
+			if (SkE.OcclusionPercentage < 0.f)
+			{
+				TotalOverlapCalcNum += 1 + SkE.Bones.Num();
+			}
 		}
-		TotalOverlapCalcNum = Entities->Num() + SkelEntities->Num() + NumBones;
 		
 		if (!SelectFirstItem())
 		{
 			UE_LOG(LogTemp, Error, TEXT("%s::%d No items found in the scene.."), *FString(__func__), __LINE__);
-			return;
+			bSkelArrayActive = false;
+			Entities = nullptr;
+			SkelEntities = nullptr;
+			return false;
 		}
 
 		ApplyNonOccludingMaterial();
@@ -108,8 +119,10 @@ void USLVisionOverlapCalc::Start(FSLVisionViewData* CurrViewData, float Timestam
 		RequestScreenshot();
 		
 		bIsFinished = false;
-		bIsStarted = true;		
+		bIsStarted = true;
+		return true;
 	}
+	return false;
 }
 
 // Reset all flags and temporaries, called when the scene overlaps are calculated, this un-pauses the parent as well
@@ -163,15 +176,12 @@ void USLVisionOverlapCalc::ScreenshotCB(int32 SizeX, int32 SizeY, const TArray<F
 	// Calcuate overlap for the currently selected item
 	CalculateOverlap(Bitmap, SizeX, SizeY);
 
-	// Save the png locally
+	// Save the png locally (compressed and saved by the image workers of the parent)
 	if (!SaveLocallyFolderName.IsEmpty())
 	{
-		// Compress image
-		TArray<uint8> CompressedBitmap;
-		FImageUtils::CompressImageArray(SizeX, SizeY, Bitmap, CompressedBitmap);
 		FString Path = FPaths::ProjectDir() + "/SemLog/" + SaveLocallyFolderName + "/" + SubFolderName + "/" + CurrImageFilename + ".png";
 		FPaths::RemoveDuplicateSlashes(Path);
-		FFileHelper::SaveArrayToFile(CompressedBitmap, *Path);
+		Parent->GetImagePipeline().AddImage(SizeX, SizeY, TArray<FColor>(Bitmap), Path);
 	}
 
 	// Re-apply original material before selecting the next item
@@ -257,6 +267,11 @@ bool USLVisionOverlapCalc::SelectFirstEntity()
 	if (EntityIndex == INDEX_NONE && Entities && Entities->Num() > 0)
 	{
 		EntityIndex = 0;
+		if ((*Entities)[EntityIndex].OcclusionPercentage >= 0.f)
+		{
+			// Already known
+			return SelectNextEntity();
+		}
 		CurrSMAClone = Parent->GetStaticMeshMaskCloneFromId((*Entities)[EntityIndex].Id);
 		if (!CurrSMAClone)
 		{
@@ -285,6 +300,11 @@ bool USLVisionOverlapCalc::SelectNextEntity()
 			CurrSMAClone = nullptr;
 			return false;
 		}
+		else if ((*Entities)[EntityIndex].OcclusionPercentage >= 0.f)
+		{
+			// Already known
+			return SelectNextEntity();
+		}
 		else
 		{
 			CurrSMAClone = Parent->GetStaticMeshMaskCloneFromId((*Entities)[EntityIndex].Id);
@@ -311,6 +331,11 @@ bool USLVisionOverlapCalc::SelectFirstSkel()
 	{		
 		SkelIndex = 0;
 		bSkelArrayActive = true;
+		if ((*SkelEntities)[SkelIndex].OcclusionPercentage >= 0.f)
+		{
+			// Already known (with its bones)
+			return SelectNextSkel();
+		}
 
 		CurrPMAClone = Parent->GetPoseableSkeletalMaskCloneFromId((*SkelEntities)[SkelIndex].Id, &CurrSkelDataComp);
 
@@ -341,6 +366,11 @@ bool USLVisionOverlapCalc::SelectNextSkel()
 			CurrPMAClone = nullptr;
 			return false;
 		}
+		else if ((*SkelEntities)[SkelIndex].OcclusionPercentage >= 0.f)
+		{
+			// Already known (with its bones)
+			return SelectNextSkel();
+		}
 		else
 		{
 			CurrPMAClone = Parent->GetPoseableSkeletalMaskCloneFromId((*SkelEntities)[SkelIndex].Id, &CurrSkelDataComp);
@@ -41,7 +41,7 @@ bool ASLVisionPoseableMeshActor::Init(ASkeletalMeshActor* SkMA)
 }
 
 // Apply bone transformations
-void ASLVisionPoseableMeshActor::SetBoneTransforms(const TMap<FName, FTransform>& BoneTransfroms)
+void ASLVisionPoseableMeshActor::SetBoneTransforms(const TArrayView<const TPair<FName, FTransform>>& BoneTransfroms)
 {
 	for(const auto& Pair : BoneTransfroms)
 	{
@@ -0,0 +1,192 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "Vision/SLVisionShardsCommandlet.h"
+#include "Vision/SLVisionDBHandler.h"
+
+#include "HAL/PlatformProcess.h"
+#include "Misc/Paths.h"
+
+// Ctor
+USLVisionShardsCommandlet::USLVisionShardsCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+
+	ServerIp = TEXT("127.0.0.1");
+	ServerPort = 27017;
+	NumShards = 1;
+	ShardTimeout = 0.f;
+}
+
+// Commandlet entry point
+int32 USLVisionShardsCommandlet::Main(const FString& Params)
+{
+	const bool bMergeOnly = FParse::Param(*Params, TEXT("MergeOnly"));
+	if ((!bMergeOnly && !FParse::Value(*Params, TEXT("Map="), MapName)) ||
+		!FParse::Value(*Params, TEXT("TaskId="), TaskId) ||
+		!FParse::Value(*Params, TEXT("EpisodeId="), EpisodeId) ||
+		!FParse::Value(*Params, TEXT("Shards="), NumShards) || NumShards < 2)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Usage: -run=SLVisionShards -Map=<MapPackage> -TaskId=<TaskId> -EpisodeId=<Id> -Shards=N(>1) [-Workers=N] [-Only=<Shard>[+<Shard>..]] [-MergeOnly] [-NoMerge] [-ShardTimeout=<Seconds>].."),
+			*FString(__func__), __LINE__);
+		return 1;
+	}
+	FParse::Value(*Params, TEXT("ServerIp="), ServerIp);
+	FParse::Value(*Params, TEXT("ServerPort="), ServerPort);
+	FParse::Value(*Params, TEXT("ShardTimeout="), ShardTimeout);
+
+	int32 NumFailed = 0;
+	if (!bMergeOnly)
+	{
+		// All the shards, or only the given ones (e.g. the failed shards of a previous run)
+		TArray<int32> Shards;
+		FString OnlyStr;
+		if (FParse::Value(*Params, TEXT("Only="), OnlyStr))
+		{
+			TArray<FString> OnlyArr;
+			OnlyStr.ParseIntoArray(OnlyArr, TEXT("+"), true);
+			for (const FString& Shard : OnlyArr)
+			{
+				const int32 ShardIdx = FCString::Atoi(*Shard);
+				if (ShardIdx >= 0 && ShardIdx < NumShards)
+				{
+					Shards.AddUnique(ShardIdx);
+				}
+			}
+		}
+		else
+		{
+			for (int32 ShardIdx = 0; ShardIdx < NumShards; ++ShardIdx)
+			{
+				Shards.Add(ShardIdx);
+			}
+		}
+
+		int32 NumWorkers = NumShards;
+		FParse::Value(*Params, TEXT("Workers="), NumWorkers);
+		NumFailed = RunShards(Shards, FMath::Max(NumWorkers, 1));
+	}
+
+	// The shard states in the database decide what is merged, the failed processes are reported in the return code
+	if (FParse::Param(*Params, TEXT("NoMerge")))
+	{
+		return NumFailed;
+	}
+	return FMath::Max(NumFailed, MergeShards());
+}
+
+// Run one game process per shard (at most NumWorkers at the same time), returns the number of processes that failed to run or timed out
+int32 USLVisionShardsCommandlet::RunShards(const TArray<int32>& Shards, int32 NumWorkers) const
+{
+	// The shards render offscreen, the manager in the map reads the shard from the command line
+	const FString ProjectPath = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
+	const FString SharedArgs = FString::Printf(
+		TEXT("\"%s\" %s -game -RenderOffscreen -unattended -nosound -nopause -SLTaskId=%s -SLEpisodeId=%s -SLServerIp=%s -SLServerPort=%d -SLVisionShards=%d"),
+		*ProjectPath, *MapName, *TaskId, *EpisodeId, *ServerIp, ServerPort, NumShards);
+
+	// Running shards with their start time
+	TArray<TTuple<int32, FProcHandle, double>> Running;
+	int32 NextIdx = 0;
+	int32 NumFailed = 0;
+	while (NextIdx < Shards.Num() || Running.Num() > 0)
+	{
+		// Fill the free slots
+		while (NextIdx < Shards.Num() && Running.Num() < NumWorkers)
+		{
+			const int32 ShardIdx = Shards[NextIdx++];
+			const FString Args = FString::Printf(TEXT("%s -SLVisionShard=%d"), *SharedArgs, ShardIdx);
+			FProcHandle Proc = FPlatformProcess::CreateProc(FPlatformProcess::ExecutablePath(), *Args,
+				false, true, true, nullptr, 0, nullptr, nullptr);
+			if (Proc.IsValid())
+			{
+				UE_LOG(LogTemp, Display, TEXT("%s::%d Started shard %d/%d.."), *FString(__func__), __LINE__, ShardIdx, NumShards);
+				Running.Emplace(ShardIdx, Proc, FPlatformTime::Seconds());
+			}
+			else
+			{
+				UE_LOG(LogTemp, Error, TEXT("%s::%d Could not start shard %d/%d.."), *FString(__func__), __LINE__, ShardIdx, NumShards);
+				NumFailed++;
+			}
+		}
+
+		// Collect the finished shards, kill the ones running past the timeout (their state stays unfinished)
+		for (int32 Idx = Running.Num() - 1; Idx >= 0; --Idx)
+		{
+			const int32 ShardIdx = Running[Idx].Get<0>();
+			FProcHandle& Proc = Running[Idx].Get<1>();
+			if (!FPlatformProcess::IsProcRunning(Proc))
+			{
+				int32 ReturnCode = 0;
+				FPlatformProcess::GetProcReturnCode(Proc, &ReturnCode);
+				if (ReturnCode != 0)
+				{
+					UE_LOG(LogTemp, Error, TEXT("%s::%d Shard %d exited with %d.."),
+						*FString(__func__), __LINE__, ShardIdx, ReturnCode);
+					NumFailed++;
+				}
+				FPlatformProcess::CloseProc(Proc);
+				Running.RemoveAtSwap(Idx);
+			}
+			else if (ShardTimeout > 0.f && FPlatformTime::Seconds() - Running[Idx].Get<2>() > ShardTimeout)
+			{
+				UE_LOG(LogTemp, Error, TEXT("%s::%d Shard %d did not finish in %.0fs, killing it.."),
+					*FString(__func__), __LINE__, ShardIdx, ShardTimeout);
+				FPlatformProcess::TerminateProc(Proc, true);
+				FPlatformProcess::CloseProc(Proc);
+				Running.RemoveAtSwap(Idx);
+				NumFailed++;
+			}
+		}
+
+		FPlatformProcess::Sleep(0.1f);
+	}
+	return NumFailed;
+}
+
+// Check the shard states and merge them into the vision collection, returns the number of unfinished shards (or 1 if the merge failed)
+int32 USLVisionShardsCommandlet::MergeShards() const
+{
+	TArray<FString> States;
+	if (!FSLVisionDBHandler::GetShardStates(TaskId, EpisodeId, ServerIp, ServerPort, NumShards, States))
+	{
+		return 1;
+	}
+
+	// Every shard has to be finished, the missing ones never started (or crashed before connecting)
+	TArray<FString> Unfinished;
+	for (int32 ShardIdx = 0; ShardIdx < States.Num(); ++ShardIdx)
+	{
+		UE_LOG(LogTemp, Display, TEXT("%s::%d Shard %d/%d: %s;"), *FString(__func__), __LINE__,
+			ShardIdx, NumShards, States[ShardIdx].IsEmpty() ? TEXT("missing") : *States[ShardIdx]);
+		if (!States[ShardIdx].Equals(TEXT("finished")))
+		{
+			Unfinished.Add(FString::FromInt(ShardIdx));
+		}
+	}
+	if (Unfinished.Num() > 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Not merging, re-run the unfinished shards with -Only=%s"),
+			*FString(__func__), __LINE__, *FString::Join(Unfinished, TEXT("+")));
+		return Unfinished.Num();
+	}
+
+	// The vision collection of the episode is re-created from the shards
+	FSLVisionDBHandler DBHandler;
+	if (!DBHandler.Connect(TaskId, EpisodeId, ServerIp, ServerPort, true))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Could not connect to the DB.."), *FString(__func__), __LINE__);
+		return 1;
+	}
+	const bool bMerged = DBHandler.MergeShards(NumShards);
+	if (bMerged)
+	{
+		DBHandler.CreateIndexes();
+		UE_LOG(LogTemp, Display, TEXT("%s::%d Merged %d shards into %s.."),
+			*FString(__func__), __LINE__, NumShards, *FSLVisionDBHandler::GetVisCollName(EpisodeId));
+	}
+	DBHandler.Disconnect();
+	return bMerged ? 0 : 1;
+}
@@ -0,0 +1,661 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "Vision/SLVisionSoftwareOcclusion.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/StaticMesh.h"
+#include "StaticMeshResources.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/PoseableMeshComponent.h"
+#include "Camera/CameraComponent.h"
+#include "PhysicsEngine/PhysicsAsset.h"
+#include "PhysicsEngine/SkeletalBodySetup.h"
+#include "PhysicsEngine/AggregateGeom.h"
+#include "Async/ParallelFor.h"
+
+#include "SLSkeletalDataComponent.h"
+#include "SLVisionLogger.h"
+
+// Ctor
+FSLVisionSoftwareOcclusion::FSLVisionSoftwareOcclusion() : bIsInit(false)
+{
+	Parent = nullptr;
+	NumSkels = 0;
+	NumValidationSamples = 0;
+	SumValidationError = 0.0;
+	MaxValidationError = 0.f;
+	NumClippedMismatches = 0;
+}
+
+// Set the parent (access to the mask clones) and the resolution of the depth buffer
+void FSLVisionSoftwareOcclusion::Init(USLVisionLogger* InParent, FIntPoint InResolution)
+{
+	if (!bIsInit)
+	{
+		Parent = InParent;
+		Resolution = InResolution;
+		if (Parent && Resolution.X > 0 && Resolution.Y > 0)
+		{
+			bIsInit = true;
+		}
+		else
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s::%d Could not init, parent or resolution (%dx%d) not valid.."),
+				*FString(__func__), __LINE__, Resolution.X, Resolution.Y);
+		}
+	}
+}
+
+// Calculate the occlusion percentages and the clipped flags of the entities in the view
+void FSLVisionSoftwareOcclusion::Calculate(const UCameraComponent* Camera, FSLVisionViewData& ViewData)
+{
+	if (!bIsInit || !Camera)
+	{
+		return;
+	}
+
+	ProjectItems(Camera, ViewData);
+
+	TArray<int64> SkelNumPixels;
+	RasterizeItems(SkelNumPixels);
+
+	WriteResults(ViewData, SkelNumPixels);
+}
+
+// Calculate the occlusion percentages on a copy of the view entities, compared later against the screenshot values
+void FSLVisionSoftwareOcclusion::CalculateForValidation(const UCameraComponent* Camera, const FSLVisionViewData& ViewData)
+{
+	// Copy only the entity data, the images are not needed
+	ValidationViewData.Init(ViewData.Id, ViewData.Class);
+	ValidationViewData.Entities = ViewData.Entities;
+	ValidationViewData.SkelEntities = ViewData.SkelEntities;
+	Calculate(Camera, ValidationViewData);
+}
+
+// Compare the last validation estimates against the values calculated from the screenshots
+void FSLVisionSoftwareOcclusion::Validate(const FSLVisionViewData& ScreenshotViewData)
+{
+	if (ValidationViewData.Entities.Num() != ScreenshotViewData.Entities.Num()
+		|| ValidationViewData.SkelEntities.Num() != ScreenshotViewData.SkelEntities.Num())
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d View %s: the estimated and the screenshot entities differ, skipping validation.."),
+			*FString(__func__), __LINE__, *ScreenshotViewData.Class);
+		return;
+	}
+
+	for (int32 Idx = 0; Idx < ScreenshotViewData.Entities.Num(); ++Idx)
+	{
+		const FSLVisionViewEntityData& Est = ValidationViewData.Entities[Idx];
+		const FSLVisionViewEntityData& Ref = ScreenshotViewData.Entities[Idx];
+		AddValidationSample(Ref.Class + "-" + Ref.Id, Est.OcclusionPercentage, Ref.OcclusionPercentage, Est.bIsClipped, Ref.bIsClipped);
+	}
+
+	for (int32 Idx = 0; Idx < ScreenshotViewData.SkelEntities.Num(); ++Idx)
+	{
+		const FSLVisionViewSkelData& Est = ValidationViewData.SkelEntities[Idx];
+		const FSLVisionViewSkelData& Ref = ScreenshotViewData.SkelEntities[Idx];
+		AddValidationSample(Ref.Class + "-" + Ref.Id, Est.OcclusionPercentage, Ref.OcclusionPercentage, Est.bIsClipped, Ref.bIsClipped);
+
+		for (int32 BoneIdx = 0; BoneIdx < Ref.Bones.Num() && BoneIdx < Est.Bones.Num(); ++BoneIdx)
+		{
+			AddValidationSample(Ref.Class + "-" + Ref.Id + "-" + Ref.Bones[BoneIdx].Class,
+				Est.Bones[BoneIdx].OcclusionPercentage, Ref.Bones[BoneIdx].OcclusionPercentage,
+				Est.Bones[BoneIdx].bIsClipped, Ref.Bones[BoneIdx].bIsClipped);
+		}
+	}
+}
+
+// Log the accumulated validation errors
+void FSLVisionSoftwareOcclusion::LogValidationSummary() const
+{
+	if (NumValidationSamples > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d Software occlusion vs. screenshots: Samples=%lld; MeanError=%.4f; MaxError=%.4f; ClippedMismatches=%lld;"),
+			*FString(__func__), __LINE__, NumValidationSamples, SumValidationError / NumValidationSamples,
+			MaxValidationError, NumClippedMismatches);
+	}
+}
+
+// Project the geometry of the view entities to the screen
+void FSLVisionSoftwareOcclusion::ProjectItems(const UCameraComponent* Camera, FSLVisionViewData& ViewData)
+{
+	Items.Reset();
+	NumSkels = ViewData.SkelEntities.Num();
+
+	// The screenshots keep the horizontal field of view
+	const FTransform ViewPose = Camera->GetComponentTransform();
+	const float Focal = (Resolution.X * 0.5f) / FMath::Tan(FMath::DegreesToRadians(Camera->FieldOfView) * 0.5f);
+
+	for (int32 EntityIdx = 0; EntityIdx < ViewData.Entities.Num(); ++EntityIdx)
+	{
+		const FSLVisionViewEntityData& Entity = ViewData.Entities[EntityIdx];
+		AStaticMeshActor* SMAClone = Parent->GetStaticMeshMaskCloneFromId(Entity.Id);
+		UStaticMeshComponent* SMC = SMAClone ? SMAClone->GetStaticMeshComponent() : nullptr;
+		if (!SMC || !SMC->GetStaticMesh())
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s::%d Could not find the mesh of entity %s - %s, continuing.."),
+				*FString(__func__), __LINE__, *Entity.Class, *Entity.Id);
+			continue;
+		}
+
+		if (const FSLOcclusionMesh* Mesh = GetStaticMeshGeometry(SMC->GetStaticMesh()))
+		{
+			FSLOcclusionItem& Item = Items.AddDefaulted_GetRef();
+			Item.EntityIdx = EntityIdx;
+			ProjectMesh(*Mesh, SMC->GetComponentTransform(), ViewPose, Focal, Item.ScreenTris);
+		}
+	}
+
+	for (int32 SkelIdx = 0; SkelIdx < ViewData.SkelEntities.Num(); ++SkelIdx)
+	{
+		const FSLVisionViewSkelData& Skel = ViewData.SkelEntities[SkelIdx];
+		USLSkeletalDataComponent* SkelDataComp = nullptr;
+		ASLVisionPoseableMeshActor* PMAClone = Parent->GetPoseableSkeletalMaskCloneFromId(Skel.Id, &SkelDataComp);
+		UPoseableMeshComponent* PMC = PMAClone ? PMAClone->GetPoseableMeshComponent() : nullptr;
+		if (!PMC || !SkelDataComp || !PMC->SkeletalMesh || !PMC->SkeletalMesh->PhysicsAsset)
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s::%d Could not find the physics asset of skel entity %s - %s, continuing.."),
+				*FString(__func__), __LINE__, *Skel.Class, *Skel.Id);
+			continue;
+		}
+
+		// Bone name to the bone index in the view
+		TMap<FName, int32> BoneNameToIdx;
+		for (const auto& Pair : SkelDataComp->SemanticBonesData)
+		{
+			const int32 BoneIdx = Skel.Bones.IndexOfByPredicate([&Pair](const FSLVisionViewSkelBoneData& Bone)
+			{
+				return Bone.Class.Equals(Pair.Value.Class);
+			});
+			if (BoneIdx != INDEX_NONE)
+			{
+				BoneNameToIdx.Add(Pair.Key, BoneIdx);
+			}
+		}
+
+		// Every body is part of the skeleton, only the ones of the semantic bones have their own values
+		for (USkeletalBodySetup* BodySetup : PMC->SkeletalMesh->PhysicsAsset->SkeletalBodySetups)
+		{
+			const int32 MeshBoneIdx = BodySetup ? PMC->GetBoneIndex(BodySetup->BoneName) : INDEX_NONE;
+			if (MeshBoneIdx == INDEX_NONE)
+			{
+				continue;
+			}
+
+			if (const FSLOcclusionMesh* Mesh = GetBodyGeometry(BodySetup))
+			{
+				FSLOcclusionItem& Item = Items.AddDefaulted_GetRef();
+				Item.SkelIdx = SkelIdx;
+				if (const int32* BoneIdx = BoneNameToIdx.Find(BodySetup->BoneName))
+				{
+					Item.BoneIdx = *BoneIdx;
+				}
+				ProjectMesh(*Mesh, PMC->GetBoneTransform(MeshBoneIdx), ViewPose, Focal, Item.ScreenTris);
+			}
+		}
+	}
+}
+
+// Rasterize the items into the depth buffer, count the covered and visible pixels
+void FSLVisionSoftwareOcclusion::RasterizeItems(TArray<int64>& OutSkelNumPixels)
+{
+	const int32 NumPixels = Resolution.X * Resolution.Y;
+	DepthBuffer.Init(0.f, NumPixels);
+	ItemBuffer.Init(INDEX_NONE, NumPixels);
+	ItemStamp.Init(INDEX_NONE, NumPixels);
+	SkelStamp.Init(INDEX_NONE, NumPixels);
+
+	// Every chunk owns its rows in the buffers, the counts are merged afterwards
+	const int32 NumChunks = FMath::Max(1, FMath::Min(Resolution.Y, FTaskGraphInterface::Get().GetNumWorkerThreads() + 1));
+	const int32 RowsPerChunk = FMath::DivideAndRoundUp(Resolution.Y, NumChunks);
+	TArray<TArray<int64>> ChunkNumPixels;
+	ChunkNumPixels.SetNum(NumChunks);
+	TArray<TArray<int64>> ChunkNumVisiblePixels;
+	ChunkNumVisiblePixels.SetNum(NumChunks);
+	TArray<TArray<int64>> ChunkSkelNumPixels;
+	ChunkSkelNumPixels.SetNum(NumChunks);
+	TArray<TArray<bool>> ChunkIsClipped;
+	ChunkIsClipped.SetNum(NumChunks);
+	ParallelFor(NumChunks, [&](int32 ChunkIdx)
+	{
+		ChunkNumPixels[ChunkIdx].SetNumZeroed(Items.Num());
+		ChunkNumVisiblePixels[ChunkIdx].SetNumZeroed(Items.Num());
+		ChunkSkelNumPixels[ChunkIdx].SetNumZeroed(NumSkels);
+		ChunkIsClipped[ChunkIdx].SetNumZeroed(Items.Num());
+		RasterizeRows(ChunkIdx * RowsPerChunk, FMath::Min((ChunkIdx + 1) * RowsPerChunk, Resolution.Y) - 1,
+			ChunkNumPixels[ChunkIdx], ChunkNumVisiblePixels[ChunkIdx], ChunkSkelNumPixels[ChunkIdx], ChunkIsClipped[ChunkIdx]);
+	});
+
+	OutSkelNumPixels.SetNumZeroed(NumSkels);
+	for (int32 ChunkIdx = 0; ChunkIdx < NumChunks; ++ChunkIdx)
+	{
+		for (int32 ItemIdx = 0; ItemIdx < Items.Num(); ++ItemIdx)
+		{
+			Items[ItemIdx].NumPixels += ChunkNumPixels[ChunkIdx][ItemIdx];
+			Items[ItemIdx].NumVisiblePixels += ChunkNumVisiblePixels[ChunkIdx][ItemIdx];
+			Items[ItemIdx].bIsClipped |= ChunkIsClipped[ChunkIdx][ItemIdx];
+		}
+		for (int32 SkelIdx = 0; SkelIdx < NumSkels; ++SkelIdx)
+		{
+			OutSkelNumPixels[SkelIdx] += ChunkSkelNumPixels[ChunkIdx][SkelIdx];
+		}
+	}
+}
+
+// Rasterize the items in the given rows, count the covered and visible pixels of the rows
+void FSLVisionSoftwareOcclusion::RasterizeRows(int32 FirstRow, int32 LastRow, TArray<int64>& OutNumPixels, TArray<int64>& OutNumVisiblePixels,
+	TArray<int64>& OutSkelNumPixels, TArray<bool>& OutIsClipped)
+{
+	const int32 Width = Resolution.X;
+	const int32 Height = Resolution.Y;
+	float* Depths = DepthBuffer.GetData();
+	int32* ClosestItems = ItemBuffer.GetData();
+	int32* ItemStamps = ItemStamp.GetData();
+	int32* SkelStamps = SkelStamp.GetData();
+
+	for (int32 ItemIdx = 0; ItemIdx < Items.Num(); ++ItemIdx)
+	{
+		const FSLOcclusionItem& Item = Items[ItemIdx];
+		const TArray<FVector>& Tris = Item.ScreenTris;
+		for (int32 Idx = 0; Idx + 2 < Tris.Num(); Idx += 3)
+		{
+			const FVector& A = Tris[Idx];
+			FVector B = Tris[Idx + 1];
+			FVector C = Tris[Idx + 2];
+
+			// Same winding for every triangle, nothing is culled
+			float Area = (B.X - A.X) * (C.Y - A.Y) - (B.Y - A.Y) * (C.X - A.X);
+			if (Area < 0.f)
+			{
+				Swap(B, C);
+				Area = -Area;
+			}
+			if (Area < KINDA_SMALL_NUMBER)
+			{
+				continue;
+			}
+
+			// Pixels with the centers inside the triangle bounds
+			const int32 MinX = FMath::Max(0, FMath::CeilToInt(FMath::Min3(A.X, B.X, C.X) - 0.5f));
+			const int32 MaxX = FMath::Min(Width - 1, FMath::FloorToInt(FMath::Max3(A.X, B.X, C.X) - 0.5f));
+			const int32 MinY = FMath::Max(FirstRow, FMath::CeilToInt(FMath::Min3(A.Y, B.Y, C.Y) - 0.5f));
+			const int32 MaxY = FMath::Min(LastRow, FMath::FloorToInt(FMath::Max3(A.Y, B.Y, C.Y) - 0.5f));
+			if (MinX > MaxX || MinY > MaxY)
+			{
+				continue;
+			}
+
+			// Edge functions (barycentric weights times the area) stepped along the row
+			const float InvArea = 1.f / Area;
+			const float StepA = B.Y - C.Y;
+			const float StepB = C.Y - A.Y;
+			const float StepC = A.Y - B.Y;
+			for (int32 Y = MinY; Y <= MaxY; ++Y)
+			{
+				const float PX = MinX + 0.5f;
+				const float PY = Y + 0.5f;
+				float WA = (C.X - B.X) * (PY - B.Y) - (C.Y - B.Y) * (PX - B.X);
+				float WB = (A.X - C.X) * (PY - C.Y) - (A.Y - C.Y) * (PX - C.X);
+				float WC = (B.X - A.X) * (PY - A.Y) - (B.Y - A.Y) * (PX - A.X);
+				for (int32 X = MinX; X <= MaxX; ++X, WA += StepA, WB += StepB, WC += StepC)
+				{
+					if (WA < 0.f || WB < 0.f || WC < 0.f)
+					{
+						continue;
+					}
+
+					const int32 PixelIdx = Y * Width + X;
+
+					// Coverage, every pixel is counted once per item and once per skeleton
+					if (ItemStamps[PixelIdx] != ItemIdx)
+					{
+						ItemStamps[PixelIdx] = ItemIdx;
+						OutNumPixels[ItemIdx]++;
+						if (X == 0 || X == Width - 1 || Y == 0 || Y == Height - 1)
+						{
+							OutIsClipped[ItemIdx] = true;
+						}
+					}
+					if (Item.SkelIdx != INDEX_NONE && SkelStamps[PixelIdx] != Item.SkelIdx)
+					{
+						SkelStamps[PixelIdx] = Item.SkelIdx;
+						OutSkelNumPixels[Item.SkelIdx]++;
+					}
+
+					// Depth test, the inverse depth is linear in screen space
+					const float InvDepth = (WA * A.Z + WB * B.Z + WC * C.Z) * InvArea;
+					if (InvDepth > Depths[PixelIdx])
+					{
+						Depths[PixelIdx] = InvDepth;
+						ClosestItems[PixelIdx] = ItemIdx;
+					}
+				}
+			}
+		}
+	}
+
+	// Visible pixels of the rows
+	for (int32 PixelIdx = FirstRow * Width; PixelIdx < (LastRow + 1) * Width; ++PixelIdx)
+	{
+		if (ClosestItems[PixelIdx] != INDEX_NONE)
+		{
+			OutNumVisiblePixels[ClosestItems[PixelIdx]]++;
+		}
+	}
+}
+
+// Write the results back to the view entities
+void FSLVisionSoftwareOcclusion::WriteResults(FSLVisionViewData& ViewData, const TArray<int64>& SkelNumPixels) const
+{
+	// Same rounding as the screenshot based calculation
+	auto GetOcclusion = [](int64 NumPixels, int64 NumVisiblePixels)
+	{
+		const float OccPerc = 1.f - (float)NumVisiblePixels / NumPixels;
+		return OccPerc < 0.01f ? 0.f : OccPerc;
+	};
+
+	TArray<int64> SkelNumVisiblePixels;
+	SkelNumVisiblePixels.SetNumZeroed(NumSkels);
+	TArray<bool> SkelIsClipped;
+	SkelIsClipped.SetNumZeroed(NumSkels);
+
+	for (const FSLOcclusionItem& Item : Items)
+	{
+		if (Item.EntityIdx != INDEX_NONE)
+		{
+			// Items outside of the view (e.g. simplified geometry) keep the unknown value
+			if (Item.NumPixels > 0)
+			{
+				ViewData.Entities[Item.EntityIdx].OcclusionPercentage = GetOcclusion(Item.NumPixels, Item.NumVisiblePixels);
+				ViewData.Entities[Item.EntityIdx].bIsClipped = Item.bIsClipped;
+			}
+		}
+		else if (Item.SkelIdx != INDEX_NONE)
+		{
+			SkelNumVisiblePixels[Item.SkelIdx] += Item.NumVisiblePixels;
+			SkelIsClipped[Item.SkelIdx] |= Item.bIsClipped;
+			if (Item.BoneIdx != INDEX_NONE && Item.NumPixels > 0)
+			{
+				FSLVisionViewSkelBoneData& Bone = ViewData.SkelEntities[Item.SkelIdx].Bones[Item.BoneIdx];
+				Bone.OcclusionPercentage = GetOcclusion(Item.NumPixels, Item.NumVisiblePixels);
+				Bone.bIsClipped = Item.bIsClipped;
+			}
+		}
+	}
+
+	for (int32 SkelIdx = 0; SkelIdx < NumSkels; ++SkelIdx)
+	{
+		if (SkelNumPixels[SkelIdx] > 0)
+		{
+			ViewData.SkelEntities[SkelIdx].OcclusionPercentage = GetOcclusion(SkelNumPixels[SkelIdx], SkelNumVisiblePixels[SkelIdx]);
+			ViewData.SkelEntities[SkelIdx].bIsClipped = SkelIsClipped[SkelIdx];
+		}
+	}
+}
+
+// Project the mesh triangles, clipped against the near plane
+void FSLVisionSoftwareOcclusion::ProjectMesh(const FSLOcclusionMesh& Mesh, const FTransform& MeshToWorld, const FTransform& ViewPose, float Focal,
+	TArray<FVector>& OutScreenTris) const
+{
+	const float HalfWidth = Resolution.X * 0.5f;
+	const float HalfHeight = Resolution.Y * 0.5f;
+
+	// Vertices in view space (X forward, Y right, Z up)
+	TArray<FVector> ViewVertices;
+	ViewVertices.SetNumUninitialized(Mesh.Vertices.Num());
+	for (int32 Idx = 0; Idx < Mesh.Vertices.Num(); ++Idx)
+	{
+		ViewVertices[Idx] = ViewPose.InverseTransformPosition(MeshToWorld.TransformPosition(Mesh.Vertices[Idx]));
+	}
+
+	auto ToScreen = [&](const FVector& V)
+	{
+		const float InvDepth = 1.f / V.X;
+		return FVector(HalfWidth + V.Y * InvDepth * Focal, HalfHeight - V.Z * InvDepth * Focal, InvDepth);
+	};
+
+	for (int32 Idx = 0; Idx + 2 < Mesh.Indices.Num(); Idx += 3)
+	{
+		const FVector Tri[3] = { ViewVertices[Mesh.Indices[Idx]], ViewVertices[Mesh.Indices[Idx + 1]], ViewVertices[Mesh.Indices[Idx + 2]] };
+
+		// Clip against the near plane, results in at most a quad
+		FVector Poly[4];
+		int32 NumPoly = 0;
+		for (int32 V = 0; V < 3; ++V)
+		{
+			const FVector& P0 = Tri[V];
+			const FVector& P1 = Tri[(V + 1) % 3];
+			const bool bP0In = P0.X >= NearClipDistance;
+			const bool bP1In = P1.X >= NearClipDistance;
+			if (bP0In)
+			{
+				Poly[NumPoly++] = P0;
+			}
+			if (bP0In != bP1In)
+			{
+				Poly[NumPoly++] = P0 + (P1 - P0) * ((NearClipDistance - P0.X) / (P1.X - P0.X));
+			}
+		}
+		if (NumPoly < 3)
+		{
+			continue;
+		}
+
+		FVector ScreenPoly[4];
+		FVector2D Min(MAX_flt, MAX_flt);
+		FVector2D Max(-MAX_flt, -MAX_flt);
+		for (int32 V = 0; V < NumPoly; ++V)
+		{
+			ScreenPoly[V] = ToScreen(Poly[V]);
+			Min.X = FMath::Min(Min.X, ScreenPoly[V].X);
+			Min.Y = FMath::Min(Min.Y, ScreenPoly[V].Y);
+			Max.X = FMath::Max(Max.X, ScreenPoly[V].X);
+			Max.Y = FMath::Max(Max.Y, ScreenPoly[V].Y);
+		}
+
+		// Skip the triangles outside of the image
+		if (Max.X < 0.f || Max.Y < 0.f || Min.X > Resolution.X || Min.Y > Resolution.Y)
+		{
+			continue;
+		}
+
+		for (int32 V = 1; V + 1 < NumPoly; ++V)
+		{
+			OutScreenTris.Add(ScreenPoly[0]);
+			OutScreenTris.Add(ScreenPoly[V]);
+			OutScreenTris.Add(ScreenPoly[V + 1]);
+		}
+	}
+}
+
+// Get the simplified geometry of the static mesh (cached)
+const FSLOcclusionMesh* FSLVisionSoftwareOcclusion::GetStaticMeshGeometry(UStaticMesh* StaticMesh)
+{
+	if (const FSLOcclusionMesh* CachedMesh = StaticMeshGeometry.Find(StaticMesh))
+	{
+		return CachedMesh->Indices.Num() > 0 ? CachedMesh : nullptr;
+	}
+
+	FSLOcclusionMesh& Mesh = StaticMeshGeometry.Add(StaticMesh);
+
+	// Lowest detail LOD, the vertex data is kept on the CPU in the editor or if the mesh allows CPU access
+	if (StaticMesh->RenderData && StaticMesh->RenderData->LODResources.Num() > 0 && (GIsEditor || StaticMesh->bAllowCPUAccess))
+	{
+		const FStaticMeshLODResources& LOD = StaticMesh->RenderData->LODResources.Last();
+		const FPositionVertexBuffer& Positions = LOD.VertexBuffers.PositionVertexBuffer;
+		if (Positions.GetNumVertices() > 0 && LOD.IndexBuffer.GetNumIndices() > 0)
+		{
+			Mesh.Vertices.SetNumUninitialized(Positions.GetNumVertices());
+			for (uint32 Idx = 0; Idx < Positions.GetNumVertices(); ++Idx)
+			{
+				Mesh.Vertices[Idx] = Positions.VertexPosition(Idx);
+			}
+
+			TArray<uint32> Indices;
+			LOD.IndexBuffer.GetCopy(Indices);
+			Mesh.Indices.Reserve(Indices.Num());
+			for (uint32 Index : Indices)
+			{
+				Mesh.Indices.Add(Index);
+			}
+		}
+	}
+
+	// Simplified collision
+	if (Mesh.Indices.Num() == 0 && StaticMesh->BodySetup)
+	{
+		AddAggregateGeometry(StaticMesh->BodySetup->AggGeom, Mesh);
+	}
+
+	// Bounding box
+	if (Mesh.Indices.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s::%d No LOD or collision geometry for %s, using its bounding box.."),
+			*FString(__func__), __LINE__, *StaticMesh->GetName());
+		AddBox(StaticMesh->GetBoundingBox(), FTransform::Identity, Mesh);
+	}
+
+	return &Mesh;
+}
+
+// Get the collision geometry of the skeletal body (cached)
+const FSLOcclusionMesh* FSLVisionSoftwareOcclusion::GetBodyGeometry(USkeletalBodySetup* BodySetup)
+{
+	FSLOcclusionMesh* Mesh = BodyGeometry.Find(BodySetup);
+	if (!Mesh)
+	{
+		Mesh = &BodyGeometry.Add(BodySetup);
+		AddAggregateGeometry(BodySetup->AggGeom, *Mesh);
+	}
+	return Mesh->Indices.Num() > 0 ? Mesh : nullptr;
+}
+
+// Triangulate the collision shapes
+void FSLVisionSoftwareOcclusion::AddAggregateGeometry(const FKAggregateGeom& AggGeom, FSLOcclusionMesh& OutMesh)
+{
+	for (const FKBoxElem& Box : AggGeom.BoxElems)
+	{
+		const FVector HalfExtent = FVector(Box.X, Box.Y, Box.Z) * 0.5f;
+		AddBox(FBox(-HalfExtent, HalfExtent), Box.GetTransform(), OutMesh);
+	}
+
+	for (const FKSphereElem& Sphere : AggGeom.SphereElems)
+	{
+		AddCapsule(Sphere.Radius, 0.f, Sphere.GetTransform(), OutMesh);
+	}
+
+	for (const FKSphylElem& Sphyl : AggGeom.SphylElems)
+	{
+		AddCapsule(Sphyl.Radius, Sphyl.Length, Sphyl.GetTransform(), OutMesh);
+	}
+
+	for (const FKConvexElem& Convex : AggGeom.ConvexElems)
+	{
+		const FTransform ConvexTransform = Convex.GetTransform();
+		if (Convex.IndexData.Num() >= 3)
+		{
+			const int32 Offset = OutMesh.Vertices.Num();
+			for (const FVector& Vertex : Convex.VertexData)
+			{
+				OutMesh.Vertices.Add(ConvexTransform.TransformPosition(Vertex));
+			}
+			for (int32 Index : Convex.IndexData)
+			{
+				OutMesh.Indices.Add(Offset + Index);
+			}
+		}
+		else if (Convex.VertexData.Num() > 0)
+		{
+			AddBox(Convex.ElemBox, ConvexTransform, OutMesh);
+		}
+	}
+}
+
+// Triangulate the box
+void FSLVisionSoftwareOcclusion::AddBox(const FBox& Box, const FTransform& Transform, FSLOcclusionMesh& OutMesh)
+{
+	// Corner bits: 1 - max X, 2 - max Y, 4 - max Z
+	static const int32 BoxIndices[36] = {
+		0, 1, 3,  0, 3, 2,
+		4, 6, 7,  4, 7, 5,
+		0, 4, 5,  0, 5, 1,
+		2, 3, 7,  2, 7, 6,
+		0, 2, 6,  0, 6, 4,
+		1, 5, 7,  1, 7, 3 };
+
+	const int32 Offset = OutMesh.Vertices.Num();
+	for (int32 Corner = 0; Corner < 8; ++Corner)
+	{
+		OutMesh.Vertices.Add(Transform.TransformPosition(FVector(
+			(Corner & 1) ? Box.Max.X : Box.Min.X,
+			(Corner & 2) ? Box.Max.Y : Box.Min.Y,
+			(Corner & 4) ? Box.Max.Z : Box.Min.Z)));
+	}
+	for (int32 Index : BoxIndices)
+	{
+		OutMesh.Indices.Add(Offset + Index);
+	}
+}
+
+// Triangulate the capsule along the Z axis (a sphere if the length is zero)
+void FSLVisionSoftwareOcclusion::AddCapsule(float Radius, float Length, const FTransform& Transform, FSLOcclusionMesh& OutMesh)
+{
+	// Rings of the top and bottom hemispheres, the two equator rings form the cylinder
+	const int32 NumHalfRings = NumCapsuleSegments / 2;
+	const float HalfLength = Length * 0.5f;
+	const int32 Offset = OutMesh.Vertices.Num();
+	int32 NumRings = 0;
+	for (int32 Half = 0; Half < 2; ++Half)
+	{
+		for (int32 Ring = 0; Ring <= NumHalfRings; ++Ring)
+		{
+			const float Phi = HALF_PI * (Half + (float)Ring / NumHalfRings);
+			const float RingRadius = FMath::Sin(Phi) * Radius;
+			const float Z = FMath::Cos(Phi) * Radius + (Half == 0 ? HalfLength : -HalfLength);
+			for (int32 Seg = 0; Seg < NumCapsuleSegments; ++Seg)
+			{
+				const float Theta = 2.f * PI * Seg / NumCapsuleSegments;
+				OutMesh.Vertices.Add(Transform.TransformPosition(
+					FVector(RingRadius * FMath::Cos(Theta), RingRadius * FMath::Sin(Theta), Z)));
+			}
+			NumRings++;
+		}
+	}
+
+	for (int32 Ring = 0; Ring + 1 < NumRings; ++Ring)
+	{
+		for (int32 Seg = 0; Seg < NumCapsuleSegments; ++Seg)
+		{
+			const int32 V0 = Offset + Ring * NumCapsuleSegments + Seg;
+			const int32 V1 = Offset + Ring * NumCapsuleSegments + (Seg + 1) % NumCapsuleSegments;
+			const int32 V2 = V0 + NumCapsuleSegments;
+			const int32 V3 = V1 + NumCapsuleSegments;
+			OutMesh.Indices.Append({ V0, V1, V3, V0, V3, V2 });
+		}
+	}
+}
+
+// Collect the errors of a single estimate
+void FSLVisionSoftwareOcclusion::AddValidationSample(const FString& Name, float Estimated, float Reference, bool bEstClipped, bool bRefClipped)
+{
+	// Unknown values (not calculated by one of the methods)
+	if (Estimated < 0.f || Reference < 0.f)
+	{
+		return;
+	}
+
+	const float Error = FMath::Abs(Estimated - Reference);
+	NumValidationSamples++;
+	SumValidationError += Error;
+	MaxValidationError = FMath::Max(MaxValidationError, Error);
+	if (bEstClipped != bRefClipped)
+	{
+		NumClippedMismatches++;
+	}
+
+	if (Error > ValidationLogThreshold)
+	{
+		UE_LOG(LogTemp, Log, TEXT("%s::%d [%s] EstimatedOcc=%.4f; ScreenshotOcc=%.4f; EstimatedClipped=%d; ScreenshotClipped=%d;"),
+			*FString(__func__), __LINE__, *Name, Estimated, Reference, bEstClipped, bRefClipped);
+	}
+}
@@ -0,0 +1,148 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "Engine/EngineTypes.h"
+
+// Forward declaration
+class ISLContactShapeInterface;
+
+/**
+ * Singleton computing the contacts between the semantic contact shapes without relying on the engine overlap events,
+ * the bounds of the registered shapes are kept sorted on the X axis (incremental insertion sort, sort and sweep),
+ * only the candidate pairs with overlapping bounds are tested with the shape geometry; the resulting begin/end
+ * contacts are forwarded to the shapes overlap handling, so the same contact delegates are broadcasted;
+ * the registered shapes are moved to their own object channel which they ignore, so the engine does not generate
+ * the shape vs shape overlaps anymore, the contacts with components without a contact shape (walls, counters,
+ * unannotated props) still come from the overlap events (the channel is unused in the project, blocked by default)
+ */
+class USEMLOG_API FSLContactBroadphase : public FTickableGameObject
+{
+private:
+	// Constructor
+	FSLContactBroadphase();
+
+public:
+	// Destructor
+	~FSLContactBroadphase() = default;
+
+	// Get singleton
+	static FSLContactBroadphase* GetInstance();
+
+	// Delete instance
+	static void DeleteInstance();
+
+	// Check if the singleton exists (avoids creating it when the broadphase is not used)
+	static bool HasInstance() { return StaticInstance.IsValid(); }
+
+	// Init with the world, the shapes started afterwards will register themselves (their overlap events ignore the other registered shapes)
+	void Init(UWorld* InWorld);
+
+	// Check if the broadphase is init
+	bool IsInit() const { return bIsInit; }
+
+	// Register the shape, returns false if the broadphase is not init
+	bool AddShape(ISLContactShapeInterface* InShape);
+
+	// Unregister the shape, the active contacts of the shape are ended
+	void RemoveShape(ISLContactShapeInterface* InShape);
+
+	// Check if the shape is registered
+	bool HasShape(ISLContactShapeInterface* InShape) const { return ShapeToProxyIdx.Contains(InShape); }
+
+	// Get the number of registered shapes
+	int32 NumShapes() const { return Proxies.Num(); }
+
+	/** Begin FTickableGameObject interface */
+	// Called after ticking all actors, DeltaTime is the time passed since the last call.
+	virtual void Tick(float DeltaTime) override;
+
+	// Return if object is ready to be ticked
+	virtual bool IsTickable() const override;
+
+	// Return the world the manager is ticked with (ticked by the world tick, also when the world is ticked manually)
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	// Return the stat id to use for this tickable
+	virtual TStatId GetStatId() const override;
+	/** End FTickableGameObject interface */
+
+private:
+	/**
+	 * Registered contact shape with its cached world bounds
+	 */
+	struct FSLBroadphaseProxy
+	{
+		// The contact shape
+		ISLContactShapeInterface* Shape;
+
+		// World space bounds of the shape
+		FBox Bounds;
+
+		// Object channel of the shape before it was registered (restored on removal)
+		TEnumAsByte<ECollisionChannel> PrevObjectType;
+
+		// Response of the shape to the broadphase channel before it was registered
+		TEnumAsByte<ECollisionResponse> PrevChannelResponse;
+	};
+
+	// Read the world bounds of the shapes
+	void UpdateBounds();
+
+	// Insertion sort the proxies on the bounds min X (the order changes little between ticks)
+	void SortProxies();
+
+	// Sweep the sorted proxies, test the candidate pairs, output the overlapping pairs
+	void SweepAndTestPairs(TSet<uint64>& OutOverlappingPairs) const;
+
+	// Check if the geometry of the two shapes overlaps
+	static bool ShapesOverlap(ISLContactShapeInterface* A, ISLContactShapeInterface* B);
+
+	// Forward the contact begin of the pair to both shapes
+	void BeginPairContact(uint64 PairKey);
+
+	// Forward the contact end of the pair to both shapes
+	void EndPairContact(uint64 PairKey);
+
+	// Order independent key of the two proxies
+	static FORCEINLINE uint64 GetPairKey(int32 IdxA, int32 IdxB)
+	{
+		return IdxA < IdxB ? (uint64(IdxA) << 32) | uint32(IdxB) : (uint64(IdxB) << 32) | uint32(IdxA);
+	}
+
+	// Get the proxy indexes from the key
+	static FORCEINLINE void GetPairIndexes(uint64 PairKey, int32& OutIdxA, int32& OutIdxB)
+	{
+		OutIdxA = int32(PairKey >> 32);
+		OutIdxB = int32(PairKey & 0xFFFFFFFF);
+	}
+
+private:
+	// Instance of the singleton
+	static TSharedPtr<FSLContactBroadphase> StaticInstance;
+
+	// Flag showing the broadphase has been init
+	bool bIsInit;
+
+	// Pointer to the world
+	UWorld* World;
+
+	// The registered shapes
+	TSparseArray<FSLBroadphaseProxy> Proxies;
+
+	// Quick access from the shape to its proxy index
+	TMap<ISLContactShapeInterface*, int32> ShapeToProxyIdx;
+
+	// Proxy indexes sorted by the bounds min X
+	TArray<int32> SortedProxies;
+
+	// Pairs currently in contact
+	TSet<uint64> ActivePairs;
+
+	/* Constants */
+	// Object channel of the registered shapes (ignored by them), keep it unused in the project collision settings
+	constexpr static ECollisionChannel ShapeChannel = ECC_GameTraceChannel18;
+};
@@ -11,7 +11,7 @@
 
 /**
  * Structure holding the OverlapEnd event data,
- * cached for a small period of time in case it should be concatenated with the follow-up event
+ * delayed for a small period of time (by the overlap end debouncer) in case it should be concatenated with the follow-up event
  */
 struct FSLOverlapEndEvent
 {
@@ -50,6 +50,12 @@ class ISLContactShapeInterface
 {
 	GENERATED_BODY()
 
+	// Broadcasts the resolved supported by candidates through the shape delegates
+	friend class FSLSupportedByManager;
+
+	// Forwards the computed contacts to the shape overlap callbacks
+	friend class FSLContactBroadphase;
+
 public:
 	// Initialize trigger area for runtime, check if outer is valid and semantically annotated
 	virtual void Init(bool bLogSupportedByEvents = true) = 0;
@@ -102,11 +108,17 @@ protected:
 	// Publish currently overlapping components
 	void TriggerInitialOverlaps();
 
-	// Start checking for supported by events
+	// Register the shape with the contact broadphase if it is active (the contacts with the other registered shapes are computed by it)
+	void RegisterWithContactBroadphase();
+
+	// Start checking for supported by events (registers the shape candidates with the supported by manager)
 	void StartSupportedByUpdateCheck();
 
-	// Check for supported by events
-	void SupportedByUpdateCheckBegin();
+	// Add supported by candidate to the manager
+	void AddSupportedByCandidate(const FSLContactResult& InCandidate);
+
+	// Called by the supported by manager when the candidate is in a supported by event
+	void OnSupportedByCandidateResolved(const FSLContactResult& InCandidate, bool bIsSelfSupported, float Time);
 
 	// Check if Other is a supported by candidate
 	bool CheckAndRemoveIfJustCandidate(UObject* InOther);
@@ -127,14 +139,20 @@ protected:
 		UPrimitiveComponent* OtherComp,
 		int32 OtherBodyIndex);
 
-	// Delayed call of sending the finished event to check for possible concatenation of jittering events of the same type
-	void DelayedOverlapEndEventCallback();
+	// Process the overlap begin (from the overlap events or the broadphase)
+	void BeginOverlap(AActor* OtherActor, UPrimitiveComponent* OtherComp);
+
+	// Process the overlap end (from the overlap events or the broadphase)
+	void EndOverlap(AActor* OtherActor, UPrimitiveComponent* OtherComp);
 
-	// Broadcast delayed overlaps, if curr time < 0, it guarantees a publish
-	bool PublishDelayedOverlapEndEvent(const FSLOverlapEndEvent& Ev, float CurrTime = -1.f);
+	// Broadcast the delayed overlap end (called by the debouncer if no concatenation happened)
+	void PublishDelayedOverlapEndEvent(const FSLOverlapEndEvent& Ev);
 
 	// Skip publishing overlap event if it can be concatenated with the current event start
 	bool SkipOverlapEndEventBroadcast(const FSLEntity& InItem, float StartTime);
+
+	// Get the pair id of the owner and the other item (used as key for the delayed overlap ends)
+	uint64 GetOverlapPairId(const FSLEntity& InItem) const;
 	
 public:
 	// Event called when a semantic overlap begins / ends
@@ -176,27 +194,7 @@ protected:
 	// Include supported by events
 	bool bLogSupportedByEvents;
 
-	// SupportedBy contact candidates
-	TArray<FSLContactResult> SBCandidates;
-	
-	// Supported by event update timer handle
-	FTimerHandle SBTimerHandle;
-
-	// Allow binding against non-UObject functions
-	FTimerDelegate SBTimerDelegate;
-
-	// Send finished events with a delay to check for possible concatenation of equal and consecutive events with small time gaps in between
-	FTimerHandle DelayTimerHandle;
-
-	// Can only bind the timer handle to UObjects or FTimerDelegates
-	FTimerDelegate DelayTimerDelegate;
-
-	// Array of recently ended overlaps
-	TArray<FSLOverlapEndEvent> RecentlyEndedOverlapEvents;
-
 	/* Constants */
 	constexpr static const char* TagTypeName = "SemLogColl";
-	constexpr static float SBUpdateRate = 0.11f;
-	constexpr static float SBMaxVertSpeed = 0.5f;
 	constexpr static float MaxOverlapEventTimeGap = 0.12f;
 };
\ No newline at end of file
@@ -56,12 +56,6 @@ private:
 	// Finish any active events
 	void FinishActiveEvents();
 
-	// Iterate recursively attached constraints actors of parent, append other constrained actors to set
-	void GetAllConstraintsOtherActors(AActor* Actor, TSet<AActor*>& OutOtherConstraintActors);
-
-	// Iterate recursively on the attached actors, and search for container type
-	void GetAllAttachedContainers(AActor* Actor, TSet<AActor*>& OutContainers);
-
 public:
 	// Container manipulation delegate
 	FSLContainerManipulationSignature OnContainerManipulation;
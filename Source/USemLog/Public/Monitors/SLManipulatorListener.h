@@ -95,6 +95,12 @@ public:
 	// Get finished state
 	bool IsFinished() const { return bIsFinished; };
 
+	// Detect the grasps from the finger overlaps only, without the trigger input (before start, e.g. when replaying an episode)
+	void SetIgnoreGraspInput(bool bValue) { bIgnoreGraspInput = bValue; };
+
+	// True if there are ended grasp or contact events which are not yet published (waiting for a possible concatenation)
+	bool HasPendingEvents() const { return RecentlyEndedGraspEvents.Num() > 0 || RecentlyEndedContactEvents.Num() > 0; };
+
 protected:
 #if WITH_EDITOR
 	// Called when a property is changed in the editor
@@ -219,6 +225,10 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Semantic Logger")
 	float UnPauseTriggerVal;
 
+	// Do not bind the grasp input, the grasp detection is never paused
+	UPROPERTY(EditAnywhere, Category = "Semantic Logger")
+	bool bIgnoreGraspInput;
+
 	// If the owner is not a skeletal actor, one needs to add the children (fingers) manually
 	UPROPERTY(EditAnywhere, Category = "Semantic Logger")
 	bool bIsNotSkeletal;
@@ -19,25 +19,6 @@ enum class ESLManipulatorOverlapGroup : uint8
 	B					UMETA(DisplayName = "B"),
 };
 
-/**
- * Overlap event end data
- */
-struct FSLManipulatorOverlapEndEvent
-{
-	// Default ctor
-	FSLManipulatorOverlapEndEvent() = default;
-
-	// Init ctor
-	FSLManipulatorOverlapEndEvent(AActor* InOtherActor, float InTime) :
-		OtherActor(InOtherActor), Time(InTime) {};
-
-	// Overlap component
-	AActor* OtherActor;
-
-	// End time of the event 
-	float Time;
-};
-
 /** Delegate to notify that a contact begins between the grasp overlap and an item**/
 DECLARE_MULTICAST_DELEGATE_OneParam(FSLManipulatorOverlapBeginSignature, AActor* /*OtherActor*/);
 
@@ -118,11 +99,8 @@ private:
 		UPrimitiveComponent* OtherComp,
 		int32 OtherBodyIndex);
 
-	// Delayed call of sending the finished event to check for possible concatenation of jittering events of the same type
-	void DelayedGraspOverlapEndEventCallback();
-
-	// Check if this begin event happened right after the previous one ended
-	// if so remove it from the array, and cancel publishing the begin event
+	// Check if this begin event happened right after the previous one ended,
+	// if so cancel the pending end and skip publishing the begin event
 	bool SkipRecentGraspOverlapEndEventBroadcast(AActor* OtherActor, float StartTime);
 
 	/* Contact related */
@@ -145,11 +123,8 @@ private:
 		UPrimitiveComponent* OtherComp,
 		int32 OtherBodyIndex);
 
-	// Delayed call of sending the finished event to check for possible concatenation of jittering events of the same type
-	void DelayedContactOverlapEndEventCallback();
-
-	// Check if this begin event happened right after the previous one ended
-	// if so remove it from the array, and cancel publishing the begin event
+	// Check if this begin event happened right after the previous one ended,
+	// if so cancel the pending end and skip publishing the begin event
 	bool SkipRecentContactOverlapEndEventBroadcast(AActor* OtherActor, float StartTime);
 
 public:
@@ -210,21 +185,9 @@ private:
 	TArray<AStaticMeshActor*> IgnoreList;
 
 
-	// Send finished events with a delay to check for possible concatenation of equal and consecutive events with small time gaps in between
-	FTimerHandle GraspDelayTimerHandle;
-
-	// Array of recently ended events
-	TArray<FSLManipulatorOverlapEndEvent> RecentlyEndedGraspOverlapEvents;
-	
-	
-	// Send finished events with a delay to check for possible concatenation of equal and consecutive events with small time gaps in between
-	FTimerHandle ContactDelayTimerHandle;
-
-	// Array of recently ended events
-	TArray<FSLManipulatorOverlapEndEvent> RecentlyEndedContactOverlapEvents;
-	
-
 	/* Constants */
 	constexpr static bool bVisualDebug = true;
 	constexpr static float MaxOverlapEventTimeGap = 0.11f;
+	constexpr static uint32 GraspDebounceChannel = 0;
+	constexpr static uint32 ContactDebounceChannel = 1;
 };
@@ -0,0 +1,110 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Fixed capacity, time ordered ring buffer of (time, location) samples,
+ * O(1) append (the oldest or expired samples are overwritten), O(log n) lookup of the first sample since a given time,
+ * and O(log n) min/max height queries over any suffix window (kept with monotonic queues)
+ */
+class USEMLOG_API FSLMotionHistory
+{
+public:
+	// Ctor
+	FSLMotionHistory(int32 InCapacity = 256, float InMaxDuration = 3.3f);
+
+	// Remove all samples
+	void Reset();
+
+	// Add the newest sample, samples older than the max duration are dropped
+	void Add(float Time, const FVector& Location);
+
+	// Number of samples
+	int32 Num() const { return int32(NextSeq - OldestSeq); }
+
+	// True if there are no samples
+	bool IsEmpty() const { return NextSeq == OldestSeq; }
+
+	// Time of the sample (0 is the oldest)
+	float GetTime(int32 Idx) const { return Times[ToSlot(OldestSeq + Idx)]; }
+
+	// Location of the sample (0 is the oldest)
+	const FVector& GetLocation(int32 Idx) const { return Locations[ToSlot(OldestSeq + Idx)]; }
+
+	// Time of the newest sample (0 if there are no samples)
+	float GetLastTime() const { return Num() > 0 ? GetTime(Num() - 1) : 0.f; }
+
+	// Location of the newest sample (zero vector if there are no samples)
+	const FVector& GetLastLocation() const { return Num() > 0 ? GetLocation(Num() - 1) : FVector::ZeroVector; }
+
+	// Index of the first sample with the time equal or later than the given one (Num() if there is none)
+	int32 FindFirstSince(float Time) const;
+
+	// Max height of the samples from the index to the newest one (the index of the max is returned as well)
+	float GetMaxHeightSince(int32 Idx, int32* OutMaxIdx = nullptr) const;
+
+	// Min height of the samples from the index to the newest one (the index of the min is returned as well)
+	float GetMinHeightSince(int32 Idx, int32* OutMinIdx = nullptr) const;
+
+	// Displacement from the sample at the index to the newest one
+	FVector GetDisplacementSince(int32 Idx) const { return GetLastLocation() - GetLocation(Idx); }
+
+private:
+	/**
+	 * Monotonic queue of sample sequence numbers, the front is the extreme height of the stored window
+	 */
+	struct FSLHeightQueue
+	{
+		// Sequence numbers, ring storage
+		TArray<int64> Seqs;
+
+		// Ring front
+		int32 Head = 0;
+
+		// Number of stored sequence numbers
+		int32 Count = 0;
+
+		// Get the sequence number at the index (0 is the front)
+		FORCEINLINE int64 Get(int32 Idx) const { return Seqs[(Head + Idx) % Seqs.Num()]; }
+	};
+
+	// Slot of the sequence number in the sample arrays
+	FORCEINLINE int32 ToSlot(int64 Seq) const { return int32(Seq % Capacity); }
+
+	// Push the newest sample into the queue, removes the samples which can no longer be the extreme (bMax for max heights)
+	void PushToQueue(FSLHeightQueue& Queue, int64 Seq, bool bMax);
+
+	// Remove the expired sequence numbers from the front of the queue
+	void TrimQueue(FSLHeightQueue& Queue);
+
+	// Get the queue entry of the extreme of the samples since the sequence number
+	int64 FindInQueue(const FSLHeightQueue& Queue, int64 SinceSeq) const;
+
+private:
+	// Max number of samples
+	int32 Capacity;
+
+	// Samples older than this (relative to the newest) are dropped
+	float MaxDuration;
+
+	// Sample times
+	TArray<float> Times;
+
+	// Sample locations
+	TArray<FVector> Locations;
+
+	// Sequence number of the oldest sample
+	int64 OldestSeq;
+
+	// Sequence number of the next sample
+	int64 NextSeq;
+
+	// Max height queue (decreasing heights)
+	FSLHeightQueue MaxHeightQueue;
+
+	// Min height queue (increasing heights)
+	FSLHeightQueue MinHeightQueue;
+};
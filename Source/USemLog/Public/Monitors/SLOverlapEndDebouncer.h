@@ -0,0 +1,180 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+
+/**
+ * Key of a pending overlap end (monitor, pair of entities, and the monitor channel (e.g. grasp/contact))
+ */
+struct FSLDebounceKey
+{
+	// The monitor which scheduled the end
+	const void* Owner;
+
+	// Pair id of the entities (combination of two unique runtime ids)
+	uint64 PairId;
+
+	// Separates multiple end types of the same monitor
+	uint32 Channel;
+
+	// Default ctor
+	FSLDebounceKey() : Owner(nullptr), PairId(0), Channel(0) {};
+
+	// Init ctor
+	FSLDebounceKey(const void* InOwner, uint64 InPairId, uint32 InChannel) :
+		Owner(InOwner), PairId(InPairId), Channel(InChannel) {};
+
+	// Equality
+	FORCEINLINE bool operator==(const FSLDebounceKey& Other) const
+	{
+		return Owner == Other.Owner && PairId == Other.PairId && Channel == Other.Channel;
+	}
+
+	// Hash
+	friend FORCEINLINE uint32 GetTypeHash(const FSLDebounceKey& Key)
+	{
+		return HashCombine(HashCombine(PointerHash(Key.Owner), GetTypeHash(Key.PairId)), Key.Channel);
+	}
+};
+
+/**
+ * Singleton delaying the overlap end events of the monitors in order to filter out flickering overlaps,
+ * a re-begin within the time gap cancels the pending end, otherwise the end is fired in a batch once per tick;
+ * the pending ends are stored in a hierarchical timer wheel (O(1) schedule / cancel)
+ */
+class USEMLOG_API FSLOverlapEndDebouncer : public FTickableGameObject
+{
+private:
+	// Constructor
+	FSLOverlapEndDebouncer();
+
+public:
+	// Destructor
+	~FSLOverlapEndDebouncer() = default;
+
+	// Get singleton
+	static FSLOverlapEndDebouncer* GetInstance();
+
+	// Delete instance
+	static void DeleteInstance();
+
+	// Init with the world
+	void Init(UWorld* InWorld);
+
+	// Check if the debouncer is init
+	bool IsInit() const { return bIsInit; }
+
+	// Schedule the end of the pair, it is fired if no re-begin happens within the time gap (returns false if already pending)
+	bool Schedule(const void* InOwner, uint64 InPairId, float EndTime, float MaxTimeGap,
+		TFunction<void()>&& InOnExpired, uint32 InChannel = 0);
+
+	// Called on a re-begin, cancels the pending end if it is within its time gap (returns true if the end was cancelled),
+	// if the end is pending but too old, it is fired before returning
+	bool CancelIfRecent(const void* InOwner, uint64 InPairId, float BeginTime, uint32 InChannel = 0);
+
+	// Check if the end of the pair is pending
+	bool IsPending(const void* InOwner, uint64 InPairId, uint32 InChannel = 0) const;
+
+	// True if any overlap end is still waiting for its time gap
+	bool HasPending() const { return Entries.Num() > 0; }
+
+	// Fire all the pending ends of the owner
+	void FlushOwner(const void* InOwner);
+
+	// Drop all the pending ends of the owner without firing them
+	void CancelOwner(const void* InOwner);
+
+	/** Begin FTickableGameObject interface */
+	// Called after ticking all actors, DeltaTime is the time passed since the last call.
+	virtual void Tick(float DeltaTime) override;
+
+	// Return if object is ready to be ticked
+	virtual bool IsTickable() const override;
+
+	// Return the world the manager is ticked with (ticked by the world tick, also when the world is ticked manually)
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	// Return the stat id to use for this tickable
+	virtual TStatId GetStatId() const override;
+	/** End FTickableGameObject interface */
+
+private:
+	/**
+	 * Pending end stored in the wheel slots as a doubly linked list
+	 */
+	struct FSLDebounceEntry
+	{
+		// Key of the entry
+		FSLDebounceKey Key;
+
+		// Time of the overlap end
+		float EndTime;
+
+		// Re-begins within this gap cancel the end
+		float MaxTimeGap;
+
+		// Tick at which the end is fired
+		int64 ExpireTick;
+
+		// Global slot index the entry is linked in
+		int32 Slot;
+
+		// Previous and next entries in the slot
+		int32 Prev;
+		int32 Next;
+
+		// Called when the end is fired
+		TFunction<void()> OnExpired;
+	};
+
+	// Convert seconds to wheel ticks
+	static FORCEINLINE int64 ToTicks(float Seconds) { return static_cast<int64>(FMath::FloorToDouble(Seconds / TickResolution)); }
+
+	// Link entry into the wheel slot given by its expire tick
+	void LinkEntry(int32 EntryIdx);
+
+	// Unlink entry from its wheel slot
+	void UnlinkEntry(int32 EntryIdx);
+
+	// Remove entry, returns its callback
+	TFunction<void()> RemoveEntry(int32 EntryIdx);
+
+	// Re-link the entries of the upper level slot into the lower levels, returns the slot index
+	int32 Cascade(int32 Level, int32 Index);
+
+	// Advance the wheel to the given tick, collect the expired entries
+	void Advance(int64 ToTick, TArray<TFunction<void()>>& OutExpired);
+
+private:
+	// Instance of the singleton
+	static TSharedPtr<FSLOverlapEndDebouncer> StaticInstance;
+
+	// Flag showing the debouncer has been init
+	bool bIsInit;
+
+	// Pointer to the world
+	UWorld* World;
+
+	// Next tick to be processed by the wheel
+	int64 CurrentTick;
+
+	// Pending ends
+	TSparseArray<FSLDebounceEntry> Entries;
+
+	// Quick access from the key to the entry index
+	TMap<FSLDebounceKey, int32> KeyToEntryIdx;
+
+	// Head entry index of every slot of every level
+	TArray<int32> SlotHeads;
+
+	/* Constants */
+	constexpr static float TickResolution = 0.01f;
+	constexpr static int32 NumLevels = 4;
+	constexpr static int32 RootBits = 8;
+	constexpr static int32 LevelBits = 6;
+	constexpr static int32 RootSize = 1 << RootBits;
+	constexpr static int32 LevelSize = 1 << LevelBits;
+};
@@ -8,6 +8,8 @@
 #include "Components/ActorComponent.h"
 #include "SLStructs.h" // FSLEntity
 #include "SLContactShapeInterface.h"
+#include "Monitors/SLMotionHistory.h"
+#include "Monitors/SLSpatialQueryManager.h"
 #include "SLPickAndPlaceListener.generated.h"
 
 
@@ -40,6 +42,55 @@ public:
 	float StartTime;
 };
 
+/**
+ * Thresholds of the pick and place state checks (cm / seconds)
+ */
+USTRUCT()
+struct FSLPaPThresholds
+{
+	GENERATED_BODY()
+
+	// Sampling rate of the grasped object location
+	UPROPERTY(EditAnywhere)
+	float UpdateRate = 0.05f;
+
+	// Slide
+	UPROPERTY(EditAnywhere)
+	float MinSlideDistXY = 9.f;
+
+	UPROPERTY(EditAnywhere)
+	float MinSlideDuration = 0.9f;
+
+	// PickUp
+	UPROPERTY(EditAnywhere)
+	float MaxPickUpDistXY = 9.f;
+
+	UPROPERTY(EditAnywhere)
+	float MinPickUpHeight = 3.f;
+
+	UPROPERTY(EditAnywhere)
+	float MaxPickUpHeight = 12.f;
+
+	// PutDown
+	UPROPERTY(EditAnywhere)
+	int32 RecentMovementBufferSize = 256;
+
+	UPROPERTY(EditAnywhere)
+	float RecentMovementBufferDuration = 3.3f;
+
+	UPROPERTY(EditAnywhere)
+	float PutDownMovementBacktrackDuration = 1.5f;
+
+	UPROPERTY(EditAnywhere)
+	float MinPutDownHeight = 2.f;
+
+	UPROPERTY(EditAnywhere)
+	float MaxPutDownHeight = 8.f;
+
+	UPROPERTY(EditAnywhere)
+	float MaxPutDownDistXY = 9.f;
+};
+
 /** Notify the beginning and the end of the pick and place related events */
 DECLARE_MULTICAST_DELEGATE_FourParams(FSLPaPSubEventSignature, const FSLEntity& /*Self*/, AActor* /*Other*/, float /*StartTime*/, float /*EndTime*/);
 
@@ -76,6 +127,12 @@ public:
 	// Get finished state
 	bool IsFinished() const { return bIsFinished; };
 
+	// Get the state check thresholds
+	const FSLPaPThresholds& GetThresholds() const { return Thresholds; };
+
+	// Set the state check thresholds (before init)
+	void SetThresholds(const FSLPaPThresholds& InThresholds) { Thresholds = InThresholds; };
+
 private:
 	// Subscribe to grasp events from sibling
 	bool SubscribeForGraspEvents();
@@ -89,14 +146,17 @@ private:
 	// Called on grasp end
 	void OnSLGraspEnd(const FSLEntity& Self, AActor* Other, float Time);
 
-	// Update callback
-	void Update();
+	// Spatial query callback with the grasped object location
+	void Update(const FVector& OriginLocation, const TArray<FSLSpatialQueryHit>& Hits, float Time);
 
 	// Object released, terminate active even
 	void FinishActiveEvent(float CurrTime);
 
-	// Backtrace and check if a put-down event happened
-	bool HasPutDownEventHappened(const float CurrTime,const FVector& CurrObjLocation,  uint32& OutPutDownEndIdx);
+	// Displacement of the grasped object since the previous relevant time (from the history while it still holds that time)
+	FVector GetDisplacementSincePrevRelevant() const;
+
+	// Backtrace the transport movement and check if a put-down event happened (outputs the history index of the put-down end)
+	bool HasPutDownEventHappened(const float CurrTime, const FVector& CurrObjLocation, int32& OutPutDownEndIdx) const;
 
 	// State update functions
 	void Update_NONE();
@@ -143,8 +203,8 @@ private:
 	// Contact shape of the grasped object, holds information if the object is supported by a surface
 	ISLContactShapeInterface* GraspedObjectContactShape;
 	
-	// Update timer handle
-	FTimerHandle UpdateTimerHandle;
+	// Handle of the grasped object sampling query of the spatial query manager (active while grasping)
+	int32 SpatialQueryHandle;
 
 	/* Update function bindings */
 	// Function pointer type for calling the correct update function
@@ -160,29 +220,12 @@ private:
 	// The location where the object was started to be lifted (use this to compare against MaxPickUpDistXY and MaxPickUpHeight)
 	FVector LiftOffLocation;
 
-	/* PutDown related */
-	// Past locations and time during transport in order to backtrace and detect put-down events
-	TArray<TPair<float, FVector>> RecentMovementBuffer;
+	/* Movement history */
+	// Recent locations and times of the grasped object, sampled once per update and queried by the state checks
+	FSLMotionHistory RecentMovementBuffer;
 
-	/* Constants */
-	constexpr static float UpdateRate = 0.05f;
-
-	// Slide
-	constexpr static float MinSlideDistXY = 9.f;
-	constexpr static float MinSlideDuration = 0.9f;
-	
-	// PickUp
-	constexpr static float MaxPickUpDistXY = 9.f;
-	constexpr static float MinPickUpHeight = 3.f;
-	constexpr static float MaxPickUpHeight = 12.f;
-
-	// PutDown
-	constexpr static int32 RecentMovementBufferSize = 256;
-	constexpr static float RecentMovementBufferDuration = 3.3f;
-	constexpr static float PutDownMovementBacktrackDuration = 1.5f;
-	constexpr static float MinPutDownHeight = 2.f;
-
-	constexpr static float MaxPutDownHeight = 8.f;
-	constexpr static float MaxPutDownDistXY = 9.f;
+	// Thresholds of the state checks (editable per instance, overridable by the event replay)
+	UPROPERTY(EditAnywhere, Category = "Semantic Logger")
+	FSLPaPThresholds Thresholds;
 };
 
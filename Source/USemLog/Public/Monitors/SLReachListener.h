@@ -7,27 +7,9 @@
 #include "Components/SphereComponent.h"
 #include "SLStructs.h"
 #include "Engine/StaticMeshActor.h"
+#include "Monitors/SLSpatialQueryManager.h"
 #include "SLReachListener.generated.h"
 
-/**
- * PreGrasp event end data
- */
-struct FSLPreGraspEndEvent
-{
-	// Default ctor
-	FSLPreGraspEndEvent() = default;
-
-	// Init ctor
-	FSLPreGraspEndEvent(AStaticMeshActor* InOther, float InTime) :
-		Other(InOther), Time(InTime) {};
-
-	// Other actor
-	AStaticMeshActor* Other;
-
-	// End time of the event 
-	float Time;
-};
-
 // Convenience enum
 enum ESLTimeAndDist
 {
@@ -94,8 +76,8 @@ private:
 	// Subscribe for grasp event from sibling component
 	bool SubscribeForManipulatorEvents();
 	
-	// Update callback, checks distance to hand, if it increases it resets the start time
-	void ReachUpdate();
+	// Spatial query callback, checks distance to hand, if it increases it resets the start time
+	void ReachUpdate(const FVector& OriginLocation, const TArray<FSLSpatialQueryHit>& Hits, float Time);
 
 	// Publish currently overlapping components
 	void TriggerInitialOverlaps();
@@ -131,10 +113,10 @@ private:
 	// Manipulator is not in contact with object anymore, check for possible concatenation, or reset the potential reach time
 	void OnSLManipulatorContactEnd(const FSLEntity& Self, const FSLEntity& Other, float Time);
 	
-	// Delayed call of sending the finished event to check for possible concatenation of jittering events of the same type
-	void DelayedManipulatorContactEndEventCallback();
+	// Delayed call of resetting the reach time, called if no concatenation of the jittering contact happened
+	void DelayedManipulatorContactEndEventCallback(AStaticMeshActor* Other, float EndTime);
 
-	// Check if this begin event happened right after the previous one ended, if so remove it from the array, and cancel publishing the begin event
+	// Check if this begin event happened right after the previous one ended, if so cancel the pending end and skip the begin event
 	bool SkipRecentManipulatorContactEndEventTime(AStaticMeshActor* Other, float StartTime);
 
 public:
@@ -154,8 +136,8 @@ private:
 	// Shows if the begin / end overlap callbacks are bound (avoid adding the same callback twice--crash)
 	bool bCallbacksAreBound;
 
-	// Timer handle for the update rate
-	FTimerHandle UpdateTimerHandle;
+	// Handle of the candidates distance query of the spatial query manager
+	int32 SpatialQueryHandle;
 
 	// Semantic data of the owner
 	FSLEntity SemanticOwner;
@@ -169,12 +151,6 @@ private:
 	// Pause everything if the hand is currently grasping something
 	AActor* CurrGraspedObj;
 
-	// Send finished events with a delay to check for possible concatenation of equal and consecutive events with small time gaps in between
-	FTimerHandle ManipulatorContactDelayTimerHandle;
-
-	// Array of recently ended events
-	TArray<FSLPreGraspEndEvent> RecentlyEndedManipulatorContactEvents;
-	
 	/* Constants */
 	constexpr static float MinDist = 2.5f;
 	constexpr static float UpdateRate = 0.27f;
@@ -0,0 +1,222 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "Components/SceneComponent.h"
+
+/**
+ * Relative movement of an entity with respect to the query origin
+ */
+enum class ESLDistanceTrend : uint8
+{
+	Idle,
+	Closer,
+	Further
+};
+
+/**
+ * Entity found by a spatial query
+ */
+struct FSLSpatialQueryHit
+{
+	// Default ctor
+	FSLSpatialQueryHit() = default;
+
+	// Init ctor
+	FSLSpatialQueryHit(AActor* InEntity, float InDistance, ESLDistanceTrend InTrend) :
+		Entity(InEntity), Distance(InDistance), Trend(InTrend) {};
+
+	// The entity
+	AActor* Entity;
+
+	// Distance to the query origin
+	float Distance;
+
+	// Movement relative to the origin since the last significant distance change
+	ESLDistanceTrend Trend;
+};
+
+/** Delegate to notify the results of a spatial query */
+DECLARE_DELEGATE_ThreeParams(FSLSpatialQueryResultSignature, const FVector& /*OriginLocation*/, const TArray<FSLSpatialQueryHit>& /*Hits*/, float /*Time*/);
+
+/**
+ * Singleton answering the proximity queries of the listeners in one batch per tick,
+ * the semantic entities are stored in a uniform hash grid, only the entities which reported a move are re-bucketed;
+ * a query returns the location of its origin, the entities within its radius, and the distances and trends of its tracked entities
+ */
+class USEMLOG_API FSLSpatialQueryManager : public FTickableGameObject
+{
+private:
+	// Constructor
+	FSLSpatialQueryManager();
+
+public:
+	// Destructor, unbinds from the moving entities
+	~FSLSpatialQueryManager();
+
+	// Get singleton
+	static FSLSpatialQueryManager* GetInstance();
+
+	// Delete instance
+	static void DeleteInstance();
+
+	// Init with the world, adds the semantic entities to the grid
+	void Init(UWorld* InWorld);
+
+	// Check if the manager is init
+	bool IsInit() const { return bIsInit; }
+
+	// Add a query around the component, returns its handle (INDEX_NONE if the manager is not init),
+	// the radius can be zero if only the origin location or the tracked entities are of interest
+	int32 AddQuery(USceneComponent* InOrigin, float InRadius, float InMinTrendDist, float InUpdateRate,
+		const FSLSpatialQueryResultSignature& InOnResult);
+
+	// Remove the query
+	void RemoveQuery(int32 QueryHandle);
+
+	// Pause or resume the updates of the query
+	void SetQueryPaused(int32 QueryHandle, bool bPaused);
+
+	// Track the distance of the entity to the query origin (starts from the current distance)
+	void TrackEntity(int32 QueryHandle, AActor* InEntity);
+
+	// Stop tracking the entity
+	void UntrackEntity(int32 QueryHandle, AActor* InEntity);
+
+	// Stop tracking all the entities of the query
+	void UntrackAllEntities(int32 QueryHandle);
+
+	/** Begin FTickableGameObject interface */
+	// Called after ticking all actors, DeltaTime is the time passed since the last call.
+	virtual void Tick(float DeltaTime) override;
+
+	// Return if object is ready to be ticked
+	virtual bool IsTickable() const override;
+
+	// Return the world the manager is ticked with (ticked by the world tick, also when the world is ticked manually)
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	// Return the stat id to use for this tickable
+	virtual TStatId GetStatId() const override;
+	/** End FTickableGameObject interface */
+
+private:
+	/**
+	 * Entity stored in the grid
+	 */
+	struct FSLGridEntity
+	{
+		// The entity actor (can be destroyed during the episode)
+		TWeakObjectPtr<AActor> Actor;
+
+		// Last known location
+		FVector Location;
+
+		// Radius of the entity bounds around its location
+		float Radius;
+
+		// Cell the entity is bucketed in (unused for the large entities)
+		FIntVector Cell;
+
+		// Entities larger than a cell are checked by every radius query instead of being bucketed
+		bool bIsLarge;
+
+		// Move notification binding of the root component (movable entities only)
+		FDelegateHandle TransformUpdatedHandle;
+	};
+
+	/**
+	 * Registered proximity query
+	 */
+	struct FSLSpatialQuery
+	{
+		// The query origin
+		TWeakObjectPtr<USceneComponent> Origin;
+
+		// Entities within the radius are returned (zero for the origin location and the tracked entities only)
+		float Radius;
+
+		// Distance changes smaller than this are considered idle
+		float MinTrendDist;
+
+		// Time between the updates
+		float UpdateRate;
+
+		// Time passed since the last update
+		float TimeSinceLastUpdate;
+
+		// Paused queries are not updated
+		bool bIsPaused;
+
+		// Reference distances of the tracked and in radius entities (updated on significant changes)
+		TMap<TWeakObjectPtr<AActor>, float> RefDistances;
+
+		// Explicitly tracked entities
+		TSet<TWeakObjectPtr<AActor>> TrackedEntities;
+
+		// Called with the results
+		FSLSpatialQueryResultSignature OnResult;
+	};
+
+	// Called by the root component of a movable entity when its transform changes
+	void OnEntityMoved(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags,
+		ETeleportType Teleport, int32 EntityIdx);
+
+	// Re-bucket the moved entities
+	void UpdateGrid();
+
+	// Run the query, output the hits
+	void RunQuery(FSLSpatialQuery& Query, const FVector& Origin, TArray<FSLSpatialQueryHit>& OutHits) const;
+
+	// Add the entity to the hits if it is within the radius of the query
+	void TestEntity(FSLSpatialQuery& Query, const FVector& Origin, const FSLGridEntity& Entity,
+		TSet<AActor*>& OutInRadius, TArray<FSLSpatialQueryHit>& OutHits) const;
+
+	// Get the location of the entity (the cached one if it is in the grid)
+	FVector GetEntityLocation(AActor* InEntity) const;
+
+	// Compute the trend against the reference distance, updates the reference on significant changes
+	static ESLDistanceTrend UpdateTrend(float& RefDistance, float CurrDistance, float MinTrendDist);
+
+	// Get the cell of the location
+	FORCEINLINE FIntVector GetCell(const FVector& Location) const
+	{
+		return FIntVector(FMath::FloorToInt(Location.X / CellSize),
+			FMath::FloorToInt(Location.Y / CellSize),
+			FMath::FloorToInt(Location.Z / CellSize));
+	}
+
+private:
+	// Instance of the singleton
+	static TSharedPtr<FSLSpatialQueryManager> StaticInstance;
+
+	// Flag showing the manager has been init
+	bool bIsInit;
+
+	// Pointer to the world
+	UWorld* World;
+
+	// The semantic entities
+	TArray<FSLGridEntity> Entities;
+
+	// Quick access from the actor to its entity index
+	TMap<const AActor*, int32> ActorToEntityIdx;
+
+	// Grid cells with the indexes of the entities inside them
+	TMap<FIntVector, TArray<int32>> Cells;
+
+	// Indexes of the entities larger than a cell
+	TArray<int32> LargeEntities;
+
+	// Indexes of the entities which moved since the last grid update
+	TSet<int32> MovedEntities;
+
+	// The registered queries
+	TSparseArray<FSLSpatialQuery> Queries;
+
+	/* Constants */
+	constexpr static float CellSize = 50.f;
+};
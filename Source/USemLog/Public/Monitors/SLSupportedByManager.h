@@ -0,0 +1,116 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "SLStructs.h"
+
+// Forward declaration
+class ISLContactShapeInterface;
+
+/**
+ * Singleton evaluating the supported by candidates of all the contact shapes in one batched update,
+ * the contact shapes register their candidate pairs, the results are broadcasted through the shapes delegates;
+ * there is no separate sleep list for idle pairs: an idle pair has no relative vertical speed and is resolved
+ * (removed) in the next update, only sleeping rigid bodies skip the velocity query, and the manager itself
+ * stops ticking while there are no candidates
+ */
+class USEMLOG_API FSLSupportedByManager : public FTickableGameObject
+{
+private:
+	// Constructor
+	FSLSupportedByManager();
+
+public:
+	// Destructor
+	~FSLSupportedByManager() = default;
+
+	// Get singleton
+	static FSLSupportedByManager* GetInstance();
+
+	// Delete instance
+	static void DeleteInstance();
+
+	// Init with the world
+	void Init(UWorld* InWorld);
+
+	// Check if the manager is init
+	bool IsInit() const { return bIsInit; }
+
+	// Add a supported by candidate of the shape (Self is the owner of the shape)
+	void AddCandidate(ISLContactShapeInterface* InShape, const FSLContactResult& InCandidate);
+
+	// Remove the candidate of the shape, return false if the pair is not a candidate
+	bool RemoveCandidate(ISLContactShapeInterface* InShape, UObject* InOther);
+
+	// Remove all the candidates of the shape
+	void RemoveCandidates(ISLContactShapeInterface* InShape);
+
+	// Get the number of registered candidates
+	int32 NumCandidates() const { return CandidateShapes.Num(); }
+
+	/** Begin FTickableGameObject interface */
+	// Called after ticking all actors, DeltaTime is the time passed since the last call.
+	virtual void Tick(float DeltaTime) override;
+
+	// Return if object is ready to be ticked
+	virtual bool IsTickable() const override;
+
+	// Return the world the manager is ticked with (ticked by the world tick, also when the world is ticked manually)
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	// Return the stat id to use for this tickable
+	virtual TStatId GetStatId() const override;
+	/** End FTickableGameObject interface */
+
+private:
+	// Evaluate all the candidates in one batch
+	void Update();
+
+	// Read the velocities and heights of the candidates
+	void GatherCandidatesData();
+
+	// Remove candidate at the given index (swaps with the last one)
+	void RemoveCandidateAt(int32 Index);
+
+private:
+	// Instance of the singleton
+	static TSharedPtr<FSLSupportedByManager> StaticInstance;
+
+	// Flag showing the manager has been init
+	bool bIsInit;
+
+	// Pointer to the world
+	UWorld* World;
+
+	// Time passed since the last evaluation
+	float TimeSinceLastUpdate;
+
+	/* Candidates, structure of arrays (all arrays share the same index) */
+	// The shapes the candidates belong to (the results are broadcasted through them)
+	TArray<ISLContactShapeInterface*> CandidateShapes;
+
+	// The contact data of the candidates
+	TArray<FSLContactResult> CandidateResults;
+
+	// Vertical velocities of the self (shape owner) mesh components
+	TArray<float> SelfVelZ;
+
+	// Vertical velocities of the other mesh components
+	TArray<float> OtherVelZ;
+
+	// Heights of the self mesh components
+	TArray<float> SelfZ;
+
+	// Heights of the other mesh components
+	TArray<float> OtherZ;
+
+	// Validity of the candidates (the mesh components can be destroyed)
+	TArray<bool> bIsCandidateValid;
+
+	/* Constants */
+	constexpr static float UpdateRate = 0.11f;
+	constexpr static float MaxVertSpeed = 0.5f;
+};
@@ -0,0 +1,142 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SLOwlExperiment.h"
+#include "SLEventReplayCommandlet.generated.h"
+
+// Forward declarations
+struct FSLWorldStateFrame;
+class FSLEventIndex;
+
+/**
+ * Headless re-detection of the semantic events from the recorded world state,
+ * the poses are replayed kinematically as fast as possible and a new events (_ED.owl) file is written
+ *
+ * UE4Editor-Cmd.exe <Project>.uproject -run=SLEventReplay -Map=/Game/Maps/Kitchen -TaskId=<TaskId>
+ *     -Episodes=<EpisodeId>[+<EpisodeId>..] [-Workers=N] [-Source=Mongo|Json] [-ServerIp=127.0.0.1] [-ServerPort=27017]
+ *     [-MaxStep=0.033] [-Template=Default|IAI] [-NoContacts] [-NoSupportedBy] [-NoGrasps] [-NoPickAndPlace]
+ *     [-Slicing] [-Timelines] [-Broadphase] [-PaP<Threshold>=<Value>..] (e.g. -PaPMinSlideDistXY=12)
+ *     [-WorkerTimeout=<Seconds>] [-Check] [-CheckTolerance=0.1]
+ *
+ * The grasp trigger input is not part of the recorded world state, the grasps are detected from the replayed finger bones only;
+ * with -Check the number of events of each type is compared with the live log (its index is kept as <EpisodeId>_EI.live.bin),
+ * the episode fails if any type differs by more than the tolerance (fraction of the live count)
+ */
+UCLASS()
+class USEMLOG_API USLEventReplayCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	// Ctor
+	USLEventReplayCommandlet();
+
+	// Commandlet entry point
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	// Run one worker process per episode (at most NumWorkers at the same time), returns the number of failed episodes
+	int32 RunWorkers(const TArray<FString>& Episodes, int32 NumWorkers, const TArray<FString>& Switches) const;
+
+	// Replay the episode in the map and write its events, returns true on success
+	bool ReplayEpisode(const FString& EpisodeId);
+
+	// Load the map as a game world without any semantic logging manager
+	UWorld* LoadReplayWorld();
+
+	// Tear down the replay world and the semantic logging singletons
+	void UnloadReplayWorld(UWorld* World) const;
+
+	// Apply the command line overrides to the monitors of the world (before the event logger inits them)
+	void ApplyMonitorOverrides(UWorld* World) const;
+
+	// Set the world clock without ticking (the replay starts at the first recorded entry)
+	void SetWorldTime(UWorld* World, float Time) const;
+
+	// Move the recorded entities and bones, advance the world time until the next frame
+	void ReplayFrames(UWorld* World, const TArray<FSLWorldStateFrame>& Frames) const;
+
+	// Teleport the component to the recorded pose, the velocity is derived from its previous location (kinematic moves do not set it)
+	void MoveComponent(USceneComponent* SceneComp, const FTransform& Pose, float DeltaTime) const;
+
+	// Set the velocity of the component and of its attached children
+	void SetComponentVelocity(USceneComponent* SceneComp, const FVector& Velocity) const;
+
+	// Tick until the pending (delayed) events of the monitors are published, returns false if the max duration was reached
+	bool DrainPendingEvents(UWorld* World) const;
+
+	// True if any monitor still holds delayed events
+	bool HasPendingEvents(UWorld* World) const;
+
+	// Tick the world (the managers are ticked with it)
+	void TickWorld(UWorld* World, float DeltaSeconds) const;
+
+	// Load the events index of the live episode, it is copied aside the first time since the replay overwrites it
+	bool LoadLiveIndex(const FString& EpisodeId, FSLEventIndex& OutIndex) const;
+
+	// Compare the number of events of each type of the replay with the live episode, returns false on mismatch
+	bool CheckEventCounts(const FString& EpisodeId, const FSLEventIndex& LiveIndex) const;
+
+private:
+	// Map package to load (e.g. /Game/Maps/Kitchen)
+	FString MapName;
+
+	// Task id (database / log directory)
+	FString TaskId;
+
+	// Command line of the commandlet (monitor overrides are read from it)
+	FString CmdLineParams;
+
+	// Read the world state from the json files instead of mongo
+	bool bFromJson;
+
+	// Mongo server ip
+	FString ServerIp;
+
+	// Mongo server port
+	uint16 ServerPort;
+
+	// Max simulated step between the recorded entries (timers and update rates of the monitors are sampled at this rate)
+	float MaxStep;
+
+	// Events owl document template
+	ESLOwlExperimentTemplate ExperimentTemplateType;
+
+	// Detect contact events
+	bool bLogContactEvents;
+
+	// Detect supported by events
+	bool bLogSupportedByEvents;
+
+	// Detect grasp events
+	bool bLogGraspEvents;
+
+	// Detect pick and place events
+	bool bLogPickAndPlaceEvents;
+
+	// Detect slicing events
+	bool bLogSlicingEvents;
+
+	// Write the events timelines as well
+	bool bWriteTimelines;
+
+	// Use the sort and sweep broadphase for the contact shapes
+	bool bUseContactBroadphase;
+
+	// Worker processes running longer than this are killed (seconds, 0 for no limit)
+	float WorkerTimeout;
+
+	// Compare the replayed events with the live ones
+	bool bCheckEvents;
+
+	// Allowed difference of the number of events of a type (fraction of the live count)
+	float CheckTolerance;
+
+	/* Constants */
+	// Max simulated time after the last entry for the pending events to be published
+	constexpr static float MaxDrainDuration = 10.f;
+};
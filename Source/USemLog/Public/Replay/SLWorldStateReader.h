@@ -0,0 +1,53 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+* Recorded skeletal entity pose with its bone poses (unreal coordinates)
+*/
+struct FSLWorldStateSkeletalPose
+{
+	// Entity id
+	FString Id;
+
+	// World pose of the skeletal data component
+	FTransform Pose;
+
+	// Bone names and their world poses
+	TArray<TPair<FName, FTransform>> BonePoses;
+};
+
+/**
+* Recorded world state entry (the entities which moved since the previous entry)
+*/
+struct FSLWorldStateFrame
+{
+	// Entry timestamp
+	float Timestamp;
+
+	// Entity ids and their world poses (unreal coordinates)
+	TArray<TPair<FString, FTransform>> Poses;
+
+	// Skeletal entities which moved since the previous entry
+	TArray<FSLWorldStateSkeletalPose> SkeletalPoses;
+
+	// Default ctor
+	FSLWorldStateFrame() : Timestamp(0.f) {};
+};
+
+/**
+ * Reads the recorded world state of an episode (mongo collection or json file) as time ordered frames
+ */
+class USEMLOG_API FSLWorldStateReader
+{
+public:
+	// Read the episode from the mongo collection (database is the task id, collection the episode id)
+	static bool ReadFromMongo(const FString& TaskId, const FString& EpisodeId,
+		const FString& ServerIp, uint16 ServerPort, TArray<FSLWorldStateFrame>& OutFrames);
+
+	// Read the episode from the json world state file (SemLog/<TaskId>/Episodes/<EpisodeId>_WS.json)
+	static bool ReadFromJsonFile(const FString& TaskId, const FString& EpisodeId, TArray<FSLWorldStateFrame>& OutFrames);
+};
@@ -0,0 +1,117 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Singleton storing the articulation graph of the world actors (attachments, physics constraints, containers),
+ * built once at init; the attachment edges are only re-synced by an explicit refresh (the queries have no side effects),
+ * the transitive queries (constrained actors, containers) are cached per attachment root until a refresh finds a change
+ */
+class USEMLOG_API FSLArticulationGraph
+{
+private:
+	// Constructor
+	FSLArticulationGraph();
+
+public:
+	// Destructor
+	~FSLArticulationGraph();
+
+	// Get singleton
+	static FSLArticulationGraph* GetInstance();
+
+	// Delete instance
+	static void DeleteInstance();
+
+	// Build the graph of the world (no-op if it is already built for the world)
+	void Init(UWorld* InWorld);
+
+	// Re-build the graph of the world (e.g. the tags or the attachments changed in the editor)
+	void Rebuild(UWorld* InWorld);
+
+	// Check if the graph is built
+	bool IsInit() const { return bIsInit; }
+
+	// Re-sync the attachment edges of all the actors (attaches and detaches), clears the cached results if anything changed
+	void Refresh();
+
+	// Re-sync the attachment parent of the actor and of the actors attached to it (detaches), clears the cached results if anything changed
+	void RefreshActor(AActor* Actor);
+
+	// Re-sync the attachment parents of the actor ancestors and of its root hierarchy, clears the cached results if anything changed
+	void RefreshHierarchy(AActor* Actor);
+
+	// Get the attachment parent of the actor (nullptr if none)
+	AActor* GetAttachParent(AActor* Actor) const;
+
+	// Get the actors directly attached to the actor
+	const TArray<AActor*>& GetAttachedActors(AActor* Actor) const;
+
+	// Get the outermost attachment parent of the actor (the actor itself if it is not attached)
+	AActor* GetAttachmentRoot(AActor* Actor) const;
+
+	// Get the actors constrained to the attachment hierarchy of the root (the root's hierarchy is excluded), cached (valid until the next query or refresh)
+	const TSet<AActor*>& GetConstrainedActors(AActor* Root);
+
+	// Get the containers in the attachment hierarchy of the root (including the root), cached (valid until the next query or refresh)
+	const TSet<AActor*>& GetContainers(AActor* Root);
+
+	// Get the semantic id of the actor (empty if the actor has no id and class)
+	FString GetSemanticId(AActor* Actor) const;
+
+private:
+	// Add the actor with its edges
+	void AddActor(AActor* Actor);
+
+	// Sync the attachment parent of the actor, returns true if it changed
+	bool SyncAttachParent(AActor* Actor);
+
+	// Collect the attachment hierarchy of the root (including the root)
+	void GetAttachmentHierarchy(AActor* Root, TArray<AActor*>& OutActors) const;
+
+	// Called when an actor is spawned in the world
+	void OnActorSpawned(AActor* Actor);
+
+	// Remove the graph data
+	void Reset();
+
+private:
+	// Instance of the singleton
+	static TSharedPtr<FSLArticulationGraph> StaticInstance;
+
+	// True if the graph is built
+	bool bIsInit;
+
+	// The world of the graph
+	TWeakObjectPtr<UWorld> World;
+
+	// Actor spawn notification handle
+	FDelegateHandle ActorSpawnedHandle;
+
+	// All the actors of the graph (re-synced on refresh)
+	TArray<TWeakObjectPtr<AActor>> Actors;
+
+	// Attachment parent of the actors
+	TMap<AActor*, AActor*> AttachParent;
+
+	// Actors directly attached to the actors
+	TMap<AActor*, TArray<AActor*>> AttachChildren;
+
+	// Actors linked through physics constraints (both directions)
+	TMap<AActor*, TArray<AActor*>> ConstraintNeighbours;
+
+	// Actors tagged as containers
+	TSet<AActor*> ContainerActors;
+
+	// Semantic ids of the annotated actors (id and class)
+	TMap<AActor*, FString> SemanticIds;
+
+	// Cached constrained actors per attachment root (cleared when a refresh finds an attachment change)
+	TMap<AActor*, TSet<AActor*>> ConstrainedActorsCache;
+
+	// Cached containers per attachment root (cleared when a refresh finds an attachment change)
+	TMap<AActor*, TSet<AActor*>> ContainersCache;
+};
@@ -139,6 +139,12 @@ public:
 		return IdToVisionCamera.GenerateValueArray(OutArray);
 	}
 
+	// Get all the virtual camera actors
+	const TMap<FString, ASLVisionCamera*>* GetIdToVisionCameraMap() const
+	{
+		return &IdToVisionCamera;
+	}
+
 
 	// Get skeletal mesh actor
 	FORCEINLINE ASkeletalMeshActor* GetSkeletalMeshActor(const FString& Id) const 
@@ -230,6 +230,10 @@ private:
 	// Listen for supported by events
 	UPROPERTY(EditAnywhere, Category = "Semantic Logger|Event Data Logger", meta = (editcondition = "bLogEventData"))
 	bool bLogSupportedByEvents;
+
+	// Compute the contacts between the contact shapes with the sort and sweep broadphase (the overlap events cover the rest)
+	UPROPERTY(EditAnywhere, Category = "Semantic Logger|Event Data Logger", meta = (editcondition = "bLogEventData"))
+	bool bUseContactBroadphase;
 	
 	// Listen for grasping events
 	UPROPERTY(EditAnywhere, Category = "Semantic Logger|Event Data Logger", meta = (editcondition = "bLogEventData"))
@@ -255,6 +259,10 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Semantic Logger|Event Data Logger", meta = (editcondition = "bLogEventData"))
 	ESLOwlExperimentTemplate ExperimentTemplateType;
 
+	// Output format of the events document (rdf/xml, n-triples or turtle)
+	UPROPERTY(EditAnywhere, Category = "Semantic Logger|Event Data Logger", meta = (editcondition = "bLogEventData"))
+	ESLOwlDocFormat EventsDocFormat;
+
 	// Event data logger, use UPROPERTY to avoid GC
 	UPROPERTY()
 	USLEventLogger* EventDataLogger;
@@ -283,6 +291,50 @@ private:
 	// Make screenshots for calculating overlaps smaller for faster logging
 	UPROPERTY(EditAnywhere, Category = "Semantic Logger|Vision Data Logger", meta = (editcondition = "bLogVisionData"))
 	uint8 OverlapResolutionDivisor;
+
+	// Calculate the overlaps from per entity screenshots, with the software rasterizer (no rendering), or both for validation
+	UPROPERTY(EditAnywhere, Category = "Semantic Logger|Vision Data Logger", meta = (editcondition = "bLogVisionData"))
+	ESLVisionOverlapMethod OverlapMethod;
+
+	// Recalculate the overlaps only for the entities whose screen footprint could have changed since the previous frame
+	UPROPERTY(EditAnywhere, Category = "Semantic Logger|Vision Data Logger", meta = (editcondition = "bLogVisionData"))
+	bool bReuseOverlaps;
+
+	// Views whose camera and frustum contents did not change reference their previous images instead of being rendered
+	UPROPERTY(EditAnywhere, Category = "Semantic Logger|Vision Data Logger", meta = (editcondition = "bLogVisionData"))
+	bool bSkipUnchangedViews;
+
+	// Rendered mask colors within this tolerance (sum of the channel differences) are restored to the closest mask color
+	UPROPERTY(EditAnywhere, Category = "Semantic Logger|Vision Data Logger", meta = (editcondition = "bLogVisionData"))
+	uint8 MaskColorTolerance;
+
+	// Number of image compression workers (0 - compress on the game thread before the next screenshot)
+	UPROPERTY(EditAnywhere, Category = "Semantic Logger|Vision Data Logger", meta = (editcondition = "bLogVisionData"), meta = (ClampMin = 0))
+	int32 VisionImageWorkers;
+
+	// Max memory (MB) of the raw images waiting for compression, the screenshots wait if it is exceeded
+	UPROPERTY(EditAnywhere, Category = "Semantic Logger|Vision Data Logger", meta = (editcondition = "bLogVisionData"), meta = (ClampMin = 1))
+	int32 VisionMaxInFlightImagesMB;
+
+	// Store the mask images with a palette and run-length encoding (FSLVisionMaskCodec) instead of png
+	UPROPERTY(EditAnywhere, Category = "Semantic Logger|Vision Data Logger", meta = (editcondition = "bLogVisionData"))
+	bool bEncodeVisionMasks;
+
+	// Episode seconds loaded from the database ahead of the rendered frame
+	UPROPERTY(EditAnywhere, Category = "Semantic Logger|Vision Data Logger", meta = (editcondition = "bLogVisionData"), meta = (ClampMin = 0))
+	float VisionPrefetchSeconds;
+
+	// Max number of episode frames loaded ahead of the rendered frame
+	UPROPERTY(EditAnywhere, Category = "Semantic Logger|Vision Data Logger", meta = (editcondition = "bLogVisionData"), meta = (ClampMin = 2))
+	int32 VisionMaxBufferedFrames;
+
+	// Replay only this timestamp range shard of the episode into a staging collection (-1 - the whole episode, -SLVisionShard=)
+	UPROPERTY(EditAnywhere, Category = "Semantic Logger|Vision Data Logger", meta = (editcondition = "bLogVisionData"), meta = (ClampMin = -1))
+	int32 VisionShardIdx;
+
+	// Number of shards the episode is split into (-SLVisionShards=)
+	UPROPERTY(EditAnywhere, Category = "Semantic Logger|Vision Data Logger", meta = (editcondition = "bLogVisionData"), meta = (ClampMin = 1))
+	int32 VisionNumShards;
 	
 	// Update rate of the vision logger (0 - updates at every available frame)
 	UPROPERTY(EditAnywhere, Category = "Semantic Logger|Vision Data Logger", meta = (editcondition = "bLogVisionData"), meta = (ClampMin = 0))
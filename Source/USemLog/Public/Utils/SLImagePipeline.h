@@ -0,0 +1,121 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeBool.h"
+
+// Forward declaration
+class FQueuedThreadPool;
+
+/**
+* Image compression job, the bitmap is released and the png is available once the job is done
+*/
+struct USEMLOG_API FSLImageJob
+{
+	// Image size
+	int32 SizeX = 0;
+	int32 SizeY = 0;
+
+	// Raw image (released after the compression)
+	TArray<FColor> Bitmap;
+
+	// Compressed png image
+	TArray<uint8> CompressedBitmap;
+
+	// If not empty the png is saved to this path as well
+	FString SavePath;
+
+	// Set by the worker after the compression and save
+	FThreadSafeBool bIsDone;
+
+	// Compress the bitmap and save it if required
+	void Run();
+};
+
+/**
+ * Bounded asynchronous image pipeline, the screenshot callbacks hand over their bitmaps and continue with
+ * the next render while the workers compress (and save) them; ordered tasks (e.g. database writes)
+ * run one at a time after every image and task added before them is done;
+ * adding images blocks while the raw bitmaps in flight exceed the memory cap;
+ * without workers everything runs synchronously on the calling thread
+ */
+class USEMLOG_API FSLImagePipeline
+{
+public:
+	// Ctor
+	FSLImagePipeline();
+
+	// Dtor
+	~FSLImagePipeline();
+
+	// Create the workers
+	void Init(int32 InNumWorkers = 2, int32 InMaxInFlightMB = 512);
+
+	// Check if the pipeline is init
+	bool IsInit() const { return bIsInit; };
+
+	// Queue the image compression (and save), the result is in the job once it is done
+	TSharedRef<FSLImageJob, ESPMode::ThreadSafe> AddImage(int32 SizeX, int32 SizeY, TArray<FColor>&& Bitmap,
+		const FString& SavePath = FString());
+
+	// Run the task after all the previously added images and tasks are done (tasks run in order, one at a time)
+	void AddOrderedTask(TFunction<void()>&& Task);
+
+	// Wait until all the images and tasks are done
+	void Flush();
+
+	// Finish the pending work and stop the workers
+	void Shutdown();
+
+	// Called by the workers when a job is done
+	void OnJobDone(FSLImageJob& Job);
+
+	// Run the tasks which have all their previous images done
+	void Drain();
+
+private:
+	/**
+	* Pipeline entry, an image job or an ordered task
+	*/
+	struct FSLImagePipelineEntry
+	{
+		// Image job
+		TSharedPtr<FSLImageJob, ESPMode::ThreadSafe> Job;
+
+		// Ordered task
+		TFunction<void()> Task;
+	};
+
+private:
+	// Init flag
+	bool bIsInit;
+
+	// Workers
+	FQueuedThreadPool* ThreadPool;
+
+	// Max raw image bytes in flight
+	int64 MaxInFlightBytes;
+
+	// Raw image bytes in flight
+	int64 InFlightBytes;
+
+	// Signaled when the in flight memory decreases
+	FEvent* MemoryEvent;
+
+	// Guards the entries and the flags
+	FCriticalSection Lock;
+
+	// Entries in the order they were added
+	TArray<FSLImagePipelineEntry> Entries;
+
+	// Index of the first pending entry
+	int32 FirstEntryIdx;
+
+	// A worker is running the ordered tasks
+	bool bIsDraining;
+
+	// A drain was requested while draining
+	bool bDrainAgain;
+};
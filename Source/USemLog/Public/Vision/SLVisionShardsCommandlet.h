@@ -0,0 +1,62 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SLVisionShardsCommandlet.generated.h"
+
+/**
+ * Splits the vision logging of an episode into equal timestamp ranges replayed by parallel game processes,
+ * every shard writes to its own staging collection (<EpisodeId>.vis.shard<N>) and its state to <EpisodeId>.vis.shards,
+ * once all the shards are finished they are merged into the vision collection of the episode (<EpisodeId>.vis);
+ * the map needs a semantic logging manager set up for vision logging, failed shards can be re-run alone with -Only=
+ *
+ * UE4Editor-Cmd.exe <Project>.uproject -run=SLVisionShards -Map=/Game/Maps/Kitchen -TaskId=<TaskId> -EpisodeId=<EpisodeId>
+ *     -Shards=N [-Workers=N] [-Only=<Shard>[+<Shard>..]] [-MergeOnly] [-NoMerge] [-ServerIp=127.0.0.1] [-ServerPort=27017]
+ *     [-ShardTimeout=<Seconds>]
+ *
+ * Returns the number of shard processes which failed (or were killed on timeout), or the number of unfinished shards if larger
+ */
+UCLASS()
+class USEMLOG_API USLVisionShardsCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	// Ctor
+	USLVisionShardsCommandlet();
+
+	// Commandlet entry point
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	// Run one game process per shard (at most NumWorkers at the same time), returns the number of processes that failed to run or timed out
+	int32 RunShards(const TArray<int32>& Shards, int32 NumWorkers) const;
+
+	// Check the shard states and merge them into the vision collection, returns the number of unfinished shards (or 1 if the merge failed)
+	int32 MergeShards() const;
+
+private:
+	// Map package to load (e.g. /Game/Maps/Kitchen)
+	FString MapName;
+
+	// Task id (database)
+	FString TaskId;
+
+	// Episode id (collection)
+	FString EpisodeId;
+
+	// Mongo server ip
+	FString ServerIp;
+
+	// Mongo server port
+	uint16 ServerPort;
+
+	// Number of timestamp ranges the episode is split into
+	int32 NumShards;
+
+	// Shard processes running longer than this are killed (seconds, 0 for no limit)
+	float ShardTimeout;
+};
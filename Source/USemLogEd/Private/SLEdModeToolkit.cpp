@@ -199,6 +199,15 @@ SVerticalBox::FSlot& FSLEdModeToolkit::CreateSemMapSlot()
 				.ToolTipText(LOCTEXT("SemMapGenTip", "Exports the generated semantic map to an owl file"))
 				.OnClicked(this, &FSLEdModeToolkit::OnWriteSemMap)
 			]
+
+			+ SHorizontalBox::Slot()
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("SemMapUpdate", "Update"))
+				.IsEnabled(true)
+				.ToolTipText(LOCTEXT("SemMapUpdateTip", "Re-creates only the individuals changed since the last export (uses the cache next to the map)"))
+				.OnClicked(this, &FSLEdModeToolkit::OnUpdateSemMap)
+			]
 		];
 }
 
@@ -750,6 +759,12 @@ FReply FSLEdModeToolkit::OnWriteSemMap()
 	return FReply::Handled();
 }
 
+FReply FSLEdModeToolkit::OnUpdateSemMap()
+{
+	FSLEdUtils::WriteSemanticMap(GEditor->GetEditorWorldContext().World(), true, true);
+	return FReply::Handled();
+}
+
 //// Managers
 FReply FSLEdModeToolkit::OnInitSemDataManagers()
 {
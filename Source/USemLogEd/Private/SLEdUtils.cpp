@@ -16,7 +16,7 @@
 #include "Utils/SLUuid.h"
 
 // Write the semantic map
-void FSLEdUtils::WriteSemanticMap(UWorld* World, bool bOverwrite)
+void FSLEdUtils::WriteSemanticMap(UWorld* World, bool bOverwrite, bool bIncremental)
 {
 	FSLSemanticMapWriter SemMapWriter;
 	FString TaskDir;
@@ -34,7 +34,8 @@ void FSLEdUtils::WriteSemanticMap(UWorld* World, bool bOverwrite)
 	}
 	
 	// Generate map and write to file
-	SemMapWriter.WriteToFile(World, ESLOwlSemanticMapTemplate::IAIKitchen, TaskDir, TEXT("SemanticMap"), bOverwrite);
+	SemMapWriter.WriteToFile(World, ESLOwlSemanticMapTemplate::IAIKitchen, TaskDir, TEXT("SemanticMap"), bOverwrite,
+		ESLOwlDocFormat::RdfXml, bIncremental);
 }
 
 
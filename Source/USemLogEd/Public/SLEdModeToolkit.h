@@ -79,6 +79,7 @@ private:
 	
 	// Semantic map
 	FReply OnWriteSemMap();
+	FReply OnUpdateSemMap();
 
 	// Semantic data managers
 	FReply OnInitSemDataManagers();
@@ -11,8 +11,8 @@
 class USEMLOGED_API FSLEdUtils
 {
 public:
-	// Write the semantic map
-	static void WriteSemanticMap(UWorld* World, bool bOverwrite = false);
+	// Write the semantic map (incremental re-creates only the individuals changed since the last write)
+	static void WriteSemanticMap(UWorld* World, bool bOverwrite = false, bool bIncremental = false);
 
 	// Get the semantic individual manager from the world, add new if none are available
 	static class ASLIndividualManager* GetExistingOrCreateNewIndividualManager(UWorld* World, bool bCreateNew = true);
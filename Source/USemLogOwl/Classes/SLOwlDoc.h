@@ -144,6 +144,12 @@ public:
 		PropertyDefinitions.Add(InNode);
 	}
 
+	// Add property definition (moves the node tree instead of copying it)
+	void AddPropertyDefinition(FSLOwlNode&& InNode)
+	{
+		PropertyDefinitions.Emplace(MoveTemp(InNode));
+	}
+
 	// Add datatype definition
 	void AddDatatypeDefinition(const FString& InNs, const FString& InName)
 	{
@@ -158,6 +164,12 @@ public:
 		DatatypeDefinitions.Add(InNode);
 	}
 
+	// Add datatype definition (moves the node tree instead of copying it)
+	void AddDatatypeDefinition(FSLOwlNode&& InNode)
+	{
+		DatatypeDefinitions.Emplace(MoveTemp(InNode));
+	}
+
 	// Add class definition
 	void AddClassDefinition(const FString& InNs, const FString& InName)
 	{
@@ -171,6 +183,12 @@ public:
 	{
 		ClassDefinitions.Add(InNode);
 	}
+
+	// Add class definition (moves the node tree instead of copying it)
+	void AddClassDefinition(FSLOwlNode&& InNode)
+	{
+		ClassDefinitions.Emplace(MoveTemp(InNode));
+	}
 	
 	// Add individual node to the document
 	void AddIndividual(const FSLOwlNode& InChildNode)
@@ -178,24 +196,56 @@ public:
 		Individuals.Add(InChildNode);
 	}
 
+	// Add individual node to the document (moves the node tree instead of copying it)
+	void AddIndividual(FSLOwlNode&& InChildNode)
+	{
+		Individuals.Emplace(MoveTemp(InChildNode));
+	}
+
 	// Add individuals to the document
 	void AddIndividuals(const TArray<FSLOwlNode>& InChildNodes)
 	{
 		Individuals.Append(InChildNodes);
 	}
 
+	// Add individuals to the document (moves the node trees)
+	void AddIndividuals(TArray<FSLOwlNode>&& InChildNodes)
+	{
+		Individuals.Append(MoveTemp(InChildNodes));
+	}
+
 	// Return document as string
 	FString ToString()
 	{
 		FString DocStr = TEXT("<?xml version=\"1.0\" encoding=\"utf-8\"?>\n\n");
 		DocStr += EntityDefinitions.ToString();
-		FSLOwlNode Root(FSLOwlPrefixName("rdf", "RDF"), Namespaces);
-		Root.AddChildNode(OntologyImports);
-		Root.AddChildNodes(PropertyDefinitions);
-		Root.AddChildNodes(DatatypeDefinitions);
-		Root.AddChildNodes(ClassDefinitions);
-		Root.AddChildNodes(Individuals);
-		DocStr += Root.ToString(Indent);
+
+		// Write the root tag around the nodes in place (avoids copying the whole document into a root node),
+		// the root without children is closed with "/>\n", re-open it
+		const FSLOwlNode Root(FSLOwlPrefixName("rdf", "RDF"), Namespaces);
+		DocStr += Root.ToString(Indent).LeftChop(3) + TEXT(">\n");
+
+		Indent += INDENT_STEP;
+		OntologyImports.AppendToString(DocStr, Indent);
+		for (const FSLOwlNode& Node : PropertyDefinitions)
+		{
+			Node.AppendToString(DocStr, Indent);
+		}
+		for (const FSLOwlNode& Node : DatatypeDefinitions)
+		{
+			Node.AppendToString(DocStr, Indent);
+		}
+		for (const FSLOwlNode& Node : ClassDefinitions)
+		{
+			Node.AppendToString(DocStr, Indent);
+		}
+		for (const FSLOwlNode& Node : Individuals)
+		{
+			Node.AppendToString(DocStr, Indent);
+		}
+		Indent.RemoveFromEnd(INDENT_STEP);
+
+		DocStr += Indent + TEXT("</") + Root.Name.ToString() + TEXT(">\n");
 		return DocStr;
 	}
 };
@@ -5,6 +5,7 @@
 
 #include "CoreMinimal.h"
 #include "SLOwlDoc.h"
+#include "SLOwlIndividualRegistry.h"
 
 /**
 * Events owl document template types
@@ -26,14 +27,11 @@ protected:
 	// Array of timepoint individuals
 	TArray<FSLOwlNode> TimepointIndividuals;
 
-	// Set of registered timepoints (in order to avoid multiple individual declaration)
-	TSet<float> RegisteredTimepoints;
-
 	// Array of object individuals
 	TArray<FSLOwlNode> ObjectIndividuals;
 
-	// Set of registered objects (in order to avoid multiple individual declaration)
-	TSet<UObject*> RegisteredObjects;
+	// Registered timepoints and objects (in order to avoid multiple individual declaration)
+	FSLOwlIndividualRegistry IndividualRegistry;
 
 	// Experiment individual
 	FSLOwlNode ExperimentIndividual;
@@ -52,31 +50,11 @@ public:
 	// Destructor
 	~FSLOwlExperiment() {}
 
-	// Add timepoint individual
-	bool AddTimepointIndividual(const float Timepoint, const FSLOwlNode& InOwlNode)
-	{
-		// Avoid logging the same individual multiple times
-		if (!RegisteredTimepoints.Contains(Timepoint))
-		{
-			RegisteredTimepoints.Add(Timepoint);
-			TimepointIndividuals.Emplace(InOwlNode);
-			return true;
-		}
-		return false;
-	}
+	// Add timepoint individual, the node is only created if the timepoint is not yet registered
+	USEMLOGOWL_API bool AddTimepointIndividual(const FString& InDocPrefix, const float Timepoint);
 
-	// Add object individual
-	bool AddObjectIndividual(UObject* Object, const FSLOwlNode& InOwlNode)
-	{
-		// Avoid logging the same individual multiple times
-		if (!RegisteredObjects.Contains(Object))
-		{
-			RegisteredObjects.Add(Object);
-			ObjectIndividuals.Emplace(InOwlNode);
-			return true;
-		}
-		return false;
-	}
+	// Add object individual, the node is only created if the object id is not yet registered
+	USEMLOGOWL_API bool AddObjectIndividual(const FString& InDocPrefix, const FString& InId, const FString& InClass);
 
 	// Create and add experiment node individual
 	void AddExperimentIndividual()
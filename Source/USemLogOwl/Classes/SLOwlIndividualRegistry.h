@@ -0,0 +1,88 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+* Case sensitive id keys (the default FString keys ignore the case, ids differing only in case are different individuals)
+*/
+struct FSLOwlIdKeyFuncs : DefaultKeyFuncs<FString>
+{
+	static FORCEINLINE bool Matches(const FString& A, const FString& B)
+	{
+		return A.Equals(B, ESearchCase::CaseSensitive);
+	}
+
+	static FORCEINLINE uint32 GetKeyHash(const FString& Key)
+	{
+		return FCrc::StrCrc32(*Key);
+	}
+};
+
+/**
+* Keeps track of the already declared individuals of a document,
+* should be queried before creating the owl nodes in order to avoid building nodes which would be discarded
+*/
+struct FSLOwlIndividualRegistry
+{
+protected:
+	// Registered timepoints, quantized to microseconds (avoids float equality issues)
+	TSet<int64> RegisteredTimepoints;
+
+	// Registered object individuals by their entity id
+	TSet<FString, FSLOwlIdKeyFuncs> RegisteredObjectIds;
+
+public:
+	// Timepoint quantization resolution (microseconds)
+	static constexpr double TimepointResolution = 1000000.0;
+
+	// Quantize the timepoint to an integer key
+	static FORCEINLINE int64 QuantizeTimepoint(const float Timepoint)
+	{
+		return static_cast<int64>(FMath::RoundToDouble(static_cast<double>(Timepoint) * TimepointResolution));
+	}
+
+	// Get the timepoint individual id, it is built from the quantized key so that near-equal timepoints share the same id
+	static FORCEINLINE FString GetTimepointId(const float Timepoint)
+	{
+		return TEXT("timepoint_") + FString::SanitizeFloat(
+			static_cast<double>(QuantizeTimepoint(Timepoint)) / TimepointResolution);
+	}
+
+	// Register timepoint, returns false if it was already registered
+	bool RegisterTimepoint(const float Timepoint)
+	{
+		bool bIsAlreadyInSet = false;
+		RegisteredTimepoints.Add(QuantizeTimepoint(Timepoint), &bIsAlreadyInSet);
+		return !bIsAlreadyInSet;
+	}
+
+	// Register object, returns false if it was already registered
+	bool RegisterObject(const FString& InId)
+	{
+		bool bIsAlreadyInSet = false;
+		RegisteredObjectIds.Add(InId, &bIsAlreadyInSet);
+		return !bIsAlreadyInSet;
+	}
+
+	// Check if the timepoint is already registered
+	bool IsTimepointRegistered(const float Timepoint) const
+	{
+		return RegisteredTimepoints.Contains(QuantizeTimepoint(Timepoint));
+	}
+
+	// Check if the object is already registered
+	bool IsObjectRegistered(const FString& InId) const
+	{
+		return RegisteredObjectIds.Contains(InId);
+	}
+
+	// Clear all registered data
+	void Empty()
+	{
+		RegisteredTimepoints.Empty();
+		RegisteredObjectIds.Empty();
+	}
+};
@@ -42,6 +42,13 @@ public:
 		ChildNodes(InChildNodes)
 	{}
 
+	// Init constructor, NO Value or Attributes (moves the children)
+	FSLOwlNode(const FSLOwlPrefixName& InName,
+		TArray<FSLOwlNode>&& InChildNodes) :
+		Name(InName),
+		ChildNodes(MoveTemp(InChildNodes))
+	{}
+
 	// Init constructor, NO Value and Children
 	FSLOwlNode(const FSLOwlPrefixName& InName,
 		const TArray<FSLOwlAttribute>& InAttributes) :
@@ -101,6 +108,12 @@ public:
 		ChildNodes.Add(InChildNode);
 	}
 
+	// Add child node (moves the subtree instead of copying it)
+	void AddChildNode(FSLOwlNode&& InChildNode)
+	{
+		ChildNodes.Emplace(MoveTemp(InChildNode));
+	}
+
 	// Add child nodes
 	void AddChildNodes(const TArray<FSLOwlNode>& InChildNodes)
 	{
@@ -113,6 +126,12 @@ public:
 		Attributes.Add(InAttribute);
 	}
 
+	// Add attribute
+	void AddAttribute(FSLOwlAttribute&& InAttribute)
+	{
+		Attributes.Emplace(MoveTemp(InAttribute));
+	}
+
 	// Add attributes
 	void AddAttributes(const TArray<FSLOwlAttribute>& InAttributes)
 	{
@@ -142,43 +161,57 @@ public:
 	// Destructor
 	~FSLOwlNode() {}
 
+	// Serialize the node tree
+	friend FArchive& operator<<(FArchive& Ar, FSLOwlNode& Node)
+	{
+		return Ar << Node.Name << Node.Value << Node.Attributes << Node.ChildNodes << Node.Comment;
+	}
+
 	// Return node as string
-	FString ToString(FString& Indent)
+	FString ToString(FString& Indent) const
 	{
 		FString NodeStr;
+		AppendToString(NodeStr, Indent);
+		return NodeStr;
+	}
+
+	// Append the node to the string (children are written in place, no intermediate strings)
+	void AppendToString(FString& OutStr, FString& Indent) const
+	{
 		// Add comment
 		if (!Comment.IsEmpty())
 		{
-			NodeStr += TEXT("\n") + Indent + TEXT("<!-- ") + Comment + TEXT(" -->\n");
+			OutStr += TEXT("\n");
+			OutStr += Indent;
+			OutStr += TEXT("<!-- ");
+			OutStr += Comment;
+			OutStr += TEXT(" -->\n");
 		}
 
 		// Comment only OR empty node
-		if (Name.ToString().IsEmpty())
+		if (Name.IsEmpty())
 		{
-			return NodeStr;
+			return;
 		}
 
 		// Add node name
-		NodeStr += Indent + TEXT("<") + Name.ToString();
+		const FString NameStr = Name.ToString();
+		OutStr += Indent;
+		OutStr += TEXT("<");
+		OutStr += NameStr;
 
 		// Add attributes to tag
 		for (int32 i = 0; i < Attributes.Num(); ++i)
 		{
-			if (Attributes.Num() == 1)
-			{
-				NodeStr += TEXT(" ") + Attributes[i].ToString();
-			}
-			else
+			OutStr += TEXT(" ");
+			OutStr += Attributes[i].ToString();
+
+			// Last attribute does not have new line
+			if (i < (Attributes.Num() - 1))
 			{
-				if (i < (Attributes.Num() - 1))
-				{
-					NodeStr += TEXT(" ") + Attributes[i].ToString() + TEXT("\n") + Indent + INDENT_STEP;
-				}
-				else
-				{
-					// Last attribute does not have new line
-					NodeStr += TEXT(" ") + Attributes[i].ToString();
-				}
+				OutStr += TEXT("\n");
+				OutStr += Indent;
+				OutStr += INDENT_STEP;
 			}
 		}
 
@@ -190,34 +223,40 @@ public:
 		if (!bHasChildren && !bHasValue)
 		{
 			// No children nor value, close tag
-			NodeStr += TEXT("/>\n");
+			OutStr += TEXT("/>\n");
 		}
 		else if (bHasValue)
 		{
 			// Node has a value, add value
-			NodeStr += TEXT(">") + Value + TEXT("</") + Name.ToString() + TEXT(">\n");
+			OutStr += TEXT(">");
+			OutStr += Value;
+			OutStr += TEXT("</");
+			OutStr += NameStr;
+			OutStr += TEXT(">\n");
 		}
 		else if(bHasChildren)
 		{
 			// Node has children, add children
-			NodeStr += TEXT(">\n");
+			OutStr += TEXT(">\n");
 			
 			// Increase indentation
 			Indent += INDENT_STEP;
 			
 			// Iterate children and add nodes
-			for (auto& ChildItr : ChildNodes)
+			for (const auto& ChildItr : ChildNodes)
 			{
-				NodeStr += ChildItr.ToString(Indent);
+				ChildItr.AppendToString(OutStr, Indent);
 			}
 			
 			// Decrease indentation
 			Indent.RemoveFromEnd(INDENT_STEP);
 			
 			// Close tag
-			NodeStr += Indent + Value + TEXT("</") + Name.ToString() + TEXT(">\n");
+			OutStr += Indent;
+			OutStr += TEXT("</");
+			OutStr += NameStr;
+			OutStr += TEXT(">\n");
 		}
-		return NodeStr;
 	}
 };
 
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "SLOwlSymbol.h"
 
 // Pair of strings typedef
 typedef TPair<FString, FString> TPairString;
@@ -19,11 +20,11 @@ static const FString INDENT_STEP = TEXT("\t");
 struct FSLOwlPrefixName
 {
 public:
-	// Prefix 
-	FString Prefix;
+	// Prefix (interned)
+	FSLOwlSymbol Prefix;
 
-	// Local name
-	FString LocalName;
+	// Local name (interned)
+	FSLOwlSymbol LocalName;
 
 public:
 	// Default constr
@@ -39,7 +40,7 @@ public:
 	// Get name as string
 	FString ToString() const
 	{
-		return LocalName.IsEmpty() ? Prefix : FString(Prefix + TEXT(":") + LocalName);
+		return LocalName.IsEmpty() ? Prefix.ToString() : FString(Prefix + TEXT(":") + LocalName.ToString());
 	}
 
 	// True if all data is empty
@@ -54,6 +55,12 @@ public:
 		Prefix.Empty();
 		LocalName.Empty();
 	}
+
+	// Serialize
+	friend FArchive& operator<<(FArchive& Ar, FSLOwlPrefixName& Name)
+	{
+		return Ar << Name.Prefix << Name.LocalName;
+	}
 };
 
 /**
@@ -64,8 +71,8 @@ public:
 struct FSLOwlAttributeValue
 {
 public:
-	// Namespace
-	FString Ns;
+	// Namespace (interned)
+	FSLOwlSymbol Ns;
 
 	// Value
 	FString LocalValue;
@@ -100,6 +107,12 @@ public:
 		Ns.Empty();
 		LocalValue.Empty();
 	}
+
+	// Serialize
+	friend FArchive& operator<<(FArchive& Ar, FSLOwlAttributeValue& Value)
+	{
+		return Ar << Value.Ns << Value.LocalValue;
+	}
 };
 	
 /**
@@ -142,6 +155,12 @@ public:
 		Key.Empty();
 		Value.Empty();
 	}
+
+	// Serialize
+	friend FArchive& operator<<(FArchive& Ar, FSLOwlAttribute& Attribute)
+	{
+		return Ar << Attribute.Key << Attribute.Value;
+	}
 };
 	
 /**
@@ -0,0 +1,93 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Process wide table of the interned owl prefixes, local names and namespaces,
+ * a few hundred distinct strings cover a whole document, every string is stored once and never freed
+ */
+struct USEMLOGOWL_API FSLOwlSymbolTable
+{
+	// Get the stored copy of the string (thread safe)
+	static const FString* Intern(const FString& InStr);
+
+	// Get the stored empty string
+	static const FString* GetEmpty();
+
+	// Number of interned strings
+	static int32 Num();
+};
+
+/**
+ * Interned string, copies and comparisons are pointer operations
+ */
+struct FSLOwlSymbol
+{
+public:
+	// Default constr (empty)
+	FSLOwlSymbol() : Str(FSLOwlSymbolTable::GetEmpty()) {}
+
+	// Init constructor
+	FSLOwlSymbol(const FString& InStr) : Str(FSLOwlSymbolTable::Intern(InStr)) {}
+
+	// Init constructor
+	FSLOwlSymbol(const TCHAR* InStr) : Str(FSLOwlSymbolTable::Intern(FString(InStr))) {}
+
+	// Get the interned string
+	const FString& ToString() const { return *Str; }
+
+	// Use as string
+	operator const FString&() const { return *Str; }
+
+	// Get the characters
+	const TCHAR* operator*() const { return **Str; }
+
+	// True if the string is empty
+	bool IsEmpty() const { return Str->IsEmpty(); }
+
+	// Length of the string
+	int32 Len() const { return Str->Len(); }
+
+	// Clear the symbol
+	void Empty() { Str = FSLOwlSymbolTable::GetEmpty(); }
+
+	// Compare with the string
+	bool Equals(const FString& Other, ESearchCase::Type SearchCase = ESearchCase::CaseSensitive) const
+	{
+		return Str->Equals(Other, SearchCase);
+	}
+
+	// Interned symbols are equal only if they point to the same string
+	bool operator==(const FSLOwlSymbol& Other) const { return Str == Other.Str; }
+	bool operator!=(const FSLOwlSymbol& Other) const { return Str != Other.Str; }
+
+	// Compare with the characters
+	bool operator==(const TCHAR* Other) const { return Str->Equals(Other); }
+	bool operator!=(const TCHAR* Other) const { return !Str->Equals(Other); }
+
+	// Concatenate with the characters
+	friend FString operator+(const FSLOwlSymbol& Lhs, const TCHAR* Rhs) { return *Lhs.Str + Rhs; }
+	friend FString operator+(const TCHAR* Lhs, const FSLOwlSymbol& Rhs) { return Lhs + *Rhs.Str; }
+
+	// Hash of the interned pointer
+	friend uint32 GetTypeHash(const FSLOwlSymbol& Symbol) { return PointerHash(Symbol.Str); }
+
+	// Serialize as string (re-interned on load)
+	friend FArchive& operator<<(FArchive& Ar, FSLOwlSymbol& Symbol)
+	{
+		FString String = *Symbol.Str;
+		Ar << String;
+		if (Ar.IsLoading())
+		{
+			Symbol.Str = FSLOwlSymbolTable::Intern(String);
+		}
+		return Ar;
+	}
+
+private:
+	// Interned string
+	const FString* Str;
+};
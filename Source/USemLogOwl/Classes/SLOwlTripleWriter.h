@@ -0,0 +1,35 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SLOwlDoc.h"
+
+/**
+* Owl document output formats
+*/
+UENUM(BlueprintType)
+enum class ESLOwlDocFormat : uint8
+{
+	RdfXml					UMETA(DisplayName = "RDF/XML (.owl)"),
+	NTriples				UMETA(DisplayName = "N-Triples (.nt)"),
+	Turtle					UMETA(DisplayName = "Turtle (.ttl)"),
+};
+
+/**
+ * Streams the owl document as N-Triples (one full iri triple per line) or as Turtle (prefixed names, grouped subjects),
+ * the output only depends on the document content (blank nodes are numbered in document order),
+ * the data is written in small chunks, no full document string is created
+ */
+struct USEMLOGOWL_API FSLOwlTripleWriter
+{
+	// Write the document to file in the given format (RdfXml uses the document string)
+	static bool WriteToFile(FSLOwlDoc& Doc, const FString& FilePath, ESLOwlDocFormat Format);
+
+	// Stream the document triples to the archive
+	static void Write(const FSLOwlDoc& Doc, FArchive& Ar, bool bTurtle);
+
+	// Get the file extension of the format (e.g. "owl")
+	static FString GetFileExtension(ESLOwlDocFormat Format);
+};
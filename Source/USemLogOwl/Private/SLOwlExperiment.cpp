@@ -0,0 +1,29 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "SLOwlExperiment.h"
+#include "SLOwlExperimentStatics.h"
+
+// Add timepoint individual, the node is only created if the timepoint is not yet registered
+bool FSLOwlExperiment::AddTimepointIndividual(const FString& InDocPrefix, const float Timepoint)
+{
+	// Avoid creating and logging the same individual multiple times
+	if (IndividualRegistry.RegisterTimepoint(Timepoint))
+	{
+		TimepointIndividuals.Emplace(FSLOwlExperimentStatics::CreateTimepointIndividual(InDocPrefix, Timepoint));
+		return true;
+	}
+	return false;
+}
+
+// Add object individual, the node is only created if the object id is not yet registered
+bool FSLOwlExperiment::AddObjectIndividual(const FString& InDocPrefix, const FString& InId, const FString& InClass)
+{
+	// Avoid creating and logging the same individual multiple times
+	if (IndividualRegistry.RegisterObject(InId))
+	{
+		ObjectIndividuals.Emplace(FSLOwlExperimentStatics::CreateObjectIndividual(InDocPrefix, InId, InClass));
+		return true;
+	}
+	return false;
+}
@@ -93,8 +93,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateEventIndividual(
 	const FString& InClass)
 {
 	// Prefix name constants
-	const FSLOwlPrefixName RdfAbout("rdf", "about");
-	const FSLOwlPrefixName OwlNI("owl", "NamedIndividual");
+	static const FSLOwlPrefixName RdfAbout("rdf", "about");
+	static const FSLOwlPrefixName OwlNI("owl", "NamedIndividual");
 
 	FSLOwlNode Individual(OwlNI, FSLOwlAttribute(RdfAbout, FSLOwlAttributeValue(
 		InDocPrefix, InId)));
@@ -108,10 +108,10 @@ FSLOwlNode FSLOwlExperimentStatics::CreateTimepointIndividual(
 	const float Timepoint)
 {
 	// Prefix name constants
-	const FSLOwlPrefixName RdfAbout("rdf", "about");
-	const FSLOwlPrefixName OwlNI("owl", "NamedIndividual");
+	static const FSLOwlPrefixName RdfAbout("rdf", "about");
+	static const FSLOwlPrefixName OwlNI("owl", "NamedIndividual");
 
-	const FString Id = "timepoint_" + FString::SanitizeFloat(Timepoint);
+	const FString Id = FSLOwlIndividualRegistry::GetTimepointId(Timepoint);
 	FSLOwlNode Individual(OwlNI, FSLOwlAttribute(RdfAbout, FSLOwlAttributeValue(
 		InDocPrefix, Id)));
 	Individual.AddChildNode(FSLOwlExperimentStatics::CreateClassProperty("Timepoint"));
@@ -125,8 +125,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateObjectIndividual(
 	const FString& InClass)
 {
 	// Prefix name constants
-	const FSLOwlPrefixName RdfAbout("rdf", "about");
-	const FSLOwlPrefixName OwlNI("owl", "NamedIndividual");
+	static const FSLOwlPrefixName RdfAbout("rdf", "about");
+	static const FSLOwlPrefixName OwlNI("owl", "NamedIndividual");
 
 	FSLOwlNode Individual(OwlNI, FSLOwlAttribute(RdfAbout, FSLOwlAttributeValue(
 		InDocPrefix, InId)));
@@ -139,8 +139,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateObjectIndividual(
 // Create class property
 FSLOwlNode FSLOwlExperimentStatics::CreateClassProperty(const FString& InClass)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName RdfType("rdf", "type");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName RdfType("rdf", "type");
 
 	return FSLOwlNode(RdfType, FSLOwlAttribute(
 		RdfResource, FSLOwlAttributeValue("knowrob", InClass)));
@@ -149,10 +149,10 @@ FSLOwlNode FSLOwlExperimentStatics::CreateClassProperty(const FString& InClass)
 // Create startTime property
 FSLOwlNode FSLOwlExperimentStatics::CreateStartTimeProperty(const FString& InDocPrefix, const float Timepoint)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName KbPrefix("knowrob", "startTime");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbPrefix("knowrob", "startTime");
 
-	const FString Id = "timepoint_" + FString::SanitizeFloat(Timepoint);
+	const FString Id = FSLOwlIndividualRegistry::GetTimepointId(Timepoint);
 	return FSLOwlNode(KbPrefix, FSLOwlAttribute(
 		RdfResource, FSLOwlAttributeValue(InDocPrefix, Id)));
 }
@@ -160,10 +160,10 @@ FSLOwlNode FSLOwlExperimentStatics::CreateStartTimeProperty(const FString& InDoc
 // Create endTime property
 FSLOwlNode FSLOwlExperimentStatics::CreateEndTimeProperty(const FString& InDocPrefix, const float Timepoint)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName KbPrefix("knowrob", "endTime");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbPrefix("knowrob", "endTime");
 
-	const FString Id = "timepoint_" + FString::SanitizeFloat(Timepoint);
+	const FString Id = FSLOwlIndividualRegistry::GetTimepointId(Timepoint);
 	return FSLOwlNode(KbPrefix, FSLOwlAttribute(
 		RdfResource, FSLOwlAttributeValue(InDocPrefix, Id)));
 }
@@ -171,8 +171,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateEndTimeProperty(const FString& InDocPr
 // Create inContact property
 FSLOwlNode FSLOwlExperimentStatics::CreateInContactProperty(const FString& InDocPrefix, const FString& InObjId)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName KbPrefix("knowrob", "inContact");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbPrefix("knowrob", "inContact");
 
 	return FSLOwlNode(KbPrefix, FSLOwlAttribute(
 		RdfResource, FSLOwlAttributeValue(InDocPrefix, InObjId)));
@@ -181,8 +181,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateInContactProperty(const FString& InDoc
 // Create isSupported property
 FSLOwlNode FSLOwlExperimentStatics::CreateIsSupportedProperty(const FString& InDocPrefix, const FString& InObjId)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName KbPrefix("knowrob", "isSupported");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbPrefix("knowrob", "isSupported");
 
 	return FSLOwlNode(KbPrefix, FSLOwlAttribute(
 		RdfResource, FSLOwlAttributeValue(InDocPrefix, InObjId)));
@@ -191,8 +191,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateIsSupportedProperty(const FString& InD
 // Create supports property
 FSLOwlNode FSLOwlExperimentStatics::CreateIsSupportingProperty(const FString& InDocPrefix, const FString& InObjId)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName KbPrefix("knowrob", "isSupporting");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbPrefix("knowrob", "isSupporting");
 
 	return FSLOwlNode(KbPrefix, FSLOwlAttribute(
 		RdfResource, FSLOwlAttributeValue(InDocPrefix, InObjId)));
@@ -201,8 +201,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateIsSupportingProperty(const FString& In
 // Create performedBy property
 FSLOwlNode FSLOwlExperimentStatics::CreatePerformedByProperty(const FString& InDocPrefix, const FString& InObjId)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName KbPrefix("knowrob", "performedBy");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbPrefix("knowrob", "performedBy");
 
 	return FSLOwlNode(KbPrefix, FSLOwlAttribute(
 		RdfResource, FSLOwlAttributeValue(InDocPrefix, InObjId)));
@@ -211,8 +211,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreatePerformedByProperty(const FString& InD
 // Create deviceUsed property
 FSLOwlNode FSLOwlExperimentStatics::CreateDeviceUsedProperty(const FString& InDocPrefix, const FString& InObjId)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName KbPrefix("knowrob", "deviceUsed");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbPrefix("knowrob", "deviceUsed");
 
 	return FSLOwlNode(KbPrefix, FSLOwlAttribute(
 		RdfResource, FSLOwlAttributeValue(InDocPrefix, InObjId)));
@@ -221,8 +221,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateDeviceUsedProperty(const FString& InDo
 // Create objectActedOn property
 FSLOwlNode FSLOwlExperimentStatics::CreateObjectActedOnProperty(const FString& InDocPrefix, const FString& InObjId)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName KbPrefix("knowrob", "objectActedOn");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbPrefix("knowrob", "objectActedOn");
 
 	return FSLOwlNode(KbPrefix, FSLOwlAttribute(
 		RdfResource, FSLOwlAttributeValue(InDocPrefix, InObjId)));
@@ -231,8 +231,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateObjectActedOnProperty(const FString& I
 // Create outputsCreated property
 FSLOwlNode FSLOwlExperimentStatics::CreateOutputsCreatedProperty(const FString& InDocPrefix, const FString& InObjId)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName KbPrefix("knowrob", "outputsCreated");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbPrefix("knowrob", "outputsCreated");
 
 	return FSLOwlNode(KbPrefix, FSLOwlAttribute(
 		RdfResource, FSLOwlAttributeValue(InDocPrefix, InObjId)));
@@ -241,8 +241,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateOutputsCreatedProperty(const FString&
 // Create taskSuccess property
 FSLOwlNode FSLOwlExperimentStatics::CreateTaskSuccessProperty(const FString& InDocPrefix, const bool TaskSuccess)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName KbPrefix("knowrob", "taskSuccess");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbPrefix("knowrob", "taskSuccess");
 
 	const FString Id = TaskSuccess ? "true" : "false";
 	return FSLOwlNode(KbPrefix, FSLOwlAttribute(
@@ -251,8 +251,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateTaskSuccessProperty(const FString& InD
 
 FSLOwlNode FSLOwlExperimentStatics::CreateGraspTypeProperty(const FString& InDocPrefix, const FString& InGraspType)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName KbPrefix("knowrob", "graspType");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbPrefix("knowrob", "graspType");
 
 	return FSLOwlNode(KbPrefix, FSLOwlAttribute(
 		RdfResource, FSLOwlAttributeValue(InDocPrefix, InGraspType)));
@@ -260,8 +260,8 @@ FSLOwlNode FSLOwlExperimentStatics::CreateGraspTypeProperty(const FString& InDoc
 
 FSLOwlNode FSLOwlExperimentStatics::CreateTypeProperty(const FString& InDocPrefix, const FString& InType)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName KbPrefix("knowrob", "type");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbPrefix("knowrob", "type");
 
 	return FSLOwlNode(KbPrefix, FSLOwlAttribute(
 		RdfResource, FSLOwlAttributeValue(InDocPrefix, InType)));
@@ -93,8 +93,8 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateObjectIndividual(
 	const FString& Class)
 {
 	// Prefix name constants
-	const FSLOwlPrefixName RdfAbout("rdf", "about");
-	const FSLOwlPrefixName OwlNI("owl", "NamedIndividual");
+	static const FSLOwlPrefixName RdfAbout("rdf", "about");
+	static const FSLOwlPrefixName OwlNI("owl", "NamedIndividual");
 
 	FSLOwlNode ObjectIndividual(OwlNI, FSLOwlAttribute(RdfAbout, FSLOwlAttributeValue(InDocPrefix, Id)));
 	ObjectIndividual.Comment = TEXT("Individual " + Class/* + " " + Id*/);
@@ -110,19 +110,19 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreatePoseIndividual(
 	const FQuat& InQuat)
 {
 	// Prefix name constants
-	const FSLOwlPrefixName RdfAbout("rdf", "about");
-	const FSLOwlPrefixName RdfType("rdf", "type");
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName OwlNI("owl", "NamedIndividual");
+	static const FSLOwlPrefixName RdfAbout("rdf", "about");
+	static const FSLOwlPrefixName RdfType("rdf", "type");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName OwlNI("owl", "NamedIndividual");
 
 	// Attribute values constants
-	const FSLOwlAttributeValue AttrValPose("knowrob", "Pose");
-	const FSLOwlAttributeValue AttrValString("xsd", "string");
+	static const FSLOwlAttributeValue AttrValPose("knowrob", "Pose");
+	static const FSLOwlAttributeValue AttrValString("xsd", "string");
 
 	// Pose individual
 	FSLOwlNode PoseIndividual(OwlNI, FSLOwlAttribute(RdfAbout, FSLOwlAttributeValue(InDocPrefix, InId)));
 	FSLOwlNode PoseProperty(RdfType, FSLOwlAttribute(RdfResource, AttrValPose));
-	PoseIndividual.AddChildNode(PoseProperty);
+	PoseIndividual.AddChildNode(MoveTemp(PoseProperty));
 	PoseIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateQuaternionProperty(InQuat));
 	PoseIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateLocationProperty(InLoc));
 	return PoseIndividual;
@@ -135,8 +135,8 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateConstraintIndividual(
 	const FString& ParentId,
 	const FString& ChildId)
 {
-	const FSLOwlPrefixName RdfAbout("rdf", "about");
-	const FSLOwlPrefixName OwlNI("owl", "NamedIndividual");
+	static const FSLOwlPrefixName RdfAbout("rdf", "about");
+	static const FSLOwlPrefixName OwlNI("owl", "NamedIndividual");
 
 	FSLOwlNode ObjectIndividual(OwlNI, FSLOwlAttribute(RdfAbout, FSLOwlAttributeValue(InDocPrefix, InId)));
 	ObjectIndividual.Comment = TEXT("Constraint"/* + InId*/);
@@ -159,8 +159,8 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateLinearConstraintProperties(
 	float Stiffness,
 	float Damping)
 {
-	const FSLOwlPrefixName RdfAbout("rdf", "about");
-	const FSLOwlPrefixName OwlNI("owl", "NamedIndividual");
+	static const FSLOwlPrefixName RdfAbout("rdf", "about");
+	static const FSLOwlPrefixName OwlNI("owl", "NamedIndividual");
 
 	FSLOwlNode ConstrPropIndividual(OwlNI, FSLOwlAttribute(RdfAbout, FSLOwlAttributeValue(InDocPrefix, InId)));
 	ConstrPropIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateClassProperty("LinearConstraint"));
@@ -199,8 +199,8 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateAngularConstraintProperties(
 	float TwistStiffness,
 	float TwistDamping)
 {
-	const FSLOwlPrefixName RdfAbout("rdf", "about");
-	const FSLOwlPrefixName OwlNI("owl", "NamedIndividual");
+	static const FSLOwlPrefixName RdfAbout("rdf", "about");
+	static const FSLOwlPrefixName OwlNI("owl", "NamedIndividual");
 
 	FSLOwlNode ConstrPropIndividual(OwlNI, FSLOwlAttribute(RdfAbout, FSLOwlAttributeValue(InDocPrefix, InId)));
 	ConstrPropIndividual.AddChildNode(FSLOwlSemanticMapStatics::CreateClassProperty("AngularConstraint"));
@@ -236,8 +236,8 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateAngularConstraintProperties(
 FSLOwlNode FSLOwlSemanticMapStatics::CreateClassDefinition(const FString& InClass)
 {
 	// Prefix name constants
-	const FSLOwlPrefixName RdfAbout("rdf", "about");
-	const FSLOwlPrefixName OwlClass("owl", "Class");
+	static const FSLOwlPrefixName RdfAbout("rdf", "about");
+	static const FSLOwlPrefixName OwlClass("owl", "Class");
 
 	return FSLOwlNode(OwlClass, FSLOwlAttribute(RdfAbout, FSLOwlAttributeValue("knowrob", InClass)));
 }
@@ -247,15 +247,15 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateClassDefinition(const FString& InClas
 FSLOwlNode FSLOwlSemanticMapStatics::CreateGenericResourceProperty(const FSLOwlPrefixName& InPrefixName,
 	const FSLOwlAttributeValue& InAttributeValue)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
 	return FSLOwlNode(InPrefixName, FSLOwlAttribute(RdfResource, InAttributeValue));
 }
 
 // Create class property
 FSLOwlNode FSLOwlSemanticMapStatics::CreateClassProperty(const FString& InClass)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName RdfType("rdf", "type");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName RdfType("rdf", "type");
 
 	return FSLOwlNode(RdfType, FSLOwlAttribute(RdfResource, FSLOwlAttributeValue("knowrob", InClass)));
 }
@@ -264,8 +264,8 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateClassProperty(const FString& InClass)
 FSLOwlNode FSLOwlSemanticMapStatics::CreateDescribedInMapProperty(
 	const FString& InDocPrefix, const FString& InDocId)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName KbDescribedInMap("knowrob", "describedInMap");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbDescribedInMap("knowrob", "describedInMap");
 
 	return FSLOwlNode(KbDescribedInMap, FSLOwlAttribute(RdfResource, FSLOwlAttributeValue(InDocPrefix, InDocId)));
 }
@@ -273,9 +273,9 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateDescribedInMapProperty(
 // Create pathToCadModel property
 FSLOwlNode FSLOwlSemanticMapStatics::CreatePathToCadModelProperty(const FString& InPath)
 {
-	const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
-	const FSLOwlPrefixName KbPathToCadModel("knowrob", "pathToCadModel");
-	const FSLOwlAttributeValue AttrValString("xsd", "string");
+	static const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
+	static const FSLOwlPrefixName KbPathToCadModel("knowrob", "pathToCadModel");
+	static const FSLOwlAttributeValue AttrValString("xsd", "string");
 	const FString Path = "package://robcog/" + InPath + ".dae";
 
 	return FSLOwlNode(KbPathToCadModel, FSLOwlAttribute(RdfDatatype,
@@ -285,9 +285,9 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreatePathToCadModelProperty(const FString&
 // Create tagsData property
 FSLOwlNode FSLOwlSemanticMapStatics::CreateTagsDataProperty(const TArray<FName>& InTags)
 {
-	const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
-	const FSLOwlPrefixName KbTagsData("knowrob", "tagsData");
-	const FSLOwlAttributeValue AttrValString("xsd", "string");
+	static const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
+	static const FSLOwlPrefixName KbTagsData("knowrob", "tagsData");
+	static const FSLOwlAttributeValue AttrValString("xsd", "string");
 	FString Data;
 	for (const auto Tag : InTags)
 	{
@@ -302,8 +302,8 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateTagsDataProperty(const TArray<FName>&
 // Create subClassOf property
 FSLOwlNode FSLOwlSemanticMapStatics::CreateSubClassOfProperty(const FString& InSubClass)
 {
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName RdfsSubClassOf("rdfs", "subClassOf");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName RdfsSubClassOf("rdfs", "subClassOf");
 
 	return FSLOwlNode(RdfsSubClassOf, FSLOwlAttribute(RdfResource, FSLOwlAttributeValue("knowrob", InSubClass)));
 }
@@ -311,9 +311,9 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateSubClassOfProperty(const FString& InS
 // Create skeletal bone property
 FSLOwlNode FSLOwlSemanticMapStatics::CreateSkeletalBoneProperty(const FString& InBone)
 {
-	const FSLOwlPrefixName KbSkelBone("knowrob", "skeletalBone");
-	const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
-	const FSLOwlAttributeValue AttrValString("xsd", "string");
+	static const FSLOwlPrefixName KbSkelBone("knowrob", "skeletalBone");
+	static const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
+	static const FSLOwlAttributeValue AttrValString("xsd", "string");
 
 	return FSLOwlNode(KbSkelBone, FSLOwlAttribute(RdfDatatype, AttrValString), InBone);
 }
@@ -321,9 +321,9 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateSkeletalBoneProperty(const FString& I
 // Create subclass - depth property
 FSLOwlNode FSLOwlSemanticMapStatics::CreateDepthProperty(float Value) 
 {
-	const FSLOwlPrefixName RdfsSubClass("rdfs", "subClassOf");
-	const FSLOwlPrefixName OwlRestriction("owl", "Restriction");
-	const FSLOwlPrefixName OwlHasVal("owl", "hasValue");
+	static const FSLOwlPrefixName RdfsSubClass("rdfs", "subClassOf");
+	static const FSLOwlPrefixName OwlRestriction("owl", "Restriction");
+	static const FSLOwlPrefixName OwlHasVal("owl", "hasValue");
 
 	FSLOwlNode SubClass(RdfsSubClass);
 	FSLOwlNode Restriction(OwlRestriction);
@@ -336,9 +336,9 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateDepthProperty(float Value)
 // Create subclass - height property
 FSLOwlNode FSLOwlSemanticMapStatics::CreateHeightProperty(float Value) 
 {
-	const FSLOwlPrefixName RdfsSubClass("rdfs", "subClassOf");
-	const FSLOwlPrefixName OwlRestriction("owl", "Restriction");
-	const FSLOwlPrefixName OwlHasVal("owl", "hasValue");
+	static const FSLOwlPrefixName RdfsSubClass("rdfs", "subClassOf");
+	static const FSLOwlPrefixName OwlRestriction("owl", "Restriction");
+	static const FSLOwlPrefixName OwlHasVal("owl", "hasValue");
 
 	FSLOwlNode SubClass(RdfsSubClass);
 	FSLOwlNode Restriction(OwlRestriction);
@@ -351,9 +351,9 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateHeightProperty(float Value)
 // Create subclass - width property
 FSLOwlNode FSLOwlSemanticMapStatics::CreateWidthProperty(float Value) 
 {
-	const FSLOwlPrefixName RdfsSubClass("rdfs", "subClassOf");
-	const FSLOwlPrefixName OwlRestriction("owl", "Restriction");
-	const FSLOwlPrefixName OwlHasVal("owl", "hasValue");
+	static const FSLOwlPrefixName RdfsSubClass("rdfs", "subClassOf");
+	static const FSLOwlPrefixName OwlRestriction("owl", "Restriction");
+	static const FSLOwlPrefixName OwlHasVal("owl", "hasValue");
 
 	FSLOwlNode SubClass(RdfsSubClass);
 	FSLOwlNode Restriction(OwlRestriction);
@@ -366,8 +366,8 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateWidthProperty(float Value)
 // Create owl:onProperty meta property
 FSLOwlNode FSLOwlSemanticMapStatics::CreateOnProperty(const FString& InProperty, const FString& Ns)
 {
-	const FSLOwlPrefixName OwlOnProp("owl", "onProperty");
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName OwlOnProp("owl", "onProperty");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
 
 	return FSLOwlNode(OwlOnProp, FSLOwlAttribute(RdfResource, FSLOwlAttributeValue(Ns, InProperty)));
 }
@@ -375,8 +375,8 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateOnProperty(const FString& InProperty,
 // Create a property with a bool value
 FSLOwlNode FSLOwlSemanticMapStatics::CreateBoolValueProperty(const FSLOwlPrefixName& InPrefixName, bool bValue)
 {
-	const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
-	const FSLOwlAttributeValue AttrValBool("xsd", "boolean");
+	static const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
+	static const FSLOwlAttributeValue AttrValBool("xsd", "boolean");
 
 	return FSLOwlNode(InPrefixName, FSLOwlAttribute(RdfDatatype, AttrValBool), bValue ? "true" : "false");
 }
@@ -384,8 +384,8 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateBoolValueProperty(const FSLOwlPrefixN
 // Create a property with an integer value
 FSLOwlNode FSLOwlSemanticMapStatics::CreateIntValueProperty(const FSLOwlPrefixName& InPrefixName, int32 Value)
 {
-	const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
-	const FSLOwlAttributeValue AttrValInt("xsd", "integer");
+	static const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
+	static const FSLOwlAttributeValue AttrValInt("xsd", "integer");
 
 	return FSLOwlNode(InPrefixName, FSLOwlAttribute(RdfDatatype, AttrValInt), FString::FromInt(Value));
 }
@@ -393,8 +393,8 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateIntValueProperty(const FSLOwlPrefixNa
 // Create a property with a float value
 FSLOwlNode FSLOwlSemanticMapStatics::CreateFloatValueProperty(const FSLOwlPrefixName& InPrefixName, float Value)
 {
-	const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
-	const FSLOwlAttributeValue AttrValFloat("xsd", "float");
+	static const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
+	static const FSLOwlAttributeValue AttrValFloat("xsd", "float");
 
 	return FSLOwlNode(InPrefixName, FSLOwlAttribute(RdfDatatype, AttrValFloat), FString::SanitizeFloat(Value));
 }
@@ -402,8 +402,8 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateFloatValueProperty(const FSLOwlPrefix
 // Create a property with a string value
 FSLOwlNode FSLOwlSemanticMapStatics::CreateStringValueProperty(const FSLOwlPrefixName& InPrefixName, const FString& InValue)
 {
-	const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
-	const FSLOwlAttributeValue AttrValString("xsd", "string");
+	static const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
+	static const FSLOwlAttributeValue AttrValString("xsd", "string");
 
 	return FSLOwlNode(InPrefixName, FSLOwlAttribute(RdfDatatype, AttrValString), InValue);
 }
@@ -411,8 +411,8 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateStringValueProperty(const FSLOwlPrefi
 // Create pose property
 FSLOwlNode FSLOwlSemanticMapStatics::CreatePoseProperty(const FString& InDocPrefix, const FString& InId)
 {
-	const FSLOwlPrefixName KbPose("knowrob", "pose");
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbPose("knowrob", "pose");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
 
 	return FSLOwlNode(KbPose, FSLOwlAttribute(RdfResource, FSLOwlAttributeValue(InDocPrefix, InId)));
 }
@@ -420,8 +420,8 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreatePoseProperty(const FString& InDocPref
 // Create linear constraint property
 FSLOwlNode FSLOwlSemanticMapStatics::CreateLinearConstraintProperty(const FString& InDocPrefix, const FString& InId)
 {
-	const FSLOwlPrefixName KbLinearConstr("knowrob", "linearConstraint");
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbLinearConstr("knowrob", "linearConstraint");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
 
 	return FSLOwlNode(KbLinearConstr, FSLOwlAttribute(RdfResource, FSLOwlAttributeValue(InDocPrefix, InId)));
 }
@@ -429,8 +429,8 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateLinearConstraintProperty(const FStrin
 // Create angular constraint property
 FSLOwlNode FSLOwlSemanticMapStatics::CreateAngularConstraintProperty(const FString& InDocPrefix, const FString& InId)
 {
-	const FSLOwlPrefixName KbAngularConstr("knowrob", "angularConstraint");
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbAngularConstr("knowrob", "angularConstraint");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
 
 	return FSLOwlNode(KbAngularConstr, FSLOwlAttribute(RdfResource, FSLOwlAttributeValue(InDocPrefix, InId)));
 }
@@ -438,8 +438,8 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateAngularConstraintProperty(const FStri
 // Create parent property
 FSLOwlNode FSLOwlSemanticMapStatics::CreateParentProperty(const FString& InDocPrefix, const FString& InId)
 {
-	const FSLOwlPrefixName KbChild("knowrob", "parent");
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbChild("knowrob", "parent");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
 
 	return FSLOwlNode(KbChild, FSLOwlAttribute(RdfResource, FSLOwlAttributeValue(InDocPrefix, InId)));
 }
@@ -447,8 +447,8 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateParentProperty(const FString& InDocPr
 // Create child property
 FSLOwlNode FSLOwlSemanticMapStatics::CreateChildProperty(const FString& InDocPrefix, const FString& InId)
 {
-	const FSLOwlPrefixName KbChild("knowrob", "child");
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbChild("knowrob", "child");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
 
 	return FSLOwlNode(KbChild, FSLOwlAttribute(RdfResource, FSLOwlAttributeValue(InDocPrefix, InId)));
 }
@@ -456,21 +456,21 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateChildProperty(const FString& InDocPre
 // Create mobility property
 FSLOwlNode FSLOwlSemanticMapStatics::CreateMobilityProperty(const FString& Mobility)
 {
-	const FSLOwlPrefixName KbMobility("knowrob", "mobility");
-	const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
-	const FSLOwlAttributeValue AttrValString("xsd", "string");
+	static const FSLOwlPrefixName KbMobility("knowrob", "mobility");
+	static const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
+	static const FSLOwlAttributeValue AttrValString("xsd", "string");
 	return FSLOwlNode(KbMobility, FSLOwlAttribute(RdfDatatype, AttrValString), Mobility);
 }
 
 // Create physics properties
 TArray<FSLOwlNode> FSLOwlSemanticMapStatics::CreatePhysicsProperties(float Mass, bool bGenerateOverlapEvents, bool bGravity)
 {
-	const FSLOwlPrefixName KbMass("knowrob", "mass");
-	const FSLOwlPrefixName KbOverlap("knowrob", "overlapEvents");
-	const FSLOwlPrefixName KbGravity("knowrob", "gravity");
-	const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
-	const FSLOwlAttributeValue AttrValFloat("xsd", "float");
-	const FSLOwlAttributeValue AttrValBool("xsd", "boolean");
+	static const FSLOwlPrefixName KbMass("knowrob", "mass");
+	static const FSLOwlPrefixName KbOverlap("knowrob", "overlapEvents");
+	static const FSLOwlPrefixName KbGravity("knowrob", "gravity");
+	static const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
+	static const FSLOwlAttributeValue AttrValFloat("xsd", "float");
+	static const FSLOwlAttributeValue AttrValBool("xsd", "boolean");
 	
 	TArray<FSLOwlNode> PhysicsProperties;
 	PhysicsProperties.Emplace(FSLOwlNode(KbMass, FSLOwlAttribute(RdfDatatype, AttrValFloat), FString::SanitizeFloat(Mass)));
@@ -483,18 +483,18 @@ TArray<FSLOwlNode> FSLOwlSemanticMapStatics::CreatePhysicsProperties(float Mass,
 // Create mask color property
 FSLOwlNode FSLOwlSemanticMapStatics::CreateMaskColorProperty(const FString& HexColor)
 {
-	const FSLOwlPrefixName KbMaskColor("knowrob", "maskColor");
-	const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
-	const FSLOwlAttributeValue AttrValString("xsd", "string");
+	static const FSLOwlPrefixName KbMaskColor("knowrob", "maskColor");
+	static const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
+	static const FSLOwlAttributeValue AttrValString("xsd", "string");
 	return FSLOwlNode(KbMaskColor, FSLOwlAttribute(RdfDatatype, AttrValString), HexColor);
 }
 
 // Create a location node
 FSLOwlNode FSLOwlSemanticMapStatics::CreateLocationProperty(const FVector& InLoc)
 {
-	const FSLOwlPrefixName KbTransl("knowrob", "translation");
-	const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
-	const FSLOwlAttributeValue AttrValString("xsd", "string");
+	static const FSLOwlPrefixName KbTransl("knowrob", "translation");
+	static const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
+	static const FSLOwlAttributeValue AttrValString("xsd", "string");
 
 	const FString LocStr = FString::Printf(TEXT("%f %f %f"),
 		InLoc.X, InLoc.Y, InLoc.Z);
@@ -504,9 +504,9 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateLocationProperty(const FVector& InLoc
 // Create a quaternion node
 FSLOwlNode FSLOwlSemanticMapStatics::CreateQuaternionProperty(const FQuat& InQuat)
 {
-	const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
-	const FSLOwlPrefixName KbQuat("knowrob", "quaternion");
-	const FSLOwlAttributeValue AttrValString("xsd", "string");
+	static const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
+	static const FSLOwlPrefixName KbQuat("knowrob", "quaternion");
+	static const FSLOwlAttributeValue AttrValString("xsd", "string");
 	
 	const FString QuatStr = FString::Printf(TEXT("%f %f %f %f"),
 		InQuat.X, InQuat.Y, InQuat.Z, InQuat.W);
@@ -517,15 +517,15 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateQuaternionProperty(const FQuat& InQua
 // Create srdl has capability properties
 FSLOwlNode FSLOwlSemanticMapStatics::CreateHasCapabilityProperties(const TArray<FString>& Capabilities)
 {
-	const FSLOwlPrefixName RdfsSubClassOf("rdfs", "subClassOf");
-	const FSLOwlPrefixName OwlClass("owl", "Class");
-	const FSLOwlPrefixName OwlIntersectionOf("owl", "intersectionOf");
-	const FSLOwlPrefixName OwlRestriction("owl", "Restriction");
+	static const FSLOwlPrefixName RdfsSubClassOf("rdfs", "subClassOf");
+	static const FSLOwlPrefixName OwlClass("owl", "Class");
+	static const FSLOwlPrefixName OwlIntersectionOf("owl", "intersectionOf");
+	static const FSLOwlPrefixName OwlRestriction("owl", "Restriction");
 
-	const FSLOwlPrefixName OwlOnProp("owl", "onProperty");
-	const FSLOwlPrefixName OwlSomeValuesFrom("owl", "someValuesFrom");
+	static const FSLOwlPrefixName OwlOnProp("owl", "onProperty");
+	static const FSLOwlPrefixName OwlSomeValuesFrom("owl", "someValuesFrom");
 
-	const FSLOwlAttributeValue HasCapabilityAttr("srdl2-cap", "hasCapability");
+	static const FSLOwlAttributeValue HasCapabilityAttr("srdl2-cap", "hasCapability");
 
 	FSLOwlNode SubClassOf(RdfsSubClassOf);
 	FSLOwlNode Class(OwlClass);
@@ -547,8 +547,8 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateHasCapabilityProperties(const TArray<
 // Create srdl skeletal bone property
 FSLOwlNode FSLOwlSemanticMapStatics::CreateSrdlSkeletalBoneProperty(const FString& InDocPrefix, const FString& InId)
 {
-	const FSLOwlPrefixName KbSkelBone("srdl2-comp", "subComponent");
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName KbSkelBone("srdl2-comp", "subComponent");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
 
 	return FSLOwlNode(KbSkelBone, FSLOwlAttribute(RdfResource, FSLOwlAttributeValue(InDocPrefix, InId)));
 }
@@ -563,18 +563,18 @@ FSLOwlNode FSLOwlSemanticMapStatics::CreateBoneIndividual(
 	const FString& BoneName)
 {
 	// Prefix name constants
-	const FSLOwlPrefixName OwlNI("owl", "NamedIndividual");
-	const FSLOwlPrefixName RdfAbout("rdf", "about");
-	const FSLOwlPrefixName RdfType("rdf", "type");
-	const FSLOwlPrefixName RdfResource("rdf", "resource");
-	const FSLOwlPrefixName SrdlBaseLink("srdl2-comp", "baseLinkOfComposition");
-	const FSLOwlPrefixName SrdlEndLink("srdl2-comp", "endLinkOfComposition");
-	const FSLOwlPrefixName KbSkelBone("knowrob", "skeletalBoneName");
-	const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
+	static const FSLOwlPrefixName OwlNI("owl", "NamedIndividual");
+	static const FSLOwlPrefixName RdfAbout("rdf", "about");
+	static const FSLOwlPrefixName RdfType("rdf", "type");
+	static const FSLOwlPrefixName RdfResource("rdf", "resource");
+	static const FSLOwlPrefixName SrdlBaseLink("srdl2-comp", "baseLinkOfComposition");
+	static const FSLOwlPrefixName SrdlEndLink("srdl2-comp", "endLinkOfComposition");
+	static const FSLOwlPrefixName KbSkelBone("knowrob", "skeletalBoneName");
+	static const FSLOwlPrefixName RdfDatatype("rdf", "datatype");
 		
 	// Attribute values constants
-	const FSLOwlAttributeValue ComponentCompAttr("srdl2-comp", "ComponentComposition");
-	const FSLOwlAttributeValue AttrValString("xsd", "string");
+	static const FSLOwlAttributeValue ComponentCompAttr("srdl2-comp", "ComponentComposition");
+	static const FSLOwlAttributeValue AttrValString("xsd", "string");
 
 	// Bone individual
 	FSLOwlNode BoneIndividual(OwlNI, FSLOwlAttribute(RdfAbout, FSLOwlAttributeValue(InDocPrefix, InId)));
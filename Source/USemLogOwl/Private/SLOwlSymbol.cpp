@@ -0,0 +1,88 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "SLOwlSymbol.h"
+#include "Misc/ScopeRWLock.h"
+#include "Templates/UniquePtr.h"
+
+namespace
+{
+	// Case sensitive string keys (the default FString keys ignore the case)
+	struct FSLOwlSymbolKeyFuncs : TDefaultMapKeyFuncs<FString, const FString*, false>
+	{
+		static FORCEINLINE bool Matches(const FString& A, const FString& B)
+		{
+			return A.Equals(B, ESearchCase::CaseSensitive);
+		}
+
+		static FORCEINLINE uint32 GetKeyHash(const FString& Key)
+		{
+			return FCrc::StrCrc32(*Key);
+		}
+	};
+
+	// Interned strings storage
+	struct FSLOwlSymbolStorage
+	{
+		// Guards the lookup map (most calls only read)
+		FRWLock Lock;
+
+		// String to its stored copy
+		TMap<FString, const FString*, FDefaultSetAllocator, FSLOwlSymbolKeyFuncs> Lookup;
+
+		// Heap allocated strings (the pointers stay valid when the arrays grow)
+		TArray<TUniquePtr<FString>> Strings;
+
+		// Shared empty string
+		const FString Empty;
+	};
+
+	// Created on first use (the symbols can be used from static initializers)
+	FSLOwlSymbolStorage& GetStorage()
+	{
+		static FSLOwlSymbolStorage Storage;
+		return Storage;
+	}
+}
+
+// Get the stored copy of the string (thread safe)
+const FString* FSLOwlSymbolTable::Intern(const FString& InStr)
+{
+	FSLOwlSymbolStorage& Storage = GetStorage();
+	if (InStr.IsEmpty())
+	{
+		return &Storage.Empty;
+	}
+
+	{
+		FRWScopeLock ReadLock(Storage.Lock, SLT_ReadOnly);
+		if (const FString* const* Found = Storage.Lookup.Find(InStr))
+		{
+			return *Found;
+		}
+	}
+
+	FRWScopeLock WriteLock(Storage.Lock, SLT_Write);
+	// Might have been added between the locks
+	if (const FString* const* Found = Storage.Lookup.Find(InStr))
+	{
+		return *Found;
+	}
+	const FString* Stored = Storage.Strings.Emplace_GetRef(MakeUnique<FString>(InStr)).Get();
+	Storage.Lookup.Add(InStr, Stored);
+	return Stored;
+}
+
+// Get the stored empty string
+const FString* FSLOwlSymbolTable::GetEmpty()
+{
+	return &GetStorage().Empty;
+}
+
+// Number of interned strings
+int32 FSLOwlSymbolTable::Num()
+{
+	FSLOwlSymbolStorage& Storage = GetStorage();
+	FRWScopeLock ReadLock(Storage.Lock, SLT_ReadOnly);
+	return Storage.Strings.Num();
+}
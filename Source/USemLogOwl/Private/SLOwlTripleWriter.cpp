@@ -0,0 +1,432 @@
+// Copyright 2017-2020, Institute for Artificial Intelligence - University of Bremen
+// Author: Andrei Haidu (http://haidu.eu)
+
+#include "SLOwlTripleWriter.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Templates/UniquePtr.h"
+
+/**
+ * Converts the owl/xml node tree (rdf:about subjects, property elements with rdf:resource / rdf:datatype / nested nodes)
+ * to triples and streams them to the archive
+ */
+class FSLOwlTripleStream
+{
+public:
+	// Ctor
+	FSLOwlTripleStream(const FSLOwlDoc& InDoc, FArchive& InAr, bool bInTurtle) :
+		Doc(InDoc), Ar(InAr), bTurtle(bInTurtle), NextBlankNodeId(0)
+	{
+		// Entity definitions (&log;) and namespace declarations (xmlns:log) both map prefixes to iris
+		for (const auto& Pair : Doc.EntityDefinitions.EntityPairs)
+		{
+			PrefixToIri.Add(Pair.Key, Pair.Value);
+		}
+		for (const auto& Namespace : Doc.Namespaces)
+		{
+			if (Namespace.Key.Prefix == TEXT("xmlns") && !Namespace.Key.LocalName.IsEmpty())
+			{
+				PrefixToIri.Add(Namespace.Key.LocalName.ToString(), Namespace.Value.LocalValue);
+				Prefixes.AddUnique(Namespace.Key.LocalName.ToString());
+			}
+		}
+		for (const auto& Pair : Doc.EntityDefinitions.EntityPairs)
+		{
+			Prefixes.AddUnique(Pair.Key);
+		}
+		Buffer.Reserve(FlushSize + 1024);
+	}
+
+	// Dtor
+	~FSLOwlTripleStream()
+	{
+		Flush();
+	}
+
+	// Write all the document nodes
+	void WriteDoc()
+	{
+		if (bTurtle)
+		{
+			for (const FString& Prefix : Prefixes)
+			{
+				Append(TEXT("@prefix ") + Prefix + TEXT(": <") + PrefixToIri[Prefix] + TEXT("> .\n"));
+			}
+			Append(TEXT("\n"));
+		}
+
+		WriteTopNode(Doc.OntologyImports);
+		for (const FSLOwlNode& Node : Doc.PropertyDefinitions)
+		{
+			WriteTopNode(Node);
+		}
+		for (const FSLOwlNode& Node : Doc.DatatypeDefinitions)
+		{
+			WriteTopNode(Node);
+		}
+		for (const FSLOwlNode& Node : Doc.ClassDefinitions)
+		{
+			WriteTopNode(Node);
+		}
+		for (const FSLOwlNode& Node : Doc.Individuals)
+		{
+			WriteTopNode(Node);
+		}
+	}
+
+private:
+	// Write a document level node
+	void WriteTopNode(const FSLOwlNode& Node)
+	{
+		// Skip comment only nodes
+		if (Node.Name.IsEmpty())
+		{
+			return;
+		}
+
+		if (bTurtle)
+		{
+			const FSLOwlAttribute* About = FindAttribute(Node, TEXT("rdf"), TEXT("about"));
+			Append(TurtleStatements(About ? IriTerm(ValueToIri(About->Value)) : FString(TEXT("[]")), Node));
+		}
+		else
+		{
+			WriteNodeTriples(Node);
+		}
+	}
+
+	// Write the triples of the node as N-Triples, returns the subject term
+	FString WriteNodeTriples(const FSLOwlNode& Node)
+	{
+		const FSLOwlAttribute* About = FindAttribute(Node, TEXT("rdf"), TEXT("about"));
+		const FString Subject = About ? IriTerm(ValueToIri(About->Value)) : NewBlankNode();
+
+		if (!IsDescription(Node))
+		{
+			AppendTriple(Subject, IriTerm(RdfType), IriTerm(NameToIri(Node.Name)));
+		}
+		for (const FSLOwlAttribute& Attribute : Node.Attributes)
+		{
+			if (IsPropertyAttribute(Attribute))
+			{
+				AppendTriple(Subject, IriTerm(NameToIri(Attribute.Key)), LiteralTerm(Attribute.Value.LocalValue, FString()));
+			}
+		}
+		for (const FSLOwlNode& Property : Node.ChildNodes)
+		{
+			if (Property.Name.IsEmpty())
+			{
+				continue;
+			}
+			const FString Predicate = IriTerm(NameToIri(Property.Name));
+			if (Property.ChildNodes.Num() > 0)
+			{
+				for (const FSLOwlNode& Object : Property.ChildNodes)
+				{
+					if (!Object.Name.IsEmpty())
+					{
+						AppendTriple(Subject, Predicate, WriteNodeTriples(Object));
+					}
+				}
+			}
+			else
+			{
+				AppendTriple(Subject, Predicate, ObjectTerm(Property));
+			}
+		}
+		return Subject;
+	}
+
+	// Get the Turtle statements of the subject followed by its named nested nodes (subjects without predicates are skipped)
+	FString TurtleStatements(const FString& Subject, const FSLOwlNode& Node)
+	{
+		const FString Predicates = TurtlePredicates(Node, 1);
+		FString Result = Predicates.IsEmpty() ? FString() : Subject + TEXT(" ") + Predicates + TEXT(" .\n\n");
+
+		// Write the named nested nodes after the current subject
+		TArray<const FSLOwlNode*> Nested = MoveTemp(PendingNodes);
+		for (const FSLOwlNode* NestedNode : Nested)
+		{
+			Result += TurtleStatements(IriTerm(ValueToIri(FindAttribute(*NestedNode, TEXT("rdf"), TEXT("about"))->Value)), *NestedNode);
+		}
+		return Result;
+	}
+
+	// Get the predicate object list of the node in Turtle (nested nodes are written as [ .. ] blank nodes)
+	FString TurtlePredicates(const FSLOwlNode& Node, int32 Depth)
+	{
+		const FString Separator = TEXT(" ;\n") + FString::ChrN(Depth, TEXT('\t'));
+		TArray<FString> Predicates;
+		if (!IsDescription(Node))
+		{
+			Predicates.Add(TEXT("a ") + IriTerm(NameToIri(Node.Name)));
+		}
+		for (const FSLOwlAttribute& Attribute : Node.Attributes)
+		{
+			if (IsPropertyAttribute(Attribute))
+			{
+				Predicates.Add(IriTerm(NameToIri(Attribute.Key)) + TEXT(" ") + LiteralTerm(Attribute.Value.LocalValue, FString()));
+			}
+		}
+		for (const FSLOwlNode& Property : Node.ChildNodes)
+		{
+			if (Property.Name.IsEmpty())
+			{
+				continue;
+			}
+			const FString Predicate = IriTerm(NameToIri(Property.Name));
+			if (Property.ChildNodes.Num() > 0)
+			{
+				for (const FSLOwlNode& Object : Property.ChildNodes)
+				{
+					if (Object.Name.IsEmpty())
+					{
+						continue;
+					}
+					if (const FSLOwlAttribute* About = FindAttribute(Object, TEXT("rdf"), TEXT("about")))
+					{
+						// Named nested nodes are written as separate subjects
+						Predicates.Add(Predicate + TEXT(" ") + IriTerm(ValueToIri(About->Value)));
+						PendingNodes.Add(&Object);
+					}
+					else
+					{
+						Predicates.Add(Predicate + TEXT(" [\n") + FString::ChrN(Depth + 1, TEXT('\t')) +
+							TurtlePredicates(Object, Depth + 1) + TEXT("\n") + FString::ChrN(Depth, TEXT('\t')) + TEXT("]"));
+					}
+				}
+			}
+			else
+			{
+				Predicates.Add(Predicate + TEXT(" ") + ObjectTerm(Property));
+			}
+		}
+
+		return FString::Join(Predicates, *Separator);
+	}
+
+	// Get the object term of a property element without nested nodes (resource or literal)
+	FString ObjectTerm(const FSLOwlNode& Property)
+	{
+		if (const FSLOwlAttribute* Resource = FindAttribute(Property, TEXT("rdf"), TEXT("resource")))
+		{
+			return IriTerm(ValueToIri(Resource->Value));
+		}
+		const FSLOwlAttribute* Datatype = FindAttribute(Property, TEXT("rdf"), TEXT("datatype"));
+		return LiteralTerm(Property.Value, Datatype ? ValueToIri(Datatype->Value) : FString());
+	}
+
+	// Find the attribute with the given key
+	static const FSLOwlAttribute* FindAttribute(const FSLOwlNode& Node, const TCHAR* Prefix, const TCHAR* LocalName)
+	{
+		for (const FSLOwlAttribute& Attribute : Node.Attributes)
+		{
+			if (Attribute.Key.Prefix == Prefix && Attribute.Key.LocalName == LocalName)
+			{
+				return &Attribute;
+			}
+		}
+		return nullptr;
+	}
+
+	// True if the node element has no type (rdf:Description)
+	static bool IsDescription(const FSLOwlNode& Node)
+	{
+		return Node.Name.Prefix == TEXT("rdf") && Node.Name.LocalName == TEXT("Description");
+	}
+
+	// True if the attribute of a node element is a property (not rdf syntax or xml)
+	static bool IsPropertyAttribute(const FSLOwlAttribute& Attribute)
+	{
+		return Attribute.Key.Prefix != TEXT("rdf") && Attribute.Key.Prefix != TEXT("xml") && Attribute.Key.Prefix != TEXT("xmlns");
+	}
+
+	// Expand the prefixed name
+	FString NameToIri(const FSLOwlPrefixName& Name) const
+	{
+		if (const FString* Iri = PrefixToIri.Find(Name.Prefix.ToString()))
+		{
+			return *Iri + Name.LocalName;
+		}
+		return Name.ToString();
+	}
+
+	// Expand the attribute value (&ns;value)
+	FString ValueToIri(const FSLOwlAttributeValue& Value) const
+	{
+		if (Value.Ns.IsEmpty())
+		{
+			return Value.LocalValue;
+		}
+		if (const FString* Iri = PrefixToIri.Find(Value.Ns.ToString()))
+		{
+			return *Iri + Value.LocalValue;
+		}
+		return Value.Ns + TEXT(":") + Value.LocalValue;
+	}
+
+	// Get the iri term, prefixed if possible in Turtle
+	FString IriTerm(const FString& Iri) const
+	{
+		if (bTurtle)
+		{
+			const FString* BestPrefix = nullptr;
+			int32 BestLen = 0;
+			for (const FString& Prefix : Prefixes)
+			{
+				const FString& PrefixIri = PrefixToIri[Prefix];
+				if (PrefixIri.Len() > BestLen && Iri.StartsWith(PrefixIri, ESearchCase::CaseSensitive)
+					&& IsValidLocalName(Iri, PrefixIri.Len()))
+				{
+					BestPrefix = &Prefix;
+					BestLen = PrefixIri.Len();
+				}
+			}
+			if (BestPrefix)
+			{
+				return *BestPrefix + TEXT(":") + Iri.RightChop(BestLen);
+			}
+		}
+		return TEXT("<") + Iri + TEXT(">");
+	}
+
+	// Check if the iri remainder can be written as a prefixed local name
+	static bool IsValidLocalName(const FString& Iri, int32 StartIdx)
+	{
+		for (int32 Idx = StartIdx; Idx < Iri.Len(); ++Idx)
+		{
+			const TCHAR C = Iri[Idx];
+			if (!FChar::IsAlnum(C) && C != TEXT('_') && !(C == TEXT('-') && Idx > StartIdx))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Get the (typed) literal term
+	FString LiteralTerm(const FString& Value, const FString& DatatypeIri) const
+	{
+		FString Escaped;
+		Escaped.Reserve(Value.Len() + 2);
+		Escaped.AppendChar(TEXT('"'));
+		for (const TCHAR C : Value)
+		{
+			switch (C)
+			{
+			case TEXT('\\'): Escaped += TEXT("\\\\"); break;
+			case TEXT('"'): Escaped += TEXT("\\\""); break;
+			case TEXT('\n'): Escaped += TEXT("\\n"); break;
+			case TEXT('\r'): Escaped += TEXT("\\r"); break;
+			case TEXT('\t'): Escaped += TEXT("\\t"); break;
+			default: Escaped.AppendChar(C);
+			}
+		}
+		Escaped.AppendChar(TEXT('"'));
+		if (!DatatypeIri.IsEmpty())
+		{
+			Escaped += TEXT("^^") + IriTerm(DatatypeIri);
+		}
+		return Escaped;
+	}
+
+	// Blank nodes are numbered in document order
+	FString NewBlankNode()
+	{
+		return FString::Printf(TEXT("_:b%d"), NextBlankNodeId++);
+	}
+
+	// Append an N-Triples line
+	void AppendTriple(const FString& Subject, const FString& Predicate, const FString& Object)
+	{
+		Append(Subject + TEXT(" ") + Predicate + TEXT(" ") + Object + TEXT(" .\n"));
+	}
+
+	// Append the text as utf-8, flushes the buffer when it is full
+	void Append(const FString& Text)
+	{
+		FTCHARToUTF8 Converted(*Text);
+		Buffer.Append(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+		if (Buffer.Num() >= FlushSize)
+		{
+			Flush();
+		}
+	}
+
+	// Write the buffer to the archive
+	void Flush()
+	{
+		if (Buffer.Num() > 0)
+		{
+			Ar.Serialize(Buffer.GetData(), Buffer.Num());
+			Buffer.Reset();
+		}
+	}
+
+private:
+	// Streamed document
+	const FSLOwlDoc& Doc;
+
+	// Output
+	FArchive& Ar;
+
+	// Turtle or N-Triples
+	bool bTurtle;
+
+	// Blank node counter
+	int32 NextBlankNodeId;
+
+	// Prefix to iri
+	TMap<FString, FString> PrefixToIri;
+
+	// Prefixes in declaration order
+	TArray<FString> Prefixes;
+
+	// Named nodes nested in the current Turtle subject (written after it)
+	TArray<const FSLOwlNode*> PendingNodes;
+
+	// Output buffer
+	TArray<uint8> Buffer;
+
+	// Buffer size after which it is written to the archive
+	static constexpr int32 FlushSize = 64 * 1024;
+
+	// Type predicate iri
+	const FString RdfType = TEXT("http://www.w3.org/1999/02/22-rdf-syntax-ns#type");
+};
+
+// Write the document to file in the given format (RdfXml uses the document string)
+bool FSLOwlTripleWriter::WriteToFile(FSLOwlDoc& Doc, const FString& FilePath, ESLOwlDocFormat Format)
+{
+	if (Format == ESLOwlDocFormat::RdfXml)
+	{
+		return FFileHelper::SaveStringToFile(Doc.ToString(), *FilePath);
+	}
+
+	TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!FileWriter)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s::%d Could not create %s.."), *FString(__func__), __LINE__, *FilePath);
+		return false;
+	}
+	Write(Doc, *FileWriter, Format == ESLOwlDocFormat::Turtle);
+	return FileWriter->Close();
+}
+
+// Stream the document triples to the archive
+void FSLOwlTripleWriter::Write(const FSLOwlDoc& Doc, FArchive& Ar, bool bTurtle)
+{
+	FSLOwlTripleStream Stream(Doc, Ar, bTurtle);
+	Stream.WriteDoc();
+}
+
+// Get the file extension of the format (e.g. "owl")
+FString FSLOwlTripleWriter::GetFileExtension(ESLOwlDocFormat Format)
+{
+	switch (Format)
+	{
+	case ESLOwlDocFormat::NTriples: return TEXT("nt");
+	case ESLOwlDocFormat::Turtle: return TEXT("ttl");
+	default: return TEXT("owl");
+	}
+}